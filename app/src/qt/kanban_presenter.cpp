@@ -52,13 +52,8 @@ vector<const Tag*> KanbanPresenter::getTagsForColumn(int columnNumber)
     return empty;
 }
 
-void KanbanPresenter::refresh(
-    Kanban* kanban,
-    const vector<Note*>& ons,
-    const vector<Outline*>& os,
-    const vector<Note*>& ns,
-    bool setFocus
-) {
+void KanbanPresenter::refresh(Kanban* kanban, bool setFocus)
+{
     MF_DEBUG("Rendering Kanban: " << kanban->getName() << "..." << endl);
 
     this->kanban = kanban;
@@ -68,8 +63,8 @@ void KanbanPresenter::refresh(
     vector<Note*> lowerLeftNs{};
     vector<Note*> lowerRightNs{};
 
-    Outline::organizeToKanbanColumns(
-        this->kanban, ons, os, ns, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs
+    orloj->getMind()->organize(
+        this->kanban, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs
     );
 
     // set quadrant titles
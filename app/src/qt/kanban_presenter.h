@@ -80,13 +80,7 @@ public:
 
     std::vector<const Tag*> getTagsForColumn(int columnNumber);
 
-    void refresh(
-        Kanban* kanban,
-        const std::vector<Note*>& ons,
-        const std::vector<Outline*>& os,
-        const std::vector<Note*>& ns,
-        bool setFocus = true
-    );
+    void refresh(Kanban* kanban, bool setFocus = true);
 
     void getVisibleColumns(std::vector<KanbanColumnPresenter*>& visible, std::vector<int>& offsets);
     KanbanColumnPresenter* getNextVisibleColumn();
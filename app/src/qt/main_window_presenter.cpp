@@ -186,6 +186,12 @@ MainWindowPresenter::MainWindowPresenter(MainWindowView& view)
 
     // let Mind to learn active repository & preserve desired state
     mind->learn();
+
+    // learn changes made to the repository by others (git pull, sync, ...)
+    repositoryWatchTimer = new QTimer{this};
+    QObject::connect(repositoryWatchTimer, SIGNAL(timeout()), this, SLOT(slotLearnRepositoryChanges()));
+    QObject::connect(repositoryWatchTimer, SIGNAL(timeout()), this, SLOT(slotReportWriteFailures()));
+    repositoryWatchTimer->start(REPOSITORY_WATCH_INTERVAL);
 }
 
 MainWindowPresenter::~MainWindowPresenter()
@@ -220,8 +226,6 @@ void MainWindowPresenter::showInitialView()
 {
     MF_DEBUG("Initial view to show " << mind->getOutlines().size() << " Os (scope is applied if active)" << endl);
 
-    static vector<Note*> emptyVector{};
-
     // UI
     if(mind->getOutlines().size()) {
         if(config.getActiveRepository()->getMode()==Repository::RepositoryMode::REPOSITORY) {
@@ -246,12 +250,7 @@ void MainWindowPresenter::showInitialView()
                     vector<Note*> notes{};
                     orloj->showFacetRecentNotes(mind->getAllNotes(notes));
                 } else if(!string{START_TO_EISENHOWER_MATRIX}.compare(config.getStartupView())) {
-                    orloj->showFacetEisenhowerMatrix(
-                         nullptr,
-                         emptyVector,
-                         mind->getOutlines(),
-                         emptyVector
-                    );
+                    orloj->showFacetEisenhowerMatrix(nullptr);
                 } else if(!string{START_TO_HOME_OUTLINE}.compare(config.getStartupView())) {
                     if(!doActionViewHome()) {
                         // fallback
@@ -584,7 +583,7 @@ void MainWindowPresenter::doActionMindToggleAutolink()
         config.setAutolinking(true);
     }
     mainMenu->showFacetMindAutolink(config.isAutolinking());
-    mdConfigRepresentation->save(config);
+    mdConfigRepresentation->saveLater(config);
 
     // refresh view
     if(orloj->isFacetActive(OrlojPresenterFacets::FACET_VIEW_OUTLINE_HEADER)
@@ -625,7 +624,7 @@ void MainWindowPresenter::doActionToggleLiveNotePreview()
     } else {
         config.setUiLiveNotePreview(true);
     }
-    mdConfigRepresentation->save(config);
+    mdConfigRepresentation->saveLater(config);
 
     // menu
     mainMenu->showFacetLiveNotePreview(config.isUiLiveNotePreview());
@@ -782,7 +781,57 @@ void MainWindowPresenter::slotMainToolbarVisibilityChanged(bool visibility)
 {
     MF_DEBUG("Main toolbar visibility changed: " << boolalpha << visibility << endl);
     this->config.setUiShowToolbar(visibility);
-    mdConfigRepresentation->save(config);
+    mdConfigRepresentation->saveLater(config);
+}
+
+void MainWindowPresenter::slotLearnRepositoryChanges()
+{
+    if(!config.isRepositoryWatch() || orloj->isFacetActiveOutlineOrNoteEdit()) {
+        // O/N being edited must not be replaced under the hands of the user
+        return;
+    }
+
+    int changes = mind->learnChanges();
+    if(changes < 0) {
+        // changes lost > learn from scratch like on repository open (kept pending if Mind is busy)
+        if(mind->learn()) {
+            statusBar->showInfo(tr("Repository changed by others - relearned"));
+            showInitialView();
+        }
+    } else if(changes > 0) {
+        statusBar->showInfo(QString(tr("Learned %1 file(s) changed by others")).arg(changes));
+        // changed O is replaced by new instance > refresh views showing it
+        if(orloj->isFacetActiveOutlineOrNoteView()
+             ||
+           orloj->isFacetActive(OrlojPresenterFacets::FACET_LIST_OUTLINES))
+        {
+            Outline* o = nullptr;
+            if(orloj->isFacetActiveOutlineOrNoteView()
+                 &&
+               orloj->getOutlineView()->getCurrentOutline())
+            {
+                o = mind->remind().getOutline(
+                    orloj->getOutlineView()->getCurrentOutline()->getKey());
+            }
+            if(o) {
+                orloj->showFacetOutline(o);
+            } else {
+                orloj->showFacetOutlineList(mind->getOutlines());
+            }
+        }
+    }
+}
+
+void MainWindowPresenter::slotReportWriteFailures()
+{
+    // Os are written in background > failed writes are known only later
+    vector<string> failures{};
+    if(mind->remind().takeWriteFailures(failures)) {
+        statusBar->showError(
+            QString(tr("Unable to save '%1' - %2 file(s) not saved, check disk space and permissions"))
+                .arg(QString::fromStdString(failures.back()))
+                .arg(failures.size()));
+    }
 }
 
 void MainWindowPresenter::doActionFindOutlineByName()
@@ -2183,7 +2232,8 @@ void MainWindowPresenter::handleMindCsvExport()
             exportMemoryToCsvDialog->isOheTags()
             ?exportMemoryToCsvDialog->getOheTagsCardinality()
             :-1,
-            &callbackCtx
+            &callbackCtx,
+            &mind->getWorkers()
             //[](float progress){ cout << "Export progress: " << progress << endl; }
         );
         statusBar->showInfo(
@@ -2374,19 +2424,27 @@ void MainWindowPresenter::doActionNoteExternalEdit()
 
             // paste text BACK to Note
             if(isFile(tempFilePath.c_str())) {
-                vector<string*> description{};
+                vector<string*> lines{};
                 size_t fileSize{};
-                fileToLines(&tempFilePath, description, fileSize);
+                fileToLines(&tempFilePath, lines, fileSize);
 
                 // kill the first line if title
-                if(description.size()
-                   && description[0]
-                   && description[0]->size() > 2
-                   && description[0]->at(0) == '#'
-                   && description[0]->at(1) == ' '
+                if(lines.size()
+                   && lines[0]
+                   && lines[0]->size() > 2
+                   && lines[0]->at(0) == '#'
+                   && lines[0]->at(1) == ' '
                 ) {
-                    delete description[0];
-                    description.erase(description.begin());
+                    delete lines[0];
+                    lines.erase(lines.begin());
+                }
+
+                Description description{};
+                for(string* l:lines) {
+                    if(l) {
+                        description.append(*l);
+                        delete l;
+                    }
                 }
 
                 // update note
@@ -2517,7 +2575,7 @@ void MainWindowPresenter::doActionNoteExtract()
                         n?n->getDepth():0);
             if(extractedNote) {
                 // parse selected text to description
-                std::vector<std::string*> description{};
+                Description description{};
                 string t{selectedText.toStdString()};
                 mdRepresentation->description(&t, description);
                 extractedNote->setDescription(description);
@@ -2787,7 +2845,7 @@ void MainWindowPresenter::handleMindScope()
     config.setTagsScope(mind->getTagsScopeAspect().getTags());
 
     // save configuration
-    mdConfigRepresentation->save(config);
+    mdConfigRepresentation->saveLater(config);
 
     // IMPROVE don't change view to Os, but refresh current one
     doActionViewOutlines();
@@ -2901,11 +2959,6 @@ void MainWindowPresenter::doActionOrganizerNew()
 
 void MainWindowPresenter::handleCreateOrganizer()
 {
-    static vector<Note*> organizerOutlinesAndNotes{};
-    organizerOutlinesAndNotes.clear();
-    static vector<Note*> organizerNotes{};
-    organizerNotes.clear();
-
     Organizer* o{nullptr};
     if(newOrganizerDialog->getOrganizerToEdit()) {
         MF_DEBUG("Updating organizer...");
@@ -2972,19 +3025,9 @@ void MainWindowPresenter::handleCreateOrganizer()
         orloj->showFacetOrganizerList(config.getRepositoryConfiguration().getOrganizers());
     } else {
         if(Organizer::OrganizerType::KANBAN == newOrganizerDialog->getOrganizerToEdit()->getOrganizerType()) {
-            orloj->showFacetKanban(
-                static_cast<Kanban*>(o),
-                mind->getAllNotes(organizerOutlinesAndNotes, true, true),
-                mind->getOutlines(),
-                mind->getAllNotes(organizerNotes, true, false)
-            );
+            orloj->showFacetKanban(static_cast<Kanban*>(o));
         } else {
-            orloj->showFacetEisenhowerMatrix(
-                o,
-                mind->getAllNotes(organizerOutlinesAndNotes, true, true),
-                mind->getOutlines(),
-                mind->getAllNotes(organizerNotes, true, false)
-            );
+            orloj->showFacetEisenhowerMatrix(o);
         }
     }
 }
@@ -3016,7 +3059,7 @@ void MainWindowPresenter::doActionOrganizerEdit()
         // ensures that if O is deleted, it will be detected
         if(!oScopeOutline) {
             o->clearOutlineScope();
-            mdConfigRepresentation->save(config);
+            mdConfigRepresentation->saveLater(config);
         }
     }
     newOrganizerDialog->show(mind->getOutlines(), nullptr, o, oScopeOutline);
@@ -3067,23 +3110,12 @@ void doActionOrganizerMoveNoteCommon(
     OrganizerQuadrantPresenter* presenter,
     OrlojPresenter* orloj
 ) {
-    static vector<Note*> organizerOutlinesAndNotes{};
-    static vector<Note*> organizerNotes{};
-
     if(presenter) {
         // persist modified N
         orloj->getMind()->remember(note->getOutlineKey());
 
         // refresh view
-        organizerOutlinesAndNotes.clear();
-        organizerNotes.clear();
-        orloj->getOrganizer()->refresh(
-            orloj->getOrganizer()->getOrganizer(),
-            orloj->getMind()->getAllNotes(organizerOutlinesAndNotes, true, true),
-            orloj->getMind()->getOutlines(),
-            orloj->getMind()->getAllNotes(organizerNotes, true, false),
-            false
-        );
+        orloj->getOrganizer()->refresh(orloj->getOrganizer()->getOrganizer(), false);
 
         // give target N column focus
         presenter->getView()->setFocus();
@@ -3098,23 +3130,12 @@ void doActionKanbanMoveNoteCommon(
     KanbanColumnPresenter* presenter,
     OrlojPresenter* orloj
 ) {
-    static vector<Note*> organizerOutlinesAndNotes{};
-    static vector<Note*> organizerNotes{};
-
     if(presenter) {
         // persist modified N
         orloj->getMind()->remember(note->getOutlineKey());
 
         // refresh view
-        organizerOutlinesAndNotes.clear();
-        organizerNotes.clear();
-        orloj->getKanban()->refresh(
-            orloj->getKanban()->getKanban(),
-            orloj->getMind()->getAllNotes(organizerOutlinesAndNotes, true, true),
-            orloj->getMind()->getOutlines(),
-            orloj->getMind()->getAllNotes(organizerNotes, true, false),
-            false
-        );
+        orloj->getKanban()->refresh(orloj->getKanban()->getKanban(), false);
 
         // give target N column focus
         presenter->getView()->setFocus();
@@ -3191,6 +3212,8 @@ void MainWindowPresenter::doActionOrganizerForget()
             tr("Do you really want to forget '") + QString::fromStdString(o->getName()) + tr("' Organizer?")
         );
         if (choice == QMessageBox::Yes) {
+            // view of the deleted organizer would be kept forever
+            mind->forgetOrganizer(o);
             config.getRepositoryConfiguration().removeOrganizer(o);
             getConfigRepresentation()->save(config);
             orloj->showFacetOrganizerList(config.getRepositoryConfiguration().getOrganizers());
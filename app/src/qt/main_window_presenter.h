@@ -97,6 +97,8 @@ class MainWindowPresenter : public QObject
     static QString EXPORT_O_TO_HTML_TITLE;
     static QString EXPORT_O_TO_HTML_EXTENSION;
 
+    static const int REPOSITORY_WATCH_INTERVAL = 2000;
+
 private:
     MainWindowView& view;
 
@@ -104,6 +106,9 @@ private:
     Mind* mind;
 
     AsyncTaskNotificationsDistributor* distributor;
+    // periodically learns repository changes made by others (if watched)
+    // and reports Os which failed to be written in background
+    QTimer* repositoryWatchTimer;
 #ifdef MF_NER
     NerMainWindowWorkerThread* nerWorker;
 #endif
@@ -370,6 +375,8 @@ public slots:
 
     void slotHandleFts();
     void slotMainToolbarVisibilityChanged(bool visibility);
+    void slotLearnRepositoryChanges();
+    void slotReportWriteFailures();
 
 private:
     void injectMarkdownText(const QString& text, bool newline=false, int offset=0);
@@ -84,7 +84,9 @@ NavigatorView::NavigatorView(QWidget* parent, bool isDashboardlet)
       w{},
       h{},
       garbageItems{},
-      subgraph{}
+      subgraph{},
+      layout{},
+      layoutNodes{}
 {
     // scene is peephole rectangle to the whole view (QGraphicsView)
     navigatorScene = new QGraphicsScene(this);
@@ -128,6 +130,8 @@ void NavigatorView::cleanupBeforeHide() {
     // TODO codereview to ensure that there are no memory leaks
     clearGarbageItems();
     navigatorScene->clear();
+    layout.clear();
+    layoutNodes.clear();
 
     MF_DEBUG("NAVIGATOR.hide() scene[" << navigatorScene->items().size() << "]" << endl);
 }
@@ -233,6 +237,8 @@ void NavigatorView::timerEvent(QTimerEvent *event)
             } else {
                 MF_DEBUG("  sub-graph is EMPTY");
                 navigatorScene->clear();
+                layout.clear();
+                layoutNodes.clear();
                 return;
             }
         } else {
@@ -268,12 +274,19 @@ void NavigatorView::timerEvent(QTimerEvent *event)
             } else {
                 MF_DEBUG("  sub-graph is EMPTY");
                 navigatorScene->clear();
+                layout.clear();
+                layoutNodes.clear();
                 return;
             }
         }
 
         //  ADD new nodes
 
+        // layout nodes order: central node, children, parents
+        layout.setSubGraph(*subgraph);
+        layoutNodes.clear();
+        layoutNodes.push_back(selectedNode);
+
         NavigatorNode* n;
         NavigatorEdge* e;
         std::vector<KnowledgeGraphNode*>& children = subgraph->getChildren();
@@ -283,6 +296,7 @@ void NavigatorView::timerEvent(QTimerEvent *event)
             // newly created nodes and edges will be destroyed by garbage items collector
             n = new NavigatorNode(kn, this, QColor(kn->getColor()));
             navigatorScene->addItem(n);
+            layoutNodes.push_back(n);
             e = new NavigatorEdge(selectedNode, n);
             navigatorScene->addItem(e);
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -304,6 +318,7 @@ void NavigatorView::timerEvent(QTimerEvent *event)
             // newly created nodes and edges will be destroyed by garbage items collector
             n = new NavigatorNode(kn, this, QColor(kn->getColor()));
             navigatorScene->addItem(n);
+            layoutNodes.push_back(n);
             e = new NavigatorEdge(n, selectedNode);
             navigatorScene->addItem(e);
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -326,20 +341,37 @@ void NavigatorView::timerEvent(QTimerEvent *event)
 
     // RENDER scene
 
-    QList<NavigatorNode*> nodes;
-    foreach(QGraphicsItem *item, navigatorScene->items()) {
-        if(NavigatorNode *node = qgraphicsitem_cast<NavigatorNode *>(item))
-            nodes << node;
-    }
-
-    foreach(NavigatorNode *node, nodes) {
-        node->calculateForces();
-    }
-
     bool itemsMoved = false;
-    foreach(NavigatorNode *node, nodes) {
-        if(node->moved()) {
+    if(layoutNodes.size()) {
+        // ensure nodes fit in scene
+        QRectF sceneRect = navigatorScene->sceneRect();
+        layout.setBounds(
+            sceneRect.left() + 10,
+            sceneRect.top() + 10,
+            sceneRect.right() - 10,
+            sceneRect.bottom() - 10);
+        layout.setEdgeLength(initialEdgeLenght);
+
+        // nodes might have been dragged by mouse or shuffled
+        QGraphicsItem* mouseGrabber = navigatorScene->mouseGrabberItem();
+        for(size_t i=0; i<layoutNodes.size(); i++) {
+            layout.setPosition(i, layoutNodes[i]->pos().x(), layoutNodes[i]->pos().y());
+            if(layoutNodes[i] == mouseGrabber) {
+                layout.setPinned(i, true);
+                layout.heat();
+            } else {
+                layout.setPinned(i, false);
+            }
+        }
+
+        if(layout.step()) {
             itemsMoved = true;
+            for(size_t i=0; i<layoutNodes.size(); i++) {
+                QPointF newPos{layout.getX(i), layout.getY(i)};
+                if(newPos != layoutNodes[i]->pos()) {
+                    layoutNodes[i]->setPos(newPos);
+                }
+            }
         }
     }
 
@@ -393,6 +425,7 @@ void NavigatorView::mousePressEvent(QMouseEvent* mouseEvent)
 
 void NavigatorView::shuffle()
 {
+    layout.heat();
     foreach (QGraphicsItem *item, navigatorScene->items()) {
         if (qgraphicsitem_cast<NavigatorNode *>(item))
             item->setPos(
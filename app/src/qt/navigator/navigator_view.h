@@ -74,6 +74,7 @@
 #include <QGraphicsView>
 
 #include "../../../../lib/src/mind/knowledge_graph.h"
+#include "../../../../lib/src/mind/knowledge_graph_layout.h"
 #include "../../../../lib/src/model/outline.h"
 #include "../look_n_feel.h"
 
@@ -88,6 +89,8 @@ class NavigatorNode;
  * @brief Knowledge graph navigator view.
  *
  * Knowledge graph is based on force-directed graph based (FDB) - magnets and rubber bands.
+ * Forces are calculated by (Qt independent) knowledge graph layout, view just copies
+ * node positions to its items.
  *
  * Synchronization & UI threads: selected node sets subgraph, timerEvent()
  * then refreshes view which avoids the need for extra synchronization.
@@ -117,6 +120,10 @@ private:
     // subgraph to be rendered
     KnowledgeSubGraph* subgraph;
 
+    // layout node i is rendered by layoutNodes[i]
+    KnowledgeGraphLayout layout;
+    std::vector<NavigatorNode*> layoutNodes;
+
     qreal initialEdgeLenght;
 
     bool isDashboardlet;
@@ -136,6 +143,7 @@ public:
 
         updateNavigatorView();
         this->subgraph = subgraph;
+        layout.heat();
         itemMoved(); // kick timer if not running
     }
     void refreshOnNextTimerTick() {
@@ -131,90 +131,6 @@ QList<NavigatorEdge *> NavigatorNode::edges() const
 	return edgeList;
 }
 
-/**
- * @brief Force-drive graph: repulse magnets and rubber bands.
- *
- * IMPORTANT: method primarily calculates RELATIVE coordinates change for this node (vectors),
- *            finally it calculates new node position which is stored to newPos
- */
-void NavigatorNode::calculateForces()
-{
-	if (!scene() || scene()->mouseGrabberItem() == this) {
-		newPos = pos();
-		return;
-	}
-
-    // NODES ~ REPULSE MAGNETS: sum up all forces pushing this node AWAY
-    qreal xVelocity = 0;
-    qreal yVelocity = 0;
-    foreach(QGraphicsItem* otherItem, scene()->items()) {
-        NavigatorNode* otherNode = qgraphicsitem_cast<NavigatorNode*>(otherItem);
-        if(!otherNode) {
-			continue;
-        }
-
-        // this node's coordinate system:
-        // - this node is in [0, 0]
-        // - other node coordinate is in fact vector:
-        //   > this node is at the beginning of the vector
-        //   > other node is at the end of other vector
-        QPointF vector = mapToItem(otherNode, 0, 0);
-        qreal dx = vector.x();
-        qreal dy = vector.y();
-        // formula that calculates and ADDs forces driving this node away in X and Y direction
-        double l = 2.0 * (dx*dx + dy*dy);
-        // if nodes have DIFFERENT coordinates, then add AWAY forces
-        if(l > 0) {
-            xVelocity += (dx * navigator->getInitialEdgeLenght()) / l;
-            yVelocity += (dy * navigator->getInitialEdgeLenght()) / l;
-        }
-	}
-
-    // EDGES ~ RUBBER BANDS: sum up all forces pulling this node TOGETHER & SUBSTRACT it from forces pulling items together
-	double weight = (edgeList.size() + 1) * 10;
-    foreach(NavigatorEdge* edge, edgeList) {
-        QPointF vector;
-        if(edge->getSrcNode() == this) {
-            vector = mapToItem(edge->getDstNode(), 0, 0);
-        } else {
-            vector = mapToItem(edge->getSrcNode(), 0, 0);
-        }
-        // substract TOGETHER forces from away forces
-        xVelocity -= vector.x() / weight;
-        yVelocity -= vector.y() / weight;
-	}
-
-    // round velocity to avoid moving FOREVER
-    // - stops redraw if change is small
-    // - higher threshold avoids "floating" graph moving a tiny fraction of pixels
-    // - original value 0.1
-    if(qAbs(xVelocity) < 0.3 && qAbs(yVelocity) < 0.3) {
-        xVelocity = yVelocity = 0;
-    }
-
-    // ensure node fits in scene
-	QRectF sceneRect = scene()->sceneRect();
-    newPos = pos() + QPointF(xVelocity, yVelocity);
-	newPos.setX(qMin(qMax(newPos.x(), sceneRect.left() + 10), sceneRect.right() - 10));
-	newPos.setY(qMin(qMax(newPos.y(), sceneRect.top() + 10), sceneRect.bottom() - 10));
-
-    // newPos contains new node position which will be applied on moved() (previously advance()) invocation
-}
-
-/**
- * @brief Apply new position calculated by calculateForces()
- */
-bool NavigatorNode::moved()
-{
-    if (newPos == pos()) {
-		return false;
-    }
-
-	setPos(newPos);
-
-	return true;
-}
-
 // IMPORTANT boundingRect MUST be sec correctly, otherwise this node rendering is CLIPPED (text or shape)
 QRectF NavigatorNode::boundingRect() const
 {
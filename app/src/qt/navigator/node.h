@@ -117,9 +117,6 @@ class NavigatorNode : public QGraphicsItem
 	enum { Type = UserType + 1 };
     int type() const override { return Type; }
 
-	void calculateForces();
-    bool moved();
-
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
@@ -133,7 +130,6 @@ class NavigatorNode : public QGraphicsItem
 
  private:
     QList<NavigatorEdge*> edgeList;
-	QPointF newPos;
 };
 
 }
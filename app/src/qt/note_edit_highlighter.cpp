@@ -28,19 +28,14 @@ NoteEditHighlighter::NoteEditHighlighter(QPlainTextEdit* noteEditorView)
       spellCheckDictionary{DictionaryManager::instance().requestDictionary()},
       isTypingPaused{false},
       noteEditorView{noteEditorView},
-      noteEditorDocument{noteEditorView->document()}
+      noteEditorDocument{noteEditorView->document()},
+      scanner{}
 {
     /*
      * HTML inlined in MD - goes first so that formatting can be rewritten by MD
      */
 
     // IMPROVE consider making HTML highlighting optional (config)
-    addRegex(HtmlTag, "<[!?]?\\w+(?:/>)?", false);
-    addRegex(HtmlTag, "(?:</\\w+)?[?]?>");
-    addRegex(HtmlEntity, "&(:?#\\d+|\\w+);");
-    addRegex(HtmlComment, "<!--.*-->");
-    addRegex(HtmlAttribute, "(\\w+(?::\\w+)?)=(\"[^\"]+\"|'[^\']+')");
-
     htmlTagFormat.setForeground(lookAndFeels.getEditorHtmlTag());
     htmlAttrNameFormat.setForeground(lookAndFeels.getEditorHtmlAttrName());
     htmlAttValueFormat.setForeground(lookAndFeels.getEditorHtmlAttrValue());
@@ -49,24 +44,9 @@ NoteEditHighlighter::NoteEditHighlighter(QPlainTextEdit* noteEditorView)
     htmlCommentFormat.setFontItalic(true);
 
     /*
-     * Markdown (check QRegExp or Perl regexps)
+     * Markdown
      */
 
-    // regexps
-    addRegex(Bold, "\\*\\S[\\S\\s]+\\*",true);
-    addRegex(Bolder, "\\*\\*[\\S\\s]+\\*\\*");
-    addRegex(Italic, "_[\\S\\s]+_");
-    addRegex(Italicer, "__[\\S\\s]+\\__");
-    addRegex(Strikethrough, "~~[\\S\\s]+\\~~");
-    addRegex(Link, "\\[(:?[\\S\\s]+)\\]\\([\\S\\s]+\\)");
-    addRegex(Autolink, "https?://\\S+",false);
-    addRegex(Codeblock, "`[\\S\\s]+`");
-    addRegex(Mathblock, "\\$[\\S\\s]+\\$");
-    addRegex(UnorderedList, "^(:?    )*[\\*\\+\\-] ");
-    addRegex(OrderedList, "^(:?    )*\\d\\d?\\. ");
-    addRegex(TaskDoneItem, "^(:?    )*[\\*\\+\\-] \\[x\\]");
-    addRegex(TaskWipItem, "^(:?    )*[\\*\\+\\-] \\[ \\]");
-
     // formats
     boldFormat.setForeground(lookAndFeels.getEditorBold());
     bolderFormat.setForeground(lookAndFeels.getEditorBolder());
@@ -96,27 +76,6 @@ NoteEditHighlighter::NoteEditHighlighter(QPlainTextEdit* noteEditorView)
 
 NoteEditHighlighter::~NoteEditHighlighter()
 {
-    for(auto& p:typeAndRegex) {
-        delete p;
-    }
-    typeAndRegex.clear();
-}
-
-
-/**
- * @brief Add regexp for matching.
- * @param minimal   controls non-greed vs greedy matching
- *
- * Add Qt's Perl compatible regexp - see QRegExp or https://perlmaven.com/regex-cheat-sheet
- */
-void NoteEditHighlighter::addRegex(Type type, const QString &pattern, bool minimal)
-{
-    QRegExp* regex = new QRegExp{pattern};
-    regex->setPatternSyntax(QRegExp::RegExp2);
-    regex->setMinimal(minimal);
-
-    std::pair<Type,QRegExp*>* p = new std::pair<Type,QRegExp*>(type,regex);
-    typeAndRegex.push_back(p);
 }
 
 /**
@@ -128,172 +87,70 @@ void NoteEditHighlighter::addRegex(Type type, const QString &pattern, bool minim
 void NoteEditHighlighter::highlightBlock(const QString& text)
 {
     if(enabled) {
-        // clear format of the text
-        setCurrentBlockState(Normal);
-
-        // when in MD code section, then there is no need to highlight anything
-        if(!highlightMultilineMdCode(text)) {
-            // highlight patterns defined using regexps
-            if(text.size()) highlightPatterns(text);
-            // eventually overwrite certain formatting with *multiline(s)* like MD code or HTML comments
-            highlightMultilineHtmlComments(text);
-
-            // spell check
-            if(Configuration::getInstance().isUiEditorLiveSpellCheck()) {
-                this->spellCheck(text);
-            }
+        // find spans of ALL highlighted types in single pass - multiline MD code and HTML comments
+        // are tracked using block state
+        setCurrentBlockState(
+            scanner.scan(
+                reinterpret_cast<const char16_t*>(text.utf16()),
+                static_cast<size_t>(text.size()),
+                previousBlockState()));
+
+        // spans are ordered so that latter spans OVERWRITE format of earlier spans, e.g. consider
+        // bold rewritten by bolder or anything rewritten by multiline HTML comment
+        for(const MarkdownHighlightSpan& span:scanner.getSpans()) {
+            setFormat(
+                static_cast<int>(span.offset),
+                static_cast<int>(span.length),
+                toFormat(span.type));
         }
-    }
-}
 
-/*
- * This method get editor's text and it uses regexps to tokenize
- * it. Then it assigns a format to every detected token using
- * setFormat(offset,length) function.
- */
-void NoteEditHighlighter::highlightPatterns(const QString& text)
-{
-    // iterate all regexps - ORDER matters as latter regexps may OVERWRITE format of
-    // earlier regexps, e.g. consider bold rewritten by multiline code or bold rewriting
-    // bolder
-    // IMPROVE improve O(n) which is BIG and depends on the number of regexps:
-    //   O(n) = size(regexps) * lng(text)
-    for(auto p:typeAndRegex) {
-        Type type = p->first;
-        QRegExp* regex = p->second;
-
-        // find 1st match for regex in text
-        int index = regex->indexIn(text);
-        // loop until there are other matches
-        while(index > -1) {
-            int length = regex->matchedLength();
-
-            switch(type) {
-            case Bolder:
-                setFormat(index, length, bolderFormat);
-                break;
-            case Bold:
-                setFormat(index, length, boldFormat);
-                break;
-            case Italic:
-                setFormat(index, length, italicFormat);
-                break;
-            case Italicer:
-                setFormat(index, length, italicerFormat);
-                break;
-            case Strikethrough:
-                setFormat(index, length, strikethroughFormat);
-                break;
-            case Codeblock:
-                setFormat(index, length, codeBlockFormat);
-                break;
-            case Mathblock:
-                setFormat(index, length, mathBlockFormat);
-                break;
-            case Link:
-                setFormat(index, length, linkFormat);
-                break;
-            case Autolink:
-                setFormat(index, length, linkFormat);
-                break;
-            case UnorderedList:
-                setFormat(index, length, listFormat);
-                break;
-            case OrderedList:
-                setFormat(index, length, listFormat);
-                break;
-            case TaskDoneItem:
-                setFormat(index, length, taskDoneFormat);
-                break;
-            case TaskWipItem:
-                setFormat(index, length, taskWipFormat);
-                break;
-            case HtmlTag:
-                setFormat(index, length, htmlTagFormat);
-                break;
-            case HtmlAttribute:
-                setFormat(
-                    index,
-                    regex->pos(2) - index - 1,
-                    htmlAttrNameFormat);
-                setFormat(
-                    regex->pos(2) + 1,
-                    regex->cap(2).length() - 2,
-                    htmlAttValueFormat);
-                break;
-            case HtmlEntity:
-                setFormat(index, length, htmlEntityFormat);
-                break;
-            case HtmlComment:
-                // this is single line comment - multiline comments are matched by separate method
-                setFormat(index, length, htmlCommentFormat);
-                break;
-            }
-
-            // match again
-            index = regex->indexIn(text, index+length);
-        }
-    }
-}
-
-/**
- * @brief Highlight MD multiline code and return true if the line has been formatted.
- */
-bool NoteEditHighlighter::highlightMultilineMdCode(const QString &text)
-{
-    static const QString TOKEN("```");
-
-    if(previousBlockState()!=-1 && (previousBlockState()&InCode)==InCode) {
-        // already inside block
-        if(!text.compare(TOKEN)) {
-            // finish block ~ don't send anything
-            setFormat(0, TOKEN.length(), codeBlockFormat);
-            return true;
-        } else {
-            // continue block
-            setCurrentBlockState(currentBlockState()|InCode);
-            setFormat(0, text.size(), codeBlockFormat);
-            return true;
-        }
-    } else {
-        // outside block
-        if(text.startsWith(TOKEN)) {
-            // enter block ~ don't send anything
-            setCurrentBlockState(currentBlockState()|InCode);
-            setFormat(0, text.size(), codeBlockFormat);
-            return true;
-        } else {
-            setCurrentBlockState(Normal);
-            return false;
+        // spell check - when in MD code section, then there is no need to check anything
+        if(!scanner.isCodeBlock() && Configuration::getInstance().isUiEditorLiveSpellCheck()) {
+            this->spellCheck(text);
         }
     }
 }
 
-void NoteEditHighlighter::highlightMultilineHtmlComments(const QString &text)
+const QTextCharFormat& NoteEditHighlighter::toFormat(MarkdownHighlightType type) const
 {
-    static const QString BEGIN_TOKEN("<!--");
-    static const QString END_TOKEN("-->");
-
-    if(previousBlockState() > -1 && (previousBlockState() & InComment) == InComment) {
-        int end = text.indexOf(END_TOKEN);
-        if (end == -1) {
-            setFormat(0, text.length(), htmlCommentFormat);
-            setCurrentBlockState(currentBlockState() | InComment);
-            return;
-        }
-        else {
-            setFormat(0, end + END_TOKEN.length(), htmlCommentFormat);
-        }
+    switch(type) {
+    case MarkdownHighlightType::BOLDER:
+        return bolderFormat;
+    case MarkdownHighlightType::BOLD:
+        return boldFormat;
+    case MarkdownHighlightType::ITALIC:
+        return italicFormat;
+    case MarkdownHighlightType::ITALICER:
+        return italicerFormat;
+    case MarkdownHighlightType::STRIKETHROUGH:
+        return strikethroughFormat;
+    case MarkdownHighlightType::CODE:
+        return codeBlockFormat;
+    case MarkdownHighlightType::MATH:
+        return mathBlockFormat;
+    case MarkdownHighlightType::LINK:
+    case MarkdownHighlightType::AUTOLINK:
+        return linkFormat;
+    case MarkdownHighlightType::UNORDERED_LIST:
+    case MarkdownHighlightType::ORDERED_LIST:
+        return listFormat;
+    case MarkdownHighlightType::TASK_DONE:
+        return taskDoneFormat;
+    case MarkdownHighlightType::TASK_WIP:
+        return taskWipFormat;
+    case MarkdownHighlightType::HTML_TAG:
+        return htmlTagFormat;
+    case MarkdownHighlightType::HTML_ATTRIBUTE_NAME:
+        return htmlAttrNameFormat;
+    case MarkdownHighlightType::HTML_ATTRIBUTE_VALUE:
+        return htmlAttValueFormat;
+    case MarkdownHighlightType::HTML_ENTITY:
+        return htmlEntityFormat;
+    case MarkdownHighlightType::HTML_COMMENT:
+        break;
     }
 
-    int start = text.lastIndexOf(BEGIN_TOKEN);
-    if(start != -1) {
-        int end = text.lastIndexOf(END_TOKEN);
-        if(end < start) {
-            setFormat(start, text.length(), htmlCommentFormat);
-            setCurrentBlockState(currentBlockState() | InComment);
-        }
-    }
+    return htmlCommentFormat;
 }
 
 void NoteEditHighlighter::spellCheck(const QString& text)
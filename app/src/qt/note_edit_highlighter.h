@@ -21,6 +21,8 @@
 
 #include <QtWidgets>
 
+#include "../../../lib/src/representations/markdown/markdown_highlight_scanner.h"
+
 #include "look_n_feel.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/dictionary_manager.h"
@@ -32,33 +34,6 @@ class NoteEditHighlighter : public QSyntaxHighlighter
     Q_OBJECT
 
 private:
-    enum Type {
-        Bold,
-        Bolder,
-        Italic,
-        Italicer,
-        Strikethrough,
-        Link,
-        Autolink,
-        Codeblock,
-        Mathblock,
-        UnorderedList,
-        TaskDoneItem,
-        TaskWipItem,
-        OrderedList,
-
-        HtmlTag,
-        HtmlAttribute,
-        HtmlEntity,
-        HtmlComment
-    };
-
-    enum State {
-        Normal=1<<0,
-        InComment=1<<1,
-        InCode=1<<2
-    };
-
     bool enabled;
 
     LookAndFeels& lookAndFeels;
@@ -89,8 +64,8 @@ private:
     QTextCharFormat htmlEntityFormat;
     QTextCharFormat htmlCommentFormat;
 
-    // well defined order of regexps MATTERS - hashes/maps CANNOT be used
-    std::vector<std::pair<Type,QRegExp*>*> typeAndRegex;
+    // single-pass scanner of all highlighted Markdown and HTML spans
+    MarkdownHighlightScanner scanner;
 
 public:
     explicit NoteEditHighlighter(QPlainTextEdit* noteEditorView);
@@ -108,10 +83,7 @@ protected:
     virtual void highlightBlock(const QString &text) override;
 
 private:
-    void addRegex(Type type, const QString& pattern, bool minimal=true);
-    void highlightPatterns(const QString& text);
-    bool highlightMultilineMdCode(const QString& text);
-    void highlightMultilineHtmlComments(const QString& text);
+    const QTextCharFormat& toFormat(MarkdownHighlightType type) const;
 
     void spellCheck(const QString& text);
 };
@@ -77,7 +77,7 @@ NoteViewPresenter::~NoteViewPresenter()
 void NoteViewPresenter::slotReceiveText(const QString& text)
 {
     string s{string{"![diagram]("} + text.toStdString() + string{")"}};
-    vector<string*> d{};
+    Description d{};
     markdownRepresentation->description(&s, d);
     currentNote->setDescription(d);
     currentNote->makeModified();
@@ -164,7 +164,7 @@ void NoteViewPresenter::refreshLivePreview()
         QString description = orloj->getNoteEdit()->getView()->getDescription();
 
         string s{description.toStdString()};
-        vector<string*> d{};
+        Description d{};
         orloj->getMainPresenter()->getMarkdownRepresentation()->description(&s, d);
         auxNote.setDescription(d);
 
@@ -64,13 +64,8 @@ vector<const Tag*> OrganizerPresenter::getTagsForQuadrant(int columnNumber)
     return empty;
 }
 
-void OrganizerPresenter::refresh(
-    Organizer* organizer,
-    const vector<Note*>& ons,
-    const vector<Outline*>& os,
-    const vector<Note*>& ns,
-    bool setFocus
-) {
+void OrganizerPresenter::refresh(Organizer* organizer, bool setFocus)
+{
     MF_DEBUG("Rendering organizer: " << organizer->getName() << "..." << endl);
 
     this->organizer = organizer;
@@ -84,8 +79,8 @@ void OrganizerPresenter::refresh(
     // lower left / do sometimes
     vector<Note*> lowerLeftNs{};
 
-    Outline::organizeToEisenhowerMatrix(
-        this->organizer, ons, os, ns, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs
+    orloj->getMind()->organize(
+        this->organizer, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs
     );
 
     // set quadrant titles
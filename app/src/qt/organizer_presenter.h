@@ -66,13 +66,7 @@ public:
 
     std::vector<const Tag*> getTagsForQuadrant(int columnNumber);
 
-    void refresh(
-        Organizer* organizer,
-        const std::vector<Note*>& ons,
-        const std::vector<Outline*>& os,
-        const std::vector<Note*>& ns,
-        bool setFocus = true
-    );
+    void refresh(Organizer* organizer, bool setFocus = true);
 
     void focusAndSelectPreviouslySelectedRow(OrganizerQuadrantView* view);
     void focusToNextVisibleQuadrant();
@@ -261,19 +261,10 @@ void OrlojPresenter::showFacetOrganizerList(const vector<Organizer*>& organizers
     mainPresenter->getStatusBar()->showMindStatistics();
 }
 
-void OrlojPresenter::showFacetEisenhowerMatrix(
-    Organizer* organizer,
-    const vector<Note*>& outlinesAndNotes,
-    const vector<Outline*>& outlines,
-    const vector<Note*>& notes
-) {
+void OrlojPresenter::showFacetEisenhowerMatrix(Organizer* organizer)
+{
     setFacet(OrlojPresenterFacets::FACET_ORGANIZER);
-    organizerPresenter->refresh(
-        organizer,
-        outlinesAndNotes,
-        outlines,
-        notes
-    );
+    organizerPresenter->refresh(organizer);
     view->showFacetOrganizer();
     mainPresenter->getMainMenu()->showFacetOrganizer();
     mainPresenter->getStatusBar()->showInfo(tr("Eisenhower Matrix: ")+QString::fromStdString(
@@ -281,19 +272,10 @@ void OrlojPresenter::showFacetEisenhowerMatrix(
     );
 }
 
-void OrlojPresenter::showFacetKanban(
-    Kanban* kanban,
-    const vector<Note*>& outlinesAndNotes,
-    const vector<Outline*>& outlines,
-    const vector<Note*>& notes
-) {
+void OrlojPresenter::showFacetKanban(Kanban* kanban)
+{
     setFacet(OrlojPresenterFacets::FACET_KANBAN);
-    kanbanPresenter->refresh(
-        kanban,
-        outlinesAndNotes,
-        outlines,
-        notes
-    );
+    kanbanPresenter->refresh(kanban);
     view->showFacetKanban();
     // Kanban shares menu facet with Eisenhower Matrix as both are organizers
     mainPresenter->getMainMenu()->showFacetOrganizer();
@@ -355,9 +337,6 @@ void OrlojPresenter::slotShowOutlines()
 
 void OrlojPresenter::slotShowSelectedOrganizer()
 {
-    static vector<Note*> organizerOutlinesAndNotes{};
-    static vector<Note*> organizerNotes{};
-
     if(activeFacet!=OrlojPresenterFacets::FACET_VIEW_OUTLINE
          &&
        activeFacet!=OrlojPresenterFacets::FACET_TAG_CLOUD
@@ -382,23 +361,11 @@ void OrlojPresenter::slotShowSelectedOrganizer()
                     }
                 }
 
-                organizerOutlinesAndNotes.clear();
-                organizerNotes.clear();
                 if(Organizer::OrganizerType::KANBAN == organizer->getOrganizerType()) {
-                    showFacetKanban(
-                        dynamic_cast<Kanban*>(organizer),
-                        mind->getAllNotes(organizerOutlinesAndNotes, true, true),
-                        mind->getOutlines(),
-                        mind->getAllNotes(organizerNotes, true, false)
-                    );
+                    showFacetKanban(dynamic_cast<Kanban*>(organizer));
                 } else {
                     // Eisnehower Matrix as fallback
-                    showFacetEisenhowerMatrix(
-                        dynamic_cast<EisenhowerMatrix*>(organizer),
-                        mind->getAllNotes(organizerOutlinesAndNotes, true, true),
-                        mind->getOutlines(),
-                        mind->getAllNotes(organizerNotes, true, false)
-                    );
+                    showFacetEisenhowerMatrix(dynamic_cast<EisenhowerMatrix*>(organizer));
                 }
                 string statusNotebookScope{
                     organizer->getOutlineScope().size()
@@ -761,7 +728,7 @@ bool OrlojPresenter::avoidDataLossOnNoteEdit()
                 break;
             case OrlojButtonRoles::AUTOSAVE_ROLE:
                 Configuration::getInstance().setUiEditorAutosave(true);
-                mainPresenter->getConfigRepresentation()->save(Configuration::getInstance());
+                mainPresenter->getConfigRepresentation()->saveLater(Configuration::getInstance());
                 MF_FALL_THROUGH;
             case OrlojButtonRoles::SAVE_ROLE:
                 noteEditPresenter->slotSaveNote();
@@ -783,7 +750,7 @@ bool OrlojPresenter::avoidDataLossOnNoteEdit()
                 break;
             case OrlojButtonRoles::AUTOSAVE_ROLE:
                 Configuration::getInstance().setUiEditorAutosave(true);
-                mainPresenter->getConfigRepresentation()->save(Configuration::getInstance());
+                mainPresenter->getConfigRepresentation()->saveLater(Configuration::getInstance());
                 MF_FALL_THROUGH;
             case OrlojButtonRoles::SAVE_ROLE:
                 outlineHeaderEditPresenter->slotSaveOutlineHeader();
@@ -883,7 +850,9 @@ void OrlojPresenter::slotGetLinksForPattern(const QString& pattern)
         &thingsNames,
         &prefix,
         ThingNameSerialization::LINK,
-        currentOutline);
+        currentOutline,
+        // links are created only for the most read things shown by completer
+        100);
 
     vector<string>* links = new vector<string>{};
     *links = thingsNames;
@@ -1019,13 +988,13 @@ void OrlojPresenter::slotOutlinesTableSorted(int column)
 
     config.setUiOsTableSortColumn(column);
     config.setUiOsTableSortOrder(order==Qt::SortOrder::AscendingOrder?true:false);
-    mainPresenter->getConfigRepresentation()->save(config);
+    mainPresenter->getConfigRepresentation()->saveLater(config);
 }
 
 void OrlojPresenter::slotToggleFullOutlinePreview()
 {
     config.setUiFullOPreview(!config.isUiFullOPreview());
-    mainPresenter->getConfigRepresentation()->save(config);
+    mainPresenter->getConfigRepresentation()->saveLater(config);
 
     // refresh O header view
     getOutlineHeaderView()->refreshCurrent();
@@ -186,18 +186,8 @@ public:
 
     void showFacetDashboard();
     void showFacetOrganizerList(const std::vector<Organizer*>& organizers);
-    void showFacetEisenhowerMatrix(
-            Organizer* organizer,
-            const std::vector<Note*>& outlinesAndNotes,
-            const std::vector<Outline*>& outlines,
-            const std::vector<Note*>& notes
-    );
-    void showFacetKanban(
-            Kanban* kanban,
-            const std::vector<Note*>& outlinesAndNotes,
-            const std::vector<Outline*>& outlines,
-            const std::vector<Note*>& notes
-    );
+    void showFacetEisenhowerMatrix(Organizer* organizer);
+    void showFacetKanban(Kanban* kanban);
     void showFacetTagCloud();
     void showFacetOutlineList(const std::vector<Outline*>& outlines);
     void showFacetRecentNotes(const std::vector<Note*>& notes);
@@ -95,7 +95,7 @@ void OutlineHeaderEditPresenter::slotSaveOutlineHeader()
 
         if(!view->isDescriptionEmpty()) {
             string s{view->getDescription().toStdString()};
-            vector<string*> d{};
+            Description d{};
             mwp->getMarkdownRepresentation()->description(&s, d);
             currentOutline->setDescription(d);
         } else {
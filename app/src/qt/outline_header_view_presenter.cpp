@@ -69,7 +69,7 @@ void OutlineHeaderViewPresenter::refreshLivePreview()
 
     QString description = orloj->getOutlineHeaderEdit()->getView()->getDescription();
     string s{description.toStdString()};
-    vector<string*> d{};
+    Description d{};
     orloj->getMainPresenter()->getMarkdownRepresentation()->description(&s, d);
     auxOutline.setDescription(d);
 
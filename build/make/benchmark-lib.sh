@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+#
+# MindForger thinking notebook
+#
+# Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 2
+# of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+# Usage:
+#   ./benchmark-lib.sh [notes] [other mindforger-lib-benchmarks options]
+#
+# Builds lib/ benchmark suite (release, no debug output), generates synthetic
+# repository and writes JSON report to BENCHMARK-<commit>-<notes>.json in
+# the benchmark build directory - compare reports of two commits to find regressions.
+
+export BENCHMARK_NOTES=${1:-10000}
+shift
+
+if [ -z ${M8R_CPU_CORES} ]
+then
+    export M8R_CPU_CORES=`nproc`
+fi
+
+export SCRIPT_DIR=`pwd`
+export BUILD_DIR=${SCRIPT_DIR}/../../lib/test
+export GIT_DIR=${SCRIPT_DIR}/../..
+export COMMIT=`cd ${GIT_DIR} && git rev-parse --short HEAD`
+export REPORT_FILE="${BUILD_DIR}/benchmark/suite/BENCHMARK-${COMMIT}-${BENCHMARK_NOTES}.json"
+
+cd ${BUILD_DIR} && qmake -r mindforger-lib-benchmarks.pro && make -j${M8R_CPU_CORES}
+if [ ${?} -ne 0 ]
+then
+    exit 1
+fi
+
+cd ${BUILD_DIR} && ./benchmark/suite/mindforger-lib-benchmarks --notes ${BENCHMARK_NOTES} --label ${COMMIT} --output ${REPORT_FILE} "$@"
+echo "Benchmark report: ${REPORT_FILE}"
+
+# eof
@@ -75,18 +75,25 @@ SOURCES += \
     ./src/repository_indexer.cpp \
     ./src/gear/datetime_utils.cpp \
     ./src/gear/file_utils.cpp \
+    ./src/gear/file_line_provider.cpp \
     ./src/gear/string_utils.cpp \
+    ./src/gear/thread_pool.cpp \
     ./src/mind/ontology/ontology.cpp \
     ./src/model/note_type.cpp \
+    ./src/model/description.cpp \
     ./src/model/note.cpp \
     ./src/model/outline_type.cpp \
     ./src/model/outline.cpp \
     ./src/model/stencil.cpp \
     ./src/model/tag.cpp \
     ./src/persistence/filesystem_persistence.cpp \
+    ./src/persistence/configuration_store.cpp \
+    ./src/persistence/write_behind_queue.cpp \
     ./src/representations/html/html_outline_representation.cpp \
+    ./src/representations/html/html_fragment_cache.cpp \
     ./src/representations/markdown/markdown_ast_node.cpp \
     ./src/representations/markdown/markdown_lexem.cpp \
+    ./src/representations/markdown/markdown_highlight_scanner.cpp \
     ./src/representations/markdown/markdown_lexer_sections.cpp \
     ./src/representations/markdown/markdown_note_metadata.cpp \
     ./src/representations/markdown/markdown_outline_metadata.cpp \
@@ -117,8 +124,10 @@ SOURCES += \
     src/model/eisenhower_matrix.cpp \
     src/model/kanban.cpp \
     src/model/organizer.cpp \
+    src/model/note_tree_index.cpp \
     src/persistence/configuration_persistence.cpp \
     src/persistence/persistence.cpp \
+    src/persistence/repository_snapshot.cpp \
     src/representations/markdown/markdown_document.cpp \
     src/representations/html/html_document.cpp \
     src/mind/ai/ai.cpp \
@@ -132,6 +141,7 @@ SOURCES += \
     src/mind/ai/nn/genann.c \
     src/mind/ai/nlp/word_frequency_list.cpp \
     src/gear/trie.cpp \
+    src/gear/aho_corasick.cpp \
     src/mind/ai/nlp/stemmer/stemmer.cpp \
     src/mind/ai/ai_aa_bow.cpp \
     src/mind/ai/ai_aa_weighted_fts.cpp \
@@ -140,17 +150,26 @@ SOURCES += \
     src/mind/aspect/tag_scope_aspect.cpp \
     src/mind/aspect/mind_scope_aspect.cpp \
     src/mind/knowledge_graph.cpp \
+    src/mind/knowledge_graph_layout.cpp \
     src/representations/markdown/markdown_document_representation.cpp \
     src/representations/markdown/markdown_repository_configuration_representation.cpp \
     src/representations/twiki/twiki_outline_representation.cpp \
     src/mind/associated_notes.cpp \
     src/mind/ai/autolinking_preprocessor.cpp \
     src/representations/csv/csv_outline_representation.cpp \
+    src/representations/columnar/columnar_outline_representation.cpp \
     src/mind/ai/autolinking/naive_autolinking_preprocessor.cpp \
     src/representations/markdown/cmark_gfm_markdown_transcoder.cpp \
     src/mind/ai/autolinking/autolinking_mind.cpp \
     src/mind/limbo.cpp \
-    src/representations/unicode.cpp
+    src/representations/unicode.cpp \
+    src/mind/document_index.cpp \
+    src/mind/fts_index.cpp \
+    src/mind/dirty_outlines.cpp \
+    src/mind/tag_index.cpp \
+    src/mind/name_index.cpp \
+    src/mind/aggregates.cpp \
+    src/mind/organizer_index.cpp
 
 !mfnomd2html {
     SOURCES += \
@@ -176,12 +195,15 @@ HEADERS += \
     ./src/3rdparty/hoedown/version.h \
     ./src/gear/datetime_utils.h \
     ./src/gear/file_utils.h \
+    ./src/gear/file_line_provider.h \
     ./src/gear/hash_map.h \
     ./src/gear/lang_utils.h \
     ./src/gear/string_utils.h \
+    ./src/gear/thread_pool.h \
     ./src/mind/ontology/ontology_vocabulary.h \
     ./src/mind/ontology/ontology.h \
     ./src/model/note_type.h \
+    ./src/model/description.h \
     ./src/model/note.h \
     ./src/model/outline_type.h \
     ./src/model/outline.h \
@@ -190,9 +212,14 @@ HEADERS += \
     ./src/model/tag.h \
     ./src/persistence/filesystem_persistence.h \
     ./src/persistence/persistence.h \
+    ./src/persistence/configuration_store.h \
+    ./src/persistence/write_behind_queue.h \
+    ./src/persistence/repository_snapshot.h \
     ./src/representations/html/html_outline_representation.h \
+    ./src/representations/html/html_fragment_cache.h \
     ./src/representations/markdown/markdown_ast_node.h \
     ./src/representations/markdown/markdown_lexem.h \
+    ./src/representations/markdown/markdown_highlight_scanner.h \
     ./src/representations/markdown/markdown_lexer_sections.h \
     ./src/representations/markdown/markdown_note_metadata.h \
     ./src/representations/markdown/markdown_outline_metadata.h \
@@ -229,6 +256,7 @@ HEADERS += \
     src/model/eisenhower_matrix.h \
     src/model/kanban.h \
     src/model/organizer.h \
+    src/model/note_tree_index.h \
     src/persistence/configuration_persistence.h \
     src/representations/markdown/markdown_document.h \
     src/representations/html/html_document.h \
@@ -246,6 +274,7 @@ HEADERS += \
     src/mind/ai/nn/genann.h \
     src/mind/ai/nlp/word_frequency_list.h \
     src/gear/trie.h \
+    src/gear/aho_corasick.h \
     src/mind/ai/nlp/char_provider.h \
     src/mind/ai/nlp/stemmer/stemmer.h \
     src/mind/ai/nlp/stemmer/stemming/danish_stem.h \
@@ -276,18 +305,28 @@ HEADERS += \
     src/mind/aspect/mind_scope_aspect.h \
     src/compilation.h \
     src/mind/knowledge_graph.h \
+    src/mind/knowledge_graph_layout.h \
     src/representations/twiki/twiki_outline_representation.h \
     src/mind/associated_notes.h \
     src/mind/ai/autolinking_preprocessor.h \
     src/representations/representation_interceptor.h \
     src/representations/csv/csv_outline_representation.h \
+    src/representations/columnar/columnar_outline_representation.h \
     src/mind/ai/autolinking/naive_autolinking_preprocessor.h \
     src/representations/markdown/markdown_transcoder.h \
     src/representations/representation_type.h \
     src/definitions.h \
     src/representations/markdown/cmark_gfm_markdown_transcoder.h \
     src/mind/ai/autolinking/autolinking_mind.h \
-    src/mind/limbo.h
+    src/mind/limbo.h \
+    src/mind/memory_index.h \
+    src/mind/document_index.h \
+    src/mind/fts_index.h \
+    src/mind/dirty_outlines.h \
+    src/mind/tag_index.h \
+    src/mind/name_index.h \
+    src/mind/aggregates.h \
+    src/mind/organizer_index.h
 
 !mfnomd2html {
     SOURCES += \
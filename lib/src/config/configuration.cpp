@@ -49,6 +49,9 @@ Configuration::Configuration()
       autolinkingCaseInsensitive{},
       md2HtmlOptions{},
       distributorSleepInterval{DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL},
+      learnThreads{DEFAULT_LEARN_THREADS},
+      repositoryWatch{DEFAULT_REPOSITORY_WATCH},
+      repositorySnapshot{DEFAULT_REPOSITORY_SNAPSHOT},
       markdownQuoteSections{},
       uiNerdTargetAudience{DEFAULT_UI_NERD_MENU},
       uiHtmlZoom{},
@@ -163,6 +166,9 @@ void Configuration::clear()
     }
 
     distributorSleepInterval = DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL;
+    learnThreads = DEFAULT_LEARN_THREADS;
+    repositoryWatch = DEFAULT_REPOSITORY_WATCH;
+    repositorySnapshot = DEFAULT_REPOSITORY_SNAPSHOT;
 
     // GUI
     uiNerdTargetAudience = false;
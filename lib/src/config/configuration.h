@@ -51,6 +51,9 @@ constexpr const auto DIRNAME_M8R_REPOSITORY = "mindforger-repository";
 constexpr const auto FILE_PATH_M8R_REPOSITORY = "~/mindforger-repository";
 
 constexpr const auto FILENAME_M8R_CONFIGURATION = ".mindforger.md";
+constexpr const auto FILENAME_M8R_SNAPSHOT = "repository.snapshot";
+constexpr const auto DIRNAME_M8R_CACHE = "MindForger";
+constexpr const auto DIRNAME_M8R_SNAPSHOTS = "snapshots";
 constexpr const auto DIRNAME_MEMORY = "memory";
 constexpr const auto DIRNAME_MIND = "mind";
 constexpr const auto DIRNAME_LIMBO = "limbo";
@@ -177,6 +180,11 @@ public:
     static constexpr const int DEFAULT_ASYNC_MIND_THRESHOLD_BOW = 200;
     static constexpr const int DEFAULT_ASYNC_MIND_THRESHOLD_WEIGHTED_FTS = 20000;
     static constexpr const int DEFAULT_DISTRIBUTOR_SLEEP_INTERVAL = 500;
+    // 0 ~ use all hardware threads, 1 ~ sequential repository load
+    static constexpr const unsigned int DEFAULT_LEARN_THREADS = 0;
+    static constexpr const unsigned int MAX_LEARN_THREADS = 64;
+    static constexpr const bool DEFAULT_REPOSITORY_WATCH = false;
+    static constexpr const bool DEFAULT_REPOSITORY_SNAPSHOT = true;
 
     static const std::string DEFAULT_ACTIVE_REPOSITORY_PATH;
     static const std::string DEFAULT_TIME_SCOPE;
@@ -255,6 +263,12 @@ private:
     unsigned int md2HtmlOptions;
     AssociationAssessmentAlgorithm aaAlgorithm;
     int distributorSleepInterval;
+    // number of threads used to parse Markdown files on repository load
+    unsigned int learnThreads;
+    // watch repository for changes made by others (Linux only)
+    bool repositoryWatch;
+    // load unchanged Os from parsed repository snapshot (MindForger repositories only)
+    bool repositorySnapshot;
     bool markdownQuoteSections;
 
     // GUI configuration
@@ -397,6 +411,14 @@ public:
     void setAaAlgorithm(AssociationAssessmentAlgorithm aaa) { aaAlgorithm = aaa; }
     int getDistributorSleepInterval() const { return distributorSleepInterval; }
     void setDistributorSleepInterval(int sleepInterval) { distributorSleepInterval = sleepInterval; }
+    unsigned int getLearnThreads() const { return learnThreads; }
+    void setLearnThreads(unsigned int threads) {
+        learnThreads = threads>MAX_LEARN_THREADS?MAX_LEARN_THREADS:threads;
+    }
+    bool isRepositoryWatch() const { return repositoryWatch; }
+    void setRepositoryWatch(bool repositoryWatch) { this->repositoryWatch = repositoryWatch; }
+    bool isRepositorySnapshot() const { return repositorySnapshot; }
+    void setRepositorySnapshot(bool repositorySnapshot) { this->repositorySnapshot = repositorySnapshot; }
     bool isMarkdownQuoteSections() const { return markdownQuoteSections; }
     void setMarkdownQuoteSections(bool markdownQuoteSections) { this->markdownQuoteSections = markdownQuoteSections; }
 
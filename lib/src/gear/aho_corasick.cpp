@@ -0,0 +1,292 @@
+/*
+ aho_corasick.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "aho_corasick.h"
+
+#include <algorithm>
+
+#include "string_utils.h"
+
+namespace m8r {
+
+using namespace std;
+
+constexpr u_int32_t AhoCorasick::ROOT;
+
+AhoCorasick::AhoCorasick()
+    : refCounts{},
+      depths{},
+      edges{},
+      rootTransitions{},
+      edgeOffsets{},
+      edgeBytes{},
+      edgeTargets{},
+      failures{},
+      longestWords{},
+      dictionaryLinks{},
+      bfsOrder{},
+      trieModified{},
+      wordsModified{},
+      words{},
+      fingerprint{}
+{
+    clear();
+}
+
+AhoCorasick::~AhoCorasick()
+{
+}
+
+void AhoCorasick::clear()
+{
+    refCounts.assign(1, 0);
+    depths.assign(1, 0);
+    edges.clear();
+    words = 0;
+    fingerprint = 0;
+    trieModified = true;
+    wordsModified = true;
+    // compiled automaton must never refer to released states
+    compile();
+}
+
+void AhoCorasick::addWord(const string& s)
+{
+    if(s.size()) {
+        u_int32_t state = ROOT;
+        for(size_t i=0; i<s.size(); i++) {
+            u_int64_t key = static_cast<u_int64_t>(state) << 8 | static_cast<unsigned char>(s[i]);
+            auto e = edges.find(key);
+            if(e == edges.end()) {
+                u_int32_t n = static_cast<u_int32_t>(refCounts.size());
+                refCounts.push_back(0);
+                depths.push_back(depths[state]+1);
+                edges[key] = n;
+                state = n;
+                trieModified = true;
+            } else {
+                state = e->second;
+            }
+        }
+
+        if(!refCounts[state]++) {
+            words++;
+            fingerprint += wordFingerprint(s);
+            wordsModified = true;
+        }
+    }
+}
+
+u_int64_t AhoCorasick::wordFingerprint(const string& s)
+{
+    // sum of words hashes > hash bits must be well mixed (splitmix64 finalizer)
+    u_int64_t h = stringHash(s);
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 31);
+}
+
+u_int32_t AhoCorasick::findState(const string& s) const
+{
+    u_int32_t state = ROOT;
+    for(size_t i=0; i<s.size(); i++) {
+        auto e = edges.find(static_cast<u_int64_t>(state) << 8 | static_cast<unsigned char>(s[i]));
+        if(e == edges.end()) {
+            return ROOT;
+        }
+        state = e->second;
+    }
+    return state;
+}
+
+bool AhoCorasick::removeWord(const string& s)
+{
+    u_int32_t state = findState(s);
+    if(state != ROOT && refCounts[state]) {
+        if(!--refCounts[state]) {
+            words--;
+            fingerprint -= wordFingerprint(s);
+            wordsModified = true;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool AhoCorasick::findWord(const string& s) const
+{
+    u_int32_t state = findState(s);
+    return state != ROOT && refCounts[state];
+}
+
+bool AhoCorasick::findLongestPrefixWord(const string& s, string& r) const
+{
+    u_int32_t state = ROOT;
+    size_t longest = 0;
+    for(size_t i=0; i<s.size(); i++) {
+        state = state==ROOT?rootTransitions[static_cast<unsigned char>(s[i])]:child(state, s[i]);
+        if(state == ROOT) {
+            break;
+        }
+        if(refCounts[state]) {
+            longest = i+1;
+        }
+    }
+
+    if(longest) {
+        r.append(s, 0, longest);
+        return true;
+    }
+    return false;
+}
+
+void AhoCorasick::compile()
+{
+    if(trieModified) {
+        compileTrie();
+        trieModified = false;
+        wordsModified = true;
+    }
+    if(wordsModified) {
+        compileWords();
+        wordsModified = false;
+    }
+}
+
+void AhoCorasick::compileTrie()
+{
+    size_t states = refCounts.size();
+
+    // flat transition table: edges sorted by parent (counting sort) and byte
+    edgeOffsets.assign(states+1, 0);
+    for(const auto& e:edges) {
+        edgeOffsets[(e.first >> 8) + 1]++;
+    }
+    for(size_t s=0; s<states; s++) {
+        edgeOffsets[s+1] += edgeOffsets[s];
+    }
+    edgeBytes.resize(edges.size());
+    edgeTargets.resize(edges.size());
+    vector<u_int32_t> fill(edgeOffsets.begin(), edgeOffsets.end()-1);
+    for(const auto& e:edges) {
+        u_int32_t i = fill[e.first >> 8]++;
+        edgeBytes[i] = static_cast<unsigned char>(e.first & 0xFF);
+        edgeTargets[i] = e.second;
+    }
+    vector<pair<unsigned char,u_int32_t>> sorted{};
+    for(size_t s=0; s<states; s++) {
+        u_int32_t from = edgeOffsets[s];
+        u_int32_t to = edgeOffsets[s+1];
+        if(to-from > 1) {
+            sorted.clear();
+            for(u_int32_t i=from; i<to; i++) {
+                sorted.push_back(make_pair(edgeBytes[i], edgeTargets[i]));
+            }
+            std::sort(sorted.begin(), sorted.end());
+            for(u_int32_t i=from; i<to; i++) {
+                edgeBytes[i] = sorted[i-from].first;
+                edgeTargets[i] = sorted[i-from].second;
+            }
+        }
+    }
+
+    std::fill(std::begin(rootTransitions), std::end(rootTransitions), ROOT);
+    for(u_int32_t i=edgeOffsets[ROOT]; i<edgeOffsets[ROOT+1]; i++) {
+        rootTransitions[edgeBytes[i]] = edgeTargets[i];
+    }
+
+    // failure links (parent's failure is always calculated before its children)
+    failures.assign(states, ROOT);
+    bfsOrder.clear();
+    bfsOrder.reserve(states);
+    bfsOrder.push_back(ROOT);
+    for(size_t b=0; b<bfsOrder.size(); b++) {
+        u_int32_t s = bfsOrder[b];
+        for(u_int32_t i=edgeOffsets[s]; i<edgeOffsets[s+1]; i++) {
+            u_int32_t n = edgeTargets[i];
+            failures[n] = s==ROOT?ROOT:next(failures[s], edgeBytes[i]);
+            bfsOrder.push_back(n);
+        }
+    }
+}
+
+void AhoCorasick::compileWords()
+{
+    size_t states = refCounts.size();
+    longestWords.assign(states, 0);
+    dictionaryLinks.assign(states, ROOT);
+    for(size_t b=1; b<bfsOrder.size(); b++) {
+        u_int32_t s = bfsOrder[b];
+        u_int32_t f = failures[s];
+        longestWords[s] = refCounts[s]?depths[s]:longestWords[f];
+        dictionaryLinks[s] = refCounts[f]?f:dictionaryLinks[f];
+    }
+}
+
+void AhoCorasick::findAll(const char* text, size_t size, vector<Match>& matches) const
+{
+    u_int32_t state = ROOT;
+    for(size_t i=0; i<size; i++) {
+        state = next(state, static_cast<unsigned char>(text[i]));
+        if(longestWords[state]) {
+            for(u_int32_t w = refCounts[state]?state:dictionaryLinks[state]; w != ROOT; w = dictionaryLinks[w]) {
+                matches.push_back(Match{i+1-depths[w], depths[w]});
+            }
+        }
+    }
+}
+
+void AhoCorasick::findWholeWords(
+        const char* text,
+        size_t size,
+        const string& delimiters,
+        vector<Match>& matches) const
+{
+    bool isDelimiter[256] = {};
+    for(char c:delimiters) {
+        isDelimiter[static_cast<unsigned char>(c)] = true;
+    }
+
+    // the longest whole word match for every start ~ candidates are few, text is scanned once
+    vector<Match> candidates{};
+    u_int32_t state = ROOT;
+    for(size_t i=0; i<size; i++) {
+        state = next(state, static_cast<unsigned char>(text[i]));
+        if(longestWords[state] && (i+1 == size || isDelimiter[static_cast<unsigned char>(text[i+1])])) {
+            for(u_int32_t w = refCounts[state]?state:dictionaryLinks[state]; w != ROOT; w = dictionaryLinks[w]) {
+                size_t offset = i+1-depths[w];
+                if(offset == 0 || isDelimiter[static_cast<unsigned char>(text[offset-1])]) {
+                    candidates.push_back(Match{offset, depths[w]});
+                }
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Match& a, const Match& b) {
+        return a.offset < b.offset || (a.offset == b.offset && a.size > b.size);
+    });
+    size_t end = 0;
+    for(const Match& m:candidates) {
+        if(m.offset >= end) {
+            matches.push_back(m);
+            end = m.offset+m.size;
+        }
+    }
+}
+
+} // m8r namespace
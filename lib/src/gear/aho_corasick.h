@@ -0,0 +1,190 @@
+/*
+ aho_corasick.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_AHO_CORASICK_H
+#define M8R_AHO_CORASICK_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../debug.h"
+
+namespace m8r {
+
+/**
+ * @brief Aho-Corasick automaton.
+ *
+ * Automaton finds all occurrences of all (byte string) words in a text
+ * in a single pass over the text.
+ *
+ * Words can be added and removed incrementally (e.g. on O/N rename). Added
+ * words extend a mutable trie whose edges are kept in a hash map. Automaton
+ * must be compiled explicitly after modifications (by the writer) - search
+ * methods are const and use the compiled automaton only, therefore they can
+ * be called by multiple threads concurrently:
+ *
+ * - trie edges are compressed to a flat transition table (edges of every
+ *   node are stored contiguously and sorted by byte, root transitions
+ *   are a dense table)
+ * - failure links are calculated by BFS
+ * - dictionary outputs (the longest word ending in a state and link to the
+ *   next state which is a word) are calculated in BFS order
+ *
+ * Word removal decrements word's reference count and only outputs are
+ * recalculated (in one linear pass), trie nodes are released on clear().
+ */
+class AhoCorasick
+{
+public:
+    struct Match {
+        size_t offset;
+        size_t size;
+    };
+
+private:
+    static constexpr u_int32_t ROOT = 0;
+
+    /*
+     * Mutable trie
+     */
+
+    // number of times the word ending in the node was added (0 if node is not a word)
+    std::vector<u_int32_t> refCounts;
+    std::vector<u_int32_t> depths;
+    // (parent node << 8 | byte) > child node
+    std::unordered_map<u_int64_t,u_int32_t> edges;
+
+    /*
+     * Compiled automaton
+     */
+
+    u_int32_t rootTransitions[256];
+    // node edges are [edgeOffsets[node], edgeOffsets[node+1])
+    std::vector<u_int32_t> edgeOffsets;
+    std::vector<unsigned char> edgeBytes;
+    std::vector<u_int32_t> edgeTargets;
+    std::vector<u_int32_t> failures;
+    // size of the longest word which ends in the state (0 if none)
+    std::vector<u_int32_t> longestWords;
+    // the nearest state on failure path which is a word (ROOT if none)
+    std::vector<u_int32_t> dictionaryLinks;
+    std::vector<u_int32_t> bfsOrder;
+
+    bool trieModified;
+    bool wordsModified;
+    size_t words;
+    // order independent hash of the words set
+    u_int64_t fingerprint;
+
+public:
+    explicit AhoCorasick();
+    AhoCorasick(const AhoCorasick&) = delete;
+    AhoCorasick(const AhoCorasick&&) = delete;
+    AhoCorasick& operator=(const AhoCorasick&) = delete;
+    AhoCorasick& operator=(const AhoCorasick&&) = delete;
+    ~AhoCorasick();
+
+    bool empty() const { return words == 0; }
+    size_t size() const { return words; }
+    size_t getStatesCount() const { return refCounts.size(); }
+    /**
+     * @brief Fingerprint of the words set - the same words give the same fingerprint.
+     *
+     * Fingerprint is used to find out whether matches (and results derived from them)
+     * can be reused: it changes only when a word is added or removed, it's kept
+     * when words are re-added (e.g. on rebuild) or when reference counts change.
+     */
+    u_int64_t getFingerprint() const { return fingerprint; }
+
+    /**
+     * @brief Add word (empty words are ignored).
+     */
+    void addWord(const std::string& s);
+    /**
+     * @brief Decrement word's reference count - word is removed if it drops to zero.
+     */
+    bool removeWord(const std::string& s);
+    /**
+     * @brief Is the word known to automaton?
+     */
+    bool findWord(const std::string& s) const;
+    /**
+     * @brief Find longest word which is prefix of s.
+     */
+    bool findLongestPrefixWord(const std::string& s, std::string& r) const;
+
+    /**
+     * @brief Find all occurrences of all words - ordered by match end.
+     */
+    void findAll(const char* text, size_t size, std::vector<Match>& matches) const;
+
+    /**
+     * @brief Find leftmost longest non-overlapping whole word matches.
+     *
+     * Whole word match starts at the beginning of the text or after a delimiter
+     * and ends at the end of the text or before a delimiter.
+     */
+    void findWholeWords(
+            const char* text,
+            size_t size,
+            const std::string& delimiters,
+            std::vector<Match>& matches) const;
+
+    /**
+     * @brief Compile automaton after words were added/removed (no-op if there was no change).
+     */
+    void compile();
+    bool isCompiled() const { return !trieModified && !wordsModified; }
+
+    /**
+     * @brief Forget all words.
+     */
+    void clear();
+
+private:
+    static u_int64_t wordFingerprint(const std::string& s);
+    u_int32_t findState(const std::string& s) const;
+    u_int32_t child(u_int32_t state, unsigned char c) const {
+        u_int32_t from = edgeOffsets[state];
+        u_int32_t to = edgeOffsets[state+1];
+        for(u_int32_t e=from; e<to; e++) {
+            if(edgeBytes[e] == c) {
+                return edgeTargets[e];
+            } else if(edgeBytes[e] > c) {
+                break;
+            }
+        }
+        return ROOT;
+    }
+    u_int32_t next(u_int32_t state, unsigned char c) const {
+        while(state != ROOT) {
+            u_int32_t n = child(state, c);
+            if(n != ROOT) {
+                return n;
+            }
+            state = failures[state];
+        }
+        return rootTransitions[c];
+    }
+    void compileTrie();
+    void compileWords();
+};
+
+}
+#endif // M8R_AHO_CORASICK_H
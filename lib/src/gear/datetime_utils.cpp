@@ -18,10 +18,186 @@
  */
 #include "datetime_utils.h"
 
+#include <atomic>
+
 using namespace std;
 
 namespace m8r {
 
+constexpr long long SECONDS_PER_DAY = 60 * 60 * 24;
+
+/*
+ * Integer civil (proleptic Gregorian) date arithmetic - days since 1970-01-01.
+ */
+
+static long long daysFromCivil(long long y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const long long era = (y >= 0 ? y : y-399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153*(m > 2 ? m-3 : m+9) + 2)/5 + d-1;
+    const unsigned doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+    return era * 146097 + static_cast<long long>(doe) - 719468;
+}
+
+static void civilFromDays(long long z, long long& y, unsigned& m, unsigned& d)
+{
+    z += 719468;
+    const long long era = (z >= 0 ? z : z-146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    const unsigned doy = doe - (365*yoe + yoe/4 - yoe/100);
+    const unsigned mp = (5*doy + 2)/153;
+    d = doy - (153*mp+2)/5 + 1;
+    m = mp < 10 ? mp+3 : mp-9;
+    y = static_cast<long long>(yoe) + era * 400 + (m <= 2);
+}
+
+static long long floorDiv(long long a, long long b)
+{
+    return a/b - (a%b && ((a<0) != (b<0)));
+}
+
+/*
+ * UTC offset of local standard time (DST is ignored) cached per year - mktime()
+ * w/ tm_isdst=0 interprets broken down time as local standard time.
+ *
+ * IMPROVE time zone change while MindForger is running is not reflected
+ */
+constexpr long long OFFSET_CACHE_FIRST_YEAR = 1900;
+constexpr long long OFFSET_CACHE_YEARS = 400;
+// cached value is biased so that 0 means unknown (|offset| < 1 day)
+constexpr long OFFSET_BIAS = 1L << 20;
+static std::atomic<long> standardOffsets[OFFSET_CACHE_YEARS];
+
+static long standardUtcOffset(long long year)
+{
+    bool cacheable = year >= OFFSET_CACHE_FIRST_YEAR && year < OFFSET_CACHE_FIRST_YEAR+OFFSET_CACHE_YEARS;
+    if(cacheable) {
+        long cached = standardOffsets[year-OFFSET_CACHE_FIRST_YEAR].load(std::memory_order_relaxed);
+        if(cached) {
+            return cached - OFFSET_BIAS;
+        }
+    }
+
+    struct tm t;
+    // C-style initialization as GCC doesn't like {}
+    memset(&t, 0, sizeof t);
+    t.tm_year = static_cast<int>(year - 1900);
+    t.tm_mday = 1;
+    t.tm_hour = 12;
+    time_t local = mktime(&t);
+    long offset = static_cast<long>(daysFromCivil(year, 1, 1)*SECONDS_PER_DAY + 12*60*60 - local);
+
+    if(cacheable && offset > -OFFSET_BIAS && offset < OFFSET_BIAS) {
+        standardOffsets[year-OFFSET_CACHE_FIRST_YEAR].store(offset + OFFSET_BIAS, std::memory_order_relaxed);
+    }
+    return offset;
+}
+
+static bool parseDigits(const char* s, size_t count, unsigned& result)
+{
+    result = 0;
+    for(size_t i=0; i<count; i++) {
+        if(s[i] < '0' || s[i] > '9') {
+            return false;
+        }
+        result = result*10 + static_cast<unsigned>(s[i]-'0');
+    }
+    return true;
+}
+
+static inline void formatDigits(unsigned value, size_t count, char* result)
+{
+    while(count) {
+        result[--count] = static_cast<char>('0' + value%10);
+        value /= 10;
+    }
+}
+
+bool datetimeParse(const char* s, size_t size, time_t& seconds)
+{
+    while(size && (*s == ' ' || *s == '\t')) {
+        s++;
+        size--;
+    }
+    while(size && (s[size-1] == ' ' || s[size-1] == '\t' || s[size-1] == '\r')) {
+        size--;
+    }
+
+    // YYYY-MM-DD HH:MM:SS
+    unsigned year, month, day, hour, minute, second;
+    if(size != 19
+         || s[4] != '-' || s[7] != '-' || s[10] != ' ' || s[13] != ':' || s[16] != ':'
+         || !parseDigits(s, 4, year)
+         || !parseDigits(s+5, 2, month)
+         || !parseDigits(s+8, 2, day)
+         || !parseDigits(s+11, 2, hour)
+         || !parseDigits(s+14, 2, minute)
+         || !parseDigits(s+17, 2, second)
+         || month < 1 || month > 12 || day < 1 || day > 31
+         || hour > 23 || minute > 59 || second > 60)
+    {
+        return false;
+    }
+
+    seconds = static_cast<time_t>(
+        daysFromCivil(year, month, day)*SECONDS_PER_DAY
+        + hour*60*60 + minute*60 + second
+        - standardUtcOffset(year));
+    return true;
+}
+
+char* datetimeFormat(const time_t seconds, char* result)
+{
+    long long year;
+    unsigned month, day;
+    civilFromDays(floorDiv(seconds, SECONDS_PER_DAY), year, month, day);
+    // offset of the local year (differs from UTC year around New Year)
+    long long offsetYear = year;
+    long long local = static_cast<long long>(seconds) + standardUtcOffset(offsetYear);
+    long long days = floorDiv(local, SECONDS_PER_DAY);
+    civilFromDays(days, year, month, day);
+    if(year != offsetYear) {
+        local = static_cast<long long>(seconds) + standardUtcOffset(year);
+        days = floorDiv(local, SECONDS_PER_DAY);
+        civilFromDays(days, year, month, day);
+    }
+    unsigned daySeconds = static_cast<unsigned>(local - days*SECONDS_PER_DAY);
+
+    // clamp to the supported range > YYYY always fits the buffer
+    if(year < 0) {
+        year = 0;
+        month = day = 1;
+        daySeconds = 0;
+    } else if(year > 9999) {
+        year = 9999;
+        month = 12;
+        day = 31;
+        daySeconds = static_cast<unsigned>(SECONDS_PER_DAY-1);
+    }
+
+    formatDigits(static_cast<unsigned>(year), 4, result);
+    result[4] = '-';
+    formatDigits(month, 2, result+5);
+    result[7] = '-';
+    formatDigits(day, 2, result+8);
+    result[10] = ' ';
+    formatDigits(daySeconds/3600, 2, result+11);
+    result[13] = ':';
+    formatDigits(daySeconds/60%60, 2, result+14);
+    result[16] = ':';
+    formatDigits(daySeconds%60, 2, result+17);
+    result[19] = 0;
+    return result;
+}
+
+void datetimeToString(const time_t ts, std::string& s)
+{
+    char to[20];
+    s.append(datetimeFormat(ts, to), 19);
+}
+
 time_t datetimeNow()
 {
     return time(nullptr);
@@ -98,11 +274,8 @@ char* datetimeTo(const struct tm* datetime, char* result)
 
 std::string datetimeToString(const time_t ts)
 {
-    char to[50];
-    if(datetimeTo(localtime(&ts), to)) {
-        return string{to};
-    }
-    return "";
+    char to[20];
+    return string{datetimeFormat(ts, to)};
 }
 
 time_t datetimeSeconds(struct tm* datetime)
@@ -123,14 +296,55 @@ std::string datetimeToPrettyHtml(const time_t ts)
     return datetimeToPrettyHtml(&ts);
 }
 
+/*
+ * Now in local time w/ the current day boundaries - it's cached per thread and
+ * converted on (local) midnight only, not for every prettified timestamp.
+ */
+struct PrettyNow {
+    time_t now;
+    tm nowT;
+    time_t dayStart;
+    time_t dayEnd;
+};
+
+static const PrettyNow& prettyNow()
+{
+    static thread_local PrettyNow n;
+
+    time(&n.now);
+    if(n.now >= n.dayEnd || n.now < n.dayStart) {
+#ifndef _WIN32
+        localtime_r(&n.now, &n.nowT);
+#else
+        localtime_s(&n.nowT, &n.now);
+#endif
+        tm t = n.nowT;
+        t.tm_hour = t.tm_min = t.tm_sec = 0;
+        t.tm_isdst = -1;
+        n.dayStart = mktime(&t);
+        t = n.nowT;
+        t.tm_mday++;
+        t.tm_hour = t.tm_min = t.tm_sec = 0;
+        t.tm_isdst = -1;
+        n.dayEnd = mktime(&t);
+    }
+    return n;
+}
+
 constexpr time_t SIX_DAYS = 60 * 60 * 24 * 6;
 std::string datetimeToPrettyHtml(const time_t* seconds)
 {
-    time_t now;
-    time(&now);
+    const PrettyNow& n = prettyNow();
+    time_t now = n.now;
+    const tm* nowS = &n.nowT;
 
-    tm tsS = *localtime(seconds);
-    tm* nowS = localtime(&now);
+    // reentrant conversion - Os are parsed (and prettified) in parallel
+    tm tsS;
+#ifndef _WIN32
+    localtime_r(seconds, &tsS);
+#else
+    localtime_s(&tsS, seconds);
+#endif
 
     Pretty pretty = Pretty::LONG_TIME_AGO;
 
@@ -185,5 +399,16 @@ std::string datetimeToPrettyHtml(const time_t* seconds)
     return result;
 }
 
+const std::string& PrettyDatetime::get(const time_t ts) const
+{
+    time_t today = prettyNow().dayStart;
+    if(html.empty() || seconds != ts || day != today) {
+        html = datetimeToPrettyHtml(&ts);
+        seconds = ts;
+        day = today;
+    }
+    return html;
+}
+
 } // m8r namespace
 
@@ -50,6 +50,61 @@ std::string datetimeToString(const time_t ts);
 std::string datetimeToPrettyHtml(const time_t ts);
 std::string datetimeToPrettyHtml(const time_t* seconds);
 
+/*
+ * Fixed format codec of Markdown metadata timestamps "YYYY-MM-DD HH:MM:SS".
+ *
+ * Timestamps are local standard time (DST is ignored) - conversion is done
+ * using integer civil date arithmetic and UTC offset which is cached per year,
+ * therefore there is no heap allocation, strptime() nor mktime() per call.
+ */
+
+/**
+ * @brief Parse timestamp from the text span (surrounding whitespaces are skipped).
+ * @return false if the text doesn't have the fixed format (caller may fall back to strptime()).
+ */
+bool datetimeParse(const char* s, size_t size, time_t& seconds);
+
+/**
+ * @brief Format timestamp to the buffer.
+ *
+ * Timestamps out of years 0000-9999 are clamped to the range.
+ *
+ * @param result    char[20] or bigger is expected for result serialization.
+ * @returns pointer to the NUL terminated result.
+ */
+char* datetimeFormat(const time_t seconds, char* result);
+
+/**
+ * @brief Append formatted timestamp to the string.
+ */
+void datetimeToString(const time_t ts, std::string& s);
+
+/**
+ * @brief Pretty HTML representation of a timestamp calculated lazily.
+ *
+ * Pretty representation is relative to now (today, this week, ...), therefore it's
+ * calculated when it's needed for presentation and it's recalculated only when
+ * the timestamp or the current day changes.
+ */
+class PrettyDatetime
+{
+private:
+    mutable std::string html;
+    mutable time_t seconds;
+    mutable time_t day;
+
+public:
+    explicit PrettyDatetime() : html{}, seconds{}, day{} {}
+    PrettyDatetime(const PrettyDatetime&) = delete;
+    PrettyDatetime(const PrettyDatetime&&) = delete;
+    PrettyDatetime& operator=(const PrettyDatetime&) = delete;
+    PrettyDatetime& operator=(const PrettyDatetime&&) = delete;
+    ~PrettyDatetime() {}
+
+    const std::string& get(const time_t ts) const;
+    void clear() { html.clear(); }
+};
+
 } // m8r namespace
 
 #endif /* M8R_DATETIME_UTILS_H_ */
@@ -0,0 +1,154 @@
+/*
+ file_line_provider.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "file_line_provider.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+  #include <fstream>
+#else
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace m8r {
+
+FileLineProvider::FileLineProvider()
+    : content{nullptr},
+      contentSize{0},
+      buffer{nullptr},
+      lines{}
+{
+}
+
+FileLineProvider::~FileLineProvider()
+{
+    close();
+}
+
+void FileLineProvider::close()
+{
+    if(buffer) {
+        delete[] buffer;
+        buffer = nullptr;
+    }
+    content = nullptr;
+    contentSize = 0;
+    lines.clear();
+}
+
+bool FileLineProvider::open(const string* filename, size_t& fileSize)
+{
+    close();
+    fileSize = 0;
+    if(!filename) {
+        return false;
+    }
+
+#ifdef _WIN32
+    ifstream is(*filename, ios::in | ios::binary);
+    if(!is) {
+        return false;
+    }
+    is.seekg(0, ios::end);
+    streamoff size = is.tellg();
+    if(size <= 0) {
+        return false;
+    }
+    is.seekg(0, ios::beg);
+    buffer = new char[static_cast<size_t>(size)];
+    is.read(buffer, size);
+    content = buffer;
+    contentSize = static_cast<size_t>(is.gcount());
+
+    fileSize = split(content, contentSize, lines);
+    return fileSize>0;
+#else
+    int fd = ::open(filename->c_str(), O_RDONLY);
+    if(fd < 0) {
+        return false;
+    }
+    struct stat attrs;
+    if(fstat(fd, &attrs) || attrs.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    // file is read (NOT mapped) - mapped file truncated by others (e.g. git pull) would SIGBUS on access
+    read(fd, static_cast<size_t>(attrs.st_size));
+    ::close(fd);
+
+    fileSize = split(content, contentSize, lines);
+    return fileSize>0;
+#endif
+}
+
+#ifndef _WIN32
+void FileLineProvider::read(int fd, size_t size)
+{
+    buffer = new char[size];
+    size_t offset = 0;
+    while(offset < size) {
+        ssize_t r = ::read(fd, buffer+offset, size-offset);
+        if(r < 0 && errno == EINTR) {
+            continue;
+        }
+        if(r <= 0) {
+            // error or file truncated since fstat() > use what was read
+            break;
+        }
+        offset += static_cast<size_t>(r);
+    }
+    content = buffer;
+    contentSize = offset;
+}
+#endif
+
+bool FileLineProvider::open(const string* text)
+{
+    close();
+    if(text && !text->empty()) {
+        // text is NOT owned i.e. nothing to unmap/delete on close
+        split(text->data(), text->size(), lines);
+        return true;
+    }
+    return false;
+}
+
+size_t FileLineProvider::split(const char* content, size_t contentSize, vector<LineSpan>& lines)
+{
+    size_t size = 0;
+    const char* end = content+contentSize;
+    const char* line = content;
+    while(line < end) {
+        const char* eol = static_cast<const char*>(memchr(line, '\n', static_cast<size_t>(end-line)));
+        if(!eol) {
+            eol = end;
+        }
+        lines.push_back(LineSpan{line, static_cast<size_t>(eol-line)});
+        size += static_cast<size_t>(eol-line)+1;
+        line = eol+1;
+    }
+    return size;
+}
+
+} // m8r namespace
@@ -0,0 +1,120 @@
+/*
+ file_line_provider.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_FILE_LINE_PROVIDER_H
+#define M8R_FILE_LINE_PROVIDER_H
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace m8r {
+
+/**
+ * @brief Line as a span of characters (w/o newline) owned by someone else.
+ *
+ * C++11 lacks std::string_view - this is its minimal (lexer) subset.
+ */
+struct LineSpan
+{
+    const char* data;
+    size_t length;
+
+    size_t size() const { return length; }
+    bool empty() const { return !length; }
+    // bound checked like std::string::at() (lexer relies on it)
+    char at(size_t i) const {
+        if(i >= length) {
+            throw std::out_of_range{"LineSpan::at()"};
+        }
+        return data[i];
+    }
+    char operator[](size_t i) const { return data[i]; }
+    std::string toString() const { return std::string{data, length}; }
+    std::string substr(size_t pos, size_t n) const {
+        if(pos > length) {
+            throw std::out_of_range{"LineSpan::substr()"};
+        }
+        return std::string{data+pos, n<length-pos?n:length-pos};
+    }
+};
+
+/**
+ * @brief Zero-copy line source of a file.
+ *
+ * File is read into a single buffer and split to lines which point to the
+ * content. Therefore there is no heap allocation per line and strings are
+ * materialized only when a consumer asks for them. Lines are valid as long
+ * as the provider lives and they are NOT affected by file changes.
+ *
+ * Lines are split consistently with std::getline(): newline is dropped
+ * and a file which ends with newline has no trailing empty line.
+ */
+class FileLineProvider
+{
+private:
+    const char* content;
+    size_t contentSize;
+    // != nullptr if file content is read to (owned) buffer
+    char* buffer;
+
+    std::vector<LineSpan> lines;
+
+public:
+    explicit FileLineProvider();
+    FileLineProvider(const FileLineProvider&) = delete;
+    FileLineProvider(const FileLineProvider&&) = delete;
+    FileLineProvider& operator=(const FileLineProvider&) = delete;
+    FileLineProvider& operator=(const FileLineProvider&&) = delete;
+    ~FileLineProvider();
+
+    /**
+     * @brief Read file and split it to lines.
+     *
+     * @param fileSize  size of lines incl. newlines (as counted by fileToLines()).
+     * @return FALSE if file cannot be read or it is empty.
+     */
+    bool open(const std::string* filename, size_t& fileSize);
+
+    /**
+     * @brief Split text (which MUST outlive the provider) to lines.
+     */
+    bool open(const std::string* text);
+
+    void close();
+
+    const std::vector<LineSpan>& getLines() const { return lines; }
+
+    /**
+     * @brief Split content to lines.
+     * @return size of lines incl. newlines.
+     */
+    static size_t split(const char* content, size_t contentSize, std::vector<LineSpan>& lines);
+
+private:
+#ifndef _WIN32
+    /**
+     * @brief Read (up to) size bytes of the file to buffer.
+     */
+    void read(int fd, size_t size);
+#endif
+};
+
+} // m8r namespace
+
+#endif // M8R_FILE_LINE_PROVIDER_H
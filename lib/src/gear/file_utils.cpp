@@ -18,6 +18,12 @@
  */
 #include "file_utils.h"
 
+#include <atomic>
+#include <cerrno>
+#ifndef _WIN32
+  #include <fcntl.h>
+#endif
+
 #ifdef _WIN32
   #include <ShlObj.h>
   #include <KnownFolders.h>
@@ -238,6 +244,33 @@ string getSystemMindForgerConfigPath()
     return mfConfigPath;
 }
 
+string getSystemCachePath()
+{
+    string cachePath{};
+#if defined(_WIN32)
+    // no roaming of data which can be recreated
+    cachePath = getSystemAppsConfigPath();
+#elif defined(__APPLE__)
+    cachePath = getHomeDirectoryPath();
+    cachePath += FILE_PATH_SEPARATOR;
+    cachePath += "Library";
+    cachePath += FILE_PATH_SEPARATOR;
+    cachePath += "Caches";
+#else
+    // XDG base directory specification
+    char* xdgCache = getenv("XDG_CACHE_HOME");
+    if(xdgCache && *xdgCache) {
+        cachePath = string{xdgCache};
+    } else {
+        cachePath = getHomeDirectoryPath();
+        cachePath += FILE_PATH_SEPARATOR;
+        cachePath += ".cache";
+    }
+#endif
+
+    return cachePath;
+}
+
 string getNewTempFilePath(const string& extension)
 {
 #ifdef MD_UNUSED_CODE
@@ -328,6 +361,74 @@ void stringToFile(const string& filename, const string& content)
     out.close();
 }
 
+bool stringToFileAtomically(const string& filename, const string& content)
+{
+    static std::atomic<unsigned> tempSequence{0};
+
+    string target{filename};
+#ifndef _WIN32
+    struct stat targetStat{};
+    if(!lstat(filename.c_str(), &targetStat) && S_ISLNK(targetStat.st_mode)) {
+        // write link target, rename would replace the link w/ regular file
+        resolvePath(filename, target);
+    }
+#endif
+    string directory{}, file{};
+    pathToDirectoryAndFile(target, directory, file);
+    // hidden temp file is ignored by repository watch
+    string temp{directory};
+    temp += FILE_PATH_SEPARATOR;
+    temp += "." + file + "." + std::to_string(tempSequence++) + ".tmp";
+
+#ifdef _WIN32
+    ofstream out(temp, ofstream::out | ofstream::binary);
+    out << content;
+    out.close();
+    if(out.fail()
+       || !MoveFileExA(temp.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING|MOVEFILE_WRITE_THROUGH))
+    {
+        remove(temp.c_str());
+        return false;
+    }
+    return true;
+#else
+    int fd = open(temp.c_str(), O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC, 0666);
+    if(fd < 0) {
+        return false;
+    }
+    if(!stat(target.c_str(), &targetStat)) {
+        fchmod(fd, targetStat.st_mode & 07777);
+    }
+    const char* data = content.data();
+    size_t size = content.size();
+    while(size) {
+        ssize_t written = write(fd, data, size);
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    bool ok = !size && !fsync(fd);
+    ok = !close(fd) && ok;
+    if(!ok || rename(temp.c_str(), target.c_str())) {
+        unlink(temp.c_str());
+        return false;
+    }
+    // rename survives crash only once the directory entry is synced
+    // (file systems which can't sync directories report EINVAL)
+    int dirFd = open(directory.c_str(), O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+    if(dirFd >= 0) {
+        ok = !fsync(dirFd) || errno == EINVAL;
+        close(dirFd);
+    }
+    return ok;
+#endif
+}
+
 time_t fileModificationTime(const string* filename)
 {
 #ifdef __linux__
@@ -224,6 +224,11 @@ std::string getSystemAppsConfigPath();
  * @return MindForger config path.
  */
 std::string getSystemMindForgerConfigPath();
+/**
+ * @brief Get OS specific per-user cache directory path (content which can be recreated).
+ * @return cache path.
+ */
+std::string getSystemCachePath();
 
 void pathToDirectoryAndFile(const std::string& path, std::string& directory, std::string& file);
 void pathToLinuxDelimiters(const std::string& path, std::string& linuxPath);
@@ -233,6 +238,16 @@ bool stringToLines(const std::string* text, std::vector<std::string*>& lines);
 bool fileToLines(const std::string* filename, std::vector<std::string*>& lines, size_t& filesize);
 std::string* fileToString(const std::string& filename);
 void stringToFile(const std::string& filename, const std::string& content);
+/**
+ * @brief Replace file content atomically: write temp file, fsync and rename.
+ *
+ * Temp file is hidden in the same directory (rename must not cross file systems),
+ * permissions of the existing file are preserved and symbolic link is followed,
+ * therefore the file has either old or new content (even on crash).
+ *
+ * @return `true` if the file was written, `false` otherwise (original file is kept).
+ */
+bool stringToFileAtomically(const std::string& filename, const std::string& content);
 time_t fileModificationTime(const std::string* filename);
 bool copyFile(const std::string& from, const std::string& to);
 bool moveFile(const std::string& from, const std::string& to);
@@ -20,6 +20,11 @@
 
 #include <cassert>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  #define M8R_SIMD_X86
+  #include <immintrin.h>
+#endif
+
 using namespace std;
 
 namespace m8r {
@@ -183,6 +188,145 @@ void toString(const std::vector<std::string*>& ss, std::string& os)
     }
 }
 
+/*
+ * Case insensitive search
+ */
+
+static inline unsigned char asciiToLower(unsigned char c)
+{
+    return c>='A' && c<='Z' ? c|0x20 : c;
+}
+
+static inline bool stringEqualsIgnoreCase(const char* s, const char* lowerPattern, size_t n)
+{
+    for(size_t i=0; i<n; i++) {
+        if(asciiToLower(static_cast<unsigned char>(s[i])) != static_cast<unsigned char>(lowerPattern[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t stringFindIgnoreCaseScalar(const char* s, size_t sSize, const char* p, size_t pSize, size_t from)
+{
+    const unsigned char first = static_cast<unsigned char>(p[0]);
+    for(size_t i=from; i+pSize<=sSize; i++) {
+        if(asciiToLower(static_cast<unsigned char>(s[i])) == first
+             && stringEqualsIgnoreCase(s+i+1, p+1, pSize-1))
+        {
+            return i;
+        }
+    }
+    return string::npos;
+}
+
+#ifdef M8R_SIMD_X86
+/*
+ * Vectorized search compares the first and the last pattern character
+ * w/ a block of positions at once and verifies candidate positions only.
+ * Case is folded w/o branches: signed compare keeps bytes >=0x80 (UTF-8) intact.
+ */
+
+__attribute__((target("sse2")))
+static inline __m128i foldSse2(__m128i c)
+{
+    __m128i isUpper = _mm_and_si128(
+        _mm_cmpgt_epi8(c, _mm_set1_epi8('A'-1)),
+        _mm_cmpgt_epi8(_mm_set1_epi8('Z'+1), c));
+    return _mm_or_si128(c, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("sse2")))
+static size_t stringFindIgnoreCaseSse2(const char* s, size_t sSize, const char* p, size_t pSize, size_t from)
+{
+    const __m128i first = _mm_set1_epi8(p[0]);
+    const __m128i last = _mm_set1_epi8(p[pSize-1]);
+    const size_t middle = pSize>1 ? pSize-2 : 0;
+
+    size_t i = from;
+    for(; i+pSize-1+16 <= sSize; i+=16) {
+        __m128i blockFirst = foldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+i)));
+        __m128i blockLast = foldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+i+pSize-1)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last))));
+        while(mask) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if(stringEqualsIgnoreCase(s+i+bit+1, p+1, middle)) {
+                return i+bit;
+            }
+            mask &= mask-1;
+        }
+    }
+    return stringFindIgnoreCaseScalar(s, sSize, p, pSize, i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i foldAvx2(__m256i c)
+{
+    __m256i isUpper = _mm256_and_si256(
+        _mm256_cmpgt_epi8(c, _mm256_set1_epi8('A'-1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('Z'+1), c));
+    return _mm256_or_si256(c, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+static size_t stringFindIgnoreCaseAvx2(const char* s, size_t sSize, const char* p, size_t pSize, size_t from)
+{
+    const __m256i first = _mm256_set1_epi8(p[0]);
+    const __m256i last = _mm256_set1_epi8(p[pSize-1]);
+    const size_t middle = pSize>1 ? pSize-2 : 0;
+
+    size_t i = from;
+    for(; i+pSize-1+32 <= sSize; i+=32) {
+        __m256i blockFirst = foldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+i)));
+        __m256i blockLast = foldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+i+pSize-1)));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last))));
+        while(mask) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if(stringEqualsIgnoreCase(s+i+bit+1, p+1, middle)) {
+                return i+bit;
+            }
+            mask &= mask-1;
+        }
+    }
+    return stringFindIgnoreCaseSse2(s, sSize, p, pSize, i);
+}
+#endif
+
+typedef size_t (*FindIgnoreCaseKernel)(const char*, size_t, const char*, size_t, size_t);
+
+static FindIgnoreCaseKernel selectFindIgnoreCaseKernel()
+{
+#ifdef M8R_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        return stringFindIgnoreCaseAvx2;
+    }
+  #ifdef __SSE2__
+    return stringFindIgnoreCaseSse2;
+  #else
+    if(__builtin_cpu_supports("sse2")) {
+        return stringFindIgnoreCaseSse2;
+    }
+  #endif
+#endif
+    return stringFindIgnoreCaseScalar;
+}
+
+size_t stringFindIgnoreCase(const char* s, size_t sSize, const char* lowerPattern, size_t patternSize, size_t from)
+{
+    if(!patternSize) {
+        return from<=sSize ? from : string::npos;
+    }
+    if(from >= sSize || patternSize > sSize-from) {
+        return string::npos;
+    }
+
+    static const FindIgnoreCaseKernel kernel = selectFindIgnoreCaseKernel();
+    return kernel(s, sSize, lowerPattern, patternSize, from);
+}
+
 void replaceAll(const std::string& old_s, const std::string& new_s, std::string& s)
 {
     size_t from = 0;
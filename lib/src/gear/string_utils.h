@@ -83,6 +83,31 @@ static inline void stringToLower(const std::string& s, std::string& lowerS)
     }
 }
 
+/**
+ * @brief Find lowercase pattern in a string while ignoring case of the string.
+ *
+ * Search is allocation free and vectorized (SSE2/AVX2 selected in runtime
+ * on x86). ASCII letters are case folded, other bytes (incl. UTF-8 multibyte
+ * sequences) are compared as they are.
+ *
+ * @param lowerPattern  pattern converted to lowercase by stringToLower().
+ * @return position of the first match at or after from, std::string::npos otherwise.
+ */
+size_t stringFindIgnoreCase(
+        const char* s,
+        size_t sSize,
+        const char* lowerPattern,
+        size_t patternSize,
+        size_t from=0);
+
+static inline size_t stringFindIgnoreCase(
+        const std::string& s,
+        const std::string& lowerPattern,
+        size_t from=0)
+{
+    return stringFindIgnoreCase(s.data(), s.size(), lowerPattern.data(), lowerPattern.size(), from);
+}
+
 /**
  * @brief Trim leading and trailing whitespaces.
  *
@@ -181,6 +206,22 @@ static inline std::string to_stringl(time_t x)
 
 void toString(const std::vector<std::string*>& ss, std::string& os);
 
+/**
+ * @brief 64-bit FNV-1a hash of the string (fast, but NOT cryptographic).
+ */
+static inline u_int64_t stringHash(const char* s, size_t size, u_int64_t hash=14695981039346656037ULL)
+{
+    for(size_t i=0; i<size; i++) {
+        hash ^= static_cast<unsigned char>(s[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+static inline u_int64_t stringHash(const std::string& s, u_int64_t hash=14695981039346656037ULL)
+{
+    return stringHash(s.c_str(), s.size(), hash);
+}
+
 static inline std::string stringIntFormat(std::string value, char thousandSep = ',')
 {
     unsigned long long len = value.length();
@@ -0,0 +1,306 @@
+/*
+ thread_pool.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+using namespace std;
+
+namespace m8r {
+
+// index of pool's worker queue owned by this thread (workers only)
+static thread_local const void* workerPool = nullptr;
+static thread_local size_t workerId = 0;
+
+ThreadPool::ThreadPool(unsigned threads)
+    : queues{},
+      workers{},
+      pending{0},
+      nextQueue{0},
+      stopping{false}
+{
+    if(!threads) {
+        threads = std::thread::hardware_concurrency();
+        if(!threads) {
+            threads = 2;
+        }
+    }
+
+    for(unsigned i=0; i<threads; i++) {
+        queues.push_back(unique_ptr<WorkerQueue>{new WorkerQueue{}});
+    }
+    for(unsigned i=0; i<threads; i++) {
+        workers.push_back(thread{&ThreadPool::work, this, i});
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    shutdown();
+}
+
+TaskHandle ThreadPool::submit(Task task, TaskPriority priority)
+{
+    shared_ptr<atomic<bool>> cancelled = make_shared<atomic<bool>>(false);
+    QueuedTask queuedTask{task, cancelled};
+    {
+        // lock ensures that sleeping worker doesn't miss the notification
+        // and that no task is queued once the pool is shut down
+        unique_lock<mutex> criticalSection{sleepMutex};
+        if(stopping) {
+            criticalSection.unlock();
+            run(queuedTask, true);
+            return TaskHandle{cancelled};
+        }
+
+        // task submitted by a worker stays local, others are spread
+        size_t q = workerPool==this ? workerId : nextQueue++ % queues.size();
+        lock_guard<mutex> queueCriticalSection{queues[q]->mutex};
+        queues[q]->tasks[static_cast<int>(priority)].push_back(std::move(queuedTask));
+        pending++;
+    }
+    wakeUp.notify_one();
+
+    return TaskHandle{cancelled};
+}
+
+bool ThreadPool::take(size_t id, QueuedTask& result)
+{
+    for(int p=0; p<PRIORITIES; p++) {
+        // own queue first (FIFO) ...
+        {
+            WorkerQueue& own = *queues[id];
+            lock_guard<mutex> criticalSection{own.mutex};
+            if(!own.tasks[p].empty()) {
+                result = std::move(own.tasks[p].front());
+                own.tasks[p].pop_front();
+                return true;
+            }
+        }
+        // ... then steal from the back of other queues
+        for(size_t i=1; i<queues.size(); i++) {
+            WorkerQueue& victim = *queues[(id+i) % queues.size()];
+            lock_guard<mutex> criticalSection{victim.mutex};
+            if(!victim.tasks[p].empty()) {
+                result = std::move(victim.tasks[p].back());
+                victim.tasks[p].pop_back();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(QueuedTask& task, bool cancelled)
+{
+    // task is responsible for its errors - worker must survive
+    try {
+        task.task(cancelled || *task.cancelled);
+    } catch(const std::exception& e) {
+        cerr << "Error: worker task failed: " << e.what() << endl;
+    } catch(...) {
+        cerr << "Error: worker task failed w/ unknown exception" << endl;
+    }
+}
+
+void ThreadPool::work(size_t id)
+{
+    workerPool = this;
+    workerId = id;
+
+    QueuedTask task{};
+    while(true) {
+        {
+            unique_lock<mutex> criticalSection{sleepMutex};
+            wakeUp.wait(criticalSection, [this]() { return pending > 0 || stopping; });
+            if(stopping) {
+                return;
+            }
+            // reserve one of the queued tasks > workers w/o reservation keep sleeping
+            pending--;
+        }
+
+        // tasks are taken by reserving workers only, therefore the reserved one is queued
+        // (the scan may miss it only if it races w/ other workers' takes > scan again)
+        while(!take(id, task)) {
+        }
+        run(task, false);
+        task = QueuedTask{};
+    }
+}
+
+void ThreadPool::processInOrder(
+    size_t chunks,
+    const function<void(size_t)>& process,
+    const function<void(size_t)>& consume,
+    size_t window)
+{
+    if(!window) {
+        window = 2*workers.size()+1;
+    }
+
+    // shared w/ helper tasks which may start after this method returned
+    struct Progress {
+        std::mutex progressMutex;
+        condition_variable changed;
+        size_t chunks;
+        size_t window;
+        size_t next;
+        size_t consumed;
+        // chunks being processed (they use caller's process())
+        size_t running;
+        bool aborted;
+        vector<bool> done;
+        vector<exception_ptr> errors;
+        const function<void(size_t)>* process;
+
+        explicit Progress(size_t chunks, size_t window, const function<void(size_t)>* process)
+            : progressMutex{}, changed{}, chunks{chunks}, window{window}, next{0}, consumed{0},
+              running{0}, aborted{false}, done(chunks, false), errors(chunks), process{process} {}
+
+        // the next chunk to process, chunks if there is none
+        size_t claim(unique_lock<std::mutex>& lock, bool wait) {
+            while(!aborted && next < chunks && next >= consumed+window) {
+                if(!wait) return chunks;
+                changed.wait(lock);
+            }
+            if(aborted || next >= chunks) {
+                return chunks;
+            }
+            running++;
+            return next++;
+        }
+        void run(size_t chunk) {
+            exception_ptr error{};
+            try {
+                (*process)(chunk);
+            } catch(...) {
+                // chunk must be marked as done to let consumer proceed (and rethrow)
+                error = current_exception();
+            }
+            lock_guard<std::mutex> criticalSection{progressMutex};
+            errors[chunk] = error;
+            done[chunk] = true;
+            running--;
+            changed.notify_all();
+        }
+        // stop processing and wait for running chunks - caller's state is about to be unwound
+        void abort() {
+            unique_lock<std::mutex> lock{progressMutex};
+            aborted = true;
+            changed.notify_all();
+            changed.wait(lock, [this]() { return !running; });
+        }
+    };
+    shared_ptr<Progress> progress = make_shared<Progress>(chunks, window, &process);
+
+    size_t helpers = std::min(workers.size(), chunks>0?chunks-1:0);
+    for(size_t i=0; i<helpers; i++) {
+        submit([progress](bool cancelled) {
+            if(!cancelled) {
+                while(true) {
+                    size_t chunk;
+                    {
+                        unique_lock<mutex> lock{progress->progressMutex};
+                        chunk = progress->claim(lock, true);
+                    }
+                    if(chunk == progress->chunks) {
+                        return;
+                    }
+                    progress->run(chunk);
+                }
+            }
+        }, TaskPriority::HIGH);
+    }
+
+    for(size_t c=0; c<chunks; c++) {
+        while(true) {
+            size_t chunk;
+            {
+                unique_lock<mutex> lock{progress->progressMutex};
+                if(progress->done[c]) {
+                    break;
+                }
+                chunk = progress->claim(lock, false);
+                if(chunk == chunks) {
+                    // chunk c is processed by a worker
+                    progress->changed.wait(lock);
+                    continue;
+                }
+            }
+            progress->run(chunk);
+        }
+
+        exception_ptr error{};
+        {
+            lock_guard<mutex> criticalSection{progress->progressMutex};
+            error = progress->errors[c];
+        }
+        if(error) {
+            // failed chunk must not be consumed > failure is reported to the caller
+            progress->abort();
+            rethrow_exception(error);
+        }
+        try {
+            consume(c);
+        } catch(...) {
+            progress->abort();
+            throw;
+        }
+        {
+            lock_guard<mutex> criticalSection{progress->progressMutex};
+            progress->consumed = c+1;
+        }
+        progress->changed.notify_all();
+    }
+}
+
+void ThreadPool::shutdown()
+{
+    {
+        lock_guard<mutex> criticalSection{sleepMutex};
+        if(stopping) {
+            return;
+        }
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for(thread& w:workers) {
+        if(w.joinable()) {
+            w.join();
+        }
+    }
+    workers.clear();
+
+    // let tasks which never started know that they were cancelled
+    for(unique_ptr<WorkerQueue>& q:queues) {
+        for(int p=0; p<PRIORITIES; p++) {
+            for(QueuedTask& t:q->tasks[p]) {
+                run(t, true);
+            }
+            q->tasks[p].clear();
+        }
+    }
+    pending = 0;
+}
+
+} // m8r namespace
@@ -0,0 +1,158 @@
+/*
+ thread_pool.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_THREAD_POOL_H
+#define M8R_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Priority of a task submitted to the thread pool.
+ */
+enum class TaskPriority {
+    // user is waiting for the result (e.g. associations of viewed N)
+    HIGH = 0,
+    NORMAL = 1,
+    // background precomputations
+    LOW = 2
+};
+
+/**
+ * @brief Handle of a submitted task which can be used to cancel it.
+ *
+ * Cancellation is cooperative: a task which has not started yet is not
+ * executed (its body is called w/ cancelled flag set instead), a running
+ * task may check isCancelled() to finish early.
+ */
+class TaskHandle
+{
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+
+public:
+    explicit TaskHandle() : cancelled{} {}
+    explicit TaskHandle(std::shared_ptr<std::atomic<bool>> cancelled) : cancelled{cancelled} {}
+
+    bool isValid() const { return cancelled != nullptr; }
+    void cancel() { if(cancelled) *cancelled = true; }
+    bool isCancelled() const { return cancelled && *cancelled; }
+};
+
+/**
+ * @brief Bounded work-stealing thread pool w/ task priorities.
+ *
+ * Every worker has its own queue per priority. Tasks submitted by a worker
+ * go to worker's queue, other tasks are distributed round robin. Idle worker
+ * takes the highest priority task from its queue or steals one from other
+ * workers' queues - higher priority tasks are always taken first.
+ *
+ * Task is called exactly once: either w/ FALSE when it's executed or w/ TRUE
+ * when it was cancelled before it started (or when the pool is shut down),
+ * therefore it can always fulfill its promises.
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void(bool cancelled)> Task;
+
+private:
+    static constexpr int PRIORITIES = 3;
+
+    struct QueuedTask {
+        Task task;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks[PRIORITIES];
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    // queued tasks w/o worker - decremented (under sleep mutex) when a worker reserves one
+    std::atomic<unsigned> pending;
+    std::atomic<unsigned> nextQueue;
+    std::atomic<bool> stopping;
+
+public:
+    /**
+     * @param threads  number of workers, 0 to use number of hardware threads.
+     */
+    explicit ThreadPool(unsigned threads=0);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(const ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&&) = delete;
+    ~ThreadPool();
+
+    size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Number of tasks which are queued, but not claimed by a worker.
+     */
+    unsigned getPendingCount() const { return pending; }
+
+    TaskHandle submit(Task task, TaskPriority priority=TaskPriority::NORMAL);
+
+    /**
+     * @brief Process chunks in parallel and consume their results in order.
+     *
+     * Chunks [0, chunks) are processed by the calling thread and idle workers,
+     * consume() is called by the calling thread in chunk order as soon as
+     * the chunk is processed (e.g. serialized chunk is written to a file).
+     * At most window chunks are processed ahead of the consumed one so that
+     * memory used by results is bounded. The calling thread processes chunks
+     * itself, therefore it never waits for busy workers (and it can be a worker).
+     *
+     * If process() or consume() throws, then no further chunk is consumed, chunks
+     * being processed are finished and the exception is rethrown in the calling thread.
+     *
+     * @param window  0 for twice the number of workers.
+     */
+    void processInOrder(
+        size_t chunks,
+        const std::function<void(size_t chunk)>& process,
+        const std::function<void(size_t chunk)>& consume,
+        size_t window=0);
+
+    /**
+     * @brief Cancel queued tasks, wait for running tasks and stop workers.
+     */
+    void shutdown();
+
+private:
+    void work(size_t id);
+    bool take(size_t id, QueuedTask& result);
+    static void run(QueuedTask& task, bool cancelled);
+};
+
+}
+#endif // M8R_THREAD_POOL_H
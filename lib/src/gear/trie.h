@@ -57,7 +57,7 @@ private:
         void setRefCount(int refCount) { mRefCount=refCount; }
         void setWordMarker() { ++mRefCount; }
         void appendChild(Node* child) { mChildren.push_back(child); }
-        std::vector<Node*> children() const { return mChildren; }
+        const std::vector<Node*>& children() const { return mChildren; }
 
         // IMPROVE sort children once trie filled AND use binary search here O(n) -> O(log(n))
         Node* findChild(char c) {
@@ -0,0 +1,170 @@
+/*
+ aggregates.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "aggregates.h"
+
+using namespace std;
+
+namespace m8r {
+
+Aggregates::Aggregates()
+    : outlines{},
+      outlineReadsLeaders{},
+      outlineRevisionLeaders{},
+      noteReadsLeaders{},
+      noteRevisionLeaders{},
+      notesCount{},
+      bytesize{},
+      slotSequence{}
+{
+}
+
+Aggregates::~Aggregates()
+{
+}
+
+void Aggregates::clear()
+{
+    outlines.clear();
+    outlineReadsLeaders.clear();
+    outlineRevisionLeaders.clear();
+    noteReadsLeaders.clear();
+    noteRevisionLeaders.clear();
+    notesCount = 0;
+    bytesize = 0;
+    slotSequence = 0;
+}
+
+void Aggregates::index(Outline* outline)
+{
+    if(outline) {
+        auto i = outlines.find(outline);
+        u_int32_t slot = i==outlines.end()?slotSequence++:i->second.slot;
+        forget(outline);
+
+        OutlineAggregate a{
+            slot,
+            outline->getNotes().size(),
+            outline->getBytesize(),
+            Leader{outline->getReads(), slot, outline},
+            Leader{outline->getRevision(), slot, outline},
+            Leader{0, slot, nullptr},
+            Leader{0, slot, nullptr}};
+        for(Note* n:outline->getNotes()) {
+            if(n->getReads() > a.noteReads.value) {
+                a.noteReads.value = n->getReads();
+                a.noteReads.thing = n;
+            }
+            if(n->getRevision() > a.noteRevision.value) {
+                a.noteRevision.value = n->getRevision();
+                a.noteRevision.thing = n;
+            }
+        }
+
+        notesCount += a.notes;
+        bytesize += a.bytes;
+        addLeader(outlineReadsLeaders, a.outlineReads);
+        addLeader(outlineRevisionLeaders, a.outlineRevision);
+        addLeader(noteReadsLeaders, a.noteReads);
+        addLeader(noteRevisionLeaders, a.noteRevision);
+
+        outlines[outline] = a;
+    }
+}
+
+void Aggregates::forget(const Outline* outline)
+{
+    auto i = outlines.find(outline);
+    if(i != outlines.end()) {
+        const OutlineAggregate& a = i->second;
+        notesCount -= a.notes;
+        bytesize -= a.bytes;
+        removeLeader(outlineReadsLeaders, a.outlineReads);
+        removeLeader(outlineRevisionLeaders, a.outlineRevision);
+        removeLeader(noteReadsLeaders, a.noteReads);
+        removeLeader(noteRevisionLeaders, a.noteRevision);
+        outlines.erase(i);
+    }
+}
+
+void Aggregates::replace(const Outline* oldOutline, Outline* newOutline)
+{
+    auto i = outlines.find(oldOutline);
+    if(i != outlines.end()) {
+        u_int32_t slot = i->second.slot;
+        forget(oldOutline);
+        outlines[newOutline].slot = slot;
+    }
+    index(newOutline);
+}
+
+bool Aggregates::check(const vector<Outline*>& memoryOutlines, string* error) const
+{
+    size_t notes{}, bytes{};
+    u_int32_t oReads{}, oRevision{}, nReads{}, nRevision{};
+    Outline* oReadsLeader{};
+    Outline* oRevisionLeader{};
+    Note* nReadsLeader{};
+    Note* nRevisionLeader{};
+    for(Outline* o:memoryOutlines) {
+        notes += o->getNotes().size();
+        bytes += o->getBytesize();
+        if(o->getReads() > oReads) {
+            oReads = o->getReads();
+            oReadsLeader = o;
+        }
+        if(o->getRevision() > oRevision) {
+            oRevision = o->getRevision();
+            oRevisionLeader = o;
+        }
+        for(Note* n:o->getNotes()) {
+            if(n->getReads() > nReads) {
+                nReads = n->getReads();
+                nReadsLeader = n;
+            }
+            if(n->getRevision() > nRevision) {
+                nRevision = n->getRevision();
+                nRevisionLeader = n;
+            }
+        }
+    }
+
+    string e{};
+    if(memoryOutlines.size() != getOutlinesCount()) {
+        e = "outlines count " + std::to_string(getOutlinesCount()) + " != " + std::to_string(memoryOutlines.size());
+    } else if(notes != notesCount) {
+        e = "notes count " + std::to_string(notesCount) + " != " + std::to_string(notes);
+    } else if(bytes != bytesize) {
+        e = "bytesize " + std::to_string(bytesize) + " != " + std::to_string(bytes);
+    } else if(oReadsLeader != getMostReadOutline()) {
+        e = "most read outline";
+    } else if(oRevisionLeader != getMostWrittenOutline()) {
+        e = "most written outline";
+    } else if(nReadsLeader != getMostReadNote()) {
+        e = "most read note";
+    } else if(nRevisionLeader != getMostWrittenNote()) {
+        e = "most written note";
+    }
+
+    if(error) {
+        *error = e;
+    }
+    return e.empty();
+}
+
+} // m8r namespace
@@ -0,0 +1,130 @@
+/*
+ aggregates.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_AGGREGATES_H
+#define M8R_AGGREGATES_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "memory_index.h"
+
+namespace m8r {
+
+/**
+ * @brief Repository aggregates: counts, sizes and the most read/written Os and Ns.
+ *
+ * Every O has a partial aggregate (Ns count, bytes and its most read/written
+ * N) which is recalculated when the O is (re)indexed. Totals are updated by
+ * the difference and leaders are kept in ordered sets, therefore queries are
+ * O(1) and update is O(O's Ns) + O(log Os).
+ *
+ * Leader is the thing w/ the highest (non-zero) value, the first thing
+ * in the memory order wins on tie.
+ */
+class Aggregates : public MemoryIndex
+{
+private:
+    struct Leader {
+        u_int32_t value;
+        // O slot - the first O in memory wins on tie
+        u_int32_t slot;
+        Thing* thing;
+    };
+
+    struct LeaderOrder {
+        bool operator()(const Leader& a, const Leader& b) const {
+            return a.value < b.value || (a.value == b.value && a.slot > b.slot);
+        }
+    };
+
+    struct OutlineAggregate {
+        u_int32_t slot;
+        size_t notes;
+        size_t bytes;
+        Leader outlineReads;
+        Leader outlineRevision;
+        Leader noteReads;
+        Leader noteRevision;
+    };
+
+    std::unordered_map<const Outline*,OutlineAggregate> outlines;
+
+    std::set<Leader,LeaderOrder> outlineReadsLeaders;
+    std::set<Leader,LeaderOrder> outlineRevisionLeaders;
+    std::set<Leader,LeaderOrder> noteReadsLeaders;
+    std::set<Leader,LeaderOrder> noteRevisionLeaders;
+
+    size_t notesCount;
+    size_t bytesize;
+
+    u_int32_t slotSequence;
+
+public:
+    explicit Aggregates();
+    Aggregates(const Aggregates&) = delete;
+    Aggregates(const Aggregates&&) = delete;
+    Aggregates& operator=(const Aggregates&) = delete;
+    Aggregates& operator=(const Aggregates&&) = delete;
+    ~Aggregates();
+
+    virtual void index(Outline* outline) override;
+    virtual void forget(const Outline* outline) override;
+    virtual void replace(const Outline* oldOutline, Outline* newOutline) override;
+    virtual void clear() override;
+
+    size_t getOutlinesCount() const { return outlines.size(); }
+    size_t getNotesCount() const { return notesCount; }
+    size_t getBytesize() const { return bytesize; }
+    bool isAggregated(const Outline* outline) const { return outlines.find(outline) != outlines.end(); }
+
+    Outline* getMostReadOutline() const { return leader<Outline>(outlineReadsLeaders); }
+    Outline* getMostWrittenOutline() const { return leader<Outline>(outlineRevisionLeaders); }
+    Note* getMostReadNote() const { return leader<Note>(noteReadsLeaders); }
+    Note* getMostWrittenNote() const { return leader<Note>(noteRevisionLeaders); }
+
+    /**
+     * @brief Check aggregates invariant: aggregates must be equal to full recalculation.
+     *
+     * @param outlines  Os in memory order.
+     * @param error     description of the first difference (if not nullptr).
+     */
+    bool check(const std::vector<Outline*>& outlines, std::string* error=nullptr) const;
+
+private:
+    template<typename T> static T* leader(const std::set<Leader,LeaderOrder>& leaders) {
+        return leaders.empty()?nullptr:static_cast<T*>(leaders.rbegin()->thing);
+    }
+    static void addLeader(std::set<Leader,LeaderOrder>& leaders, const Leader& leader) {
+        if(leader.value) {
+            leaders.insert(leader);
+        }
+    }
+    static void removeLeader(std::set<Leader,LeaderOrder>& leaders, const Leader& leader) {
+        if(leader.value) {
+            leaders.erase(leader);
+        }
+    }
+};
+
+}
+#endif // M8R_AGGREGATES_H
@@ -138,6 +138,24 @@ public:
     }
 #endif
 
+    /**
+     * @brief Incrementally learn O and its added/modified/deleted Ns.
+     */
+    void remember(Outline* outline) {
+        if(aa) {
+            aa->remember(outline);
+        }
+    }
+
+    /**
+     * @brief Incrementally forget O.
+     */
+    void forget(Outline* outline) {
+        if(aa) {
+            aa->forget(outline);
+        }
+    }
+
     /**
      * @brief Clear, but don't deallocate.
      *
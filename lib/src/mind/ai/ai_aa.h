@@ -73,6 +73,16 @@ public:
      */
     virtual std::shared_future<bool> getAssociatedNotes(const std::string& words, std::vector<std::pair<Note*,float>>& associations, const Note* self) = 0;
 
+    /**
+     * @brief Incrementally learn O and its Ns which were added, modified or deleted.
+     */
+    virtual void remember(Outline* outline) = 0;
+
+    /**
+     * @brief Incrementally forget O and its Ns.
+     */
+    virtual void forget(Outline* outline) = 0;
+
     /**
      * @brief Clear.
      */
@@ -27,34 +27,18 @@ AiAaBoW::AiAaBoW(Memory& memory, Mind& mind)
       memory(memory),
       lexicon{},
       wordBlacklist{},
-      tokenizer{lexicon,wordBlacklist}
+      tokenizer{lexicon,wordBlacklist},
+      titleLexicon{},
+      titleTokenizer{titleLexicon,wordBlacklist},
+      leaderboardTask{},
+      leaderboardTaskNote{nullptr},
+      generation{0},
+      learned{false}
 {
 }
 
 AiAaBoW::~AiAaBoW()
 {
-    // delete dead threads
-    auto zombieIterator
-        = std::remove_if(runningWorkers.begin(),
-                         runningWorkers.end(),
-                         [](const thread* t) { if(!t->joinable()) { delete t; return true; } else return false; });
-    runningWorkers.erase(zombieIterator, runningWorkers.end());
-}
-
-void AiAaBoW::addWorkerAndCleanZombies(thread* t)
-{
-    lock_guard<mutex> criticalSection{runningWorkersMutex};
-    MF_DEBUG("AA.BoW: workers+zombies " << runningWorkers.size() << endl);
-
-    // IMPROVE: if zombies is erased > future/promise is deleted as well > frontend that has future calls a method on it > crash
-    //   - temporal SOLUTION: threads are deleted on MF exit (i.e. finished threads are kept in memory for whole MF run)
-    //     (see destructor for dead threads code to move in here)
-    //   - IDEA: frontend could use a thread hook to indicate that it got future and t can be freed
-
-    // add new one
-    runningWorkers.push_back(t);
-
-    MF_DEBUG("AA.BoW: workers " << runningWorkers.size() << endl);
 }
 
 // it's presumed that caller ensures the correct Mind state & synchronization
@@ -63,14 +47,21 @@ shared_future<bool> AiAaBoW::dream() {
         MF_DEBUG("AA.BoW: ASYNC dream..." << endl);
         mind.incActiveProcesses();
 
-        // packaged task is parametrized by function/method signature (not return type)
-        std::packaged_task<bool (AiAaBoW*,thread*)> learnMemoryTask([](AiAaBoW* a,thread* t) { return a->learnMemorySync(t); });
-        future<bool> result = learnMemoryTask.get_future(); // move
-        thread* t = new thread{};
-        *t = thread(std::move(learnMemoryTask), this, t);
-        addWorkerAndCleanZombies(t);
+        shared_ptr<promise<bool>> p = make_shared<promise<bool>>();
+        shared_future<bool> result{p->get_future()};
+        mind.getWorkers().submit(
+            [this,p](bool cancelled) {
+                if(cancelled) {
+                    mind.decActiveProcesses();
+                    p->set_value(false);
+                } else {
+                    p->set_value(learnMemorySync());
+                }
+            },
+            // N being viewed (leaderboard) goes before dreaming
+            TaskPriority::LOW);
 
-        return shared_future<bool>(std::move(result));
+        return result;
     } else {
         MF_DEBUG("AA.BoW: SYNC dream..." << endl);
         promise<bool> p{};
@@ -83,52 +74,40 @@ shared_future<bool> AiAaBoW::dream() {
     }
 }
 
-bool AiAaBoW::learnMemorySync(thread* t)
+bool AiAaBoW::learnMemorySync()
 {
     MF_DEBUG("AA.BoW: LEARNING memory to BoW..." << endl);
-    notes.clear();
-    memory.getAllNotes(notes);
-    // let N know it's indexed in AI
-    for(size_t i=0; i<notes.size(); i++) {
-        notes[i]->setAiAaMatrixIndex(static_cast<int>(i));
-    }
-
-    // build lexicon and BoW
-    lexicon.clear();
-    bow.clear();
-    for(Note* n:notes) {
-        NoteCharProvider chars{n};
-        WordFrequencyList* wfl = new WordFrequencyList{&lexicon};
-        tokenizer.tokenize(chars, *wfl);
-        bow.add(n, wfl);
-    }
-    // prepare DATA to quickly create association assessment features
-    lexicon.recalculateWeights();
-    bow.reorderDocVectorsByWeight();
+    {
+        lock_guard<mutex> criticalSection{aaMutex};
+
+        clearDataSets();
+        memory.getAllNotes(notes);
+
+        // build lexicon, N features and posting lists
+        aaLeaderboards.resize(notes.size());
+        aaCalculated.resize(notes.size(), false);
+        features.resize(notes.size());
+        for(size_t i=0; i<notes.size(); i++) {
+            // let N know it's indexed in AI
+            notes[i]->setAiAaMatrixIndex(static_cast<int>(i));
+            indexNote(static_cast<u_int32_t>(i));
+        }
+        // prepare DATA to quickly create association assessment features
+        lexicon.recalculateWeights();
+        for(shared_ptr<NoteFeatures>& f:features) {
+            rankWords(*f);
+        }
 
 #ifdef DO_MF_DEBUG
-    lexicon.print();
-    bow.print();
+        lexicon.print();
 #endif
 
-    // AA to be built incrementally - just initialize it
-    if(notes.size() != aaMatrix.size()) {
-        aaMatrix.clear();
-        aaMatrix.resize(notes.size());
-        for(size_t i=0; i<aaMatrix.size(); ++i) {
-            aaMatrix[i].resize(aaMatrix.size(),(float)AiAaBoW::AA_NOT_SET); // C++ :-Z constexpr w/ internal linkage does NOT have to be solved in compile time > workaround via temporary var
-        }
-    } else {
-        for(size_t i=0; i<aaMatrix.size(); ++i) {
-            std::fill(aaMatrix[i].begin(), aaMatrix[i].end(), (float)AiAaBoW::AA_NOT_SET); // C++ :-Z constexpr w/ internal linkage does NOT have to be solved in compile time > workaround via temporary var
-        }
+        // AA leaderboards to be calculated lazily and maintained incrementally
+        learned = true;
     }
 
-    // NN to be trained on demand - just initialize it
-
     mind.persistMindState(Configuration::MindState::THINKING);
     mind.decActiveProcesses();
-    if(t) t->detach(); // indicate that thread finished
 
     MF_DEBUG("AA.BoW: memory LEARNED!" << endl);
     return true;
@@ -136,18 +115,19 @@ bool AiAaBoW::learnMemorySync(thread* t)
 
 // it's presumed that caller ensures the correct Mind state & synchronization
 shared_future<bool> AiAaBoW::getAssociatedNotes(const Note* note, vector<pair<Note*,float>>& associations) {
-    auto cachedLeaderboard = leaderboardCache.find(note);
-    if(cachedLeaderboard != leaderboardCache.end()) {
+    unique_lock<mutex> criticalSection{aaMutex};
+    int y = getNoteIndex(note);
+    if(y >= 0 && aaCalculated[y]) {
         MF_DEBUG("AA.BoW: SYNC leaderboard calculation for '" << note->getName() << "'" << endl);
         // copy leaderboard to ENSURE it's validity even if Mind/AI will be cleared/asleep/...
-        for(auto p:cachedLeaderboard->second) {
-            associations.push_back(p);
+        for(const Association& a:aaLeaderboards[y]) {
+            associations.push_back(std::make_pair(notes[a.note], a.aa));
         }
         // indicate that it's immediately available
         promise<bool> p{};
         p.set_value(true);
         return shared_future<bool>(p.get_future());
-    } else {        
+    } else {
         MF_DEBUG("AA.BoW: ASYNC leaderboard calculation for '" << note->getName() << "'" << endl);
         if(leaderboardWip.find(note) != leaderboardWip.end()) {
             // calculation WIP & future OWNER will update what needs to be updated -> intentionally NOT sharing futures
@@ -156,246 +136,442 @@ shared_future<bool> AiAaBoW::getAssociatedNotes(const Note* note, vector<pair<No
             MF_DEBUG("AA.BoW: leaderboard WIP for '" << note->getName() << "'" << endl);
             return p.get_future(); // move
         } else {
-            mind.incActiveProcesses();
-            MF_DEBUG("AA.BoW: starting THREAD for '" << note->getName() << "'" << endl);
+            // user navigated away > leaderboard which was not started yet is not needed
+            if(leaderboardTaskNote != note) {
+                leaderboardTask.cancel();
+            }
 
-            // packaged task is parametrized by function/method signature (not return type)
-            packaged_task<bool (AiAaBoW*,const Note*,thread*)> calculateLeaderboardTask([](AiAaBoW* a, const Note* n, thread* t) { return a->calculateLeaderboardSync(n,t); });
-            future<bool> result = calculateLeaderboardTask.get_future(); // move
-            thread* t = new thread{};
-            *t = thread(std::move(calculateLeaderboardTask), this, note, t); // run task w/ handle to self thread
-            addWorkerAndCleanZombies(t);
+            leaderboardWip.insert(note);
+            mind.incActiveProcesses();
+            MF_DEBUG("AA.BoW: submitting leaderboard TASK for '" << note->getName() << "'" << endl);
+
+            shared_ptr<promise<bool>> p = make_shared<promise<bool>>();
+            shared_future<bool> result{p->get_future()};
+            leaderboardTaskNote = note;
+            // N being viewed goes before background work
+            criticalSection.unlock();
+            TaskHandle task = mind.getWorkers().submit(
+                [this,note,y,p](bool cancelled) {
+                    p->set_value(calculateLeaderboardSync(note, y, cancelled));
+                },
+                TaskPriority::HIGH);
+            criticalSection.lock();
+            if(leaderboardTaskNote == note) {
+                leaderboardTask = task;
+            }
 
-            return shared_future<bool>(std::move(result));
+            return result;
         }
     }
 }
 
-// Pre-calculate/calculate code CANNOT be reused as pre-calculate relies on rows w/ lower index
-// to fill the beginning of the line.
 // This is a private method called from AI ~ AI state/async/critical sections handled by caller.
-void AiAaBoW::calculateAaRow(size_t y)
+int AiAaBoW::getNoteIndex(const Note* n) const
 {
-    MF_DEBUG("AA.BoW: Calculating AA row " << y << "..." << endl);
-    // calculate row and column that cross diagonal on [y][y]
+    // index is copied w/ N > check that it's really this N on that index
+    int i = n->getAiAaMatrixIndex();
+    if(i >= 0 && static_cast<size_t>(i) < notes.size() && notes[i] == n) {
+        return i;
+    }
+    return -1;
+}
 
-    // check diagonal to find out whether the cross has been already calculated
-    if(aaMatrix[y][y] == 1.f) {
-        return;
+// posting lists are sorted by N index > binary search (common words have long lists)
+static void insertPosting(vector<u_int32_t>& postings, u_int32_t i)
+{
+    auto p = std::lower_bound(postings.begin(), postings.end(), i);
+    if(p == postings.end() || *p != i) {
+        postings.insert(p, i);
     }
+}
 
-    float aa;
-    AssociationAssessmentNotesFeature aaFeature{};
+static void removePosting(vector<u_int32_t>& postings, u_int32_t i)
+{
+    auto p = std::lower_bound(postings.begin(), postings.end(), i);
+    if(p != postings.end() && *p == i) {
+        postings.erase(p);
+    }
+}
 
-    notes[y]->setAiAaMatrixIndex(y);
-    for(size_t x=0; x<aaMatrix.size(); x++) {
-        // set diagonal at the end
-        if(x!=y) {
-            // skip if value has been already calculated
-            if(aaMatrix[y][x] == AA_NOT_SET) {
-                Note* n1 = notes[x];
-                Note* n2 = notes[y];
-
-                aaFeature.setHaveMutualRel(false); // TODO
-                aaFeature.setTypeMatches(n1->getType()==n2->getType());
-                aaFeature.setSimilaritySameOutline(n1->getOutline()==n2->getOutline());
-                aaFeature.setSimilarityByTags(calculateSimilarityByTags(n1->getTags(),n2->getTags()));
-                aaFeature.setSimilarityByTitles(calculateSimilarityByTitles(n1->getName(),n2->getName()));
-                aaFeature.setSimilarityByDescription(calculateSimilarityByWords(*bow.get(n1),*bow.get(n2),AA_WORD_RELEVANCY_THRESHOLD));
-                aaFeature.setSimilarityBySameTargetRels(0.0); // TODO nice
-
-                aa = aaFeature.areNotesAssociatedMetric();
-
-                // set AA ranking both below and above diagonal - detection will be faster later (no check x>y needed)
-                aaMatrix[x][y] = aa;
-                aaMatrix[y][x] = aa;
-            }
-        }
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::indexNote(u_int32_t i)
+{
+    Note* n = notes[i];
+    shared_ptr<NoteFeatures> f = make_shared<NoteFeatures>();
+    f->type = n->getType();
+    f->outline = n->getOutline();
+    f->revision = n->getRevision();
+    f->modified = n->getModified();
+
+    NoteCharProvider chars{n};
+    WordFrequencyList wfl{&lexicon};
+    tokenizer.tokenize(chars, wfl);
+    f->words = wfl.iterable();
+    rankWords(*f);
+    if(wordPostings.size() < lexicon.size()) {
+        wordPostings.resize(lexicon.size());
+    }
+    for(auto& e:f->words) {
+        insertPosting(wordPostings[e.id], i);
     }
 
-    // set diagonal at the end to indicate calculation is done (consider reentrancy)
-    aaMatrix[y][y] = 1.;
+    f->tags = *n->getTags();
+    std::sort(f->tags.begin(), f->tags.end());
+    f->tags.erase(std::unique(f->tags.begin(), f->tags.end()), f->tags.end());
+    for(const Tag* t:f->tags) {
+        insertPosting(tagPostings[t], i);
+    }
 
-#ifdef DO_MF_DEBUG
-    MF_DEBUG("AA.BoW: AA row calculated!" << endl);
-    //printAa();
-    //assertAaSymmetry();
-#endif
+    StringCharProvider titleChars{n->getName()};
+    WordFrequencyList titleWfl{&titleLexicon};
+    titleTokenizer.tokenize(titleChars, titleWfl, false, true, false);
+    f->titleWords.reserve(titleWfl.size());
+    for(auto& e:titleWfl.iterable()) {
+        f->titleWords.push_back(e.id);
+    }
+
+    insertPosting(outlinePostings[f->outline], i);
+
+    features[i] = f;
+    generation++;
 }
 
 // This is a private method called from AI ~ AI state/async/critical sections handled by caller.
-void AiAaBoW::precalculateAa()
+void AiAaBoW::rankWords(NoteFeatures& f) const
 {
-#ifdef DO_MF_DEBUG
-    static const float UNIQUE_AA_CELLS = (float)(notes.size()*notes.size()/2.+notes.size()/2.);
-    MF_DEBUG("  Building AA matrix w/ " << UNIQUE_AA_CELLS << " UNIQUE rankings..." << endl);
-    float c=0;
-    float p;
-#endif
+    f.topWords.clear();
+    f.topWords.reserve(f.words.size());
+    for(auto& e:f.words) {
+        f.topWords.push_back(make_pair(e.id, lexicon.getWeight(e.id)));
+    }
+    // higher weight first, lower ID on the same weight
+    size_t size = std::min(f.topWords.size(), static_cast<size_t>(AA_WORD_RELEVANCY_THRESHOLD));
+    std::partial_sort(
+        f.topWords.begin(),
+        f.topWords.begin()+size,
+        f.topWords.end(),
+        [](const pair<u_int32_t,float>& w1, const pair<u_int32_t,float>& w2) {
+            return w1.second > w2.second || (w1.second == w2.second && w1.first < w2.first);
+        });
+    f.topWords.resize(size);
+    f.topWords.shrink_to_fit();
+}
+
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::unindexNote(u_int32_t i)
+{
+    // N might be already deleted > use features only
+    shared_ptr<NoteFeatures> f = features[i];
+    if(!f) {
+        return;
+    }
+
+    for(auto& e:f->words) {
+        removePosting(wordPostings[e.id], i);
+        lexicon.release(e.id, e.frequency);
+    }
+    for(const Tag* t:f->tags) {
+        removePosting(tagPostings[t], i);
+    }
+    removePosting(outlinePostings[f->outline], i);
+
+    // workers might still use the snapshot of features
+    features[i].reset();
+    generation++;
+}
+
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::collectCandidates(u_int32_t y, vector<u_int32_t>& candidates)
+{
+    const NoteFeatures* f = features[y].get();
+    if(!f) {
+        return;
+    }
+    size_t offset = candidates.size();
 
-    // calculate FULL matrix of Ns associativity assessment for every N1 and N2 tuple
-    float aa;
+    for(auto& e:f->words) {
+        const vector<u_int32_t>& p = wordPostings[e.id];
+        candidates.insert(candidates.end(), p.begin(), p.end());
+    }
+    for(const Tag* t:f->tags) {
+        const vector<u_int32_t>& p = tagPostings[t];
+        candidates.insert(candidates.end(), p.begin(), p.end());
+    }
+    const vector<u_int32_t>& p = outlinePostings[f->outline];
+    candidates.insert(candidates.end(), p.begin(), p.end());
+
+    std::sort(candidates.begin()+offset, candidates.end());
+    candidates.erase(std::unique(candidates.begin()+offset, candidates.end()), candidates.end());
+    candidates.erase(
+        std::remove(candidates.begin()+offset, candidates.end(), y),
+        candidates.end());
+}
+
+// features are immutable > safe to be called outside of critical section
+float AiAaBoW::assessNotes(const NoteFeatures& x, const NoteFeatures& y) const
+{
     AssociationAssessmentNotesFeature aaFeature{};
-    for(size_t y=0; y<aaMatrix.size(); y++) {
-        notes[y]->setAiAaMatrixIndex(y); // sets index for ALL notes in notes vector
 
-#ifdef DO_MF_DEBUG
-        p = c/(UNIQUE_AA_CELLS/100.);
-        MF_DEBUG("    " << (int)p << "% AA matrix rankings for '" << notes[y]->getName() << "'" << endl);
-#endif
+    aaFeature.setHaveMutualRel(false);
+    aaFeature.setTypeMatches(x.type==y.type);
+    aaFeature.setSimilaritySameOutline(x.outline==y.outline);
+    aaFeature.setSimilarityByTags(calculateSimilarityByTags(x.tags,y.tags));
+    aaFeature.setSimilarityByTitles(calculateSimilarityByTitles(x.titleWords,y.titleWords));
+    aaFeature.setSimilarityByDescription(calculateSimilarityByWords(x,y,AA_WORD_RELEVANCY_THRESHOLD));
+    aaFeature.setSimilarityBySameTargetRels(0.0);
 
-        // calculate only values ABOVE diagonal i.e. initialize x=y
-        for(size_t x=y; x<aaMatrix.size(); x++) {
-#ifdef DO_MF_DEBUG
-            c++;
-#endif
+    return aaFeature.areNotesAssociatedMetric();
+}
+
+// higher AA first, lower N index on the same AA (to make leaderboards deterministic)
+static bool isBetterAssociation(float aa1, u_int32_t n1, float aa2, u_int32_t n2)
+{
+    return aa1 > aa2 || (aa1 == aa2 && n1 < n2);
+}
+
+// features snapshot is immutable > called outside of critical section
+void AiAaBoW::calculateAaLeaderboard(
+        const NoteFeatures& y,
+        const vector<pair<u_int32_t,shared_ptr<const NoteFeatures>>>& candidates,
+        vector<Association>& leaderboard) const
+{
+    MF_DEBUG("AA.BoW: Calculating AA leaderboard from " << candidates.size() << " candidates..." << endl);
+    leaderboard.clear();
+    leaderboard.reserve(candidates.size());
+    for(auto& x:candidates) {
+        leaderboard.push_back(Association{x.first, assessNotes(*x.second, y)});
+    }
+
+    // only top N associations are kept
+    size_t size = std::min(leaderboard.size(), static_cast<size_t>(AA_LEADERBOARD_SIZE));
+    std::partial_sort(
+        leaderboard.begin(),
+        leaderboard.begin()+size,
+        leaderboard.end(),
+        [](const Association& a1, const Association& a2) {
+            return isBetterAssociation(a1.aa, a1.note, a2.aa, a2.note);
+        });
+    leaderboard.resize(size);
+    leaderboard.shrink_to_fit();
+}
+
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::updateCandidateRows(u_int32_t y, const vector<u_int32_t>& candidates, bool isLearned)
+{
+    for(u_int32_t x:candidates) {
+        if(!aaCalculated[x]) {
+            continue;
+        }
 
-            if(x==y) {
-                aaMatrix[x][y] = 1.;
-            } else {
-                Note* n1 = notes[x];
-                Note* n2 = notes[y];
-
-                aaFeature.setHaveMutualRel(false); // TODO
-                aaFeature.setTypeMatches(n1->getType()==n2->getType());
-                aaFeature.setSimilaritySameOutline(n1->getOutline()==n2->getOutline());
-                aaFeature.setSimilarityByTags(calculateSimilarityByTags(n1->getTags(),n2->getTags()));
-                aaFeature.setSimilarityByTitles(calculateSimilarityByTitles(n1->getName(),n2->getName()));
-                aaFeature.setSimilarityByDescription(calculateSimilarityByWords(*bow.get(n1),*bow.get(n2),AA_WORD_RELEVANCY_THRESHOLD));
-                aaFeature.setSimilarityBySameTargetRels(0.0); // TODO nice
-
-                aa = aaFeature.areNotesAssociatedMetric();
-
-                // set AA ranking both below and above diagonal - detection will be faster later (no check x>y needed)
-                aaMatrix[x][y] = aa;
-                aaMatrix[y][x] = aa;
+        vector<Association>& leaderboard = aaLeaderboards[x];
+        auto a = std::find_if(
+            leaderboard.begin(),
+            leaderboard.end(),
+            [y](const Association& a) { return a.note == y; });
+        if(a != leaderboard.end()) {
+            // N's AA might have dropped below the ones which were cut off > recalculate on demand
+            aaCalculated[x] = false;
+            leaderboard.clear();
+        } else if(isLearned) {
+            // AA of others did NOT change > N either makes it to the leaderboard or not
+            float aa = assessNotes(*features[x], *features[y]);
+            if(leaderboard.size() < static_cast<size_t>(AA_LEADERBOARD_SIZE)
+                 || isBetterAssociation(aa, y, leaderboard.back().aa, leaderboard.back().note))
+            {
+                auto target = std::find_if(
+                    leaderboard.begin(),
+                    leaderboard.end(),
+                    [aa,y](const Association& a) { return isBetterAssociation(aa, y, a.aa, a.note); });
+                leaderboard.insert(target, Association{y, aa});
+                if(leaderboard.size() > static_cast<size_t>(AA_LEADERBOARD_SIZE)) {
+                    leaderboard.pop_back();
+                }
             }
         }
     }
-
-#ifdef DO_MF_DEBUG
-    MF_DEBUG("  AA matrix built!" << endl);
-    //printAa();
-    assertAaSymmetry();
-#endif
 }
 
-float AiAaBoW::calculateSimilarityByTitles(const string& t1, const string& t2)
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::learnNote(Note* n)
 {
-    StringCharProvider cp1{t1};
-    WordFrequencyList v1{&lexicon};
-    tokenizer.tokenize(cp1, v1, false, true, false);
-    StringCharProvider cp2{t2};
-    WordFrequencyList v2{&lexicon};
-    tokenizer.tokenize(cp2, v2, false, true, false);
-
-    // calculate overlap
-    if(!v1.size() || !v2.size()) {
-        return 0.;
+    vector<u_int32_t> candidates{};
+    int i = getNoteIndex(n);
+    u_int32_t y;
+    if(i < 0) {
+        // new N
+        y = static_cast<u_int32_t>(notes.size());
+        notes.push_back(n);
+        aaLeaderboards.push_back(vector<Association>{});
+        aaCalculated.push_back(false);
+        features.push_back(nullptr);
+        n->setAiAaMatrixIndex(static_cast<int>(y));
     } else {
-        // direct access for efficiency
-        WordFrequencyList intersection{&lexicon};
-        float iWeight=0, uWeight=0;
+        // modified N > Ns which shared something w/ OLD N must be updated as well
+        y = static_cast<u_int32_t>(i);
+        collectCandidates(y, candidates);
+        unindexNote(y);
+    }
+
+    indexNote(y);
+    collectCandidates(y, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    updateCandidateRows(y, candidates, true);
+
+    aaCalculated[y] = false;
+    aaLeaderboards[y].clear();
+}
+
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::forgetNote(u_int32_t y)
+{
+    vector<u_int32_t> candidates{};
+    collectCandidates(y, candidates);
+    unindexNote(y);
+    updateCandidateRows(y, candidates, false);
+
+    // slot is NOT reused - indices are compacted when Memory is learned again
+    notes[y] = nullptr;
+    aaCalculated[y] = false;
+    aaLeaderboards[y].clear();
+    aaLeaderboards[y].shrink_to_fit();
+}
+
+void AiAaBoW::remember(Outline* outline)
+{
+    lock_guard<mutex> criticalSection{aaMutex};
+    if(!learned || !outline) {
+        return;
+    }
 
-        for(auto& e:v1.iterable()) {
-            uWeight += 1;
-            if(v2.contains(e.first)) {
-                iWeight += 1;
-                intersection.add(e.first);
+    MF_DEBUG("AA.BoW: remembering O '" << outline->getName() << "'..." << endl);
+    const vector<Note*>& outlineNotes = outline->getNotes();
+
+    // forget Ns which were deleted from O or moved to another O (pointers NOT dereferenced)
+    auto learnedNotes = outlinePostings.find(outline);
+    if(learnedNotes != outlinePostings.end()) {
+        set<const Note*> current{outlineNotes.begin(), outlineNotes.end()};
+        vector<u_int32_t> removed{};
+        for(u_int32_t i:learnedNotes->second) {
+            if(current.find(notes[i]) == current.end()) {
+                removed.push_back(i);
             }
         }
+        for(u_int32_t i:removed) {
+            forgetNote(i);
+        }
+    }
 
-        for(auto& e:v2.iterable()) {
-            if(!intersection.contains(e.first)) {
-                uWeight += 1;
-                if(v1.contains(e.first)) {
-                    iWeight += 1;
-                    // no need to update iVector as it won't be needed
-                }
-            }
+    // only new and modified Ns are (re)learned
+    for(Note* n:outlineNotes) {
+        int i = getNoteIndex(n);
+        if(i < 0
+             || features[i]->revision != n->getRevision()
+             || features[i]->modified != n->getModified()
+             || features[i]->outline != n->getOutline())
+        {
+            learnNote(n);
         }
+    }
+}
 
-        //MF_DEBUG("  titleSimilarity = "<<iWeight<<" / "<<uWeight << endl);
-        // intersection % of union
-        return (iWeight/(uWeight/100.))/100;
+void AiAaBoW::forget(Outline* outline)
+{
+    lock_guard<mutex> criticalSection{aaMutex};
+    if(!learned) {
+        return;
+    }
+
+    auto learnedNotes = outlinePostings.find(outline);
+    if(learnedNotes != outlinePostings.end()) {
+        // forgetNote() modifies posting list
+        vector<u_int32_t> removed{learnedNotes->second};
+        for(u_int32_t i:removed) {
+            forgetNote(i);
+        }
+        outlinePostings.erase(outline);
+    }
+}
+
+// intersection % of union of two SORTED sets w/o duplicates (merge w/o allocation)
+template<typename T>
+static float calculateSortedSetsSimilarity(const vector<T>& s1, const vector<T>& s2)
+{
+    size_t i1=0, i2=0, intersection=0;
+    while(i1<s1.size() && i2<s2.size()) {
+        if(s1[i1] < s2[i2]) {
+            i1++;
+        } else if(s2[i2] < s1[i1]) {
+            i2++;
+        } else {
+            intersection++;
+            i1++;
+            i2++;
+        }
+    }
+    return static_cast<float>(intersection)/static_cast<float>(s1.size()+s2.size()-intersection);
+}
+
+float AiAaBoW::calculateSimilarityByTitles(const vector<u_int32_t>& t1, const vector<u_int32_t>& t2) const
+{
+    if(t1.empty() || t2.empty()) {
+        return 0.;
+    } else {
+        return calculateSortedSetsSimilarity(t1, t2);
     }
 }
 
 // algorithm is based on similarity by words (for now there are no weights - might be added later if needed by other lib functions)
-float AiAaBoW::calculateSimilarityByTags(const vector<const Tag*>* t1, const vector<const Tag*>* t2)
+float AiAaBoW::calculateSimilarityByTags(const vector<const Tag*>& t1, const vector<const Tag*>& t2) const
 {
-    if(!t1->size()) {
-        if(!t2->size()) {
+    if(t1.empty()) {
+        if(t2.empty()) {
             return 1.;
         } else {
             return 0.;
         }
+    } else if(t2.empty()) {
+        return 0.;
     } else {
-        // direct access for efficiency
-        vector<const Tag*> intersection{};
-        float iWeight=0, uWeight=0;
-
-        // iterate at most *threshold* words from v1: all + to UNION, matching + to INTERSECTION
-        for(auto& t:*t1) {
-            uWeight += 1;
-            if(std::find(t2->begin(),t2->end(),t) != t2->end()) {
-                iWeight += 1;
-                intersection.push_back(t);
-            }
-        }
-        // uWeight contains weight of v1's tags, iWeight weight of v1 intersection v2
-
-        // iterate tags from v2: w in intersection HANDLED both u&i, w in v2&v1 > intersection else union
-        for(auto& t:*t2) {
-            if(std::find(intersection.begin(),intersection.end(),t) == intersection.end()) {
-                uWeight += 1;
-                if(std::find(t1->begin(),t1->end(),t) != t1->end()) {
-                    iWeight += 1;
-                    // no need to update iVector as it won't be needed
-                }
-            }
-        }
-
-        //MF_DEBUG("  tagSimilarity = "<<iWeight<<" / "<<uWeight << endl);
-        // intersection % of union
-        return (iWeight/(uWeight/100.))/100;
+        return calculateSortedSetsSimilarity(t1, t2);
     }
 }
 
 // consider ONLY most valuable words via threshold - many irrelevat words would kill the score (irrelevant words make noise)
-float AiAaBoW::calculateSimilarityByWords(WordFrequencyList& v1, WordFrequencyList& v2, int threshold)
+float AiAaBoW::calculateSimilarityByWords(const NoteFeatures& v1, const NoteFeatures& v2, int threshold) const
 {
-    if(!v1.size() || !v2.size()) {
+    if(v1.words.empty() || v2.words.empty()) {
         return 0.;
     } else {
         // direct access for efficiency
-        WordFrequencyList intersection{&lexicon};
+        vector<u_int32_t> intersection{};
         float iWeight=0, uWeight=0;
         int t=0;
 
         // iterate at most *threshold* words from v1: all + to UNION, matching + to INTERSECTION
-        for(auto& e:v1.iterable()) {
+        for(auto& e:v1.topWords) {
             if(t++>=threshold) break;
 
-            float w = lexicon.get(e.first)->weight;
+            float w = e.second;
             uWeight += w;
-            if(v2.contains(e.first)) {
+            if(v2.containsWord(e.first)) {
                 iWeight += w;
-                intersection.add(e.first);
+                intersection.push_back(e.first);
             }
         }
         // uWeight contains weight of 1st 10 v1's words, iWeight weight of v1 intersection v2
 
         // iterate at most *threshold* words from v2: w in intersection HANDLED both u&i, w in v2&v1 > intersection else union
         t=0;
-        for(auto& e:v2.iterable()) {
+        for(auto& e:v2.topWords) {
             // consider at most threshold words from v2
             if(++t>=threshold) break;
 
-            if(!intersection.contains(e.first)) {
-                float w = lexicon.get(e.first)->weight;
+            if(std::find(intersection.begin(), intersection.end(), e.first) == intersection.end()) {
+                float w = e.second;
                 uWeight += w;
-                if(v1.contains(e.first)) {
+                if(v1.containsWord(e.first)) {
                     iWeight += w;
                     // no need to update iVector as it won't be needed
                 }
@@ -409,112 +585,95 @@ float AiAaBoW::calculateSimilarityByWords(WordFrequencyList& v1, WordFrequencyLi
     }
 }
 
-bool AiAaBoW::calculateLeaderboardSync(const Note* n, thread* t)
+bool AiAaBoW::calculateLeaderboardSync(const Note* n, int i, bool cancelled)
 {
-    MF_DEBUG("AA.BoW: SYNC leaderboard calculation for '" << n->getName() << "' in thread " << t << endl);
-
-    // If N was REMOVED, then nobody will ask for leaderboard.
-    // If N was MODIFIED, then leaderboard will not be accurate (but it's not critical).
-    // If N was ADDED, then I don't have data - no leaderboard provided.
-    if(n->getAiAaMatrixIndex() != AA_NOT_SET) {
-        // check cache
-        auto cachedLeaderboard = leaderboardCache.find(n);
-        if(cachedLeaderboard != leaderboardCache.end()) {
-            return true;
+    MF_DEBUG("AA.BoW: SYNC leaderboard calculation for N #" << i << (cancelled?" CANCELLED":"") << endl);
+
+    for(int attempt=0; !cancelled && attempt<AA_LEADERBOARD_ATTEMPTS; attempt++) {
+        u_int32_t y;
+        u_int64_t snapshotGeneration;
+        shared_ptr<const NoteFeatures> f{};
+        vector<pair<u_int32_t,shared_ptr<const NoteFeatures>>> candidates{};
+        {
+            lock_guard<mutex> criticalSection{aaMutex};
+
+            // N might be forgotten (and deleted) or Memory relearned since the task was
+            // submitted > N is NOT dereferenced, it's only checked to be still on its index
+            if(i < 0 || static_cast<size_t>(i) >= notes.size() || notes[i] != n || aaCalculated[i]) {
+                break;
+            }
+
+            // snapshot: features are immutable, therefore sharing them is enough
+            y = static_cast<u_int32_t>(i);
+            snapshotGeneration = generation;
+            f = features[y];
+            vector<u_int32_t> c{};
+            collectCandidates(y, c);
+            candidates.reserve(c.size());
+            for(u_int32_t x:c) {
+                candidates.push_back(make_pair(x, features[x]));
+            }
         }
 
-        // calculate row/column of AA matrix & build leaderboard
-        calculateAaRow(n->getAiAaMatrixIndex());
+        // scoring w/o critical section - remember() and getAssociatedNotes() are NOT blocked
+        vector<Association> leaderboard{};
+        calculateAaLeaderboard(*f, candidates, leaderboard);
 
-        int aaLeaderboard[AA_LEADERBOARD_SIZE][2];
-        for(int i=0; i<AA_LEADERBOARD_SIZE; i++) {
-            aaLeaderboard[i][0] = aaLeaderboard[i][1] = AA_NOT_SET;
-        }
+        {
+            lock_guard<mutex> criticalSection{aaMutex};
 
-        float aa;
-        for(size_t x=0, y=n->getAiAaMatrixIndex(); x<notes.size(); x++) {
-            if(x==y) continue; // self on diagonal
-
-            aa = aaMatrix[x][y];
-
-            if(aa > aaLeaderboard[AA_LEADERBOARD_SIZE-1][0]) { // covers also lb[][]==NOT_SET (== -1)
-                // find target leaderboard row
-                size_t target;
-                for(target=0; target<AA_LEADERBOARD_SIZE; target++) {
-                    if(aaLeaderboard[target][0] == AA_NOT_SET) {
-                        break; // fill empty row -> no shift needed
-                    } else {
-                        if(aa > aaMatrix[aaLeaderboard[target][0]][aaLeaderboard[target][1]]) {
-                            break;
-                        }
-                    }
-                }
+            // Ns (re)learned/forgotten meanwhile > leaderboard might be stale
+            if(generation == snapshotGeneration) {
+                aaLeaderboards[y].swap(leaderboard);
+                aaCalculated[y] = true;
 
-                /// empty row > no shift needed
-                if(aaLeaderboard[target][0] != AA_NOT_SET) {
-                    // shift leaderboard
-                    int sx = aaLeaderboard[target][0];
-                    int sy = aaLeaderboard[target][1];
-                    for(size_t ll=target; ll<AA_LEADERBOARD_SIZE; ll++) {
-                        if(aaLeaderboard[ll][0]!=AA_NOT_SET) {
-                            int tx=aaLeaderboard[ll][0];
-                            int ty=aaLeaderboard[ll][1];
-                            aaLeaderboard[ll][0]=sx;
-                            aaLeaderboard[ll][1]=sy;
-                            sx=tx;
-                            sy=ty;
-                        } else {
-                            aaLeaderboard[ll][0]=sx;
-                            aaLeaderboard[ll][1]=sy;
-                            break;
-                        }
-                    }
+#ifdef DO_MF_DEBUG
+                MF_DEBUG("Leaderboard of " << notes[y]->getName() << " (" << notes[y]->getOutline()->getName() << "):" << endl);
+                for(size_t i=0; i<aaLeaderboards[y].size(); i++) {
+                    const Association& a = aaLeaderboards[y][i];
+                    MF_DEBUG("  #" << i << " " <<
+                             notes[a.note]->getName() << " (" << notes[a.note]->getOutline()->getName() << ")" <<
+                             " ~ " << a.aa << endl);
                 }
-
-                // assign value
-                aaLeaderboard[target][0]=x;
-                aaLeaderboard[target][1]=y;
+#endif
+                break;
             }
+            MF_DEBUG("AA.BoW: leaderboard of N #" << y << " DISCARDED (Ns modified meanwhile)" << endl);
         }
+    }
 
-        MF_DEBUG("Leaderboard of " << n->getName() << " (" << n->getOutline()->getName() << "):" << endl);
-        vector<pair<Note*,float>> leaderboard{};
-        for(int i=0; i<AA_LEADERBOARD_SIZE && aaLeaderboard[i][0]!=AA_NOT_SET; i++) {
-            MF_DEBUG("  #" << i << " " <<
-                     notes[aaLeaderboard[i][0]]->getName() << " (" << notes[aaLeaderboard[i][0]]->getOutline()->getName() << ")" <<
-                     " ~ " << aaMatrix[aaLeaderboard[i][0]][aaLeaderboard[i][1]] << endl);
-            leaderboard.push_back(std::make_pair(notes[aaLeaderboard[i][0]],aaMatrix[aaLeaderboard[i][0]][aaLeaderboard[i][1]]));
-        }
-
-        // cache leaderboard (copied)
-        leaderboardCache[n] = leaderboard;
+    {
+        lock_guard<mutex> criticalSection{aaMutex};
+        leaderboardWip.erase(n);
     }
 
-    leaderboardWip.erase(n);
     mind.decActiveProcesses();
-    if(t) t->detach(); // indicate that thread finished
-    return true;
+    return !cancelled;
 }
 
-void AiAaBoW::assertAaSymmetry()
+// This is a private method called from AI ~ AI state/async/critical sections handled by caller.
+void AiAaBoW::clearDataSets()
 {
-    MF_DEBUG("AI: checking AA symmetry..." << endl);
-    for(size_t i=0; i<aaMatrix.size(); ++i) {
-        for(size_t j=0; i<aaMatrix.size(); ++i) {
-            if(aaMatrix[i][j] != aaMatrix[j][i]) {
-                MF_DEBUG("  Symmetry ERROR: aa["<<i<<"]["<<j<<"]" << endl);
-            }
-        }
-    }
-    MF_DEBUG("AI: AA symmetry checked!" << endl);
+    lexicon.clear();
+    notes.clear();
+    outlines.clear();
+
+    aaLeaderboards.clear();
+    aaCalculated.clear();
+    wordPostings.clear();
+    tagPostings.clear();
+    outlinePostings.clear();
+    features.clear();
+    titleLexicon.clear();
+    generation++;
+
+    learned = false;
 }
 
 // it's presumed that caller ensures the correct Mind state & synchronization
 bool AiAaBoW::sleep() {
-    lexicon.clear();
-    notes.clear();
-    outlines.clear();
-    bow.clear();
+    lock_guard<mutex> criticalSection{aaMutex};
+    clearDataSets();
 
     return true;
 }
@@ -522,7 +681,6 @@ bool AiAaBoW::sleep() {
 // it's presumed that caller ensures the correct Mind state & synchronization
 bool AiAaBoW::amnesia() {
     sleep();
-    aaMatrix.clear();
 
     return true;
 }
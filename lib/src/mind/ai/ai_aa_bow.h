@@ -20,12 +20,15 @@
 #define M8R_AI_ASSOCIATIONS_ASSESSMENT_BOW_H
 
 #include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "../mind.h"
+#include "../../gear/thread_pool.h"
 #include "ai_aa.h"
 #include "./nlp/markdown_tokenizer.h"
 #include "./nlp/note_char_provider.h"
-#include "./nlp/bag_of_words.h"
 #include "./nlp/common_words_blacklist.h"
 
 namespace m8r {
@@ -41,10 +44,11 @@ class Mind;
 class AiAaBoW : public AiAssociationsAssessment
 {
 private:
-    static constexpr int THREAD_POOL_SIZE = 2; // IMPROVE thread pool size to be either configured OR #CPU detected and 1/2 or 1/3 used
     static constexpr float AA_NOT_SET = -1.f;
     static constexpr int AA_WORD_RELEVANCY_THRESHOLD = 10; // use 10 words w/ highest weight from vectors (and ignore others - irrelevant can bring noice with volume)
     static constexpr float AA_TITLE_WORD_BONUS = 0.2f;
+    // leaderboard calculated while Ns were (re)learned is discarded and calculated again
+    static constexpr int AA_LEADERBOARD_ATTEMPTS = 3;
 
 private:
     Mind& mind;
@@ -52,8 +56,10 @@ private:
 
     Lexicon lexicon; // IMPROVE merge Standford GloVe word vectors (https://nlp.stanford.edu/projects/glove/)
     CommonWordsBlacklist wordBlacklist;
-    BagOfWords bow;
     MarkdownTokenizer tokenizer;
+    // title words are kept aside so that they don't skew description word weights
+    Lexicon titleLexicon;
+    MarkdownTokenizer titleTokenizer;
 
     /*
      * Data sets
@@ -68,18 +74,65 @@ private:
      * Associations
      */
 
+    struct Association {
+        u_int32_t note;
+        float aa;
+    };
+
+    // N features as learned - features are immutable (re)learned N gets new features,
+    // therefore leaderboards are calculated by workers from snapshots w/o critical section
+    struct NoteFeatures {
+        const NoteType* type;
+        const Outline* outline;
+        // N version which was learned
+        u_int32_t revision;
+        time_t modified;
+        // tag and title vectors are SORTED so that similarity is a merge of two arrays
+        std::vector<const Tag*> tags;
+        std::vector<u_int32_t> titleWords;
+        // description words ordered by word ID (lookups, lexicon frequencies)
+        std::vector<WordFrequencyList::Term> words;
+        // AA_WORD_RELEVANCY_THRESHOLD most weighted description words w/ weights (descending)
+        std::vector<std::pair<u_int32_t,float>> topWords;
+
+        bool containsWord(u_int32_t id) const {
+            return std::binary_search(
+                words.begin(), words.end(), WordFrequencyList::Term{id,0},
+                [](const WordFrequencyList::Term& t1, const WordFrequencyList::Term& t2) { return t1.id < t2.id; });
+        }
+    };
+
     // associate Ns as you READ: N -> O/N
-    // IMPROVE thing*,float - both O and N to be association
-    std::map<const Note*,std::vector<std::pair<Note*,float>>> leaderboardCache;
+    //
+    // Sparse associations assessment: N index -> top AA_LEADERBOARD_SIZE associations
+    // ordered by AA (descending). Rows are calculated lazily (on N leaderboard request)
+    // from candidate Ns only and then maintained incrementally as Ns are (re)learned,
+    // therefore memory grows linearly w/ the number of Ns (unlike N x N matrix).
+    std::vector<std::vector<Association>> aaLeaderboards;
+    std::vector<bool> aaCalculated;
     std::set<const Note*> leaderboardWip;
+    // the last submitted leaderboard calculation (cancelled when user moves to other N)
+    TaskHandle leaderboardTask;
+    const Note* leaderboardTaskNote;
 
     // associate as you WRITE: word(s) -> O/N
     // IMPROVE std::map<const Note*,std::vector<std::pair<string*,float>>> leaderboardCache;
 
-    // Associations assessment matrix w/ rankings for any N1/N2 tuple (diagonal symmetry).
-    // Changed from float** to vector<vector>> to enable row/col extension on new N/O
-    // (keep & avoid realloc)
-    std::vector<std::vector<float>> aaMatrix; // IMPROVE: notesAA and outlinesAA ~ Notes assocications assessment
+    // Candidate generation: Ns which do NOT share a word, tag or O have (almost)
+    // no association, therefore only Ns from posting lists are assessed.
+    // Posting lists are SORTED by N index.
+    std::vector<std::vector<u_int32_t>> wordPostings; // indexed by word ID
+    std::unordered_map<const Tag*,std::vector<u_int32_t>> tagPostings;
+    std::unordered_map<const Outline*,std::vector<u_int32_t>> outlinePostings;
+    // N's features at the time N was learned (N might be deleted since then) - nullptr if forgotten
+    std::vector<std::shared_ptr<NoteFeatures>> features;
+
+    // guards data sets and associations - leaderboards are scored by workers OUTSIDE
+    // of the critical section (snapshot > score > publish if generation didn't change)
+    std::mutex aaMutex;
+    // incremented whenever Ns are (re)learned or forgotten
+    u_int64_t generation;
+    bool learned;
 
 public:
     explicit AiAaBoW(Memory& memory, Mind& mind);
@@ -121,36 +174,27 @@ public:
         return std::shared_future<bool>(p.get_future());
     }
 
-    virtual bool sleep();
+    virtual void remember(Outline* outline);
 
-    virtual bool amnesia();
+    virtual void forget(Outline* outline);
 
-private:
-
-    /*
-     * Worker threads:
-     *  1. packaged task is assigned to thread
-     *  2. thread performs the task and calls detach() on self when finishes
-     *     to indicate that it's ready to be deleted
-     *  3. if main thread detects that !thread.joinable(), then it can be deleted;
-     *     cleanup is done on any new thread launch AND/OR by this class destructor.
-     */
+    virtual bool sleep();
 
-    // IMPROVE introduce a LIMIT on number of running threads in configuration
-    std::vector<std::thread*> runningWorkers;
-    std::mutex runningWorkersMutex;
+    virtual bool amnesia();
 
 private:
 
     /**
      * @brief Learn Memory to start thinking.
      */
-    bool learnMemorySync(std::thread* t = nullptr);
+    bool learnMemorySync();
 
     /**
-     * @brief Calculate leaderboard and indicate that it has been stored to cache.
+     * @brief Calculate leaderboard (unless cancelled) and indicate that it has been stored.
+     *
+     * N index i is taken when the calculation is requested, N itself is NOT dereferenced.
      */
-    bool calculateLeaderboardSync(const Note* n, std::thread* t = nullptr);
+    bool calculateLeaderboardSync(const Note* n, int i, bool cancelled=false);
 
     /**
      * @brief Initialize blacklist using common words.
@@ -161,66 +205,80 @@ private:
     void initializeWordBlacklist();
 
     /**
-     * @brief Precalculate entire AA.
-     *
-     * LONG running method.
+     * @brief Clear data sets and associations.
      */
-    void precalculateAa();
+    void clearDataSets();
 
     /**
-     * @brief Calculate AA row/column cross i.e. associations of N with *all* other Ns.
-     *
-     * LONG running method on bigger repositories.
+     * @brief Get N index in data sets or -1 if N is not learned.
      */
-    void calculateAaRow(size_t y);
+    int getNoteIndex(const Note* n) const;
 
     /**
-     * @brief Calculate similarity of two word vectors.
+     * @brief Tokenize N to features and add it to posting lists.
      */
-    float calculateSimilarityByWords(WordFrequencyList& v1, WordFrequencyList& v2, int threshold=1000);
+    void indexNote(u_int32_t i);
 
     /**
-     * @brief Calculate similarity of two tag lists.
+     * @brief Remove N from posting lists and lexicon (N is NOT dereferenced).
      */
-    float calculateSimilarityByTags(const std::vector<const Tag*>* t1, const std::vector<const Tag*>* t2);
+    void unindexNote(u_int32_t i);
 
     /**
-     * @brief Calculate similarity of two N/O names.
+     * @brief Pick the most weighted N description words.
      */
-    float calculateSimilarityByTitles(const std::string& t1, const std::string& t2);
+    void rankWords(NoteFeatures& f) const;
 
     /**
-     * @brief Check AA matrix symmetry.
+     * @brief Collect Ns sharing a word, tag or O w/ given N.
      */
-    void assertAaSymmetry();
+    void collectCandidates(u_int32_t y, std::vector<u_int32_t>& candidates);
 
     /**
-     * @brief Get AA leaderboard from cache.
+     * @brief (Re)learn N: update rows which (might) associate it and invalidate its own row.
      */
-    bool getCachedLeaderboard(const Note* n, std::vector<std::pair<Note*,float>>& leaderboard);
+    void learnNote(Note* n);
 
     /**
-     * @brief Remove finished workers and add new one.
+     * @brief Forget N: invalidate rows which associate it.
      */
-    void addWorkerAndCleanZombies(std::thread* t);
+    void forgetNote(u_int32_t y);
 
-public:
-#ifdef DO_MF_DEBUG
-    void printAa() {
-        std::cout << "AA Matrix:" << std::endl;
-        for(size_t i=0; i<aaMatrix.size(); i++) {
-            std::cout << "AA[" << i << "] = ";
-            for(size_t j=0; j<aaMatrix.size(); j++) {
-                if(aaMatrix[i][j] == -1) {
-                    std::cout << "_ ";
-                } else {
-                    std::cout << aaMatrix[i][j] << " ";
-                }
-            }
-            std::cout << std::endl;
-        }
-    }
-#endif
+    /**
+     * @brief Update calculated rows of candidates after N (y) was changed.
+     */
+    void updateCandidateRows(u_int32_t y, const std::vector<u_int32_t>& candidates, bool isLearned);
+
+    /**
+     * @brief Calculate top associations of N from features snapshot.
+     *
+     * LONG running method on bigger repositories (depends on the number of candidates),
+     * it does NOT access data sets and therefore it's called outside of critical section.
+     */
+    void calculateAaLeaderboard(
+            const NoteFeatures& y,
+            const std::vector<std::pair<u_int32_t,std::shared_ptr<const NoteFeatures>>>& candidates,
+            std::vector<Association>& leaderboard) const;
+
+    /**
+     * @brief Assess association of two learned Ns.
+     */
+    float assessNotes(const NoteFeatures& x, const NoteFeatures& y) const;
+
+    /**
+     * @brief Calculate similarity of two word vectors.
+     */
+    float calculateSimilarityByWords(const NoteFeatures& v1, const NoteFeatures& v2, int threshold=1000) const;
+
+    /**
+     * @brief Calculate similarity of two SORTED tag lists.
+     */
+    float calculateSimilarityByTags(const std::vector<const Tag*>& t1, const std::vector<const Tag*>& t2) const;
+
+    /**
+     * @brief Calculate similarity of two N/O names given by SORTED title word IDs.
+     */
+    float calculateSimilarityByTitles(const std::vector<u_int32_t>& t1, const std::vector<u_int32_t>& t2) const;
 };
 
 }
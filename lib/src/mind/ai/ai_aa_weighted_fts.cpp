@@ -178,34 +178,27 @@ vector<pair<Note*,float>>* AiAaWeightedFts::assessNotesWithFallback(const string
 
 void AiAaWeightedFts::assessNotesInOutline(Outline* outline, vector<pair<Note*,float>>* result, vector<string>& regexps, const bool ignoreCase)
 {
-    // IMPROVE make this faster - do NOT convert to lower case, but compare it in that method > will do less
     if(ignoreCase) {
-        // case INSENSITIVE
+        // case INSENSITIVE: regexps are lowercase, text is case folded while searched
 
         // O matches
         float oScore = 0.f;
-        string s{};
         // O.title matches
-        stringToLower(outline->getName(), s);
         for(auto& regexp:regexps) {
-            if(s.find(regexp)!=string::npos) {
+            if(stringFindIgnoreCase(outline->getName(), regexp)!=string::npos) {
                 oScore += 100.f;
             }
         }
         // O.description matches
         float matches = 0.f;
-        for(string* d:outline->getDescription()) {
-            if(d) {
-                s.clear();
-                stringToLower(*d, s);
-                for(auto& regexp:regexps) {
-                    // find all matches (regexp matched more than once)
-                    size_t m = s.find(regexp, 0);
-                    while(m != string::npos) {
-                        matches++;
-                        m = s.find(regexp,m+1);
-                    }
-                }
+        // lines are newline terminated > matches never span lines
+        const string& od = outline->getDescription().getText();
+        for(auto& regexp:regexps) {
+            // find all matches (regexp matched more than once)
+            size_t m = stringFindIgnoreCase(od, regexp, 0);
+            while(m != string::npos) {
+                matches++;
+                m = stringFindIgnoreCase(od, regexp, m+1);
             }
         }
         if(matches != 0.f) {
@@ -226,27 +219,20 @@ void AiAaWeightedFts::assessNotesInOutline(Outline* outline, vector<pair<Note*,f
                 continue;
             }
             // N.title matches
-            s.clear();
-            stringToLower(note->getName(), s);
             for(auto& regexp:regexps) {
-                if(s.find(regexp)!=string::npos) {
+                if(stringFindIgnoreCase(note->getName(), regexp)!=string::npos) {
                     nScore += 100.f;
                 }
             }
             // N.description matches
             float matches=0.;
-            for(string* d:note->getDescription()) {
-                if(d) {
-                    s.clear();
-                    stringToLower(*d, s);
-                    for(auto& regexp:regexps) {
-                        // find them all
-                        size_t m = s.find(regexp, 0);
-                        while(m != string::npos) {
-                            matches++;
-                            m = s.find(regexp,m+1);
-                        }
-                    }
+            const string& nd = note->getDescription().getText();
+            for(auto& regexp:regexps) {
+                // find them all
+                size_t m = stringFindIgnoreCase(nd, regexp, 0);
+                while(m != string::npos) {
+                    matches++;
+                    m = stringFindIgnoreCase(nd, regexp, m+1);
                 }
             }
             if(nScore!=0.f || matches!=0.f) {
@@ -82,6 +82,10 @@ public:
 
     virtual std::shared_future<bool> getAssociatedNotes(const std::string& words, std::vector<std::pair<Note*,float>>& associations, const Note* self);
 
+    // FTS is evaluated on demand - nothing to maintain
+    virtual void remember(Outline* outline) { UNUSED_ARG(outline); }
+    virtual void forget(Outline* outline) { UNUSED_ARG(outline); }
+
     virtual bool sleep() {
         notes.clear();
         return true;
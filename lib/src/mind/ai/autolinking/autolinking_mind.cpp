@@ -28,15 +28,15 @@ using namespace std;
 
 AutolinkingMind::AutolinkingMind(Mind& mind)
     : mind{mind},
-      trie{nullptr}
+      automaton{nullptr}
 {
 }
 
 AutolinkingMind::~AutolinkingMind()
 {
-    if(trie) {
-        delete trie;
-        trie = nullptr;
+    if(automaton) {
+        delete automaton;
+        automaton = nullptr;
     }
 }
 
@@ -50,7 +50,7 @@ void AutolinkingMind::updateTrieIndex()
     // IMPROVE update indices only if an O/N is modified (except writing read timestamps)
 
 #ifdef DO_MF_DEBUG
-    MF_DEBUG("[Autolinking] Rebuilding trie index..." << endl);
+    MF_DEBUG("[Autolinking] Rebuilding automaton index..." << endl);
     auto begin = chrono::high_resolution_clock::now();
     int size{};
 #endif
@@ -78,9 +78,12 @@ void AutolinkingMind::updateTrieIndex()
 
     // IMPROVE: add also tags
 
+    // compiled here (writer) > searches are read-only and thread safe
+    automaton->compile();
+
 #ifdef DO_MF_DEBUG
     auto end = chrono::high_resolution_clock::now();
-    MF_DEBUG("[Autolinking] trie w/ " << size << " things updated in: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
+    MF_DEBUG("[Autolinking] automaton w/ " << size << " things updated in: " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000000.0 << "ms" << endl);
 #endif
 }
 
@@ -93,17 +96,17 @@ string AutolinkingMind::getLowerName(const std::string& name)
 
 void AutolinkingMind::addThingToTrie(const Thing *t) {
     // name
-    trie->addWord(t->getAutolinkingName());
+    automaton->addWord(t->getAutolinkingName());
     // name w/ lowercase 1st letter
-    trie->addWord(getLowerName(t->getAutolinkingName()));
+    automaton->addWord(getLowerName(t->getAutolinkingName()));
     // abbrev (if present)
-    trie->addWord(t->getAutolinkingAbbr());
+    automaton->addWord(t->getAutolinkingAbbr());
 }
 
 void AutolinkingMind::removeThingFromTrie(const Thing *t) {
-    trie->removeWord(t->getAutolinkingName());
-    trie->removeWord(getLowerName(t->getAutolinkingName()));
-    trie->removeWord(t->getAutolinkingAbbr());
+    automaton->removeWord(t->getAutolinkingName());
+    automaton->removeWord(getLowerName(t->getAutolinkingName()));
+    automaton->removeWord(t->getAutolinkingAbbr());
 }
 
 void AutolinkingMind::update(const std::string& oldName, const std::string& newName)
@@ -119,17 +122,43 @@ void AutolinkingMind::update(const std::string& oldName, const std::string& newN
             Thing t{newName};
             addThingToTrie(&t);
         }
+        automaton->compile();
     }
 
     MF_DEBUG("DONE autolink update: '" << oldName << "' > '" << newName << "'" << endl);
 }
 
+void AutolinkingMind::remember(const Outline* outline)
+{
+    if(!automaton) {
+        return;
+    }
+    addThingToTrie(outline);
+    for(const Note* n:outline->getNotes()) {
+        addThingToTrie(n);
+    }
+    automaton->compile();
+}
+
+void AutolinkingMind::forget(const Outline* outline)
+{
+    if(!automaton) {
+        return;
+    }
+    removeThingFromTrie(outline);
+    for(const Note* n:outline->getNotes()) {
+        removeThingFromTrie(n);
+    }
+    automaton->compile();
+}
+
 void AutolinkingMind::clear()
 {
-    if(trie) {
-        delete trie;
+    if(automaton) {
+        automaton->clear();
+    } else {
+        automaton = new AhoCorasick{};
     }
-    trie = new Trie{};
 
     MF_DEBUG("[Autolinking] indices CLEARed" << endl);
 }
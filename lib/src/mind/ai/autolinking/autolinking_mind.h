@@ -26,7 +26,8 @@
 
 #include "../../../debug.h"
 #include "../../ontology/thing_class_rel_triple.h"
-#include "../../../gear/trie.h"
+#include "../../../model/outline.h"
+#include "../../../gear/aho_corasick.h"
 
 namespace m8r {
 
@@ -40,7 +41,7 @@ class AutolinkingMind
 private:
     Mind& mind;
 
-    Trie* trie;
+    AhoCorasick* automaton;
 
 public:
     explicit AutolinkingMind(Mind& mind);
@@ -51,7 +52,7 @@ public:
     ~AutolinkingMind();
 
     /**
-     * @brief Rebuild indices (like trie) e.g. on new MD/repository load.
+     * @brief Rebuild indices (like automaton) e.g. on new MD/repository load.
      */
     void reindex() {
         updateTrieIndex();
@@ -62,11 +63,40 @@ public:
      */
     void update(const std::string& oldName, const std::string& newName);
 
+    /**
+     * @brief Add O and its Ns to indices.
+     */
+    void remember(const Outline* outline);
+
+    /**
+     * @brief Remove O and its Ns from indices.
+     *
+     * Names are reference counted > name shared w/ another thing is kept.
+     */
+    void forget(const Outline* outline);
+
     /**
      * @brief Find longest autolinking match.
      */
     bool findLongestPrefixWord(std::string& s, std::string& r) const {
-        return trie->findLongestPrefixWord(s, r);
+        return automaton->findLongestPrefixWord(s, r);
+    }
+
+    /**
+     * @brief Find leftmost longest whole word autolinking matches in one pass over the text.
+     */
+    void findMatches(
+            const std::string& text,
+            const std::string& delimiters,
+            std::vector<AhoCorasick::Match>& matches) const {
+        automaton->findWholeWords(text.c_str(), text.size(), delimiters, matches);
+    }
+
+    /**
+     * @brief Fingerprint of indexed names.
+     */
+    u_int64_t getFingerprint() const {
+        return automaton->getFingerprint();
     }
 
     /**
@@ -83,17 +113,17 @@ protected:
     static std::string getLowerName(const std::string& name);
 
     /**
-     * @brief Update trie-based Os and Ns names index.
+     * @brief Update automaton-based Os and Ns names index.
      */
     void updateTrieIndex();
 
     /**
-     * @brief Add thing's name (and abbrev) to trie.
+     * @brief Add thing's name (and abbrev) to automaton.
      */
     void addThingToTrie(const Thing *t);
 
     /**
-     * @brief Remove thing's name (and abbrev) from trie.
+     * @brief Remove thing's name (and abbrev) from automaton.
      */
     void removeThingFromTrie(const Thing *t);
 };
@@ -55,15 +55,8 @@
  *    - blacklist ~ don't autolink e.g. http (to protect cmark's URLs autolinking)
  *
  * - performance
- *    - avoid trie rebuild - on N save():
- *      ! implement delete operation on trie:
- *       - enhance trie w/ refcount for words so that delete knows whether to remove or not
- *       - implement delete() operation:
- *        - finds word mark, decreases refcount, if it's leaf than it goes up deletes orphan
- *      OR:
- *      1) synchronous: add new N name to trie on its save()
- *      2) async: after save let trie rebuild async in other
- *         thread to update it (trie access must be synchronized)
+ *    - DONE avoid trie rebuild - on N save(): automaton words are reference counted
+ *      and added/removed on rename
  *    - avoid autolinking whole O on its load - it's not needed > debug why it happens
  *    - map search structure instead of Aho
  *    - benchmark on C++ repo
@@ -125,10 +118,8 @@ cmark_node* injectAstTxtNode(
 
 void injectThingsLinks(cmark_node* srcNode, Mind& mind)
 {
-    // copy w to t as it will be chopped word/match by word/match from head to tail
     string txt{cmark_node_get_literal(srcNode)};
-    string pre{}, at{}, chop{};
-    size_t preSize{};
+    string at{}, link{};
 
     cmark_node* node{};
 
@@ -136,131 +127,33 @@ void injectThingsLinks(cmark_node* srcNode, Mind& mind)
     MF_DEBUG("[Autolinking] Injecting links to: '" << txt << "'" << endl);
 #endif
 
-    while(txt.size()>0) {
-        // skip trailing chars and append them
-        preSize = 0;
-        while(preSize < txt.size()) {
-            // check $$ to detect begin/end of math (MathJax) section to ignore it
-            if(txt.size()>=2 && '$'==txt.at(0) && '$'==txt.at(1)) {
-                MF_DEBUG("MATH matched" << endl);
-                // TODO toggle math
-                preSize+=2;
-                if(txt.size()==2) {
-                    break;
-                }
-            }
-
-            if(CmarkAhoCorasickBlockAutolinkingPreprocessor::TRAILING_CHARS.find(txt.at(preSize)) != string::npos) {
-                preSize++;
-            } else {
-                break;
-            }
-        }
-        if(preSize) {
-            // chop trailing chars prefix from input and append it to result
-            at.append(txt.substr(0, preSize));
-            txt = txt.substr(preSize);
-
-            MF_DEBUG("  Skipping trailing chars: '" << txt.substr(0, preSize) << "'" << endl);
-            MF_DEBUG("     txt: '" << txt << "'" << endl);
-            MF_DEBUG("     at : '" << at  << "'" << endl);
+    // whole word matches found by automaton in one pass over the text
+    vector<AhoCorasick::Match> matches{};
+    mind.autolinkFindMatches(
+        txt,
+        CmarkAhoCorasickBlockAutolinkingPreprocessor::TRAILING_CHARS,
+        matches);
+
+    size_t offset{};
+    for(const AhoCorasick::Match& m:matches) {
+        MF_DEBUG("    Matched: '" << txt.substr(m.offset, m.size) << "'" << endl);
+
+        // AST: add text node w/ content preceding link
+        if(m.offset > offset) {
+            at.assign(txt, offset, m.offset-offset);
+            node = injectAstTxtNode(srcNode, node, at);
         }
 
-        // try to match word
-        pre.clear();
-
-        MF_DEBUG("  Trie search txt: '" << txt << "'" << endl);
-        if(mind.autolinkFindLongestPrefixWord(txt, pre)) {
-            MF_DEBUG("    Matched prefix: '" << pre << "'" << endl);
-
-            // avoid word PREFIX matches ~ ensure that WHOLE world is matched:
-            // - match followed by trailing char
-            // - match until EOL
-
-            // determine trailing char
-            char tChar{txt.size()==pre.size()?' ':txt.at(pre.size())};
-            MF_DEBUG("    Match's trailing char: '" << tChar << "'" << endl);
-            if(CmarkAhoCorasickBlockAutolinkingPreprocessor::TRAILING_CHARS.find(tChar) != string::npos
-               || txt.size() == pre.size()
-            ) {
-                // AST: add text node w/ content preceding link
-                // IMPROVE make this method
-                if(at.size()) {
-                    node = injectAstTxtNode(srcNode, node, at);
-                }
-
-                // AST: add link
-                node = injectAstLinkNode(srcNode, node, pre);
-
-                // chop linked prefix word from input word w
-                if(txt.size() == pre.size()) {
-                    txt.clear();
-                } else {
-                    txt = txt.substr(pre.size());
-                }
-                // trailing char will be handled later
-                at.clear();
-
-                MF_DEBUG("    txt: '" << txt << "'" << endl);
-                MF_DEBUG("    at : '" << at  << "'" << endl);
-            } else {
-                // invalid trailing char > matched a NOT-whole-world prefix > skip and append one word
-
-                // TODO make it method
-                // current w prefix was NOT linked > chop it and append it
-                size_t begin = txt.find_first_of(" \t");
-                if(begin != string::npos) {
-                    chop = txt.substr(0, begin);
-                    txt = txt.substr(begin+1);
-                    at.append(chop);
-                    // TODO IMPORTANT append what was found - space or tab! simply index there
-                    at.append(" ");
-
-                    MF_DEBUG("  Skiping word: '" << chop << "'" << endl);
-                    MF_DEBUG("     txt: '" << txt << "'" << endl);
-                    MF_DEBUG("     at : '" << at  << "'" << endl);
-                } else {
-                    // no more words (prefix already checked) > DONE
-                    at.append(txt);
-
-                    MF_DEBUG("  DONE no-more words: '" << chop << "'" << endl);
-                    MF_DEBUG("     txt: '" << txt << "'" << endl);
-                    MF_DEBUG("     at : '" << at  << "'" << endl);
-
-                    break;
-                }
-            }
-        } else {
-            // didn't match prefix > skip and append one word
-
-            // TODO make it method
-            // current w prefix was NOT linked > chop it and append it
-            size_t begin = txt.find_first_of(" \t");
-            if(begin != string::npos) {
-                chop = txt.substr(0, begin);
-                txt = txt.substr(begin+1);
-                at.append(chop);
-                // TODO IMPORTANT append what was found - space or tab! simply index there
-                at.append(" ");
-
-                MF_DEBUG("  Skiping word: '" << chop << "'" << endl);
-                MF_DEBUG("     txt: '" << txt << "'" << endl);
-                MF_DEBUG("     at : '" << at  << "'" << endl);
-            } else {
-                // no more words (prefix already checked) > DONE
-                at.append(txt);
-
-                MF_DEBUG("  DONE no-more words: '" << chop << "'" << endl);
-                MF_DEBUG("     txt: '" << txt << "'" << endl);
-                MF_DEBUG("     at : '" << at  << "'" << endl);
-
-                break;
-            }
-        }
+        // AST: add link
+        link.assign(txt, m.offset, m.size);
+        node = injectAstLinkNode(srcNode, node, link);
+
+        offset = m.offset+m.size;
     }
 
-    // AST: add text node w/ content preceding link
-    if(at.size()) {
+    // AST: add text node w/ content following the last link
+    if(offset < txt.size()) {
+        at.assign(txt, offset, string::npos);
         node = injectAstTxtNode(srcNode, node, at);
     }
 }
@@ -281,7 +174,7 @@ CmarkAhoCorasickBlockAutolinkingPreprocessor::~CmarkAhoCorasickBlockAutolinkingP
 }
 
 void CmarkAhoCorasickBlockAutolinkingPreprocessor::process(
-    const vector<string*>& md,
+    const Description& md,
     string& amd
 ) {
 #ifdef MF_MD_2_HTML_CMARK
@@ -289,7 +182,7 @@ void CmarkAhoCorasickBlockAutolinkingPreprocessor::process(
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] begin CMARK" << endl);
     string ds{};
-    toString(md, ds);
+    ds.append(md.getText());
     MF_DEBUG("[Autolinking] input:" << endl << ">>>" << ds << "<<<" << endl);
 
     auto begin = chrono::high_resolution_clock::now();
@@ -302,8 +195,8 @@ void CmarkAhoCorasickBlockAutolinkingPreprocessor::process(
     // some part (prefix) of the input MD will be autolinked.
 
     if(md.size()) {
-        string mds{};
-        toString(md, mds);
+        // description text is contiguous > parsed w/o copy
+        const string& mds = md.getText();
         const char* mdsc{mds.c_str()};
 
         cmark_node* document = cmark_parse_document(
@@ -364,7 +257,7 @@ void CmarkAhoCorasickBlockAutolinkingPreprocessor::process(
 
 #else
     // cmark-gfm not available - returning Markdown as is
-    toString(md, amd);
+    amd.append(md.getText());
 #endif
 }
 
@@ -90,27 +90,24 @@ CmarkTrieLineAutolinkingPreprocessor::~CmarkTrieLineAutolinkingPreprocessor()
 }
 
 void CmarkTrieLineAutolinkingPreprocessor::processProtectedBlock(
-        vector<string*>& block,
+        string& block,
         string& amd)
 {
     if(block.size()) {
-        string blockString{};
-        toString(block, blockString);
-        amd.append(blockString);
+        amd.append(block);
         block.clear();
     }
     MF_DEBUG("Appended PROTECTED block:" << endl << "'" << amd << "'" << endl);
 }
 
 void CmarkTrieLineAutolinkingPreprocessor::processAndAutolinkBlock(
-        vector<string*>& block,
+        string& block,
         string& amd)
 {
     if(block.size()) {
-        string blockString{}, autolinkedBlock{};
-        toString(block, blockString);
+        string autolinkedBlock{};
         MF_DEBUG("111");
-        parseMarkdownLine(&blockString, &autolinkedBlock);
+        parseMarkdownLine(&block, &autolinkedBlock);
         MF_DEBUG("222");
         amd.append(autolinkedBlock);
         MF_DEBUG("333");
@@ -120,7 +117,7 @@ void CmarkTrieLineAutolinkingPreprocessor::processAndAutolinkBlock(
 }
 
 void CmarkTrieLineAutolinkingPreprocessor::process(
-        const vector<string*>& md,
+        const Description& md,
         string& amd)
 {
 #ifdef MF_MD_2_HTML_CMARK
@@ -128,7 +125,7 @@ void CmarkTrieLineAutolinkingPreprocessor::process(
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] begin CMARK" << endl);
     string ds{};
-    toString(md, ds);
+    ds.append(md.getText());
     MF_DEBUG("[Autolinking] input:" << endl << ">>>" << ds << "<<<" << endl);
 
     auto begin = chrono::high_resolution_clock::now();
@@ -136,7 +133,8 @@ void CmarkTrieLineAutolinkingPreprocessor::process(
 
     insensitive = Configuration::getInstance().isAutolinkingCaseInsensitive();
 
-    vector<string*> block{};
+    string block{};
+    block.reserve(md.getBytesize());
     if(md.size()) {
 
         // IMPROVE measure time in here and if over give limit, than STOP injecting
@@ -144,25 +142,23 @@ void CmarkTrieLineAutolinkingPreprocessor::process(
         // some part (prefix) of the input MD will be autolinked.
 
         bool inCodeBlock=false, inMathBlock=false;
-        for(string* l:md) {
-            if(l && stringStartsWith(*l, CODE_BLOCK)) {
-                block.push_back(l);
+        for(const Description::Line& l:md) {
+            block.append(l.data(), l.size());
+            block += '\n';
+            if(l.startsWith(CODE_BLOCK)) {
                 if(inCodeBlock) {
                     processProtectedBlock(block, amd);
                 } else {
                     processAndAutolinkBlock(block, amd);
                 }
                 inCodeBlock = !inCodeBlock;
-            } else if(l && stringStartsWith(*l, MATH_BLOCK)) {
-                block.push_back(l);
+            } else if(l.startsWith(MATH_BLOCK)) {
                 if(inMathBlock) {
                     processProtectedBlock(block, amd);
                 } else {
                     processAndAutolinkBlock(block, amd);
                 }
                 inMathBlock= !inMathBlock;
-            } else {
-                block.push_back(l);
             }
         }
     }
@@ -177,14 +173,14 @@ void CmarkTrieLineAutolinkingPreprocessor::process(
 #endif
 
 #else
-    toString(md, amd);
+    amd.append(md.getText());
 #endif
 }
 
 
 
 void CmarkTrieLineAutolinkingPreprocessor::processLineByLine(
-        const std::vector<std::string*>& md,
+        const Description& md,
         std::string& amd)
 {
 #ifdef MF_MD_2_HTML_CMARK
@@ -192,7 +188,7 @@ void CmarkTrieLineAutolinkingPreprocessor::processLineByLine(
 #ifdef DO_MF_DEBUG
     MF_DEBUG("[Autolinking] begin CMARK-AHO" << endl);
     string ds{};
-    toString(md, ds);
+    ds.append(md.getText());
     MF_DEBUG("[Autolinking] input:" << endl << ">>" << ds << "<<" << endl);
 
     auto begin = chrono::high_resolution_clock::now();
@@ -210,32 +206,29 @@ void CmarkTrieLineAutolinkingPreprocessor::processLineByLine(
         // some part (prefix) of the input MD will be autolinked.
 
         bool inCodeBlock=false, inMathBlock=false;
-        for(string* l:md) {
+        string line{};
+        for(const Description::Line& l:md) {
             // every line is autolinked SEPARATELY
             string* nl = new string{};
+            line.assign(l.data(), l.size());
 
             // skip code/math/... blocks
-            if(stringStartsWith(*l, CODE_BLOCK)) {
+            if(l.startsWith(CODE_BLOCK)) {
                 inCodeBlock = !inCodeBlock;
 
-                nl->assign(*l);
+                nl->assign(line);
                 amdl.push_back(nl);
-            } else if(stringStartsWith(*l, MATH_BLOCK)) {
+            } else if(l.startsWith(MATH_BLOCK)) {
                 inMathBlock= !inMathBlock;
 
-                nl->assign(*l);
+                nl->assign(line);
+                amdl.push_back(nl);
+            } else if(line.size() && !inCodeBlock && !inMathBlock) {
+                parseMarkdownLine(&line, nl);
                 amdl.push_back(nl);
-            } else if(l) {
-                if(l->size() && !inCodeBlock && !inMathBlock) {
-                    parseMarkdownLine(l, nl);
-                    amdl.push_back(nl);
-                } else {
-                    nl->assign(*l);
-                    amdl.push_back(nl);
-                }
             } else {
-                delete nl;
-                amdl.push_back(nullptr);
+                nl->assign(line);
+                amdl.push_back(nl);
             }
         }
     }
@@ -250,7 +243,7 @@ void CmarkTrieLineAutolinkingPreprocessor::processLineByLine(
 #endif
 
 #else
-    toString(md, amd);
+    amd.append(md.getText());
 #endif
 }
 
@@ -391,7 +384,7 @@ cmark_node* CmarkTrieLineAutolinkingPreprocessor::addAstLinkNode(
     cmark_node* txtNode{};
 
     linkNode = cmark_node_new(CMARK_NODE_LINK);
-    string link{MF_URL_PROTOCOL};
+    string link{AutolinkingPreprocessor::MF_URL_PREFIX};
     link.append(pre);
     cmark_node_set_url(linkNode, link.c_str());
     txtNode = cmark_node_new(CMARK_NODE_TEXT);
@@ -96,7 +96,7 @@ void NaiveAutolinkingPreprocessor::updateThingsIndex()
 #endif
 }
 
-void NaiveAutolinkingPreprocessor::process(const vector<string*>& md, string &amd)
+void NaiveAutolinkingPreprocessor::process(const Description& md, string &amd)
 {
     MF_DEBUG("[Autolinking] NAIVE" << endl);
 
@@ -111,8 +111,11 @@ void NaiveAutolinkingPreprocessor::process(const vector<string*>& md, string &am
 
     if(md.size()) {
         bool inCodeBlock=false, inMathBlock=false;
-        for(string* l:md) {
+        string line{};
+        for(const Description::Line& dl:md) {
             // every line is autolinked SEPARATELY
+            line.assign(dl.data(), dl.size());
+            string* l = &line;
 
             string* nl = new string{};
 
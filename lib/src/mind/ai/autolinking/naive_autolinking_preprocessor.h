@@ -55,7 +55,14 @@ public:
     NaiveAutolinkingPreprocessor &operator=(const NaiveAutolinkingPreprocessor&&) = delete;
     virtual ~NaiveAutolinkingPreprocessor();
 
-    virtual void process(const std::vector<std::string*>& md, std::string& amd) override;
+    virtual void process(const Description& md, std::string& amd) override;
+    /**
+     * @brief Links depend on all Os and Ns (names and keys) > NOT cacheable.
+     */
+    virtual bool getFingerprint(u_int64_t& fingerprint) const override {
+        fingerprint = 0;
+        return false;
+    }
     void clear();
 
 private:
@@ -62,7 +62,14 @@ public:
     /**
      * @brief Inject links to given MD source (list of rows) and return valid MD string.
      */
-    virtual void process(const std::vector<std::string*>& in, std::string& out) = 0;
+    virtual void process(const Description& in, std::string& out) = 0;
+
+    /**
+     * @brief Links depend on autolinking index (Os and Ns names) only.
+     */
+    virtual bool getFingerprint(u_int64_t& fingerprint) const override {
+        return mind.autolinkFingerprint(fingerprint);
+    }
 };
 
 }
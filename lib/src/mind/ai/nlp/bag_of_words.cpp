@@ -24,11 +24,4 @@ BagOfWords::BagOfWords()
 {
 }
 
-void BagOfWords::reorderDocVectorsByWeight()
-{
-    for(auto& e:bow) {
-        e.second->sort();
-    }
-}
-
 } // m8r namespace
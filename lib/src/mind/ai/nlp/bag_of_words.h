@@ -19,7 +19,8 @@
 #ifndef M8R_BAG_OF_WORDS_H
 #define M8R_BAG_OF_WORDS_H
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 #ifdef DO_MF_DEBUG
 #include <iostream>
@@ -46,11 +47,17 @@ namespace m8r {
  */
 class BagOfWords
 {
+public:
+    /**
+     * @brief Doc vector: (word ID, frequency) terms ordered by word ID.
+     */
+    typedef std::vector<WordFrequencyList::Term> DocVector;
+
 private:
     /**
-     * @brief Document (O/N) to words (w/ frequencies).
+     * @brief Document (O/N) to words (w/ frequencies) - doc vectors are stored by value.
      */
-    std::map<Thing*,WordFrequencyList*> bow;
+    std::unordered_map<Thing*,DocVector> bow;
 
 public:
     explicit BagOfWords();
@@ -58,34 +65,35 @@ public:
     BagOfWords(const BagOfWords&&) = delete;
     BagOfWords &operator=(const BagOfWords&) = delete;
     BagOfWords &operator=(const BagOfWords&&) = delete;
-    ~BagOfWords() {
-        clear();
-    }
+    ~BagOfWords() {}
 
     size_t size() const { return bow.size(); }
-    void clear() {
-        for(auto p:bow) {
-            delete p.second;
-        }
-        bow.clear();
-    }
+    void clear() { bow.clear(); }
 
-    void add(Thing* t, WordFrequencyList* wfl) {
-        bow[t] = wfl;
+    void add(Thing* t, const WordFrequencyList& wfl) {
+        bow[t] = wfl.iterable();
     }
 
-    WordFrequencyList* get(Thing* t) {
-        return bow[t];
+    /**
+     * @brief Remove doc vector (thing is NOT dereferenced).
+     */
+    void remove(Thing* t) {
+        bow.erase(t);
     }
 
-    void reorderDocVectorsByWeight();
+    const DocVector* get(Thing* t) const {
+        auto i = bow.find(t);
+        return i != bow.end() ? &i->second : nullptr;
+    }
 
 #ifdef DO_MF_DEBUG
-    void print() const {
+    void print(const Lexicon& lexicon) const {
         MF_DEBUG("BoW[" << bow.size() << "]:" << std::endl);
         for(auto& e:bow) {
             MF_DEBUG("  '" << e.first->getName() << "' > ");
-            e.second->printFlat();
+            for(const WordFrequencyList::Term& t:e.second) {
+                MF_DEBUG(lexicon.getWord(t.id) << " [" << t.frequency << "] ");
+            }
             MF_DEBUG(std::endl);
         }
     }
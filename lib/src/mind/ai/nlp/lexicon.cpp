@@ -21,6 +21,10 @@
 namespace m8r {
 
 Lexicon::Lexicon()
+    : ids{},
+      words{},
+      frequencies{},
+      weights{}
 {
     // inaccurate, but until the 1st word is added ;)
     maxFrequency = 1;
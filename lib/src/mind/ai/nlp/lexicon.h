@@ -19,7 +19,8 @@
 #ifndef M8R_LEXICON_H
 #define M8R_LEXICON_H
 
-#include <map>
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -36,41 +37,22 @@ namespace m8r {
  * @brief Lexicon of all words w/ global frequencies.
  *
  * Lexicon is the *only* data structure in MF's AI that keeps words by *value*.
- * Other data structures use either pointers or references to be memory efficient.
+ * Every word is interned to a dense integer ID (index to flat arrays of words,
+ * frequencies and weights) and other data structures use these IDs to be
+ * memory and cache efficient.
  *
  */
 // IMPROVE Stanford GloVe lexicon w/ word attributes & semantic domains (configure > check existence > use OR skip)
 class Lexicon
 {
-public:
-
-    struct WordEmbedding {
-        // IMPROVE consider use of ptr to map's key
-        std::string word;
-        int frequency;
-        float weight;
-
-        explicit WordEmbedding() {
-            frequency = 0;
-            weight = 0.;
-        }
-        explicit WordEmbedding(const std::string& ww, int f, float w) {
-            word = ww;
-            frequency = f;
-            weight = w;
-        }
-    };
-
-
 private:
-    // map of word-to-frequency pairs for fast lookup and duplicity detection
-    // IMPROVE C++ SL uses map's comparator for string to do comparisons - thefore insert
-    //         complexity is O(log(n)) string comparisons. Consider TRIE data structure
-    //         instead.
-    std::map<std::string,WordEmbedding> m;
+    // word to ID (index to flat arrays below) for fast lookup and duplicity detection
+    std::unordered_map<std::string,u_int32_t> ids;
 
-    // sorted/ordered words by weight/frequency/... referencing/pointing to map
-    //std::vector<WordEmbedding*> words;
+    // words, frequencies and weights indexed by word ID
+    std::vector<std::string> words;
+    std::vector<int> frequencies;
+    std::vector<float> weights;
 
     // keeping max word frequency for efficient weighs calculation
     int maxFrequency;
@@ -83,38 +65,72 @@ public:
     Lexicon &operator=(const Lexicon&&) = delete;
     ~Lexicon();
 
-    size_t size() const { return m.size(); }
-    void clear() { m.clear(); }
-    const std::map<std::string,WordEmbedding>& get() const { return m; }
+    size_t size() const { return words.size(); }
+    void clear() {
+        ids.clear();
+        words.clear();
+        frequencies.clear();
+        weights.clear();
+        maxFrequency = 1;
+    }
 
-    WordEmbedding* get(const std::string& word) {
-        std::map<std::string,WordEmbedding>::iterator i = m.find(word);
-        if(i != m.end()) {
-            return &i->second;
+    /**
+     * @brief Get word ID or -1 if word is not in lexicon.
+     */
+    int getId(const std::string& word) const {
+        std::unordered_map<std::string,u_int32_t>::const_iterator i = ids.find(word);
+        if(i != ids.end()) {
+            return static_cast<int>(i->second);
         } else {
-            return nullptr;
+            return -1;
         }
     }
-    WordEmbedding* get(const std::string* word) {
-        return get(*word);
+    int getId(const std::string* word) const {
+        return getId(*word);
     }
 
-    WordEmbedding* add(const std::string& word) {
-        WordEmbedding* result;
-        if((result=get(word)) != nullptr) {
-            ++result->frequency;
-            if(result->frequency>maxFrequency) maxFrequency=result->frequency;
-            return result;
+    const std::string& getWord(u_int32_t id) const { return words[id]; }
+    int getFrequency(u_int32_t id) const { return frequencies[id]; }
+    float getWeight(u_int32_t id) const { return weights[id]; }
+
+    /**
+     * @brief Add word occurrence and return word ID.
+     *
+     * Word weight is updated immediately (w/ current maximum frequency),
+     * weights of other words are updated by recalculateWeights().
+     */
+    u_int32_t intern(const std::string& word) {
+        std::unordered_map<std::string,u_int32_t>::iterator i = ids.find(word);
+        u_int32_t id;
+        if(i != ids.end()) {
+            id = i->second;
+            if(++frequencies[id]>maxFrequency) maxFrequency=frequencies[id];
         } else {
-            WordEmbedding we{word,1,0};
-            m[word] = we;
-            return &(m[word]);
+            id = static_cast<u_int32_t>(words.size());
+            words.push_back(word);
+            frequencies.push_back(1);
+            weights.push_back(0);
+            ids[word] = id;
         }
+        weights[id] = calculateWeight(frequencies[id]);
+        return id;
+    }
+
+    u_int32_t add(const std::string& word) {
+        return intern(word);
     }
-    WordEmbedding* add(const std::string* word) {
+    u_int32_t add(const std::string* word) {
         return add(*word);
     }
 
+    /**
+     * @brief Remove word occurrences (word stays in lexicon so that IDs are stable).
+     */
+    void release(u_int32_t id, int occurrences=1) {
+        frequencies[id] = std::max(0, frequencies[id]-occurrences);
+        weights[id] = calculateWeight(frequencies[id]);
+    }
+
     /**
      * @brief Recalculate word weights.
      *
@@ -130,23 +146,33 @@ public:
      *
      */
     void recalculateWeights() {
-        for(auto& e:m) {
-            e.second.weight =  1.f - ((((float)e.second.frequency)/100.f) / (((float)maxFrequency)/100.f));
-
-            // IMPROVE fixed constant is eight too big or small
-            // ensure max(w)'s weigh to be > 0
-            if(!e.second.weight) e.second.weight = 0.01f;
+        // frequencies might have been decremented since the last recalculation
+        maxFrequency = 1;
+        for(int f:frequencies) {
+            if(f>maxFrequency) maxFrequency=f;
+        }
+        for(size_t id=0; id<frequencies.size(); id++) {
+            weights[id] = calculateWeight(frequencies[id]);
         }
     }
 
 #ifdef DO_MF_DEBUG
     void print() const {
-        MF_DEBUG("Lexicon[" << m.size() << "]:" << std::endl);
-        for(auto& e:m) {
-            MF_DEBUG("  " << e.second.word << "  " << e.second.frequency << "  " << e.second.weight << std::endl);
+        MF_DEBUG("Lexicon[" << words.size() << "]:" << std::endl);
+        for(size_t id=0; id<words.size(); id++) {
+            MF_DEBUG("  " << words[id] << "  " << frequencies[id] << "  " << weights[id] << std::endl);
         }
     }
 #endif
+
+private:
+    float calculateWeight(int frequency) const {
+        float weight = 1.f - ((((float)frequency)/100.f) / (((float)maxFrequency)/100.f));
+
+        // IMPROVE fixed constant is eight too big or small
+        // ensure max(w)'s weigh to be > 0
+        return weight>0.f?weight:0.01f;
+    }
 };
 
 }
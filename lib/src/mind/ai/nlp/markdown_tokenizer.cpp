@@ -37,6 +37,8 @@ void MarkdownTokenizer::tokenize(CharProvider& md, WordFrequencyList& wfl, bool
     bool inRelLabel=false;
     bool inRelLink=false;
 
+    // word IDs are collected unsorted and merged to frequency list at once
+    vector<u_int32_t> ids{};
     string w{}, link{};
     while(md.hasNext()) {
         const char c = md.next();
@@ -125,12 +127,12 @@ void MarkdownTokenizer::tokenize(CharProvider& md, WordFrequencyList& wfl, bool
         case '<':
         case '>':
         case '/':
-            handleWord(wfl, w, stem, useBlacklist);
+            handleWord(ids, w, stem, useBlacklist);
             break;
         default:
             if(md.get() < 0) {
                 // skip HIGH Unicode chars
-                handleWord(wfl, w, stem, useBlacklist);
+                handleWord(ids, w, stem, useBlacklist);
             } else {
                 if(lowercase) {
                     w += tolower(md.get());
@@ -143,10 +145,11 @@ void MarkdownTokenizer::tokenize(CharProvider& md, WordFrequencyList& wfl, bool
         }
     }
 
-    lexicon.recalculateWeights();
+    // words are weighted as they are interned (recalculation of all weights is up to lexicon owner)
+    wfl.add(ids);
 }
 
-void MarkdownTokenizer::handleWord(WordFrequencyList& wfl, string &w, bool stem, bool useBlacklist)
+void MarkdownTokenizer::handleWord(vector<u_int32_t>& ids, string &w, bool stem, bool useBlacklist)
 {
     if(w.size()>1) {
         // stem
@@ -157,8 +160,7 @@ void MarkdownTokenizer::handleWord(WordFrequencyList& wfl, string &w, bool stem,
         // remove common words
         if(!useBlacklist || !blacklist.findWord(w)) {
             // increment token frequency
-            Lexicon::WordEmbedding* we = lexicon.add(w);
-            ++wfl[&(we->word)];
+            ids.push_back(lexicon.intern(w));
         }
     }
     w.clear();
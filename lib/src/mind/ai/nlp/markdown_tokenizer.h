@@ -84,7 +84,7 @@ public:
     static bool isNonAlpha(char c);
 
 private:
-    inline void handleWord(WordFrequencyList& wfl, std::string &w, bool stem, bool useBlacklist);
+    inline void handleWord(std::vector<u_int32_t>& ids, std::string &w, bool stem, bool useBlacklist);
 };
 
 }
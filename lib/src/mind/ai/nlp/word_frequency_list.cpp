@@ -26,31 +26,58 @@ using namespace std;
 
 WordFrequencyList::WordFrequencyList(Lexicon* lexicon)
     : lexicon(lexicon),
-      wordWeightComparator{lexicon}
+      weight{UNDEF_WEIGHT},
+      terms{},
+      termsByWeight{}
 {
-    weight = UNDEF_WEIGHT;
 }
 
 WordFrequencyList::~WordFrequencyList()
 {
 }
 
-void WordFrequencyList::sort() {
-    // reset array
-    wordsByWeight.clear();
+void WordFrequencyList::add(vector<u_int32_t>& ids) {
+    if(ids.empty()) {
+        return;
+    }
+    weight = UNDEF_WEIGHT;
 
-    for(auto& w:word2Frequency) {
-        wordsByWeight.push_back(&w);
+    std::sort(ids.begin(), ids.end());
+    vector<Term> merged{};
+    merged.reserve(terms.size()+ids.size());
+    size_t t=0;
+    for(size_t i=0; i<ids.size(); ) {
+        u_int32_t id = ids[i];
+        int frequency = 0;
+        for(; i<ids.size() && ids[i]==id; i++) {
+            frequency++;
+        }
+        for(; t<terms.size() && terms[t].id<id; t++) {
+            merged.push_back(terms[t]);
+        }
+        if(t<terms.size() && terms[t].id==id) {
+            frequency += terms[t++].frequency;
+        }
+        merged.push_back(Term{id,frequency});
     }
-    std::sort(wordsByWeight.begin(),wordsByWeight.end(),wordWeightComparator);
+    merged.insert(merged.end(), terms.begin()+t, terms.end());
+    terms.swap(merged);
+}
+
+void WordFrequencyList::sort() {
+    termsByWeight = terms;
+    // weights are in flat array indexed by ID (no lookups)
+    const Lexicon* l = lexicon;
+    std::stable_sort(
+        termsByWeight.begin(),
+        termsByWeight.end(),
+        [l](const Term& t1, const Term& t2) { return l->getWeight(t1.id) > l->getWeight(t2.id); });
 }
 
 float WordFrequencyList::recalculateWeight() {
     weight = 0;
-    for(auto& w:word2Frequency) {
-        Lexicon::WordEmbedding* e = lexicon->get(w.first);
-        // IMPROVE if(e) result += e->weight * ((float)w.second); ... means min of weights in UNION and INTERSECTION
-        if(e) weight += e->weight;
+    for(auto& t:terms) {
+        weight += lexicon->getWeight(t.id);
     }
     return weight;
 }
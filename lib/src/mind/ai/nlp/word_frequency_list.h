@@ -19,7 +19,7 @@
 #ifndef M8R_WORD_FREQUENCY_LIST_H
 #define M8R_WORD_FREQUENCY_LIST_H
 
-#include <map>
+#include <algorithm>
 #include <vector>
 #include <string>
 
@@ -35,65 +35,36 @@ namespace m8r {
 /**
  * @brief Word frequency list for a doc.
  *
+ * Words are Lexicon word IDs kept in two contiguous arrays: ordered by ID
+ * (for lookups and merges) and ordered by weight (once sorted).
+ *
  * See:
  *   https://en.wikipedia.org/wiki/Word_lists_by_frequency
  */
 class WordFrequencyList
 {
-    struct WordWeightComparator
-    {
-        Lexicon *l;
-        WordWeightComparator(Lexicon* l) : l(l) {}
-
-        // functor to compare words by weight
-        bool operator()(
-                const std::pair<const std::string* const,int>*const& p1,
-                const std::pair<const std::string* const,int>*const& p2
-        ) {
-            return l->get(p1->first)->weight > l->get(p2->first)->weight;
-        }
+public:
+    struct Term {
+        u_int32_t id;
+        int frequency;
     };
 
-public:
     static constexpr float UNDEF_WEIGHT = -1;
 
-    static void evalUnion(WordFrequencyList& l1, WordFrequencyList& l2, WordFrequencyList& u)
-    {
-        // IMPROVE u.iterable().insert(l1.iterable().begin(),l1.iterable().end());
-        for(auto& e:l1.iterable()) {
-            u.add(e.first);
-        }
-
-        for(auto& e:l2.iterable()) {
-            u.add(e.first);
-        }
-    }
-
-    static void evalIntersection(WordFrequencyList& l1, WordFrequencyList& l2, WordFrequencyList& u)
-    {
-        // IMPROVE u.iterable().insert(l1.iterable().begin(),l1.iterable().end());
-        for(auto& e:l1.iterable()) {
-            if(l2.contains(e.first)) {
-                u.add(e.first);
-            }
-        }
-    }
-
 private:
     Lexicon* lexicon;
-    WordWeightComparator wordWeightComparator;
 
     float weight;
 
     /**
-     * @brief List of words occuring in a Thing ordered by weight.
+     * @brief Words occuring in a Thing ordered by ID.
      */
-    std::vector<std::pair<const std::string *const,int>*> wordsByWeight;
+    std::vector<Term> terms;
 
     /**
-     * @brief TRANSIENT map used for quick inserts (can be cleared once list is built).
+     * @brief Words occuring in a Thing ordered by weight (descending) - built by sort().
      */
-    std::map<const std::string*,int> word2Frequency;
+    std::vector<Term> termsByWeight;
 
 public:
     explicit WordFrequencyList(Lexicon* lexicon);
@@ -103,9 +74,9 @@ public:
     WordFrequencyList &operator=(const WordFrequencyList&&) = delete;
     ~WordFrequencyList();
 
-    int& operator[](std::string* key) { return word2Frequency[key]; }
-    size_t size() const { return word2Frequency.size(); }
-    const std::map<const std::string*,int>& iterable() const { return word2Frequency; }
+    size_t size() const { return terms.size(); }
+    const std::vector<Term>& iterable() const { return terms; }
+    const std::vector<Term>& iterableByWeight() const { return termsByWeight; }
 
     float getWeight() {
         if(weight==UNDEF_WEIGHT) {
@@ -115,31 +86,30 @@ public:
         }
     }
 
-    int contains(const std::string* word) {
-        std::map<const std::string*,int>::iterator i = word2Frequency.find(word);
-        if(i != word2Frequency.end()) {
-            return true;
-        } else {
-            return false;
-        }
+    bool contains(u_int32_t id) const {
+        return std::binary_search(
+            terms.begin(), terms.end(), Term{id,0},
+            [](const Term& t1, const Term& t2) { return t1.id < t2.id; });
     }
 
-    int add(const std::string* word) {
+    int add(u_int32_t id) {
         weight = UNDEF_WEIGHT;
 
-        std::map<const std::string*,int>::iterator i = word2Frequency.find(word);
-        if(i != word2Frequency.end()) {
-            ++i->second;
-            return word2Frequency[word];
+        std::vector<Term>::iterator i = std::lower_bound(
+            terms.begin(), terms.end(), Term{id,0},
+            [](const Term& t1, const Term& t2) { return t1.id < t2.id; });
+        if(i != terms.end() && i->id == id) {
+            return ++i->frequency;
         } else {
-            word2Frequency[word] = 1;
+            terms.insert(i, Term{id,1});
             return 1;
         }
     }
 
-    void set(const std::string* word, int frequency) {
-        word2Frequency[word] = frequency;
-    }
+    /**
+     * @brief Add word occurrences - IDs are sorted and merged at once (no per word insert).
+     */
+    void add(std::vector<u_int32_t>& ids);
 
     /**
      * @brief Sort words by weight.
@@ -153,14 +123,14 @@ public:
 
 #ifdef DO_MF_DEBUG
     void print() const {
-        std::cout << "WordFrequencyList[" << word2Frequency.size() << "]:" << std::endl;
-        for(auto& w:wordsByWeight) {
-            std::cout << "  " << (*w->first) << " [" << w->second << "] " << std::endl;
+        std::cout << "WordFrequencyList[" << terms.size() << "]:" << std::endl;
+        for(auto& t:termsByWeight) {
+            std::cout << "  " << lexicon->getWord(t.id) << " [" << t.frequency << "] " << std::endl;
         }
     }
     void printFlat() const {
-        for(auto& w:wordsByWeight) {
-            std::cout << (*w->first) << " [" << w->second << "] ";
+        for(auto& t:termsByWeight) {
+            std::cout << lexicon->getWord(t.id) << " [" << t.frequency << "] ";
         }
     }
 #endif
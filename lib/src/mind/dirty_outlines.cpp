@@ -0,0 +1,82 @@
+/*
+ dirty_outlines.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "dirty_outlines.h"
+
+using namespace std;
+
+namespace m8r {
+
+DirtyOutlines::DirtyOutlines()
+    : dirtyMutex{},
+      outlines{}
+{
+}
+
+DirtyOutlines::~DirtyOutlines()
+{
+}
+
+void DirtyOutlines::index(Outline* outline)
+{
+    if(outline) {
+        // (re)indexed O is up to date in all memory indices
+        outline->setObserver(this);
+        lock_guard<std::mutex> criticalSection{dirtyMutex};
+        outlines.erase(outline);
+    }
+}
+
+void DirtyOutlines::forget(const Outline* outline)
+{
+    lock_guard<std::mutex> criticalSection{dirtyMutex};
+    outlines.erase(const_cast<Outline*>(outline));
+}
+
+void DirtyOutlines::replace(const Outline* oldOutline, Outline* newOutline)
+{
+    forget(oldOutline);
+    index(newOutline);
+}
+
+void DirtyOutlines::clear()
+{
+    lock_guard<std::mutex> criticalSection{dirtyMutex};
+    outlines.clear();
+}
+
+void DirtyOutlines::outlineDirty(Outline* outline)
+{
+    lock_guard<std::mutex> criticalSection{dirtyMutex};
+    outlines.insert(outline);
+}
+
+void DirtyOutlines::take(vector<Outline*>& result)
+{
+    lock_guard<std::mutex> criticalSection{dirtyMutex};
+    result.insert(result.end(), outlines.begin(), outlines.end());
+    outlines.clear();
+}
+
+size_t DirtyOutlines::size() const
+{
+    lock_guard<std::mutex> criticalSection{dirtyMutex};
+    return outlines.size();
+}
+
+} // m8r namespace
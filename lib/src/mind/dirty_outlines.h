@@ -0,0 +1,67 @@
+/*
+ dirty_outlines.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef M8R_DIRTY_OUTLINES_H
+#define M8R_DIRTY_OUTLINES_H
+
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "../model/outline.h"
+#include "memory_index.h"
+
+namespace m8r {
+
+/**
+ * @brief Collector of Os made dirty since they were last taken (e.g. to re-aggregate them).
+ *
+ * Collector observes Os in memory, therefore Os made dirty by views (read counters)
+ * are found w/o iterating all Os. Os might be made dirty by any thread.
+ */
+class DirtyOutlines : public MemoryIndex, public OutlineObserver
+{
+private:
+    mutable std::mutex dirtyMutex;
+    std::unordered_set<Outline*> outlines;
+
+public:
+    explicit DirtyOutlines();
+    DirtyOutlines(const DirtyOutlines&) = delete;
+    DirtyOutlines(const DirtyOutlines&&) = delete;
+    DirtyOutlines& operator=(const DirtyOutlines&) = delete;
+    DirtyOutlines& operator=(const DirtyOutlines&&) = delete;
+    virtual ~DirtyOutlines();
+
+    virtual void index(Outline* outline) override;
+    virtual void forget(const Outline* outline) override;
+    virtual void replace(const Outline* oldOutline, Outline* newOutline) override;
+    virtual void clear() override;
+
+    virtual void outlineDirty(Outline* outline) override;
+
+    /**
+     * @brief Move collected Os to result.
+     */
+    void take(std::vector<Outline*>& result);
+
+    size_t size() const;
+};
+
+}
+#endif // M8R_DIRTY_OUTLINES_H
@@ -0,0 +1,137 @@
+/*
+ document_index.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "document_index.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr size_t DocumentIndex::COMPACTION_THRESHOLD;
+constexpr u_int32_t DocumentIndex::DEAD;
+
+DocumentIndex::DocumentIndex()
+    : documents{},
+      outlines{},
+      slotSequence{},
+      deadDocuments{}
+{
+}
+
+DocumentIndex::~DocumentIndex()
+{
+}
+
+void DocumentIndex::clear()
+{
+    clearDocuments();
+    documents.clear();
+    outlines.clear();
+    slotSequence = 0;
+    deadDocuments = 0;
+}
+
+void DocumentIndex::appendDocument(Outline* outline, Note* note, u_int32_t ordinal, OutlineDocuments& od)
+{
+    u_int32_t id = static_cast<u_int32_t>(documents.size());
+    documents.push_back(Document{outline, note, od.slot, ordinal});
+    od.documents.push_back(id);
+    addDocument(id);
+}
+
+void DocumentIndex::index(Outline* outline)
+{
+    if(outline) {
+        // forget() may compact and drop O entry > get its slot first
+        auto i = outlines.find(outline);
+        u_int32_t slot = i==outlines.end()?slotSequence++:i->second.slot;
+        forget(outline);
+
+        OutlineDocuments& od = outlines[outline];
+        od.slot = slot;
+
+        appendDocument(outline, nullptr, 0, od);
+        const vector<Note*>& ns = outline->getNotes();
+        for(size_t o=0; o<ns.size(); o++) {
+            appendDocument(outline, ns[o], static_cast<u_int32_t>(o+1), od);
+        }
+    }
+}
+
+void DocumentIndex::forget(const Outline* outline)
+{
+    auto i = outlines.find(outline);
+    if(i != outlines.end()) {
+        for(u_int32_t id:i->second.documents) {
+            forgetDocument(id);
+            documents[id].outline = nullptr;
+            documents[id].note = nullptr;
+            deadDocuments++;
+        }
+        i->second.documents.clear();
+
+        if(deadDocuments > COMPACTION_THRESHOLD && deadDocuments > documents.size()/2) {
+            compactTable();
+        }
+    }
+}
+
+void DocumentIndex::replace(const Outline* oldOutline, Outline* newOutline)
+{
+    auto i = outlines.find(oldOutline);
+    if(i != outlines.end()) {
+        u_int32_t slot = i->second.slot;
+        forget(oldOutline);
+        // iterator is invalid if forget() compacted the table
+        outlines.erase(oldOutline);
+        outlines[newOutline].slot = slot;
+    }
+    index(newOutline);
+}
+
+void DocumentIndex::compactTable()
+{
+    // renumber live documents (their order is preserved)
+    vector<u_int32_t> remap(documents.size(), DEAD);
+    vector<Document> live{};
+    live.reserve(documents.size()-deadDocuments);
+    for(size_t id=0; id<documents.size(); id++) {
+        if(documents[id].outline) {
+            remap[id] = static_cast<u_int32_t>(live.size());
+            live.push_back(documents[id]);
+        }
+    }
+
+    compact(remap);
+
+    for(auto o=outlines.begin(); o!=outlines.end(); ) {
+        if(o->second.documents.empty()) {
+            o = outlines.erase(o);
+        } else {
+            for(u_int32_t& id:o->second.documents) {
+                id = remap[id];
+            }
+            ++o;
+        }
+    }
+
+    documents.swap(live);
+    deadDocuments = 0;
+}
+
+} // m8r namespace
@@ -0,0 +1,143 @@
+/*
+ document_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef M8R_DOCUMENT_INDEX_H
+#define M8R_DOCUMENT_INDEX_H
+
+#include <limits>
+#include <vector>
+#include <unordered_map>
+
+#include "../gear/lang_utils.h"
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "memory_index.h"
+
+namespace m8r {
+
+/**
+ * @brief Index whose documents are O descriptors and Ns - shared document table.
+ *
+ * O documents are appended to the document table when O is indexed and
+ * they are forgotten when O is re-indexed or forgotten. Forgotten documents
+ * are just marked as dead - Note pointers of dead documents are never
+ * dereferenced, therefore Ns can be deleted before O is re-indexed - and
+ * the table is compacted once there is too many of them.
+ *
+ * Every O has a slot which is kept when O is re-indexed or replaced,
+ * therefore documents can be ordered as Os in memory and Ns in O.
+ *
+ * Subclass indexes the document in addDocument() and keeps its postings
+ * and per-document data consistent in forgetDocument() and compact().
+ */
+class DocumentIndex : public MemoryIndex
+{
+public:
+    /**
+     * @brief Number of dead documents which triggers compaction (if live docs are minority).
+     */
+    static constexpr size_t COMPACTION_THRESHOLD = 4096;
+
+    /**
+     * @brief Compaction remap of dead documents.
+     */
+    static constexpr u_int32_t DEAD = std::numeric_limits<u_int32_t>::max();
+
+protected:
+    struct Document {
+        // nullptr if document is dead
+        Outline* outline;
+        // nullptr for O descriptor
+        Note* note;
+        u_int32_t slot;
+        // 0 for O descriptor, N offset + 1 otherwise
+        u_int32_t ordinal;
+    };
+
+    std::vector<Document> documents;
+
+private:
+    struct OutlineDocuments {
+        u_int32_t slot;
+        std::vector<u_int32_t> documents;
+    };
+
+    std::unordered_map<const Outline*,OutlineDocuments> outlines;
+
+    u_int32_t slotSequence;
+    size_t deadDocuments;
+
+public:
+    explicit DocumentIndex();
+    DocumentIndex(const DocumentIndex&) = delete;
+    DocumentIndex(const DocumentIndex&&) = delete;
+    DocumentIndex& operator=(const DocumentIndex&) = delete;
+    DocumentIndex& operator=(const DocumentIndex&&) = delete;
+    virtual ~DocumentIndex();
+
+    virtual void index(Outline* outline) override;
+    virtual void forget(const Outline* outline) override;
+    virtual void replace(const Outline* oldOutline, Outline* newOutline) override;
+    virtual void clear() override;
+
+    size_t getDocumentsCount() const { return documents.size()-deadDocuments; }
+
+protected:
+    /**
+     * @brief Index the document w/ given ID (it's the last document in the table).
+     */
+    virtual void addDocument(u_int32_t id) = 0;
+    /**
+     * @brief Document is going to be dead - its N must NOT be dereferenced.
+     */
+    virtual void forgetDocument(u_int32_t id) { UNUSED_ARG(id); }
+    /**
+     * @brief Renumber postings and per-document data: remap[id] is new ID or DEAD.
+     *
+     * Called before the table is compacted, relative order of live documents is preserved.
+     */
+    virtual void compact(const std::vector<u_int32_t>& remap) = 0;
+    /**
+     * @brief Forget postings and per-document data.
+     */
+    virtual void clearDocuments() = 0;
+
+    bool isLive(u_int32_t id) const { return documents[id].outline != nullptr; }
+    /**
+     * @brief Memory order: Os in memory, O descriptor and then Ns in O.
+     */
+    bool isBefore(u_int32_t a, u_int32_t b) const {
+        const Document& da = documents[a];
+        const Document& db = documents[b];
+        return da.slot < db.slot || (da.slot == db.slot && da.ordinal < db.ordinal);
+    }
+    /**
+     * @brief Live documents of O, nullptr if O is not indexed.
+     */
+    const std::vector<u_int32_t>* getDocuments(const Outline* outline) const {
+        auto i = outlines.find(outline);
+        return i==outlines.end()?nullptr:&i->second.documents;
+    }
+
+private:
+    void appendDocument(Outline* outline, Note* note, u_int32_t ordinal, OutlineDocuments& od);
+    void compactTable();
+};
+
+}
+#endif // M8R_DOCUMENT_INDEX_H
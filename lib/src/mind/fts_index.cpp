@@ -0,0 +1,250 @@
+/*
+ fts_index.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fts_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <locale>
+
+using namespace std;
+
+namespace m8r {
+
+FtsIndex::FtsIndex()
+    : DocumentIndex{},
+      postings{}
+{
+    static const std::locale locale;
+    for(int c=0; c<256; c++) {
+        fold[c] = static_cast<unsigned char>(std::tolower(static_cast<char>(c), locale));
+    }
+}
+
+FtsIndex::~FtsIndex()
+{
+}
+
+void FtsIndex::clearDocuments()
+{
+    postings.clear();
+}
+
+void FtsIndex::grams(const char* s, size_t size, vector<u_int32_t>& result) const
+{
+    if(size >= GRAM_SIZE) {
+        const unsigned char* c = reinterpret_cast<const unsigned char*>(s);
+        u_int32_t gram = (fold[c[0]]<<8) | fold[c[1]];
+        for(size_t i=2; i<size; i++) {
+            gram = ((gram<<8) | fold[c[i]]) & 0xFFFFFF;
+            result.push_back(gram);
+        }
+    }
+}
+
+void FtsIndex::addDocument(u_int32_t id)
+{
+    const Document& d = documents[id];
+    vector<u_int32_t> g{};
+    grams(d.note?d.note->getName():d.outline->getName(), g);
+    for(const Description::Line& l:d.note?d.note->getDescription():d.outline->getDescription()) {
+        grams(l.data(), l.size(), g);
+    }
+
+    if(g.size()) {
+        std::sort(g.begin(), g.end());
+        g.erase(std::unique(g.begin(), g.end()), g.end());
+        // IDs are increasing > posting lists stay sorted
+        for(u_int32_t gram:g) {
+            postings[gram].push_back(id);
+        }
+    }
+}
+
+void FtsIndex::compact(const vector<u_int32_t>& remap)
+{
+    for(auto p=postings.begin(); p!=postings.end(); ) {
+        vector<u_int32_t>& ids = p->second;
+        size_t w = 0;
+        for(u_int32_t id:ids) {
+            if(remap[id] != DEAD) {
+                ids[w++] = remap[id];
+            }
+        }
+        if(w) {
+            ids.resize(w);
+            ids.shrink_to_fit();
+            ++p;
+        } else {
+            p = postings.erase(p);
+        }
+    }
+}
+
+bool FtsIndex::findCandidates(
+        const string& pattern,
+        FtsSearch searchMode,
+        vector<pair<Outline*,Note*>>& candidates) const
+{
+    vector<u_int32_t> g{};
+    if(searchMode == FtsSearch::REGEXP) {
+        vector<string> literals{};
+        regexpLiterals(pattern, literals);
+        for(const string& l:literals) {
+            grams(l, g);
+        }
+    } else {
+        grams(pattern, g);
+    }
+    if(g.empty()) {
+        return false;
+    }
+    std::sort(g.begin(), g.end());
+    g.erase(std::unique(g.begin(), g.end()), g.end());
+
+    // intersect posting lists starting w/ the shortest one
+    vector<const vector<u_int32_t>*> lists{};
+    for(u_int32_t gram:g) {
+        auto p = postings.find(gram);
+        if(p == postings.end()) {
+            return true;
+        }
+        lists.push_back(&p->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+        [](const vector<u_int32_t>* a, const vector<u_int32_t>* b) { return a->size() < b->size(); });
+
+    vector<u_int32_t> ids{};
+    for(u_int32_t id:*lists[0]) {
+        if(isLive(id)) {
+            ids.push_back(id);
+        }
+    }
+    vector<u_int32_t> intersection{};
+    for(size_t l=1; l<lists.size() && ids.size(); l++) {
+        intersection.clear();
+        std::set_intersection(
+            ids.begin(), ids.end(),
+            lists[l]->begin(), lists[l]->end(),
+            std::back_inserter(intersection));
+        ids.swap(intersection);
+    }
+
+    // re-indexed Os get new IDs > restore memory order
+    std::sort(ids.begin(), ids.end(),
+        [this](u_int32_t a, u_int32_t b) { return isBefore(a, b); });
+
+    for(u_int32_t id:ids) {
+        candidates.push_back(std::make_pair(documents[id].outline, documents[id].note));
+    }
+    return true;
+}
+
+void FtsIndex::regexpLiterals(const string& regexp, vector<string>& literals)
+{
+    if(regexp.find('|') != string::npos) {
+        return;
+    }
+
+    string literal{};
+    int groupDepth = 0;
+    for(size_t i=0; i<regexp.size(); i++) {
+        char c = regexp[i];
+        if(groupDepth) {
+            if(c == '\\') {
+                i++;
+            } else if(c == '(') {
+                groupDepth++;
+            } else if(c == ')') {
+                groupDepth--;
+            }
+            continue;
+        }
+
+        bool isLiteral = false;
+        switch(c) {
+        case '\\':
+            if(i+1<regexp.size() && ispunct(static_cast<unsigned char>(regexp[i+1]))) {
+                c = regexp[++i];
+                isLiteral = true;
+            } else if(i+1<regexp.size() && strchr("xuc0123456789", regexp[i+1])) {
+                // character codes and back references cannot be analyzed
+                literals.clear();
+                return;
+            } else {
+                // character class like \d or \w
+                i++;
+            }
+            break;
+        case '[':
+            // skip character class
+            i++;
+            if(i<regexp.size() && regexp[i] == ']') {
+                i++;
+            }
+            while(i<regexp.size() && regexp[i] != ']') {
+                if(regexp[i] == '\\') {
+                    i++;
+                }
+                i++;
+            }
+            break;
+        case '(':
+            groupDepth++;
+            break;
+        case '*':
+        case '?':
+        case '{':
+            // previous character is optional
+            if(literal.size()) {
+                literal.erase(literal.size()-1);
+            }
+            if(c == '{') {
+                while(i<regexp.size() && regexp[i] != '}') {
+                    i++;
+                }
+            }
+            break;
+        case '.':
+        case '^':
+        case '$':
+        case '+':
+        case ')':
+        case ']':
+        case '}':
+            break;
+        default:
+            isLiteral = true;
+        }
+
+        if(isLiteral) {
+            literal += c;
+        } else {
+            if(literal.size()) {
+                literals.push_back(literal);
+                literal.clear();
+            }
+        }
+    }
+    if(literal.size()) {
+        literals.push_back(literal);
+    }
+}
+
+} // m8r namespace
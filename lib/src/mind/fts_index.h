@@ -0,0 +1,116 @@
+/*
+ fts_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef M8R_FTS_INDEX_H
+#define M8R_FTS_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "document_index.h"
+
+namespace m8r {
+
+enum class FtsSearch {
+    EXACT,
+    IGNORE_CASE,
+    REGEXP
+};
+
+/**
+ * @brief Full-text search inverted index.
+ *
+ * FTS semantic is substring search (a pattern may start/end in the middle
+ * of a word), therefore the index terms are case folded trigrams rather than
+ * words. Each trigram maps to a sorted posting list of documents - an O
+ * descriptor (O name and description) or a N (N name and description).
+ * Trigrams never span lines as FTS matches lines.
+ *
+ * Index is used as a prefilter: it returns candidate Ns which contain all
+ * pattern trigrams and the caller runs a verification pass on candidates only.
+ * Therefore search latency depends on the number of candidates rather than
+ * on the size of the repository.
+ *
+ * Index is maintained at O granularity (see DocumentIndex) - posting lists
+ * are compacted together w/ the document table.
+ */
+class FtsIndex : public DocumentIndex
+{
+public:
+    /**
+     * @brief Minimal length of pattern (literal) to be resolved by the index.
+     */
+    static constexpr size_t GRAM_SIZE = 3;
+
+private:
+    std::unordered_map<u_int32_t,std::vector<u_int32_t>> postings;
+
+    /**
+     * @brief Case folding table which is consistent with stringToLower().
+     */
+    unsigned char fold[256];
+
+public:
+    explicit FtsIndex();
+    FtsIndex(const FtsIndex&) = delete;
+    FtsIndex(const FtsIndex&&) = delete;
+    FtsIndex& operator=(const FtsIndex&) = delete;
+    FtsIndex& operator=(const FtsIndex&&) = delete;
+    ~FtsIndex();
+
+    /**
+     * @brief Find candidate Ns (O descriptors included) for the pattern.
+     *
+     * Candidates are ordered as Os in memory and Ns in O. O descriptor Ns are
+     * NOT refreshed i.e. caller is expected to use getOutlineDescriptorAsNote().
+     *
+     * @return FALSE if pattern is not selective enough to be resolved
+     *         by the index and caller must scan all Ns.
+     */
+    bool findCandidates(
+            const std::string& pattern,
+            FtsSearch searchMode,
+            std::vector<std::pair<Outline*,Note*>>& candidates) const;
+
+    size_t getTermsCount() const { return postings.size(); }
+
+    /**
+     * @brief Extract literals which MUST be present in any string matched by regexp.
+     *
+     * Extraction is conservative: if regexp cannot be analyzed (e.g. it uses
+     * alternation), then no literals are returned.
+     */
+    static void regexpLiterals(const std::string& regexp, std::vector<std::string>& literals);
+
+protected:
+    virtual void addDocument(u_int32_t id) override;
+    virtual void compact(const std::vector<u_int32_t>& remap) override;
+    virtual void clearDocuments() override;
+
+private:
+    void grams(const char* s, size_t size, std::vector<u_int32_t>& result) const;
+    void grams(const std::string& s, std::vector<u_int32_t>& result) const {
+        grams(s.data(), s.size(), result);
+    }
+};
+
+}
+#endif // M8R_FTS_INDEX_H
@@ -0,0 +1,323 @@
+/*
+ knowledge_graph_layout.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "knowledge_graph_layout.h"
+
+#include <cmath>
+#include <limits>
+
+namespace m8r {
+
+using namespace std;
+
+constexpr double KnowledgeGraphLayout::MOVE_THRESHOLD;
+constexpr double KnowledgeGraphLayout::THETA_DEFAULT;
+constexpr double KnowledgeGraphLayout::THETA_MAX;
+constexpr double KnowledgeGraphLayout::EDGE_LENGTH_DEFAULT;
+
+KnowledgeGraphLayout::KnowledgeGraphLayout()
+    : edgeLength{EDGE_LENGTH_DEFAULT},
+      theta{THETA_DEFAULT},
+      bounded{false},
+      left{}, top{}, right{}, bottom{}
+{
+    heat();
+}
+
+KnowledgeGraphLayout::~KnowledgeGraphLayout()
+{
+}
+
+void KnowledgeGraphLayout::clear()
+{
+    graphNodes.clear();
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    degree.clear();
+    pinned.clear();
+    edgeSrc.clear();
+    edgeDst.clear();
+
+    heat();
+}
+
+void KnowledgeGraphLayout::setSubGraph(KnowledgeSubGraph& subgraph)
+{
+    clear();
+
+    if(subgraph.getCentralNode()) {
+        addNode(0, 0, subgraph.getCentralNode());
+        for(KnowledgeGraphNode* kn:subgraph.getChildren()) {
+            addEdge(0, addNode(0, 0, kn));
+        }
+        for(KnowledgeGraphNode* kn:subgraph.getParents()) {
+            addEdge(addNode(0, 0, kn), 0);
+        }
+    }
+}
+
+size_t KnowledgeGraphLayout::addNode(double x, double y, KnowledgeGraphNode* graphNode)
+{
+    graphNodes.push_back(graphNode);
+    this->x.push_back(x);
+    this->y.push_back(y);
+    vx.push_back(0);
+    vy.push_back(0);
+    degree.push_back(0);
+    pinned.push_back(false);
+
+    return this->x.size()-1;
+}
+
+void KnowledgeGraphLayout::addEdge(size_t src, size_t dst)
+{
+    edgeSrc.push_back(src);
+    edgeDst.push_back(dst);
+    degree[src]++;
+    degree[dst]++;
+}
+
+void KnowledgeGraphLayout::setTheta(double theta)
+{
+    // node's own cell must never be approximated: distance of the node from
+    // the center of mass of its cell is at most cell size / sqrt(2)
+    if(theta < 0) {
+        theta = 0;
+    } else if(theta > THETA_MAX) {
+        theta = THETA_MAX;
+    }
+    this->theta = theta;
+}
+
+void KnowledgeGraphLayout::setBounds(double left, double top, double right, double bottom)
+{
+    bounded = true;
+    this->left = left;
+    this->top = top;
+    this->right = right;
+    this->bottom = bottom;
+}
+
+void KnowledgeGraphLayout::heat()
+{
+    temperature = ceiling = edgeLength;
+    energy = numeric_limits<double>::max();
+    progress = 0;
+}
+
+void KnowledgeGraphLayout::split(int cell)
+{
+    int children = static_cast<int>(quadtree.size());
+    double half = quadtree[cell].half/2.0;
+    double cx = quadtree[cell].cx;
+    double cy = quadtree[cell].cy;
+    // quadrant index: (x >= cx) + 2*(y >= cy)
+    quadtree.push_back(Cell{cx-half, cy-half, half, 0, 0, 0, -1, -1});
+    quadtree.push_back(Cell{cx+half, cy-half, half, 0, 0, 0, -1, -1});
+    quadtree.push_back(Cell{cx-half, cy+half, half, 0, 0, 0, -1, -1});
+    quadtree.push_back(Cell{cx+half, cy+half, half, 0, 0, 0, -1, -1});
+    quadtree[cell].children = children;
+}
+
+void KnowledgeGraphLayout::insert(int cell, int node, int depth)
+{
+    const double nx = x[node];
+    const double ny = y[node];
+    while(true) {
+        // IMPORTANT split() invalidates references to cells
+        quadtree[cell].mass += 1;
+        quadtree[cell].mx += nx;
+        quadtree[cell].my += ny;
+
+        if(quadtree[cell].children < 0) {
+            if(quadtree[cell].node == -1) {
+                quadtree[cell].node = node;
+                return;
+            }
+            if(depth >= QUADTREE_MAX_DEPTH) {
+                quadtree[cell].node = -2;
+                return;
+            }
+
+            // push the node living in the leaf one level down
+            int other = quadtree[cell].node;
+            quadtree[cell].node = -1;
+            split(cell);
+            int c = quadtree[cell].children
+                + (x[other] >= quadtree[cell].cx) + 2*(y[other] >= quadtree[cell].cy);
+            quadtree[c].mass = 1;
+            quadtree[c].mx = x[other];
+            quadtree[c].my = y[other];
+            quadtree[c].node = other;
+        }
+
+        cell = quadtree[cell].children
+            + (nx >= quadtree[cell].cx) + 2*(ny >= quadtree[cell].cy);
+        depth++;
+    }
+}
+
+void KnowledgeGraphLayout::buildQuadtree()
+{
+    quadtree.clear();
+
+    double minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for(size_t i=1; i<x.size(); i++) {
+        if(x[i] < minX) minX = x[i]; else if(x[i] > maxX) maxX = x[i];
+        if(y[i] < minY) minY = y[i]; else if(y[i] > maxY) maxY = y[i];
+    }
+    double half = (maxX-minX > maxY-minY ? maxX-minX : maxY-minY)/2.0 + 1.0;
+    quadtree.push_back(Cell{(minX+maxX)/2.0, (minY+maxY)/2.0, half, 0, 0, 0, -1, -1});
+
+    for(size_t i=0; i<x.size(); i++) {
+        insert(0, static_cast<int>(i), 0);
+    }
+}
+
+void KnowledgeGraphLayout::repulse(size_t i, double& fx, double& fy)
+{
+    const double thetaSquare = theta*theta;
+    const int self = static_cast<int>(i);
+
+    stack.clear();
+    stack.push_back(0);
+    while(!stack.empty()) {
+        const Cell& c = quadtree[stack.back()];
+        stack.pop_back();
+
+        if(c.node == self) {
+            continue;
+        }
+
+        // vector from the center of mass to the node: AWAY force direction
+        double dx = x[i] - c.mx/c.mass;
+        double dy = y[i] - c.my/c.mass;
+        double d = dx*dx + dy*dy;
+        if(c.children < 0
+           || 4.0*c.half*c.half < thetaSquare*d)
+        {
+            // leaf or distant cell ~ one magnet w/ the mass of all its nodes
+            if(d > 0) {
+                double l = 2.0 * d;
+                fx += c.mass * dx * edgeLength / l;
+                fy += c.mass * dy * edgeLength / l;
+            }
+        } else {
+            for(int q=0; q<4; q++) {
+                if(quadtree[c.children+q].mass > 0) {
+                    stack.push_back(c.children+q);
+                }
+            }
+        }
+    }
+}
+
+void KnowledgeGraphLayout::calculateForces()
+{
+    if(x.empty()) {
+        return;
+    }
+
+    // NODES ~ REPULSE MAGNETS: forces pushing nodes AWAY
+    buildQuadtree();
+    for(size_t i=0; i<x.size(); i++) {
+        vx[i] = vy[i] = 0;
+        repulse(i, vx[i], vy[i]);
+    }
+
+    // EDGES ~ RUBBER BANDS: forces pulling nodes TOGETHER
+    for(size_t e=0; e<edgeSrc.size(); e++) {
+        unsigned s = edgeSrc[e];
+        unsigned d = edgeDst[e];
+        double dx = x[s] - x[d];
+        double dy = y[s] - y[d];
+        double weight = (degree[s] + 1) * 10.0;
+        vx[s] -= dx / weight;
+        vy[s] -= dy / weight;
+        weight = (degree[d] + 1) * 10.0;
+        vx[d] += dx / weight;
+        vy[d] += dy / weight;
+    }
+}
+
+bool KnowledgeGraphLayout::step()
+{
+    if(x.empty()) {
+        return false;
+    }
+
+    calculateForces();
+
+    bool moved = false;
+    double e = 0;
+    for(size_t i=0; i<x.size(); i++) {
+        if(pinned[i]) {
+            vx[i] = vy[i] = 0;
+            continue;
+        }
+
+        e += vx[i]*vx[i] + vy[i]*vy[i];
+
+        // limit displacement by temperature
+        double l = sqrt(vx[i]*vx[i] + vy[i]*vy[i]);
+        if(l > temperature) {
+            vx[i] *= temperature/l;
+            vy[i] *= temperature/l;
+        }
+
+        // round velocity to avoid moving FOREVER
+        if(fabs(vx[i]) < MOVE_THRESHOLD && fabs(vy[i]) < MOVE_THRESHOLD) {
+            vx[i] = vy[i] = 0;
+            continue;
+        }
+
+        double nx = x[i] + vx[i];
+        double ny = y[i] + vy[i];
+        if(bounded) {
+            nx = nx < left ? left : (nx > right ? right : nx);
+            ny = ny < top ? top : (ny > bottom ? bottom : ny);
+        }
+        if(nx != x[i] || ny != y[i]) {
+            x[i] = nx;
+            y[i] = ny;
+            moved = true;
+        }
+    }
+
+    // adaptive cooling: heat up after a series of improvements, cool down otherwise
+    if(e < energy) {
+        if(++progress >= PROGRESS_STEPS) {
+            progress = 0;
+            temperature /= COOLING;
+        }
+    } else {
+        progress = 0;
+        temperature *= COOLING;
+    }
+    energy = e;
+    ceiling *= CEILING_COOLING;
+    if(temperature > ceiling) {
+        temperature = ceiling;
+    }
+
+    return moved;
+}
+
+} // m8r namespace
@@ -0,0 +1,168 @@
+/*
+ knowledge_graph_layout.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_KNOWLEDGE_GRAPH_LAYOUT_H
+#define M8R_KNOWLEDGE_GRAPH_LAYOUT_H
+
+#include <vector>
+
+#include "knowledge_graph.h"
+
+namespace m8r {
+
+/**
+ * @brief Force-directed (magnets and rubber bands) layout of knowledge sub-graph.
+ *
+ * Layout is UI independent - navigator just copies node positions
+ * calculated by step() to its graphics items.
+ *
+ * Nodes repulse each other like magnets (force is inversely proportional
+ * to distance), edges pull nodes together like rubber bands. Repulsion
+ * is approximated using Barnes-Hut quadtree i.e. distant groups of nodes
+ * are replaced by their center of mass, which makes step O(n log n).
+ *
+ * Positions and velocities are stored as structure of arrays. Maximum
+ * node displacement per step is limited by temperature which is adapted
+ * to the progress of the layout: it's lowered when energy grows (layout
+ * oscillates) and raised after a series of improvements. Temperature
+ * ceiling cools down on every step so that the layout always converges.
+ */
+class KnowledgeGraphLayout
+{
+public:
+    // nodes w/ velocity below threshold (in both directions) don't move
+    static constexpr double MOVE_THRESHOLD = 0.3;
+    // Barnes-Hut: cell is approximated if cell size / distance < theta
+    static constexpr double THETA_DEFAULT = 0.5;
+    static constexpr double THETA_MAX = 0.7;
+    static constexpr double EDGE_LENGTH_DEFAULT = 300.0;
+
+private:
+    static constexpr double COOLING = 0.9;
+    static constexpr double CEILING_COOLING = 0.99;
+    static constexpr int PROGRESS_STEPS = 5;
+    // coincident nodes are aggregated in a leaf once max depth is reached
+    static constexpr int QUADTREE_MAX_DEPTH = 24;
+
+    /**
+     * @brief Quadtree cell.
+     */
+    struct Cell {
+        double cx, cy, half;
+        // center of mass accumulator
+        double mx, my, mass;
+        // index of the first of 4 children or -1 for leaf
+        int children;
+        // leaf: node index, -1 empty, -2 more coincident nodes
+        int node;
+    };
+
+    std::vector<KnowledgeGraphNode*> graphNodes;
+
+    // nodes: structure of arrays
+    std::vector<double> x, y;
+    std::vector<double> vx, vy;
+    std::vector<unsigned> degree;
+    std::vector<char> pinned;
+
+    // edges
+    std::vector<unsigned> edgeSrc, edgeDst;
+
+    std::vector<Cell> quadtree;
+    std::vector<int> stack;
+
+    double edgeLength;
+    double theta;
+
+    bool bounded;
+    double left, top, right, bottom;
+
+    double temperature;
+    double ceiling;
+    double energy;
+    int progress;
+
+public:
+    explicit KnowledgeGraphLayout();
+    KnowledgeGraphLayout(const KnowledgeGraphLayout&) = delete;
+    KnowledgeGraphLayout(const KnowledgeGraphLayout&&) = delete;
+    KnowledgeGraphLayout& operator=(const KnowledgeGraphLayout&) = delete;
+    KnowledgeGraphLayout& operator=(const KnowledgeGraphLayout&&) = delete;
+    ~KnowledgeGraphLayout();
+
+    /**
+     * @brief Set nodes and edges of the layout from sub-graph.
+     *
+     * Central node has index 0 and it's placed to [0,0], then go children
+     * and parents in the sub-graph order (all in [0,0] - use setPosition()).
+     */
+    void setSubGraph(KnowledgeSubGraph& subgraph);
+
+    size_t addNode(double x, double y, KnowledgeGraphNode* graphNode=nullptr);
+    void addEdge(size_t src, size_t dst);
+    void clear();
+
+    size_t size() const { return x.size(); }
+    KnowledgeGraphNode* getGraphNode(size_t i) const { return graphNodes[i]; }
+    double getX(size_t i) const { return x[i]; }
+    double getY(size_t i) const { return y[i]; }
+    void setPosition(size_t i, double x, double y) { this->x[i] = x; this->y[i] = y; }
+    /**
+     * @brief Pinned node (e.g. dragged by mouse) is not moved by the layout.
+     */
+    void setPinned(size_t i, bool pinned) { this->pinned[i] = pinned; }
+    bool isPinned(size_t i) const { return pinned[i]; }
+
+    double getEdgeLength() const { return edgeLength; }
+    void setEdgeLength(double edgeLength) { this->edgeLength = edgeLength; }
+    double getTheta() const { return theta; }
+    /**
+     * @brief Set Barnes-Hut precision: 0 is exact O(n^2) calculation.
+     */
+    void setTheta(double theta);
+    void setBounds(double left, double top, double right, double bottom);
+    double getTemperature() const { return temperature; }
+
+    /**
+     * @brief Restart cooling schedule e.g. when nodes were moved by user.
+     */
+    void heat();
+
+    /**
+     * @brief Calculate forces and move nodes.
+     *
+     * @return TRUE if at least one node moved, FALSE if layout converged.
+     */
+    bool step();
+
+    /**
+     * @brief Calculate velocity of all nodes (used by step()).
+     */
+    void calculateForces();
+    double getVelocityX(size_t i) const { return vx[i]; }
+    double getVelocityY(size_t i) const { return vy[i]; }
+
+private:
+    void buildQuadtree();
+    void insert(int cell, int node, int depth);
+    void split(int cell);
+    void repulse(size_t i, double& fx, double& fy);
+};
+
+}
+#endif // M8R_KNOWLEDGE_GRAPH_LAYOUT_H
@@ -18,6 +18,10 @@
  */
 #include "memory.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <set>
+
 #include "../gear/string_utils.h"
 
 using namespace std;
@@ -34,12 +38,23 @@ Memory::Memory(
       ontology{ontology},
       mdRepresentation{htmlRepresentation.getMarkdownRepresentation()},
       persistence(new FilesystemPersistence{mdRepresentation, htmlRepresentation}),
+      unflushedKeys{},
+      writeFailures{},
       twikiRepresentation{mdRepresentation, persistence},
       csvRepresentation{},
-      limbo{}
+      columnarRepresentation{},
+      limbo{},
+      indices{}
 {
     cache = true;
     mindScope = nullptr;
+
+    indices.push_back(&ftsIndex);
+    indices.push_back(&tagIndex);
+    indices.push_back(&nameIndex);
+    indices.push_back(&aggregates);
+    indices.push_back(&organizerIndex);
+    indices.push_back(&dirtyOutlines);
 }
 
 vector<Stencil*>& Memory::getStencils(ResourceType type)
@@ -56,9 +71,14 @@ vector<Stencil*>& Memory::getStencils(ResourceType type)
 
 void Memory::learn()
 {
+    flush();
     aware = true;
 
     repositoryIndexer.index(config.getActiveRepository());
+    if(config.isRepositoryWatch()) {
+        // watch before parsing so that no change is missed
+        repositoryIndexer.watch();
+    }
 
 #ifdef DO_MF_DEBUG
     MF_DEBUG(endl << "LEARNING repository in mode " << config.getActiveRepository()->getMode() << ":");
@@ -67,28 +87,7 @@ void Memory::learn()
 
     if(config.getActiveRepository()->getMode() == Repository::RepositoryMode::REPOSITORY) {
         MF_DEBUG(endl << "Markdown files:");
-        for(const string* markdownFile:repositoryIndexer.getMarkdownFiles()) {
-            Outline* outline = mdRepresentation.outline(File(*markdownFile));
-            MF_DEBUG(endl << "  '" << *markdownFile << "' format " << (outline->getFormat()==MarkdownDocument::Format::MINDFORGER?"MF":"MD"));
-
-            // fix O type according to repository type
-            switch(config.getActiveRepository()->getType()) {
-            case Repository::RepositoryType::MINDFORGER:
-                outline->setFormat(MarkdownDocument::Format::MINDFORGER);
-                break;
-            case Repository::RepositoryType::MARKDOWN:
-                outline->setFormat(MarkdownDocument::Format::MARKDOWN);
-                break;
-            }
-
-            if(outline->isVirgin()) {
-                MF_DEBUG(endl << "    VIRGIN ~ most probably wrongly parsed > SKIPPING it");
-                delete outline;
-            } else {
-                outlines.push_back(outline);
-                outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
-            }
-        }
+        learnOutlines(repositoryIndexer.getMarkdownFiles());
 
 #ifdef MF_WIP
         MF_DEBUG(endl << "PDF files:");
@@ -153,6 +152,7 @@ void Memory::learn()
             } else {
                 outlines.push_back(outline);
                 outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
+                indexOutline(outline);
             }
 
             MF_DEBUG(endl);
@@ -165,8 +165,217 @@ void Memory::learn()
 #endif
 }
 
+void Memory::learnOutlines(const set<const string*>& markdownFiles)
+{
+    // indexer orders files by pointers > sort by path to get the same order on every load
+    vector<const string*> files(markdownFiles.begin(), markdownFiles.end());
+    std::sort(files.begin(), files.end(), [](const string* a, const string* b) { return *a < *b; });
+    vector<Outline*> parsed(files.size(), nullptr);
+
+    // unchanged Os are loaded from snapshot, the rest is parsed
+    RepositorySnapshot snapshot{ontology};
+    string snapshotPath = getSnapshotPath();
+    if(!snapshotPath.empty()) {
+        snapshot.load(snapshotPath);
+    }
+    vector<char> fromSnapshot(files.size(), 0);
+    auto learnOutline = [&](size_t i) {
+        Outline* o = snapshot.outline(*files[i]);
+        if(o) {
+            fromSnapshot[i] = 1;
+            return o;
+        }
+        return mdRepresentation.outline(File(*files[i]));
+    };
+
+    size_t threads = config.getLearnThreads();
+    if(!threads) {
+        threads = thread::hardware_concurrency();
+    }
+    if(threads > files.size()) {
+        threads = files.size();
+    }
+
+    if(threads > 1) {
+        // lex & parse in parallel: workers pick files by index, therefore
+        // the result is independent of the scheduling
+        MF_DEBUG(endl << "  parsing in " << threads << " threads");
+        atomic<size_t> next{0};
+        exception_ptr failure{};
+        mutex failureMutex{};
+        auto worker = [&]() {
+            size_t i;
+            while((i = next++) < files.size()) {
+                try {
+                    parsed[i] = learnOutline(i);
+                } catch(...) {
+                    lock_guard<mutex> lock{failureMutex};
+                    if(!failure) {
+                        failure = current_exception();
+                    }
+                    next = files.size();
+                }
+            }
+        };
+
+        vector<thread> workers{};
+        for(size_t t=1; t<threads; t++) {
+            workers.push_back(thread{worker});
+        }
+        worker();
+        for(thread& w:workers) {
+            w.join();
+        }
+
+        if(failure) {
+            for(Outline* outline:parsed) {
+                delete outline;
+            }
+            rethrow_exception(failure);
+        }
+    } else {
+        for(size_t i=0; i<files.size(); i++) {
+            parsed[i] = learnOutline(i);
+        }
+    }
+
+    // merge sequentially in files order ~ the same result as sequential load
+    bool stale = false;
+    for(size_t i=0; i<files.size(); i++) {
+        Outline* outline = parsed[i];
+        MF_DEBUG(endl << "  '" << *files[i] << "' format " << (outline->getFormat()==MarkdownDocument::Format::MINDFORGER?"MF":"MD"));
+
+        fixOutlineFormat(outline);
+
+        if(outline->isVirgin()) {
+            MF_DEBUG(endl << "    VIRGIN ~ most probably wrongly parsed > SKIPPING it");
+            delete outline;
+        } else {
+            outlines.push_back(outline);
+            outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
+            indexOutline(outline);
+            if(!fromSnapshot[i]) {
+                stale = true;
+            }
+        }
+    }
+
+    // snapshot is written only if some O was parsed or removed
+    if(!snapshotPath.empty() && (stale || snapshot.size() != outlines.size())) {
+        RepositorySnapshot::save(snapshotPath, outlines);
+    }
+}
+
+string Memory::getSnapshotPath() const
+{
+    string path{};
+    Repository* r = config.getActiveRepository();
+    if(config.isRepositorySnapshot()
+       && r->getType() == Repository::RepositoryType::MINDFORGER
+       && r->getMode() == Repository::RepositoryMode::REPOSITORY)
+    {
+        // <cache>/MindForger/snapshots/<repository path hash>-repository.snapshot
+        path.assign(getSystemCachePath());
+        for(const char* dir:{"", DIRNAME_M8R_CACHE, DIRNAME_M8R_SNAPSHOTS}) {
+            if(*dir) {
+                path += FILE_PATH_SEPARATOR;
+                path += dir;
+            }
+            if(!isDirectory(path.c_str()) && !createDirectory(path)) {
+                path.clear();
+                return path;
+            }
+        }
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(stringHash(r->getDir())));
+        path += FILE_PATH_SEPARATOR;
+        path += key;
+        path += "-";
+        path += FILENAME_M8R_SNAPSHOT;
+    }
+    return path;
+}
+
+void Memory::fixOutlineFormat(Outline* outline)
+{
+    // fix O type according to repository type
+    switch(config.getActiveRepository()->getType()) {
+    case Repository::RepositoryType::MINDFORGER:
+        outline->setFormat(MarkdownDocument::Format::MINDFORGER);
+        break;
+    case Repository::RepositoryType::MARKDOWN:
+        outline->setFormat(MarkdownDocument::Format::MARKDOWN);
+        break;
+    }
+}
+
+int Memory::learnChanges(vector<Outline*>& forgotten, vector<Outline*>& learned)
+{
+    flush();
+
+    set<string> changed{}, removed{};
+    if(!aware || !repositoryIndexer.updateIndexFromWatch(changed, removed)) {
+        return -1;
+    }
+
+#ifdef DO_MF_DEBUG
+    auto begin = chrono::high_resolution_clock::now();
+#endif
+
+    for(const string& file:removed) {
+        Outline* o = getOutline(file);
+        if(o) {
+            MF_DEBUG("  REMOVED '" << file << "'" << endl);
+            forget(o);
+            forgotten.push_back(o);
+        }
+    }
+
+    for(const string& file:changed) {
+        Outline* outline = mdRepresentation.outline(File(file));
+        fixOutlineFormat(outline);
+
+        Outline* o = getOutline(file);
+        if(outline->isVirgin()) {
+            MF_DEBUG("  VIRGIN '" << file << "' ~ most probably wrongly parsed > SKIPPING it" << endl);
+            delete outline;
+            if(o) {
+                forget(o);
+                forgotten.push_back(o);
+            }
+            continue;
+        }
+
+        if(o) {
+            MF_DEBUG("  CHANGED '" << file << "'" << endl);
+            // new O takes the place of the old one
+            std::replace(outlines.begin(), outlines.end(), o, outline);
+            outlinesMap[outline->getKey()] = outline;
+            for(MemoryIndex* i:indices) {
+                i->replace(o, outline);
+            }
+            limboOutlines.push_back(o);
+            forgotten.push_back(o);
+        } else {
+            MF_DEBUG("  CREATED '" << file << "'" << endl);
+            outlines.push_back(outline);
+            outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
+            indexOutline(outline);
+        }
+        learned.push_back(outline);
+    }
+
+#ifdef DO_MF_DEBUG
+    auto end = chrono::high_resolution_clock::now();
+    MF_DEBUG("LEARNED " << changed.size()+removed.size() << " changed files in " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl);
+#endif
+
+    return static_cast<int>(changed.size()+removed.size());
+}
+
 void Memory::amnesia()
 {
+    flush();
     aware = false;
 
     repositoryIndexer.clear();
@@ -179,6 +388,9 @@ void Memory::amnesia()
     }
     outlines.clear();
     outlinesMap.clear();
+    for(MemoryIndex* i:indices) {
+        i->clear();
+    }
 
     for(Outline*& outline:limboOutlines) {
         delete outline;
@@ -231,6 +443,8 @@ void Memory::remember(const std::string& outlineKey)
         o->makeModified();
         o->checkAndFixProperties();
         persistence->save(o);
+        unflushedKeys.insert(o->getKey());
+        indexOutline(o);
     } else {
         throw MindForgerException{
             "Save: unable to find outline w/ given key (" + outlineKey + ") to save"
@@ -248,11 +462,51 @@ void Memory::remember(Outline* outline)
 
     outline->checkAndFixProperties();
     persistence->save(outline);
+    unflushedKeys.insert(outline->getKey());
 
     if(!getOutline(outline->getKey())) {
         outlines.push_back(outline);
         outlinesMap.insert(map<string,Outline*>::value_type(outline->getKey(), outline));
     }
+    indexOutline(outline);
+}
+
+void Memory::flush()
+{
+    persistence->flush();
+
+    // written files are stable now > own writes are not reported as changes
+    for(const string& key:unflushedKeys) {
+        repositoryIndexer.watchOwnWrite(key);
+    }
+    unflushedKeys.clear();
+
+    reconcileWrites();
+}
+
+void Memory::reconcileWrites()
+{
+    unordered_map<string,bool> results{};
+    persistence->takeWriteResults(results);
+    for(const auto& r:results) {
+        if(r.second) {
+            // O might be forgotten or temporary meanwhile
+            Outline* o = getOutline(r.first);
+            if(o) {
+                o->clearDirty();
+            }
+        } else {
+            writeFailures.push_back(r.first);
+        }
+    }
+}
+
+bool Memory::takeWriteFailures(vector<string>& keys)
+{
+    reconcileWrites();
+    keys.insert(keys.end(), writeFailures.begin(), writeFailures.end());
+    writeFailures.clear();
+    return !keys.empty();
 }
 
 void Memory::exportToHtml(Outline* outline, const string& fileName)
@@ -260,30 +514,61 @@ void Memory::exportToHtml(Outline* outline, const string& fileName)
     persistence->saveAsHtml(outline, fileName);
 }
 
-void Memory::exportToCsv(
+bool Memory::exportToCsv(
         const string& fileName,
         map<const Tag*,int>& tagsCardinality,
         int oheTagEncodingCardinality,
-        ProgressCallbackCtx* callbackCtx)
+        ProgressCallbackCtx* callbackCtx,
+        ThreadPool* workers)
 {
-    csvRepresentation.to(
+    return csvRepresentation.to(
         outlines,
         tagsCardinality,
         fileName,
         oheTagEncodingCardinality,
-        callbackCtx
+        callbackCtx,
+        workers
     );
 }
 
+bool Memory::exportToColumnar(
+        const string& fileName,
+        ProgressCallbackCtx* callbackCtx,
+        ThreadPool* workers)
+{
+    return columnarRepresentation.to(outlines, fileName, workers, callbackCtx);
+}
+
 void Memory::forget(Outline* outline)
 {
+    for(MemoryIndex* i:indices) {
+        i->forget(outline);
+    }
     outlinesMap.erase(outline->getKey());
     limboOutlines.push_back(outline);
     outlines.erase(std::remove(outlines.begin(), outlines.end(), outline), outlines.end());
 }
 
+void Memory::indexOutline(Outline* outline)
+{
+    for(MemoryIndex* i:indices) {
+        i->index(outline);
+    }
+}
+
+void Memory::forget(Note* note)
+{
+    Outline* o = note->getOutline();
+    o->forgetNote(note);
+    // forgotten Ns are deleted > O must be re-indexed
+    indexOutline(o);
+}
+
 Memory::~Memory()
 {
+    // barrier: all remembered Os must be written on exit
+    persistence->flush();
+
     for(Outline*& outline:outlines) {
         delete outline;
     }
@@ -306,22 +591,61 @@ unsigned Memory::getOutlinesCount() const
 
 unsigned Memory::getOutlineMarkdownsSize() const
 {
-    // IMPROVE introduce dirty flag (add/remove outline and recount only then)
-    unsigned int result{};
-    for(Outline* outline:outlines) {
-        result+=outline->getBytesize();
-    }
-    return result;
+    return aggregates.getBytesize();
 }
 
 unsigned Memory::getNotesCount() const
 {
-    // IMPROVE PERFORMANCE cache this number & introduce dirty flag (add/remove outline and recount only then)
-    unsigned int result{};
-    for(Outline* outline:outlines) {
-        result+=outline->getNotes().size();
+    return aggregates.getNotesCount();
+}
+
+void Memory::aggregateDirty()
+{
+    vector<Outline*> dirty{};
+    dirtyOutlines.take(dirty);
+    for(Outline* o:dirty) {
+        // forgotten Os (limbo) are not re-aggregated
+        if(aggregates.isAggregated(o)) {
+            aggregates.index(o);
+        }
+    }
+}
+
+bool Memory::checkAggregates(string* error) const
+{
+    if(!aggregates.check(outlines, error)) {
+        return false;
+    }
+
+    // tag cardinalities (tag is counted once per O/N)
+    map<const Tag*,int> expected{};
+    for(Outline* o:outlines) {
+        set<const Tag*> ts(o->getTags()->begin(), o->getTags()->end());
+        for(const Tag* t:ts) {
+            if(!stringistring(string("none"), t->getName())) {
+                expected[t]++;
+            }
+        }
+        for(Note* n:o->getNotes()) {
+            ts.clear();
+            ts.insert(n->getTags()->begin(), n->getTags()->end());
+            for(const Tag* t:ts) {
+                if(!stringistring(string("none"), t->getName())) {
+                    expected[t]++;
+                }
+            }
+        }
+    }
+    map<const Tag*,int> cardinality{};
+    tagIndex.getCardinality(cardinality);
+    if(expected != cardinality) {
+        if(error) {
+            *error = "tags cardinality";
+        }
+        return false;
     }
-    return result;
+
+    return true;
 }
 
 const vector<Outline*>& Memory::getOutlines() const
@@ -380,6 +704,38 @@ std::vector<Note*>& Memory::getAllNotes(vector<Note*>& notes, bool doSortByRead,
     return notes;
 }
 
+void Memory::organize(
+    Organizer* organizer,
+    vector<Note*>& upperLeftNs,
+    vector<Note*>& upperRightNs,
+    vector<Note*>& lowerLeftNs,
+    vector<Note*>& lowerRightNs
+) {
+    if(!organizerIndex.organize(
+           organizer, outlines, mindScope, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs))
+    {
+        // organizer w/ too many tags to be compiled is organized by the scan of all Os and Ns
+        vector<Note*> ons{}, ns{};
+        getAllNotes(ons, true, true);
+        getAllNotes(ns, true, false);
+        if(Organizer::OrganizerType::KANBAN == organizer->getOrganizerType()) {
+            Outline::organizeToKanbanColumns(
+                static_cast<Kanban*>(organizer),
+                ons, outlines, ns, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs);
+        } else {
+            Outline::organizeToEisenhowerMatrix(
+                organizer, ons, outlines, ns, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs);
+        }
+    }
+}
+
+void Memory::forgetOrganizer(Organizer* organizer)
+{
+    if(organizer) {
+        organizerIndex.forgetOrganizer(organizer->getKey());
+    }
+}
+
 const OutlineType* Memory::toOutlineType(const MarkdownAstSectionMetadata& meta)
 {
     UNUSED_ARG(meta);
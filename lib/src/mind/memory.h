@@ -21,6 +21,11 @@
 
 #include <vector>
 #include <map>
+#include <set>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
 
 #include "../debug.h"
 #include "../exceptions.h"
@@ -33,6 +38,7 @@
 #include "../representations/html/html_outline_representation.h"
 #include "../representations/twiki/twiki_outline_representation.h"
 #include "../representations/csv/csv_outline_representation.h"
+#include "../representations/columnar/columnar_outline_representation.h"
 #include "../model/outline.h"
 #include "../model/note.h"
 #include "../model/stencil.h"
@@ -40,7 +46,14 @@
 #include "../model/resource_types.h"
 #include "../persistence/persistence.h"
 #include "../persistence/filesystem_persistence.h"
+#include "../persistence/repository_snapshot.h"
 #include "aspect/mind_scope_aspect.h"
+#include "fts_index.h"
+#include "tag_index.h"
+#include "name_index.h"
+#include "aggregates.h"
+#include "dirty_outlines.h"
+#include "organizer_index.h"
 #include "limbo.h"
 
 namespace m8r {
@@ -67,8 +80,13 @@ private:
     Ontology& ontology;
     MarkdownOutlineRepresentation& mdRepresentation;
     Persistence* persistence;
+    // Os saved since the last flush (written in background)
+    std::set<std::string> unflushedKeys;
+    // Os which failed to be written (they stay dirty)
+    std::vector<std::string> writeFailures;
     TWikiOutlineRepresentation twikiRepresentation;
     CsvOutlineRepresentation csvRepresentation;
+    ColumnarOutlineRepresentation columnarRepresentation;
     MindScopeAspect* mindScope;
     Limbo limbo;
 
@@ -82,6 +100,37 @@ private:
     // IMPROVE unordered_map
     std::map<std::string,Outline*> outlinesMap;
 
+    /**
+     * @brief Full-text search index of Os and Ns (maintained on learn/remember/forget).
+     */
+    FtsIndex ftsIndex;
+
+    /**
+     * @brief Tag index of Os and Ns (maintained on learn/remember/forget).
+     */
+    TagIndex tagIndex;
+
+    /**
+     * @brief Name index of Os and Ns (maintained on learn/remember/forget).
+     */
+    NameIndex nameIndex;
+
+    /**
+     * @brief Counts, sizes and leaders of Os and Ns (maintained on learn/remember/forget).
+     */
+    Aggregates aggregates;
+
+    /**
+     * @brief Materialized organizer views (maintained on learn/remember/forget).
+     */
+    OrganizerIndex organizerIndex;
+
+    // Os made dirty since they were (re)indexed
+    DirtyOutlines dirtyOutlines;
+
+    // indices above which are maintained on learn/remember/forget
+    std::vector<MemoryIndex*> indices;
+
 public:
     explicit Memory(
         Configuration& configuration,
@@ -101,10 +150,26 @@ public:
 
     /**
      * @brief Learn repository content.
+     *
+     * Markdown files are parsed by Configuration::getLearnThreads() threads.
      */
     void learn();
     bool isAware() { return aware; }
 
+    /**
+     * @brief Learn repository changes made by others (requires repository watch).
+     *
+     * Only changed Markdown files are parsed. Changed Os are replaced by newly
+     * parsed instances and removed Os are forgotten - old instances are kept
+     * in limbo until amnesia as they might be still referenced.
+     *
+     * @param forgotten     Os which were replaced or removed.
+     * @param learned       Os which were created or parsed again.
+     * @return number of changed Markdown files, -1 if changes were lost
+     *         and repository must be learned from scratch.
+     */
+    int learnChanges(std::vector<Outline*>& forgotten, std::vector<Outline*>& learned);
+
     /**
      * @brief Forget everything.
      */
@@ -142,6 +207,22 @@ public:
      */
     void remember(Outline* outline);
 
+    /**
+     * @brief Wait until all remembered Os are written.
+     *
+     * Os are written in background - flush before O files are read, moved
+     * or deleted. Called on changes learning, amnesia and destruction.
+     */
+    void flush();
+
+    /**
+     * @brief Take keys of Os which failed to be written since the last call.
+     *
+     * Os are dirty until their write is confirmed - written Os are made
+     * clean, Os which failed to be written stay dirty.
+     */
+    bool takeWriteFailures(std::vector<std::string>& keys);
+
     /**
      * @brief Export Outline to HTML.
      */
@@ -149,12 +230,26 @@ public:
 
     /**
      * @brief Export memory to CSV.
+     *
+     * @param workers  thread pool to serialize Os in parallel (optional).
      */
-    void exportToCsv(
+    bool exportToCsv(
         const std::string& fileName,
         std::map<const Tag*,int>& tagsCardinality,
         int oheTagEncodingCardinality,
-        ProgressCallbackCtx* callbackCtx = nullptr
+        ProgressCallbackCtx* callbackCtx = nullptr,
+        ThreadPool* workers = nullptr
+    );
+
+    /**
+     * @brief Export memory to binary columnar file (numeric columns, tags and TF-IDF).
+     *
+     * @param workers  thread pool to process Os in parallel (optional).
+     */
+    bool exportToColumnar(
+        const std::string& fileName,
+        ProgressCallbackCtx* callbackCtx = nullptr,
+        ThreadPool* workers = nullptr
     );
 
     /**
@@ -162,6 +257,11 @@ public:
      */
     void forget(Outline* outline);
 
+    /**
+     * @brief Forget Note (and its children) of a known Outline.
+     */
+    void forget(Note* note);
+
     /**
      * @brief Get Ontology.
      * @return Ontology
@@ -210,15 +310,73 @@ public:
      */
     std::vector<Note*>& getAllNotes(std::vector<Note*>& notes, bool sortByRead=false, bool addNoteForOutline=false) const;
 
+    /**
+     * @brief Organize Os and Ns in Mind scope to Eisenhower Matrix quadrants or Kanban columns.
+     *
+     * @param organizer     organizer, default Eisenhower Matrix if nullptr
+     */
+    void organize(
+        Organizer* organizer,
+        std::vector<Note*>& upperLeftNs,
+        std::vector<Note*>& upperRightNs,
+        std::vector<Note*>& lowerLeftNs,
+        std::vector<Note*>& lowerRightNs);
+
+    /**
+     * @brief Forget materialized view of the organizer - call before organizer is deleted.
+     */
+    void forgetOrganizer(Organizer* organizer);
+
     /*
      * UTILS
      */
 
     RepositoryIndexer& getRepositoryIndexer() { return repositoryIndexer; }
+    const FtsIndex& getFtsIndex() const { return ftsIndex; }
+    const TagIndex& getTagIndex() const { return tagIndex; }
+    const NameIndex& getNameIndex() const { return nameIndex; }
+    const Aggregates& getAggregates() const { return aggregates; }
+    const DirtyOutlines& getDirtyOutlines() const { return dirtyOutlines; }
+    const OrganizerIndex& getOrganizerIndex() const { return organizerIndex; }
+
+    /**
+     * @brief Re-aggregate Os modified outside of memory (e.g. read counters incremented by views).
+     *
+     * Only Os made dirty since they were aggregated are processed.
+     */
+    void aggregateDirty();
+
+    /**
+     * @brief Check that incrementally maintained aggregates match full recalculation.
+     */
+    bool checkAggregates(std::string* error=nullptr) const;
     Persistence& getPersistence() const { return *persistence; }
 
+    /**
+     * @brief Get path of the active repository snapshot.
+     *
+     * Snapshot is NOT written to the repository (it would be versioned and synchronized
+     * w/ Markdown files), but to per-user cache directory - it's keyed by repository path.
+     *
+     * @return snapshot path if repository can be snapshotted, empty string otherwise.
+     */
+    std::string getSnapshotPath() const;
+
 private:
     const OutlineType* toOutlineType(const MarkdownAstSectionMetadata&);
+    void fixOutlineFormat(Outline* outline);
+    /**
+     * @brief Parse Markdown files (possibly in parallel) and merge Os to memory in paths order.
+     */
+    void learnOutlines(const std::set<const std::string*>& markdownFiles);
+    /**
+     * @brief (Re)index O by all indices.
+     */
+    void indexOutline(Outline* outline);
+    /**
+     * @brief Make written Os clean and collect Os which failed to be written.
+     */
+    void reconcileWrites();
 
 };
 
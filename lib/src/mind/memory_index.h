@@ -0,0 +1,59 @@
+/*
+ memory_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef M8R_MEMORY_INDEX_H
+#define M8R_MEMORY_INDEX_H
+
+#include "../model/outline.h"
+
+namespace m8r {
+
+/**
+ * @brief Index of Os and Ns which is maintained by memory on learn, remember and forget.
+ *
+ * Index is maintained at O granularity i.e. when an O or any of its Ns changes,
+ * O is indexed again.
+ */
+class MemoryIndex
+{
+public:
+    virtual ~MemoryIndex() {}
+
+    /**
+     * @brief Index O and its Ns - O is re-indexed if it's already known.
+     */
+    virtual void index(Outline* outline) = 0;
+
+    /**
+     * @brief Forget O and its Ns - Ns are NOT dereferenced (they might be already deleted).
+     */
+    virtual void forget(const Outline* outline) = 0;
+
+    /**
+     * @brief Index O which replaces old O instance (new O keeps its order).
+     */
+    virtual void replace(const Outline* oldOutline, Outline* newOutline) = 0;
+
+    /**
+     * @brief Forget everything.
+     */
+    virtual void clear() = 0;
+};
+
+}
+#endif // M8R_MEMORY_INDEX_H
@@ -46,13 +46,15 @@ Mind::Mind(Configuration &configuration)
       autolinking{nullptr},
 #endif
       exclusiveMind{},
+      activeProcesses{0},
+      relearnPending{false},
+      workers{},
       timeScopeAspect{},
       tagsScopeAspect{ontology},
       scopeAspect{timeScopeAspect, tagsScopeAspect}
 {
     ai = new Ai{memory,*this};
     deleteWatermark = 0;
-    activeProcesses = 0;
     associationsSemaphore = 0;
 
     knowledgeGraph = new KnowledgeGraph{this};
@@ -71,9 +73,14 @@ Mind::Mind(Configuration &configuration)
 
 Mind::~Mind()
 {
+    // queued tasks are cancelled, running tasks finish before AI is deleted
+    workers.shutdown();
+
     delete ai;
     delete knowledgeGraph;
     delete mdConfigRepresentation;
+    // configuration changes debounced in background must hit the disk before exit
+    ConfigurationStore::getInstance().flush();
     delete autoInterceptor;
     delete autolinking;
     delete stats;
@@ -98,6 +105,7 @@ bool Mind::learn()
 #ifdef MF_MD_2_HTML_CMARK
         autolinking->reindex();
 #endif
+        relearnPending = false;
         MF_DEBUG("Mind LEARNED " << memory.getOutlinesCount() << " Os" << endl);
         return true;
     } else {
@@ -106,6 +114,50 @@ bool Mind::learn()
     }
 }
 
+int Mind::learnChanges()
+{
+    lock_guard<mutex> criticalSection{exclusiveMind};
+
+    // relearn is scheduled by the caller (long running) > keep it pending until learn()
+    if(relearnPending) {
+        return -1;
+    }
+    if(!memory.getRepositoryIndexer().isWatching()) {
+        return 0;
+    }
+
+    vector<Outline*> forgotten{};
+    vector<Outline*> learned{};
+    int changes = memory.learnChanges(forgotten, learned);
+    if(changes < 0) {
+        MF_DEBUG("Learn changes: changes LOST > repository must be learned from scratch" << endl);
+        relearnPending = true;
+        return -1;
+    }
+
+    for(Outline* o:forgotten) {
+        ai->forget(o);
+#ifdef MF_MD_2_HTML_CMARK
+        if(config.isAutolinking()) {
+            autolinking->forget(o);
+        }
+#endif
+    }
+    for(Outline* o:learned) {
+        ai->remember(o);
+#ifdef MF_MD_2_HTML_CMARK
+        if(config.isAutolinking()) {
+            autolinking->remember(o);
+        }
+#endif
+    }
+    if(forgotten.size() || learned.size()) {
+        allNotesCache.clear();
+    }
+
+    return changes;
+}
+
 shared_future<bool> Mind::think()
 {
     MF_DEBUG("@Think w/ threshold " << config.getAsyncMindThreshold() << endl);
@@ -284,6 +336,34 @@ bool Mind::autolinkFindLongestPrefixWord(std::string& s, std::string& r) const
 #endif
 }
 
+void Mind::autolinkFindMatches(
+        const std::string& text,
+        const std::string& delimiters,
+        std::vector<AhoCorasick::Match>& matches) const
+{
+#ifdef MF_MD_2_HTML_CMARK
+    autolinking->findMatches(text, delimiters, matches);
+#else
+    UNUSED_ARG(text);
+    UNUSED_ARG(delimiters);
+    UNUSED_ARG(matches);
+#endif
+}
+
+bool Mind::autolinkFingerprint(u_int64_t& fingerprint) const
+{
+#ifdef MF_MD_2_HTML_CMARK
+    fingerprint = autolinking->getFingerprint();
+    if(config.isAutolinkingCaseInsensitive()) {
+        fingerprint = ~fingerprint;
+    }
+    return true;
+#else
+    fingerprint = 0;
+    return false;
+#endif
+}
+
 /*
  * Remembering
  */
@@ -292,6 +372,7 @@ bool Mind::autolinkFindLongestPrefixWord(std::string& s, std::string& r) const
 void Mind::remember(const std::string& outlineKey)
 {
     memory.remember(outlineKey);
+    ai->remember(memory.getOutline(outlineKey));
 
     // TODO onRemembering()
 
@@ -305,6 +386,7 @@ void Mind::remember(const std::string& outlineKey)
 void Mind::remember(Outline* outline)
 {
     memory.remember(outline);
+    ai->remember(outline);
 
 #ifdef MF_MD_2_HTML_CMARK
     if(config.isAutolinking()) {
@@ -316,6 +398,7 @@ void Mind::remember(Outline* outline)
 void Mind::forget(Outline* outline)
 {
     memory.forget(outline);
+    ai->forget(outline);
 
     // TODO onRemembering()
 
@@ -339,15 +422,6 @@ size_t Mind::getMemoryDwellDepth() const
     return memoryDwell.size();
 }
 
-/*
-vector<Note*>* Mind::findNoteByNameFts(const string& pattern) const
-{
-    UNUSED_ARG(pattern);
-
-    return nullptr;
-}
-*/
-
 void Mind::getOutlineNames(vector<string>& names) const
 {
     // IMPROVE PERF cache vector (stack member) until and evict on memory modification
@@ -358,111 +432,64 @@ void Mind::getOutlineNames(vector<string>& names) const
 }
 
 // One match in either title or body is enought to be added to the result
-void Mind::findNoteFts(
-        vector<Note*>* result,
+bool Mind::isFtsMatch(
+        const string& name,
+        const Description& description,
         const string& pattern,
         const FtsSearch searchMode,
-        Outline* outline)
+        const std::regex* regex) const
 {
-    // IMPROVE make this faster - do NOT convert to lower case, but compare it in that method > will do less
-    // IMPROVE avoid duplicate code - introduce an pre-processing iface (lower/nop) and used one code
     if(searchMode == FtsSearch::IGNORE_CASE) {
-        string s{};
-        stringToLower(outline->getName(), s);
-        if(s.find(pattern)!=string::npos) {
-            result->push_back(outline->getOutlineDescriptorAsNote());
-        } else {
-            for(string* d:outline->getDescription()) {
-                if(d) {
-                    s.clear();
-                    stringToLower(*d, s);
-                    if(s.find(pattern)!=string::npos) {
-                        result->push_back(outline->getOutlineDescriptorAsNote());
-                        break;
-                    }
-                }
-            }
+        // pattern is lowercase, text is case folded while searched
+        if(stringFindIgnoreCase(name, pattern)!=string::npos) {
+            return true;
         }
-        for(Note* note:outline->getNotes()) {
-            if(scopeAspect.isOutOfScope(note)) {
-                continue;
-            }
-            s.clear();
-            stringToLower(note->getName(), s);
-            if(s.find(pattern)!=string::npos) {
-                result->push_back(note);
-            } else {
-                for(string* d:note->getDescription()) {
-                    if(d) {
-                        s.clear();
-                        stringToLower(*d, s);
-                        if(s.find(pattern)!=string::npos) {
-                            result->push_back(note);
-                            break;
-                        }
-                    }
-                }
+        for(const Description::Line& l:description) {
+            if(stringFindIgnoreCase(l.data(), l.size(), pattern.data(), pattern.size())!=string::npos) {
+                return true;
             }
         }
     } else if (searchMode == FtsSearch::EXACT) {
-        if(outline->getName().find(pattern)!=string::npos) {
-            result->push_back(outline->getOutlineDescriptorAsNote());
-        } else {
-            for(string* d:outline->getDescription()) {
-                if(d && d->find(pattern)!=string::npos) {
-                    result->push_back(outline->getOutlineDescriptorAsNote());
-                    // avoid multiple matches in the result
-                    break;
-                }
-            }
+        if(name.find(pattern)!=string::npos) {
+            return true;
         }
-        for(Note* note:outline->getNotes()) {
-            if(scopeAspect.isOutOfScope(note)) {
-                continue;
-            }
-            if(note->getName().find(pattern)!=string::npos) {
-                result->push_back(note);
-            } else {
-                for(string* d:note->getDescription()) {
-                    if(d && d->find(pattern)!=string::npos) {
-                        result->push_back(note);
-                        // avoid multiple matches in the result
-                        break;
-                    }
-                }
+        for(const Description::Line& l:description) {
+            if(std::search(l.begin(), l.end(), pattern.begin(), pattern.end()) != l.end()) {
+                return true;
             }
         }
     } else if (searchMode == FtsSearch::REGEXP) {
         std::smatch matchedString;
-        std::regex regex{pattern};
-        if(std::regex_search(outline->getName(), matchedString, regex)) {
-            result->push_back(outline->getOutlineDescriptorAsNote());
-        } else {
-            for(string* d:outline->getDescription()) {
-                if(d && std::regex_search(*d, matchedString, regex)) {
-                    result->push_back(outline->getOutlineDescriptorAsNote());
-                    // avoid multiple matches in the result
-                    break;
-                }
-            }
+        if(std::regex_search(name, matchedString, *regex)) {
+            return true;
         }
-        for(Note* note:outline->getNotes()) {
-            if(scopeAspect.isOutOfScope(note)) {
-                continue;
-            }
-            if(std::regex_search(outline->getName(), matchedString, regex)) {
-                result->push_back(note);
-            } else {
-                for(string* d:note->getDescription()) {
-                    if(d && std::regex_search(*d, matchedString, regex)) {
-                        result->push_back(note);
-                        // avoid multiple matches in the result
-                        break;
-                    }
-                }
+        for(const Description::Line& l:description) {
+            if(std::regex_search(l.begin(), l.end(), *regex)) {
+                return true;
             }
         }
     }
+    return false;
+}
+
+void Mind::findNoteFts(
+        vector<Note*>* result,
+        const string& pattern,
+        const FtsSearch searchMode,
+        const std::regex* regex,
+        Outline* outline)
+{
+    if(isFtsMatch(outline->getName(), outline->getDescription(), pattern, searchMode, regex)) {
+        result->push_back(outline->getOutlineDescriptorAsNote());
+    }
+    for(Note* note:outline->getNotes()) {
+        if(scopeAspect.isOutOfScope(note)) {
+            continue;
+        }
+        if(isFtsMatch(note->getName(), note->getDescription(), pattern, searchMode, regex)) {
+            result->push_back(note);
+        }
+    }
 }
 
 // IMPROVE consider result be parameter passed by caller (reuse, mem)
@@ -480,16 +507,37 @@ vector<Note*>* Mind::findNoteFts(const string& pattern, FtsSearch searchMode, Ou
     } else {
         r.assign(pattern);
     }
+    unique_ptr<std::regex> regex{searchMode==FtsSearch::REGEXP?new std::regex{r}:nullptr};
 
     if(outlineScope) {
-        findNoteFts(result, r, searchMode, outlineScope);
+        findNoteFts(result, r, searchMode, regex.get(), outlineScope);
     } else {
-        const vector<m8r::Outline*> outlines = memory.getOutlines();
-        for(Outline* outline:outlines) {
-            if(scopeAspect.isOutOfScope(outline)) {
-                continue;
+        // index resolves candidates, verification pass checks candidates only
+        vector<pair<Outline*,Note*>> candidates{};
+        if(memory.getFtsIndex().findCandidates(r, searchMode, candidates)) {
+            for(const pair<Outline*,Note*>& c:candidates) {
+                if(scopeAspect.isOutOfScope(c.first)) {
+                    continue;
+                }
+                if(c.second) {
+                    if(!scopeAspect.isOutOfScope(c.second)
+                         &&
+                       isFtsMatch(c.second->getName(), c.second->getDescription(), r, searchMode, regex.get()))
+                    {
+                        result->push_back(c.second);
+                    }
+                } else if(isFtsMatch(c.first->getName(), c.first->getDescription(), r, searchMode, regex.get())) {
+                    result->push_back(c.first->getOutlineDescriptorAsNote());
+                }
+            }
+        } else {
+            const vector<m8r::Outline*>& outlines = memory.getOutlines();
+            for(Outline* outline:outlines) {
+                if(scopeAspect.isOutOfScope(outline)) {
+                    continue;
+                }
+                findNoteFts(result, r, searchMode, regex.get(), outline);
             }
-            findNoteFts(result, r, searchMode, outline);
         }
     }
     return result;
@@ -527,24 +575,17 @@ vector<Note*>* Mind::getRefereeNotes(const Note& note, const Outline& outline) c
 
 void Mind::findNotesByTags(const vector<const Tag*>& tags, vector<Note*>& result) const
 {
-    vector<Note*> allNotes{};
-    memory.getAllNotes(allNotes);
-    for(Note* n:allNotes) {
-        const vector<const Tag*>* thingTags = n->getTags();
-        bool hasAllTags=true;
-        for(size_t i=0; i<tags.size(); i++) {
-            if(std::find(
-                        thingTags->begin(),
-                        thingTags->end(),
-                        tags.at(i)) == thingTags->end())
-            {
-                hasAllTags=false;
-                break;
+    // Ns in scope - same as the scan of Memory::getAllNotes() which is filtered by Mind scope
+    if(scopeAspect.isEnabled()) {
+        vector<Note*> notes{};
+        memory.getTagIndex().findNotes(tags, notes);
+        for(Note* n:notes) {
+            if(scopeAspect.isInScope(n)) {
+                result.push_back(n);
             }
         }
-        if(hasAllTags) {
-            result.push_back(n);
-        }
+    } else {
+        memory.getTagIndex().findNotes(tags, result);
     }
 }
 
@@ -553,52 +594,25 @@ void Mind::getAllThings(
     vector<string>* thingsNames,
     string* pattern,
     ThingNameSerialization as,
-    Outline* currentO)
-{
-    const vector<Outline*>& os = getOutlines();
-    for(Outline* o:os) {
-        if((pattern && stringStartsWith(o->getName(), *pattern))
-              ||
-            pattern==nullptr)
-        {
-            things.push_back(o);
-            if(thingsNames) {
-                string s{};
-                switch(as) {
-                case ThingNameSerialization::LINK:
-                    // IMPROVE make this Note's method
-                    {
-                        s += "[";
-                        s += o->getName();
-                        s += "](";
-                        string p = RepositoryIndexer::makePathRelative(
-                             config.getActiveRepository(),
-                             currentO?currentO->getKey():o->getKey(),
-                             o->getKey());
-                        pathToLinuxDelimiters(p, p);
-                        s += p;
-                        s += ")";
-                        break;
-                    }
-                case ThingNameSerialization::NAME:
-                case ThingNameSerialization::SCOPED_NAME:
-                default:
-                    s += o->getName();
-                    break;
-                }
-                thingsNames->push_back(s);
-            }
-        }
-    }
-    vector<Note*> ns{};
-    getAllNotes(ns);
-    for(Note* n:ns) {
-        if((pattern && stringStartsWith(n->getName(), *pattern))
-              ||
-            pattern==nullptr)
-        {
-            things.push_back(n);
-            if(thingsNames) {
+    Outline* currentO,
+    size_t limit)
+{
+    // Os followed by Ns (or top limit things by reads) whose name starts w/ pattern ignoring case,
+    // Os and Ns are scoped like getOutlines() and getAllNotes() (which is filtered by Mind scope)
+    vector<Thing*> found{};
+    memory.getNameIndex().find(
+        pattern?*pattern:string{},
+        found,
+        false,
+        limit,
+        scopeAspect.isEnabled()?&scopeAspect:nullptr);
+
+    for(Thing* t:found) {
+        things.push_back(t);
+        if(thingsNames) {
+            // names (links) are materialized for found things only
+            Note* n = dynamic_cast<Note*>(t);
+            if(n) {
                 string s{};
                 switch(as) {
                 case ThingNameSerialization::NAME:
@@ -633,6 +647,32 @@ void Mind::getAllThings(
                     }
                 }
                 thingsNames->push_back(s);
+            } else {
+                Outline* o = static_cast<Outline*>(t);
+                string s{};
+                switch(as) {
+                case ThingNameSerialization::LINK:
+                    // IMPROVE make this Note's method
+                    {
+                        s += "[";
+                        s += o->getName();
+                        s += "](";
+                        string p = RepositoryIndexer::makePathRelative(
+                             config.getActiveRepository(),
+                             currentO?currentO->getKey():o->getKey(),
+                             o->getKey());
+                        pathToLinuxDelimiters(p, p);
+                        s += p;
+                        s += ")";
+                        break;
+                    }
+                case ThingNameSerialization::NAME:
+                case ThingNameSerialization::SCOPED_NAME:
+                default:
+                    s += o->getName();
+                    break;
+                }
+                thingsNames->push_back(s);
             }
         }
     }
@@ -645,9 +685,20 @@ const vector<Outline*>& Mind::getOutlines() const
 
     if(scopeAspect.isEnabled()) {
         result.clear();
-        for(Outline* o:memory.getOutlines()) {
-            if(scopeAspect.isInScope(o)) {
-                result.push_back(o);
+        if(tagsScopeAspect.isEnabled()) {
+            // tagged Os are candidates, time scope is checked on candidates only
+            vector<Outline*> tagged{};
+            memory.getTagIndex().findOutlines(tagsScopeAspect.getTags(), tagged);
+            for(Outline* o:tagged) {
+                if(scopeAspect.isInScope(o)) {
+                    result.push_back(o);
+                }
+            }
+        } else {
+            for(Outline* o:memory.getOutlines()) {
+                if(scopeAspect.isInScope(o)) {
+                    result.push_back(o);
+                }
             }
         }
         return result;
@@ -668,6 +719,16 @@ std::vector<Note*>& Mind::getAllNotes(vector<Note*>& notes, bool sortByRead, boo
     return memory.getAllNotes(notes, sortByRead, addNoteForOutline);
 }
 
+void Mind::organize(
+    Organizer* organizer,
+    vector<Note*>& upperLeftNs,
+    vector<Note*>& upperRightNs,
+    vector<Note*>& lowerLeftNs,
+    vector<Note*>& lowerRightNs
+) {
+    memory.organize(organizer, upperLeftNs, upperRightNs, lowerLeftNs, lowerRightNs);
+}
+
 vector<Note*>* Mind::getNotesOfType(const NoteType& type) const
 {
     UNUSED_ARG(type);
@@ -685,22 +746,7 @@ vector<Note*>* Mind::getNotesOfType(const NoteType& type, const Outline& outline
 
 void Mind::findOutlinesByTags(const std::vector<const Tag*>& tags, std::vector<Outline*>& result) const
 {
-    for(Outline* o:memory.getOutlines()) {
-        bool allMatched = true;
-        for(size_t i=0; i<tags.size(); i++) {
-            if(std::find(
-                        o->getTags()->begin(),
-                        o->getTags()->end(),
-                        tags.at(i)) == o->getTags()->end())
-            {
-                allMatched = false;
-                break;
-            }
-        }
-        if(allMatched) {
-            result.push_back(o);
-        }
-    }
+    memory.getTagIndex().findOutlines(tags, result);
 }
 
 vector<Tag*>* Mind::getOutlinesTags() const
@@ -717,47 +763,14 @@ void Mind::getTagsCardinality(map<const Tag*,int>& tagsCardinality)
 {
     if(ontology.getTags().size()) {
         for(const Tag* t:ontology.getTags().values()) {
-            // IMPROVE make NONE exclusion faster (checks in three loops below)
             if(!stringistring(string("none"), t->getName())) {
                 tagsCardinality[t] = 0;
             }
         }
-        const vector<Outline*>& outlines = memory.getOutlines();
-        bool doO, doN;
-        for(Outline* o:outlines) {
-            doO = false;
-            if(scopeAspect.isEnabled()) {
-                if(scopeAspect.isInScope(o)) {
-                    doO = true;
-                }
-            } else {
-                doO = true;
-            }
-            if(doO) {
-                for(const Tag* ot:*o->getTags()) {
-                    if(!stringistring(string("none"), ot->getName())) {
-                        tagsCardinality[ot] = tagsCardinality[ot]+1;
-                    }
-                }
-
-                doN = false;
-                for(Note* n:o->getNotes()) {
-                    if(scopeAspect.isEnabled()) {
-                        if(scopeAspect.isInScope(n)) {
-                            doN = true;
-                        }
-                    } else {
-                        doN = true;
-                    }
-                    if(doN) {
-                        for(const Tag* nt:*n->getTags()) {
-                            if(!stringistring(string("none"), nt->getName())) {
-                                tagsCardinality[nt] = tagsCardinality[nt]+1;
-                            }
-                        }
-                    }
-                }
-            }
+        if(scopeAspect.isEnabled()) {
+            memory.getTagIndex().getCardinality(tagsCardinality, &getOutlines(), &scopeAspect);
+        } else {
+            memory.getTagIndex().getCardinality(tagsCardinality);
         }
     } else {
         tagsCardinality.clear();
@@ -813,11 +826,13 @@ bool Mind::setOutlineUniqueTag(const Tag* tag, const string& outlineKey)
         for(Outline* mo:modifiedOutlines) {
             // persist Os w/ removed T (timestamp not changed)
             memory.remember(mo->getKey());
+            ai->remember(mo);
         }
 
         // mark O as modified
         o->addTag(tag);
         memory.remember(o->getKey());
+        ai->remember(o);
         return true;
     } else {
         return false;
@@ -928,6 +943,7 @@ Outline* Mind::outlineClone(const std::string& outlineKey)
         Outline* clonedOutline = new Outline{*o};
         clonedOutline->setKey(memory.createOutlineKey(&o->getName()));
         memory.remember(clonedOutline);
+        ai->remember(clonedOutline);
         onRemembering();
         return clonedOutline;
     } else {
@@ -944,6 +960,8 @@ bool Mind::outlineForget(string outlineKey)
         forget(o);
         auto k = memory.createLimboKey(&o->getName());
         o->setKey(k);
+        // O file might be still being written in background
+        memory.flush();
         moveFile(outlineKey, k);
         return true;
     }
@@ -1021,6 +1039,8 @@ Outline* Mind::noteRefactor(Note* noteToRefactor, const string& targetOutlineKey
 
             memory.remember(sourceOutline);
             memory.remember(targetOutline);
+            ai->remember(sourceOutline);
+            ai->remember(targetOutline);
 
             return targetOutline;
         } else {
@@ -1037,7 +1057,9 @@ Outline* Mind::noteForget(Note* note)
     if(o) {
         deleteWatermark++;
 
-        note->getOutline()->forgetNote(note);
+        memory.forget(note);
+        // forgotten Ns are deleted > AI must not dereference them
+        ai->remember(o);
         return o;
     } else {
         throw MindForgerException("Unable find Outline from which should be the Note deleted!");
@@ -1100,45 +1122,14 @@ void Mind::onRemembering()
 
 MindStatistics* Mind::getStatistics()
 {
-    // IMPROVE cache it until memory is dirty
-    const vector<Outline*>&os = memory.getOutlines();
-    if(os.size()) {
-        u_int32_t maxReads=0;
-        u_int32_t maxWrites=0;
-        for(Outline* o:os) {
-            if(o->getReads() > maxReads) {
-                maxReads = o->getReads();
-                stats->mostReadOutline = o;
-            }
-            if(o->getRevision() > maxWrites) {
-                maxWrites = o->getRevision();
-                stats->mostWrittenOutline = o;
-            }
-        }
-    } else {
-        stats->mostReadOutline = nullptr;
-        stats->mostWrittenOutline = nullptr;
-    }
+    // Os modified outside of memory (e.g. read counters incremented by views) are re-aggregated
+    memory.aggregateDirty();
 
-    vector<Note*> ns{};
-    memory.getAllNotes(ns);
-    if(ns.size()) {
-        u_int32_t maxReads=0;
-        u_int32_t maxWrites=0;
-        for(Note* n:ns) {
-            if(n->getReads() > maxReads) {
-                maxReads = n->getReads();
-                stats->mostReadNote = n;
-            }
-            if(n->getRevision() > maxWrites) {
-                maxWrites = n->getRevision();
-                stats->mostWrittenNote = n;
-            }
-        }
-    } else {
-        stats->mostReadNote = nullptr;
-        stats->mostWrittenNote = nullptr;
-    }
+    const Aggregates& aggregates = memory.getAggregates();
+    stats->mostReadOutline = aggregates.getMostReadOutline();
+    stats->mostWrittenOutline = aggregates.getMostWrittenOutline();
+    stats->mostReadNote = aggregates.getMostReadNote();
+    stats->mostWrittenNote = aggregates.getMostWrittenNote();
 
     map<const Tag*,int> ts{};
     getTagsCardinality(ts);
@@ -1179,15 +1170,18 @@ void Mind::recognizePersons(const Outline* outline, int entityFilter, std::vecto
 unique_ptr<vector<Outline*>> Mind::findOutlineByNameFts(const string& pattern) const
 {
     // IMPROVE implement regexp and other search options by reusing HSTR code
-    // IMPROVE PERF this method is extremely inefficient > use cached map (stack member) evicted on memory modification
     unique_ptr<vector<Outline*>> result{new vector<Outline*>()};
     if(pattern.size()) {
-        vector<Outline*> outlines = memory.getOutlines();
-        for(Outline* outline:outlines) {
-            if(!pattern.compare(outline->getName())) {
-                result->push_back(outline);
-            }
-        }
+        memory.getNameIndex().findOutlinesByName(pattern, *result);
+    }
+    return result;
+}
+
+unique_ptr<vector<Note*>> Mind::findNoteByNameFts(const string& pattern) const
+{
+    unique_ptr<vector<Note*>> result{new vector<Note*>()};
+    if(pattern.size()) {
+        memory.getNameIndex().findNotesByName(pattern, *result);
     }
     return result;
 }
@@ -20,6 +20,7 @@
 #define M8R_MIND_H_
 
 #include <inttypes.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <regex>
@@ -31,6 +32,8 @@
 #include "ontology/thing_class_rel_triple.h"
 #include "aspect/mind_scope_aspect.h"
 #include "../config/configuration.h"
+#include "../gear/thread_pool.h"
+#include "../gear/aho_corasick.h"
 #include "../representations/representation_interceptor.h"
 #include "../representations/markdown/markdown_configuration_representation.h"
 #ifdef MF_NER
@@ -45,12 +48,6 @@ class AutolinkingMind;
 
 constexpr auto NO_PARENT = 0xFFFF;
 
-enum class FtsSearch {
-    EXACT,
-    IGNORE_CASE,
-    REGEXP
-};
-
 struct MindStatistics {
     Outline* mostReadOutline;
     Outline* mostWrittenOutline;
@@ -169,7 +166,17 @@ private:
     /**
      * @brief Active mental processes.
      */
-    int activeProcesses;
+    std::atomic<int> activeProcesses;
+
+    /**
+     * @brief Repository changes were lost and it must be learned from scratch.
+     */
+    bool relearnPending;
+
+    /**
+     * @brief Workers of asynchronous mental processes (AI, NER, ...).
+     */
+    ThreadPool workers;
 
     /**
      * @brief Need for associations.
@@ -244,12 +251,12 @@ public:
     int getDeleteWatermark() const { return deleteWatermark; }
 
     /**
-     * @brief Synchronize both desired and current state and persist it.
+     * @brief Synchronize both desired and current state and persist it (in background).
      */
     void persistMindState(Configuration::MindState mindState) {
         config.setMindState(mindState);
         config.setDesiredMindState(mindState);
-        mdConfigRepresentation->save(config);
+        mdConfigRepresentation->saveLater(config);
     }
 
     /*
@@ -263,6 +270,19 @@ public:
      */
     bool learn();
 
+    /**
+     * @brief Learn changes made to the repository by others (e.g. git pull) since the last call.
+     *
+     * Requires repository watch (see Configuration::isRepositoryWatch()). Only
+     * changed files are parsed and memory, AI and autolinking indices are patched
+     * in place. If changes were lost, then the repository is NOT learned here (it would
+     * block the caller), but relearn is kept pending and the caller is expected to learn()
+     * it - until then every call returns -1.
+     *
+     * @return number of changed Markdown files, -1 if repository must be learned from scratch.
+     */
+    int learnChanges();
+
     /**
      * @brief Think to do useful things for user when searching, viewing or editing.
      *
@@ -290,9 +310,11 @@ public:
     /**
      * Manage active mind processes.
      */
+    bool isRelearnPending() const { return relearnPending; }
     bool isActiveProcesses() const { return activeProcesses==0; }
     void incActiveProcesses() { activeProcesses++; }
     void decActiveProcesses() { activeProcesses--; }
+    ThreadPool& getWorkers() { return workers; }
 
     /*
      * Autolinking
@@ -300,6 +322,19 @@ public:
 
     void autolinkUpdate(const std::string& oldName, const std::string& newName) const;
     bool autolinkFindLongestPrefixWord(std::string& s, std::string& r) const;
+    /**
+     * @brief Find autolinking whole word matches (delimited by delimiters) in one pass over the text.
+     */
+    void autolinkFindMatches(
+            const std::string& text,
+            const std::string& delimiters,
+            std::vector<AhoCorasick::Match>& matches) const;
+    /**
+     * @brief Fingerprint of autolinking index - autolinks are the same while it's the same.
+     *
+     * @return `false` if there is no autolinking index.
+     */
+    bool autolinkFingerprint(u_int64_t& fingerprint) const;
 
     /*
      * Knowledge graph
@@ -366,7 +401,10 @@ public:
      * @brief Find outline by name - exact match.
      */
     std::unique_ptr<std::vector<Outline*>> findOutlineByNameFts(const std::string& pattern) const;
-    //std::vector<Note*>* findNoteByNameFts(const std::string& pattern) const;
+    /**
+     * @brief Find note by name - exact match.
+     */
+    std::unique_ptr<std::vector<Note*>> findNoteByNameFts(const std::string& pattern) const;
     std::vector<Note*>* findNoteFts(
             const std::string& pattern,
             const FtsSearch mode = FtsSearch::EXACT,
@@ -416,6 +454,8 @@ public:
 
     /**
      * @brief Get Notes tagged by given tags (logical AND).
+     *
+     * Like getAllNotes(), only Ns in Mind scope are returned.
      */
     void findNotesByTags(const std::vector<const Tag*>& tags, std::vector<Note*>& result) const;
 
@@ -469,17 +509,44 @@ public:
      * TYPES
      */
 
+    /**
+     * @brief Get Os and Ns (in scope) whose name starts with pattern (ignoring case).
+     *
+     * Os are scoped like getOutlines() and Ns like getAllNotes() i.e. by Mind scope.
+     *
+     * @param limit if > 0, then only limit most read things are returned (and serialized).
+     */
     void getAllThings(
             std::vector<Thing*>& things,
             std::vector<std::string>* thingsNames=nullptr,
             std::string* pattern=nullptr,
             ThingNameSerialization as=ThingNameSerialization::SCOPED_NAME,
-            Outline* currentO=nullptr);
+            Outline* currentO=nullptr,
+            size_t limit=0);
     // IMPROVE rename to getAllOs()
     const std::vector<Outline*>& getOutlines() const;
     std::vector<Outline*>* getOutlinesOfType(const OutlineType& type) const;
 
     std::vector<Note*>& getAllNotes(std::vector<Note*>& notes, bool sortByRead=false, bool addNoteForOutline=false) const;
+
+    /**
+     * @brief Organize Os and Ns to Eisenhower Matrix quadrants or Kanban columns.
+     *
+     * Organizer views are materialized and maintained incrementally, therefore
+     * this is a lookup rather than a scan of all Os and Ns.
+     *
+     * @param organizer     organizer, default Eisenhower Matrix if nullptr
+     */
+    void organize(
+        Organizer* organizer,
+        std::vector<Note*>& upperLeftNs,
+        std::vector<Note*>& upperRightNs,
+        std::vector<Note*>& lowerLeftNs,
+        std::vector<Note*>& lowerRightNs);
+    /**
+     * @brief Forget organizer view - call before organizer is deleted.
+     */
+    void forgetOrganizer(Organizer* organizer) { memory.forgetOrganizer(organizer); }
     std::vector<Note*>* getNotesOfType(const NoteType& type) const;
     std::vector<Note*>* getNotesOfType(const NoteType& type, const Outline& outline) const;
 
@@ -683,10 +750,21 @@ private:
      */
     void onRemembering();
 
+    /**
+     * @brief Verify whether O or N name/description matches FTS pattern.
+     */
+    bool isFtsMatch(
+            const std::string& name,
+            const Description& description,
+            const std::string& pattern,
+            const FtsSearch searchMode,
+            const std::regex* regex) const;
+
     void findNoteFts(
             std::vector<Note*>* result,
             const std::string& pattern,
             const FtsSearch searchMode,
+            const std::regex* regex,
             Outline* outline);
 };
 
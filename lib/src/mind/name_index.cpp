@@ -0,0 +1,262 @@
+/*
+ name_index.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "name_index.h"
+
+#include <algorithm>
+
+#include "../gear/string_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+NameIndex::NameIndex()
+    : DocumentIndex{},
+      documentNames{},
+      names{},
+      sorted{},
+      tail{}
+{
+}
+
+NameIndex::~NameIndex()
+{
+}
+
+void NameIndex::clearDocuments()
+{
+    documentNames.clear();
+    names.clear();
+    sorted.clear();
+    tail.clear();
+}
+
+void NameIndex::addDocument(u_int32_t id)
+{
+    const Document& d = documents[id];
+    u_int32_t offset = static_cast<u_int32_t>(names.size());
+    stringToLower(d.note?d.note->getName():d.outline->getName(), names);
+
+    documentNames.push_back(DocumentName{offset, static_cast<u_int32_t>(names.size())-offset});
+    tail.push_back(id);
+}
+
+void NameIndex::index(Outline* outline)
+{
+    DocumentIndex::index(outline);
+
+    if(tail.size() > MERGE_THRESHOLD) {
+        merge();
+    }
+}
+
+bool NameIndex::isLess(u_int32_t a, u_int32_t b) const
+{
+    const DocumentName& da = documentNames[a];
+    const DocumentName& db = documentNames[b];
+    int c = names.compare(da.offset, da.size, names, db.offset, db.size);
+    return c < 0 || (c == 0 && a < b);
+}
+
+void NameIndex::merge()
+{
+    auto less = [this](u_int32_t a, u_int32_t b) { return isLess(a, b); };
+    auto dead = [this](u_int32_t id) { return !isLive(id); };
+
+    sorted.erase(std::remove_if(sorted.begin(), sorted.end(), dead), sorted.end());
+    tail.erase(std::remove_if(tail.begin(), tail.end(), dead), tail.end());
+    std::sort(tail.begin(), tail.end(), less);
+
+    vector<u_int32_t> merged{};
+    merged.reserve(sorted.size()+tail.size());
+    std::merge(sorted.begin(), sorted.end(), tail.begin(), tail.end(), std::back_inserter(merged), less);
+    sorted.swap(merged);
+    tail.clear();
+}
+
+void NameIndex::compact(const vector<u_int32_t>& remap)
+{
+    // drop names of dead documents
+    vector<DocumentName> liveDocumentNames{};
+    string liveNames{};
+    for(size_t id=0; id<documentNames.size(); id++) {
+        if(remap[id] != DEAD) {
+            const DocumentName& dn = documentNames[id];
+            liveDocumentNames.push_back(
+                DocumentName{static_cast<u_int32_t>(liveNames.size()), dn.size});
+            liveNames.append(names, dn.offset, dn.size);
+        }
+    }
+
+    // remapping preserves relative order of sorted documents
+    for(vector<u_int32_t>* ids:{&sorted, &tail}) {
+        size_t w = 0;
+        for(u_int32_t id:*ids) {
+            if(remap[id] != DEAD) {
+                (*ids)[w++] = remap[id];
+            }
+        }
+        ids->resize(w);
+    }
+
+    documentNames.swap(liveDocumentNames);
+    names.swap(liveNames);
+}
+
+void NameIndex::lookup(const string& lowerPattern, bool substring, vector<u_int32_t>& ids) const
+{
+    if(substring && lowerPattern.size()) {
+        for(u_int32_t id=0; id<documents.size(); id++) {
+            const DocumentName& dn = documentNames[id];
+            if(isLive(id)
+                 &&
+               stringFindIgnoreCase(
+                   names.data()+dn.offset, dn.size,
+                   lowerPattern.data(), lowerPattern.size()) != string::npos)
+            {
+                ids.push_back(id);
+            }
+        }
+    } else {
+        // binary search for the first name w/ the prefix
+        auto from = std::lower_bound(
+            sorted.begin(),
+            sorted.end(),
+            lowerPattern,
+            [this](u_int32_t id, const string& p) {
+                const DocumentName& dn = documentNames[id];
+                return names.compare(dn.offset, dn.size, p) < 0;
+            });
+        for(auto i=from; i!=sorted.end() && hasPrefix(*i, lowerPattern); ++i) {
+            if(isLive(*i)) {
+                ids.push_back(*i);
+            }
+        }
+        for(u_int32_t id:tail) {
+            if(isLive(id) && hasPrefix(id, lowerPattern)) {
+                ids.push_back(id);
+            }
+        }
+    }
+}
+
+void NameIndex::find(
+        const string& pattern,
+        vector<Thing*>& result,
+        bool substring,
+        size_t limit,
+        const MindScopeAspect* scope) const
+{
+    string lowerPattern{};
+    stringToLower(pattern, lowerPattern);
+
+    vector<u_int32_t> ids{};
+    lookup(lowerPattern, substring, ids);
+
+    if(scope) {
+        size_t w = 0;
+        for(u_int32_t id:ids) {
+            const Document& d = documents[id];
+            if(d.note?scope->isInScope(d.note):scope->isInScope(d.outline)) {
+                ids[w++] = id;
+            }
+        }
+        ids.resize(w);
+    }
+
+    // Os first, then Ns - both in memory order
+    auto inMemoryOrder = [this](u_int32_t a, u_int32_t b) {
+        const Document& da = documents[a];
+        const Document& db = documents[b];
+        if((da.note != nullptr) != (db.note != nullptr)) {
+            return db.note != nullptr;
+        }
+        return isBefore(a, b);
+    };
+
+    if(limit) {
+        limit = std::min(limit, ids.size());
+        // top K by reads - only K things are returned (and materialized by caller)
+        auto reads = [this](u_int32_t id) {
+            const Document& d = documents[id];
+            return d.note?d.note->getReads():d.outline->getReads();
+        };
+        std::partial_sort(
+            ids.begin(),
+            ids.begin()+limit,
+            ids.end(),
+            [&reads,&inMemoryOrder](u_int32_t a, u_int32_t b) {
+                u_int32_t ra = reads(a), rb = reads(b);
+                return ra > rb || (ra == rb && inMemoryOrder(a, b));
+            });
+        ids.resize(limit);
+    } else {
+        std::sort(ids.begin(), ids.end(), inMemoryOrder);
+    }
+
+    for(u_int32_t id:ids) {
+        const Document& d = documents[id];
+        if(d.note) {
+            result.push_back(d.note);
+        } else {
+            result.push_back(d.outline);
+        }
+    }
+}
+
+void NameIndex::findByName(const string& name, bool notes, vector<u_int32_t>& ids) const
+{
+    string lowerName{};
+    stringToLower(name, lowerName);
+
+    vector<u_int32_t> candidates{};
+    lookup(lowerName, false, candidates);
+    for(u_int32_t id:candidates) {
+        const Document& d = documents[id];
+        if((d.note != nullptr) == notes
+             &&
+           documentNames[id].size == lowerName.size()
+             &&
+           (notes?d.note->getName():d.outline->getName()) == name)
+        {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end(), [this](u_int32_t a, u_int32_t b) { return isBefore(a, b); });
+}
+
+void NameIndex::findOutlinesByName(const string& name, vector<Outline*>& result) const
+{
+    vector<u_int32_t> ids{};
+    findByName(name, false, ids);
+    for(u_int32_t id:ids) {
+        result.push_back(documents[id].outline);
+    }
+}
+
+void NameIndex::findNotesByName(const string& name, vector<Note*>& result) const
+{
+    vector<u_int32_t> ids{};
+    findByName(name, true, ids);
+    for(u_int32_t id:ids) {
+        result.push_back(documents[id].note);
+    }
+}
+
+} // m8r namespace
@@ -0,0 +1,120 @@
+/*
+ name_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_NAME_INDEX_H
+#define M8R_NAME_INDEX_H
+
+#include <string>
+#include <vector>
+
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "document_index.h"
+#include "aspect/mind_scope_aspect.h"
+
+namespace m8r {
+
+/**
+ * @brief Name index of Os and Ns for typeahead (link completion) and find by name.
+ *
+ * Lowercase names of all Os and Ns are stored in one character pool and
+ * documents are kept in an array sorted by lowercase name, therefore
+ * case insensitive prefix lookup is a binary search followed by scan of
+ * the matching range only. Substring lookup scans the pool (w/o any
+ * per-name allocation).
+ *
+ * Index is maintained at O granularity (see DocumentIndex). New documents
+ * are appended to a small unsorted tail which is merged into the sorted
+ * array once it grows, names of dead documents are dropped from the pool
+ * when the document table is compacted.
+ */
+class NameIndex : public DocumentIndex
+{
+private:
+    /**
+     * @brief Size of unsorted tail which triggers its merge to the sorted array.
+     */
+    static constexpr size_t MERGE_THRESHOLD = 256;
+
+    // lowercase name in the pool - document ID > range in names
+    struct DocumentName {
+        u_int32_t offset;
+        u_int32_t size;
+    };
+
+    std::vector<DocumentName> documentNames;
+    std::string names;
+    // documents sorted by lowercase name
+    std::vector<u_int32_t> sorted;
+    // documents which were not merged to sorted documents yet
+    std::vector<u_int32_t> tail;
+
+public:
+    explicit NameIndex();
+    NameIndex(const NameIndex&) = delete;
+    NameIndex(const NameIndex&&) = delete;
+    NameIndex& operator=(const NameIndex&) = delete;
+    NameIndex& operator=(const NameIndex&&) = delete;
+    ~NameIndex();
+
+    virtual void index(Outline* outline) override;
+
+    /**
+     * @brief Find Os and Ns whose name starts with (contains) pattern ignoring case.
+     *
+     * If limit is 0, then all Os are returned followed by all Ns (both in memory order),
+     * otherwise at most limit things with the highest number of reads are returned.
+     *
+     * @param scope     return only Os and Ns which are in the scope, all if nullptr
+     */
+    void find(
+            const std::string& pattern,
+            std::vector<Thing*>& result,
+            bool substring=false,
+            size_t limit=0,
+            const MindScopeAspect* scope=nullptr) const;
+
+    /**
+     * @brief Find Os whose name is (case sensitive) equal to name - in the order of Os in memory.
+     */
+    void findOutlinesByName(const std::string& name, std::vector<Outline*>& result) const;
+
+    /**
+     * @brief Find Ns whose name is (case sensitive) equal to name - in the order of Os in memory and Ns in O.
+     */
+    void findNotesByName(const std::string& name, std::vector<Note*>& result) const;
+
+protected:
+    virtual void addDocument(u_int32_t id) override;
+    virtual void compact(const std::vector<u_int32_t>& remap) override;
+    virtual void clearDocuments() override;
+
+private:
+    bool isLess(u_int32_t a, u_int32_t b) const;
+    bool hasPrefix(u_int32_t id, const std::string& lowerPrefix) const {
+        const DocumentName& dn = documentNames[id];
+        return dn.size >= lowerPrefix.size()
+            && !names.compare(dn.offset, lowerPrefix.size(), lowerPrefix);
+    }
+    void lookup(const std::string& lowerPattern, bool substring, std::vector<u_int32_t>& ids) const;
+    void findByName(const std::string& name, bool notes, std::vector<u_int32_t>& ids) const;
+    void merge();
+};
+
+}
+#endif // M8R_NAME_INDEX_H
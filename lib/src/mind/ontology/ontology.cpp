@@ -177,30 +177,21 @@ const Tag* Ontology::findOrCreateTag(const string& key) {
     // by convention tags are in LOWERCASE
     std::string k{};
     stringToLower(key, k);
-    auto result = tagTaxonomy.get(k);
-    if(!result) {
-        result = new Tag(k, &tagTaxonomy, colorPalette.colorForName(key));
-        tagTaxonomy.add(k, result);
-    }
-    return result;
+    return tagTaxonomy.intern(k, [&]() {
+        return new Tag(k, &tagTaxonomy, colorPalette.colorForName(key));
+    });
 }
 
 const OutlineType* Ontology::findOrCreateOutlineType(const string& key) {
-    auto result = outlineTypeTaxonomy.get(key);
-    if(!result) {
-        result = new OutlineType(key, &outlineTypeTaxonomy, Color::DARK_GRAY());
-        outlineTypeTaxonomy.add(key, result);
-    }
-    return result;
+    return outlineTypeTaxonomy.intern(key, [&]() {
+        return new OutlineType(key, &outlineTypeTaxonomy, Color::DARK_GRAY());
+    });
 }
 
 const NoteType* Ontology::findOrCreateNoteType(const std::string& key) {
-    auto result = noteTypeTaxonomy.get(key);
-    if(!result) {
-        result = new NoteType(key, &noteTypeTaxonomy, Color::DARK_GRAY());
-        noteTypeTaxonomy.add(key, result);
-    }
-    return result;
+    return noteTypeTaxonomy.intern(key, [&]() {
+        return new NoteType(key, &noteTypeTaxonomy, Color::DARK_GRAY());
+    });
 }
 
 void Ontology::load()
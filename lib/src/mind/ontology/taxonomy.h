@@ -19,6 +19,8 @@
 #ifndef M8R_TAXONOMY_H
 #define M8R_TAXONOMY_H
 
+#include <mutex>
+
 #include "ontology_vocabulary.h"
 
 namespace m8r {
@@ -29,6 +31,9 @@ class Clazz;
  * @brief Ontology taxonomy.
  *
  * See m8r::Ontology.
+ *
+ * Lookup and interning of classes is thread safe as Os are parsed
+ * by multiple threads on repository load.
  */
 template <class CLAZZ>
 class Taxonomy : public Clazz
@@ -40,6 +45,7 @@ class Taxonomy : public Clazz
 
 private:
     OntologyVocabulary<CLAZZ> classes;
+    std::mutex classesMutex;
 
 public:
     explicit Taxonomy();
@@ -54,6 +60,11 @@ public:
     MAP_SIZE size() { return classes.size(); }
     const CLAZZ* get(const std::string& name);
     void add(const std::string& key, const CLAZZ* clazz);
+    /**
+     * @brief Get class w/ given key or atomically add the one created by factory.
+     */
+    template <class FACTORY>
+    const CLAZZ* intern(const std::string& key, FACTORY factory);
     std::vector<const CLAZZ*>& values() { return classes.values(); }
     void clear() { classes.clear(); }
 
@@ -80,14 +91,29 @@ Taxonomy<CLAZZ>::~Taxonomy()
 template <class CLAZZ>
 const CLAZZ* Taxonomy<CLAZZ>::get(const std::string& name)
 {
+    std::lock_guard<std::mutex> lock{classesMutex};
     return classes.get(name);
 }
 
 template <class CLAZZ>
 void Taxonomy<CLAZZ>::add(const std::string& name, const CLAZZ* clazz)
 {
+    std::lock_guard<std::mutex> lock{classesMutex};
     classes.put(name, clazz);
 }
 
+template <class CLAZZ>
+template <class FACTORY>
+const CLAZZ* Taxonomy<CLAZZ>::intern(const std::string& key, FACTORY factory)
+{
+    std::lock_guard<std::mutex> lock{classesMutex};
+    const CLAZZ* result = classes.get(key);
+    if(!result) {
+        result = factory();
+        classes.put(key, result);
+    }
+    return result;
+}
+
 }
 #endif // M8R_TAXONOMY_H
@@ -0,0 +1,279 @@
+/*
+ organizer_index.cpp   MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "organizer_index.h"
+
+#include <algorithm>
+
+#include "../model/eisenhower_matrix.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr unsigned OrganizerIndex::QUADRANTS;
+constexpr unsigned OrganizerIndex::MAX_TAGS;
+
+// quadrants in Organizer::getStringTagsForQuadrant() order
+constexpr unsigned UPPER_LEFT = 0;
+constexpr unsigned UPPER_RIGHT = 1;
+constexpr unsigned LOWER_LEFT = 2;
+constexpr unsigned LOWER_RIGHT = 3;
+
+OrganizerIndex::OrganizerIndex()
+    : views{}
+{
+}
+
+OrganizerIndex::~OrganizerIndex()
+{
+}
+
+void OrganizerIndex::forgetOrganizer(const string& organizerKey)
+{
+    views.erase(organizerKey);
+}
+
+void OrganizerIndex::clear()
+{
+    views.clear();
+}
+
+void OrganizerIndex::index(Outline* outline)
+{
+    if(outline) {
+        for(auto& v:views) {
+            indexOutline(v.second, outline);
+        }
+    }
+}
+
+void OrganizerIndex::forget(const Outline* outline)
+{
+    for(auto& v:views) {
+        v.second.outlines.erase(outline);
+    }
+}
+
+void OrganizerIndex::replace(const Outline* oldOutline, Outline* newOutline)
+{
+    forget(oldOutline);
+    index(newOutline);
+}
+
+string OrganizerIndex::definitionOf(Organizer* organizer)
+{
+    if(!organizer || organizer->getKey() == EisenhowerMatrix::KEY_EISENHOWER_MATRIX) {
+        return EisenhowerMatrix::KEY_EISENHOWER_MATRIX;
+    }
+
+    string d{organizer->getKey()};
+    d += '\n';
+    d += std::to_string(organizer->getFilterBy());
+    d += '\n';
+    d += organizer->getOutlineScope();
+    for(unsigned q=0; q<QUADRANTS; q++) {
+        d += '\n';
+        for(const string& t:organizer->getStringTagsForQuadrant(q)) {
+            d += t;
+            d += '\t';
+        }
+    }
+    return d;
+}
+
+bool OrganizerIndex::compile(Organizer* organizer, View& view)
+{
+    view.eisenhowerMatrix = !organizer || organizer->getKey() == EisenhowerMatrix::KEY_EISENHOWER_MATRIX;
+    view.filterBy = view.eisenhowerMatrix?Organizer::FilterBy::OUTLINES:organizer->getFilterBy();
+    view.scope = view.eisenhowerMatrix?"":organizer->getOutlineScope();
+    view.names.clear();
+    view.bits.clear();
+    view.outlines.clear();
+    std::fill(std::begin(view.predicates), std::end(view.predicates), 0);
+
+    if(!view.eisenhowerMatrix) {
+        for(unsigned q=0; q<QUADRANTS; q++) {
+            for(const string& t:organizer->getStringTagsForQuadrant(q)) {
+                size_t bit = std::find(view.names.begin(), view.names.end(), t) - view.names.begin();
+                if(bit == view.names.size()) {
+                    if(bit == MAX_TAGS) {
+                        return false;
+                    }
+                    view.names.push_back(t);
+                }
+                view.predicates[q] |= static_cast<u_int64_t>(1) << bit;
+            }
+        }
+    }
+    return true;
+}
+
+u_int64_t OrganizerIndex::tagsMask(View& view, const vector<const Tag*>* tags)
+{
+    u_int64_t mask = 0;
+    if(tags) {
+        for(const Tag* t:*tags) {
+            auto b = view.bits.find(t);
+            if(b == view.bits.end()) {
+                // tag name is compared only once - on the first sight of the tag
+                u_int64_t bit = 0;
+                for(size_t i=0; i<view.names.size(); i++) {
+                    if(t->equals(view.names[i])) {
+                        bit = static_cast<u_int64_t>(1) << i;
+                        break;
+                    }
+                }
+                b = view.bits.insert(make_pair(t, bit)).first;
+            }
+            mask |= b->second;
+        }
+    }
+    return mask;
+}
+
+u_int8_t OrganizerIndex::quadrantsOf(const View& view, u_int64_t mask)
+{
+    u_int8_t quadrants = 0;
+    for(unsigned q=0; q<QUADRANTS; q++) {
+        if(view.predicates[q] && (mask & view.predicates[q]) == view.predicates[q]) {
+            quadrants |= 1 << q;
+        }
+    }
+    return quadrants;
+}
+
+void OrganizerIndex::indexOutline(View& view, Outline* outline)
+{
+    OutlineView& ov = view.outlines[outline];
+    ov.outline = 0;
+    for(unsigned q=0; q<QUADRANTS; q++) {
+        ov.notes[q].clear();
+    }
+
+    if(view.eisenhowerMatrix) {
+        // urgency and importance of Os
+        if(outline->getUrgency()>2) {
+            ov.outline = 1 << (outline->getImportance()>2?UPPER_RIGHT:UPPER_LEFT);
+        } else if(outline->getImportance()>2) {
+            ov.outline = 1 << LOWER_RIGHT;
+        } else if(outline->getImportance()>0) {
+            ov.outline = 1 << LOWER_LEFT;
+        }
+        return;
+    }
+
+    if(view.filterBy != Organizer::FilterBy::NOTES) {
+        ov.outline = quadrantsOf(view, tagsMask(view, outline->getTags()));
+    }
+    if(view.filterBy != Organizer::FilterBy::OUTLINES) {
+        for(Note* n:outline->getNotes()) {
+            u_int8_t quadrants = quadrantsOf(view, tagsMask(view, n->getTags()));
+            if(quadrants) {
+                for(unsigned q=0; q<QUADRANTS; q++) {
+                    if(quadrants & (1 << q)) {
+                        ov.notes[q].push_back(n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool OrganizerIndex::organize(
+    Organizer* organizer,
+    const vector<Outline*>& outlines,
+    const MindScopeAspect* mindScope,
+    vector<Note*>& upperLeftNs,
+    vector<Note*>& upperRightNs,
+    vector<Note*>& lowerLeftNs,
+    vector<Note*>& lowerRightNs
+) {
+    const string key{organizer?organizer->getKey():EisenhowerMatrix::KEY_EISENHOWER_MATRIX};
+    const string definition{definitionOf(organizer)};
+
+    auto v = views.find(key);
+    if(v == views.end() || v->second.definition != definition) {
+        MF_DEBUG("Compiling organizer view: " << key << endl);
+        View& view = views[key];
+        if(!compile(organizer, view)) {
+            views.erase(key);
+            return false;
+        }
+        view.definition = definition;
+        for(Outline* o:outlines) {
+            indexOutline(view, o);
+        }
+        v = views.find(key);
+    }
+    const View& view = v->second;
+
+    if(organizer) {
+        organizer->makeModified();
+    }
+
+    vector<Note*>* quadrants[QUADRANTS] = {&upperLeftNs, &upperRightNs, &lowerLeftNs, &lowerRightNs};
+
+    // Ns of the scope O (if it exists) w/o Mind scope filtering
+    const Outline* scope{nullptr};
+    if(view.filterBy == Organizer::FilterBy::NOTES && view.scope.size()) {
+        for(Outline* o:outlines) {
+            if(o->getKey() == view.scope) {
+                scope = o;
+                break;
+            }
+        }
+    }
+
+    for(Outline* o:outlines) {
+        if(scope && o != scope) {
+            continue;
+        }
+        auto ov = view.outlines.find(o);
+        if(ov == view.outlines.end()) {
+            continue;
+        }
+
+        if(ov->second.outline
+           && (view.filterBy != Organizer::FilterBy::OUTLINES_NOTES || !mindScope || mindScope->isInScope(o)))
+        {
+            Note* descriptor = o->getOutlineDescriptorAsNote();
+            for(unsigned q=0; q<QUADRANTS; q++) {
+                if(ov->second.outline & (1 << q)) {
+                    quadrants[q]->push_back(descriptor);
+                }
+            }
+        }
+        for(unsigned q=0; q<QUADRANTS; q++) {
+            for(Note* n:ov->second.notes[q]) {
+                if(scope || !mindScope || mindScope->isInScope(n)) {
+                    quadrants[q]->push_back(n);
+                }
+            }
+        }
+    }
+
+    if(!view.eisenhowerMatrix) {
+        for(unsigned q=0; q<QUADRANTS; q++) {
+            Outline::sortByRead(*quadrants[q]);
+        }
+    }
+    return true;
+}
+
+} // m8r namespace
@@ -0,0 +1,133 @@
+/*
+ organizer_index.h   MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_ORGANIZER_INDEX_H
+#define M8R_ORGANIZER_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "../model/organizer.h"
+#include "aspect/mind_scope_aspect.h"
+#include "memory_index.h"
+
+namespace m8r {
+
+/**
+ * @brief Organizer index: materialized Eisenhower Matrix quadrants and Kanban columns.
+ *
+ * Organizer definition is compiled to tag bitmask predicates - every distinct
+ * quadrant tag gets a bit, O/N is evaluated to the mask of organizer tags it
+ * has (tag to bit is resolved once per tag) and the quadrant predicate is mask
+ * inclusion.
+ *
+ * Organizer view is built on the first use and then it's maintained at O
+ * granularity i.e. when an O or any of its Ns changes (tags, urgency,
+ * importance, ...), O's contribution to the views is recalculated. Therefore
+ * showing an organizer is a lookup over Os instead of a scan of all Ns.
+ */
+class OrganizerIndex : public MemoryIndex
+{
+public:
+    /**
+     * @brief Quadrants/columns in Organizer::getStringTagsForQuadrant() order.
+     */
+    static constexpr unsigned QUADRANTS = 4;
+
+    /**
+     * @brief Maximum number of distinct tags of a compiled organizer.
+     */
+    static constexpr unsigned MAX_TAGS = 64;
+
+private:
+    struct OutlineView {
+        // quadrants (bits) which contain O descriptor
+        u_int8_t outline;
+        std::vector<Note*> notes[QUADRANTS];
+    };
+
+    struct View {
+        // organizer definition the view was compiled from
+        std::string definition;
+        bool eisenhowerMatrix;
+        int filterBy;
+        std::string scope;
+        // tag names - bit i ~ names[i]
+        std::vector<std::string> names;
+        // quadrant predicate: all tags (bits) must be present, 0 never matches
+        u_int64_t predicates[QUADRANTS];
+        // compiled tags
+        std::unordered_map<const Tag*,u_int64_t> bits;
+        std::unordered_map<const Outline*,OutlineView> outlines;
+    };
+
+    // organizer key to view
+    std::unordered_map<std::string,View> views;
+
+public:
+    explicit OrganizerIndex();
+    OrganizerIndex(const OrganizerIndex&) = delete;
+    OrganizerIndex(const OrganizerIndex&&) = delete;
+    OrganizerIndex& operator=(const OrganizerIndex&) = delete;
+    OrganizerIndex& operator=(const OrganizerIndex&&) = delete;
+    ~OrganizerIndex();
+
+    virtual void index(Outline* outline) override;
+    virtual void forget(const Outline* outline) override;
+    virtual void replace(const Outline* oldOutline, Outline* newOutline) override;
+    virtual void clear() override;
+
+    /**
+     * @brief Forget view of the deleted organizer.
+     */
+    void forgetOrganizer(const std::string& organizerKey);
+
+    /**
+     * @brief Organize Os and Ns to quadrants (columns) - equivalent of Outline::organizeTo*().
+     *
+     * View is (re)built if organizer is used for the first time or its definition changed.
+     *
+     * @param organizer     organizer, default Eisenhower Matrix if nullptr
+     * @param outlines      Os in memory order
+     * @param mindScope     Mind scope (Ns and O descriptors filter), all if nullptr
+     * @return false if organizer cannot be compiled (too many tags) and nothing was organized.
+     */
+    bool organize(
+        Organizer* organizer,
+        const std::vector<Outline*>& outlines,
+        const MindScopeAspect* mindScope,
+        std::vector<Note*>& upperLeftNs,
+        std::vector<Note*>& upperRightNs,
+        std::vector<Note*>& lowerLeftNs,
+        std::vector<Note*>& lowerRightNs);
+
+    size_t getViewsCount() const { return views.size(); }
+
+private:
+    static std::string definitionOf(Organizer* organizer);
+    static bool compile(Organizer* organizer, View& view);
+    static void indexOutline(View& view, Outline* outline);
+    static u_int64_t tagsMask(View& view, const std::vector<const Tag*>* tags);
+    static u_int8_t quadrantsOf(const View& view, u_int64_t mask);
+};
+
+}
+#endif // M8R_ORGANIZER_INDEX_H
@@ -0,0 +1,266 @@
+/*
+ tag_index.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "tag_index.h"
+
+#include <algorithm>
+
+#include "../gear/string_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+TagIndex::TagIndex()
+    : DocumentIndex{},
+      documentTags{},
+      tags{},
+      postings{},
+      tagIds{}
+{
+}
+
+TagIndex::~TagIndex()
+{
+}
+
+void TagIndex::clearDocuments()
+{
+    documentTags.clear();
+    tags.clear();
+    postings.clear();
+    tagIds.clear();
+}
+
+void TagIndex::addDocument(u_int32_t id)
+{
+    const Document& d = documents[id];
+    u_int32_t offset = static_cast<u_int32_t>(tags.size());
+
+    const vector<const Tag*>* thingTags = d.note?d.note->getTags():d.outline->getTags();
+    if(thingTags) {
+        for(const Tag* t:*thingTags) {
+            u_int32_t tagId;
+            auto i = tagIds.find(t);
+            if(i == tagIds.end()) {
+                tagId = static_cast<u_int32_t>(postings.size());
+                tagIds[t] = tagId;
+                postings.push_back(Postings{t, stringistring(string("none"), t->getName()), {}, {}, 0, 0});
+            } else {
+                tagId = i->second;
+            }
+
+            // tag might be listed twice
+            if(std::find(tags.begin()+offset, tags.end(), tagId) == tags.end()) {
+                tags.push_back(tagId);
+                // IDs are increasing > posting lists stay sorted
+                if(d.note) {
+                    postings[tagId].notes.push_back(id);
+                    postings[tagId].liveNotes++;
+                } else {
+                    postings[tagId].outlines.push_back(id);
+                    postings[tagId].liveOutlines++;
+                }
+            }
+        }
+    }
+
+    documentTags.push_back(DocumentTags{offset, static_cast<u_int32_t>(tags.size())-offset});
+}
+
+void TagIndex::forgetDocument(u_int32_t id)
+{
+    const DocumentTags& dt = documentTags[id];
+    // N is not dereferenced
+    bool note = documents[id].note != nullptr;
+    for(u_int32_t t=dt.offset; t<dt.offset+dt.count; t++) {
+        if(note) {
+            postings[tags[t]].liveNotes--;
+        } else {
+            postings[tags[t]].liveOutlines--;
+        }
+    }
+}
+
+void TagIndex::compact(const vector<u_int32_t>& remap)
+{
+    vector<DocumentTags> liveDocumentTags{};
+    vector<u_int32_t> liveTags{};
+    for(size_t id=0; id<documentTags.size(); id++) {
+        if(remap[id] != DEAD) {
+            const DocumentTags& dt = documentTags[id];
+            u_int32_t offset = static_cast<u_int32_t>(liveTags.size());
+            liveTags.insert(liveTags.end(), tags.begin()+dt.offset, tags.begin()+dt.offset+dt.count);
+            liveDocumentTags.push_back(DocumentTags{offset, dt.count});
+        }
+    }
+
+    for(Postings& p:postings) {
+        for(vector<u_int32_t>* ids:{&p.outlines, &p.notes}) {
+            size_t w = 0;
+            for(u_int32_t id:*ids) {
+                if(remap[id] != DEAD) {
+                    (*ids)[w++] = remap[id];
+                }
+            }
+            ids->resize(w);
+            ids->shrink_to_fit();
+        }
+    }
+
+    documentTags.swap(liveDocumentTags);
+    tags.swap(liveTags);
+}
+
+void TagIndex::query(const vector<const Tag*>& tags, bool notes, bool any, vector<u_int32_t>& ids) const
+{
+    if(tags.empty()) {
+        for(size_t id=0; id<documents.size(); id++) {
+            if(isLive(static_cast<u_int32_t>(id)) && (documents[id].note != nullptr) == notes) {
+                ids.push_back(static_cast<u_int32_t>(id));
+            }
+        }
+    } else {
+        vector<const vector<u_int32_t>*> lists{};
+        for(const Tag* t:tags) {
+            auto i = tagIds.find(t);
+            if(i == tagIds.end()) {
+                if(any) {
+                    continue;
+                } else {
+                    return;
+                }
+            }
+            lists.push_back(notes?&postings[i->second].notes:&postings[i->second].outlines);
+        }
+        if(lists.empty()) {
+            return;
+        }
+
+        if(any) {
+            // union
+            for(const vector<u_int32_t>* l:lists) {
+                ids.insert(ids.end(), l->begin(), l->end());
+            }
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        } else {
+            // intersection starting w/ the shortest list
+            std::sort(lists.begin(), lists.end(),
+                [](const vector<u_int32_t>* a, const vector<u_int32_t>* b) {
+                    return a->size() < b->size();
+                });
+            ids.assign(lists[0]->begin(), lists[0]->end());
+            for(size_t l=1; l<lists.size() && ids.size(); l++) {
+                const vector<u_int32_t>& list = *lists[l];
+                auto from = list.begin();
+                size_t w = 0;
+                for(u_int32_t id:ids) {
+                    from = std::lower_bound(from, list.end(), id);
+                    if(from == list.end()) {
+                        break;
+                    }
+                    if(*from == id) {
+                        ids[w++] = id;
+                    }
+                }
+                ids.resize(w);
+            }
+        }
+
+        // drop dead documents
+        size_t w = 0;
+        for(u_int32_t id:ids) {
+            if(isLive(id)) {
+                ids[w++] = id;
+            }
+        }
+        ids.resize(w);
+    }
+
+    std::sort(ids.begin(), ids.end(),
+        [this](u_int32_t a, u_int32_t b) { return isBefore(a, b); });
+}
+
+void TagIndex::findOutlines(const vector<const Tag*>& tags, vector<Outline*>& result, bool any) const
+{
+    vector<u_int32_t> ids{};
+    query(tags, false, any, ids);
+    for(u_int32_t id:ids) {
+        result.push_back(documents[id].outline);
+    }
+}
+
+void TagIndex::findNotes(const vector<const Tag*>& tags, vector<Note*>& result, bool any) const
+{
+    vector<u_int32_t> ids{};
+    query(tags, true, any, ids);
+    for(u_int32_t id:ids) {
+        result.push_back(documents[id].note);
+    }
+}
+
+void TagIndex::getCardinality(
+        map<const Tag*,int>& cardinality,
+        const vector<Outline*>* scope,
+        const MindScopeAspect* noteScope) const
+{
+    if(scope) {
+        // documents in scope
+        vector<char> inScope(documents.size(), 0);
+        for(const Outline* o:*scope) {
+            const vector<u_int32_t>* ids = getDocuments(o);
+            if(ids) {
+                for(u_int32_t id:*ids) {
+                    const Document& d = documents[id];
+                    if(!d.note || !noteScope || noteScope->isInScope(d.note)) {
+                        inScope[id] = 1;
+                    }
+                }
+            }
+        }
+
+        for(const Postings& p:postings) {
+            if(!p.none) {
+                int c = 0;
+                for(u_int32_t id:p.outlines) c += inScope[id];
+                for(u_int32_t id:p.notes) c += inScope[id];
+                if(c) {
+                    cardinality[p.tag] += c;
+                }
+            }
+        }
+    } else {
+        for(const Postings& p:postings) {
+            if(!p.none && (p.liveOutlines || p.liveNotes)) {
+                cardinality[p.tag] += p.liveOutlines + p.liveNotes;
+            }
+        }
+    }
+}
+
+int TagIndex::getCardinality(const Tag* tag) const
+{
+    auto i = tagIds.find(tag);
+    if(i != tagIds.end()) {
+        return postings[i->second].liveOutlines + postings[i->second].liveNotes;
+    }
+    return 0;
+}
+
+} // m8r namespace
@@ -0,0 +1,126 @@
+/*
+ tag_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_TAG_INDEX_H
+#define M8R_TAG_INDEX_H
+
+#include <map>
+#include <vector>
+#include <unordered_map>
+
+#include "../model/outline.h"
+#include "../model/note.h"
+#include "aspect/mind_scope_aspect.h"
+#include "document_index.h"
+
+namespace m8r {
+
+/**
+ * @brief Tag index: tag to sorted posting lists of Os and Ns.
+ *
+ * Documents are O descriptors (O tags) and Ns. Every tag has two posting
+ * lists - one for Os and one for Ns - of increasing document IDs, therefore
+ * multi-tag AND/OR queries are intersections/unions of sorted lists and tag
+ * cardinalities are kept up to date as documents are (re)indexed.
+ *
+ * Index is maintained at O granularity (see DocumentIndex). Tags of every
+ * document are remembered by the index, therefore live tag cardinalities
+ * are updated when a document is forgotten w/o dereferencing its N.
+ */
+class TagIndex : public DocumentIndex
+{
+private:
+    struct Postings {
+        const Tag* tag;
+        // tags named "none" are not counted
+        bool none;
+        std::vector<u_int32_t> outlines;
+        std::vector<u_int32_t> notes;
+        int liveOutlines;
+        int liveNotes;
+    };
+
+    // document tag IDs - document ID > range in tags
+    struct DocumentTags {
+        u_int32_t offset;
+        u_int32_t count;
+    };
+
+    std::vector<DocumentTags> documentTags;
+    std::vector<u_int32_t> tags;
+    std::vector<Postings> postings;
+    std::unordered_map<const Tag*,u_int32_t> tagIds;
+
+public:
+    explicit TagIndex();
+    TagIndex(const TagIndex&) = delete;
+    TagIndex(const TagIndex&&) = delete;
+    TagIndex& operator=(const TagIndex&) = delete;
+    TagIndex& operator=(const TagIndex&&) = delete;
+    ~TagIndex();
+
+    /**
+     * @brief Find Os which have all (any) given tags - in the order of Os in memory.
+     *
+     * All Os are returned if no tags are given.
+     */
+    void findOutlines(
+            const std::vector<const Tag*>& tags,
+            std::vector<Outline*>& result,
+            bool any=false) const;
+
+    /**
+     * @brief Find Ns which have all (any) given tags - in the order of Os in memory and Ns in O.
+     *
+     * All Ns are returned if no tags are given.
+     */
+    void findNotes(
+            const std::vector<const Tag*>& tags,
+            std::vector<Note*>& result,
+            bool any=false) const;
+
+    /**
+     * @brief Add number of Os and Ns which have the tag to tags cardinality (except "none" tags).
+     *
+     * @param scope     count only given Os (and their Ns), all Os if nullptr
+     * @param noteScope count only Ns which are in the scope, all Ns if nullptr
+     */
+    void getCardinality(
+            std::map<const Tag*,int>& cardinality,
+            const std::vector<Outline*>* scope=nullptr,
+            const MindScopeAspect* noteScope=nullptr) const;
+
+    /**
+     * @brief Number of Os and Ns which have the tag.
+     */
+    int getCardinality(const Tag* tag) const;
+
+    size_t getTagsCount() const { return tagIds.size(); }
+
+protected:
+    virtual void addDocument(u_int32_t id) override;
+    virtual void forgetDocument(u_int32_t id) override;
+    virtual void compact(const std::vector<u_int32_t>& remap) override;
+    virtual void clearDocuments() override;
+
+private:
+    void query(const std::vector<const Tag*>& tags, bool notes, bool any, std::vector<u_int32_t>& ids) const;
+};
+
+}
+#endif // M8R_TAG_INDEX_H
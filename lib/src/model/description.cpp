@@ -0,0 +1,103 @@
+/*
+ description.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "description.h"
+
+using namespace std;
+
+namespace m8r {
+
+const string Description::EMPTY_TEXT{};
+
+Description::Text& Description::mutableText()
+{
+    if(!text) {
+        text = make_shared<Text>();
+    } else if(text.use_count() > 1) {
+        text = make_shared<Text>(*text);
+    }
+    return *text;
+}
+
+void Description::appendTo(string& out, const string& separator) const
+{
+    if(separator == "\n") {
+        out += getText();
+    } else {
+        for(size_t i=0; i<size(); i++) {
+            Line l = line(i);
+            out.append(l.data(), l.size());
+            out += separator;
+        }
+    }
+}
+
+void Description::append(const char* line, size_t size)
+{
+    Text& t = mutableText();
+    t.bytes.append(line, size);
+    t.ends.push_back(static_cast<u_int32_t>(t.bytes.size()));
+    t.bytes += '\n';
+}
+
+void Description::append(const Description& description)
+{
+    if(description.size()) {
+        if(!text) {
+            text = description.text;
+        } else {
+            // shared reference ensures that text is copied if description is this
+            shared_ptr<Text> other = description.text;
+            Text& t = mutableText();
+            u_int32_t base = static_cast<u_int32_t>(t.bytes.size());
+            t.bytes += other->bytes;
+            for(u_int32_t e:other->ends) {
+                t.ends.push_back(base+e);
+            }
+        }
+    }
+}
+
+void Description::assign(const string& lines)
+{
+    clear();
+    if(lines.size()) {
+        Text& t = mutableText();
+        t.bytes.reserve(lines.size()+1);
+        size_t b = 0;
+        while(b < lines.size()) {
+            size_t e = lines.find('\n', b);
+            if(e == string::npos) {
+                e = lines.size();
+            }
+            t.bytes.append(lines, b, e-b);
+            t.ends.push_back(static_cast<u_int32_t>(t.bytes.size()));
+            t.bytes += '\n';
+            b = e+1;
+        }
+    }
+}
+
+void Description::reserve(size_t bytes, size_t lines)
+{
+    Text& t = mutableText();
+    t.bytes.reserve(bytes);
+    t.ends.reserve(lines);
+}
+
+} // m8r namespace
@@ -0,0 +1,166 @@
+/*
+ description.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_DESCRIPTION_H
+#define M8R_DESCRIPTION_H
+
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../definitions.h"
+
+namespace m8r {
+
+/**
+ * @brief O/N description: lines of Markdown in one contiguous buffer.
+ *
+ * Lines are stored in a single buffer where every line is terminated by \n
+ * (i.e. buffer is the description text as it is written to Markdown) and
+ * line index is a vector of line ends. Lines are accessed as views, therefore
+ * scanning of the description is a scan of contiguous memory and there is no
+ * heap allocation per line.
+ *
+ * Buffer is shared by copies and copied on write, therefore description copy
+ * (O clone, O descriptor as N, edit of auxiliary Os/Ns) is O(1). Empty
+ * description doesn't allocate anything.
+ */
+class Description
+{
+public:
+    /**
+     * @brief Line view - valid until the description is modified or deleted.
+     */
+    class Line
+    {
+    private:
+        const char* b;
+        size_t n;
+
+    public:
+        explicit Line(const char* b, size_t n) : b{b}, n{n} {}
+
+        const char* data() const { return b; }
+        size_t size() const { return n; }
+        bool empty() const { return !n; }
+        const char* begin() const { return b; }
+        const char* end() const { return b+n; }
+        char operator[](size_t i) const { return b[i]; }
+        std::string str() const { return std::string{b, n}; }
+
+        bool startsWith(const char* prefix) const {
+            size_t p = std::strlen(prefix);
+            return p <= n && !std::memcmp(b, prefix, p);
+        }
+        bool startsWith(const std::string& prefix) const {
+            return prefix.size() <= n && !std::memcmp(b, prefix.data(), prefix.size());
+        }
+        bool operator==(const std::string& s) const {
+            return s.size() == n && !std::memcmp(b, s.data(), n);
+        }
+    };
+
+    class Iterator : public std::iterator<std::forward_iterator_tag,Line>
+    {
+    private:
+        const Description* d;
+        size_t i;
+
+    public:
+        explicit Iterator(const Description* d, size_t i) : d{d}, i{i} {}
+
+        Line operator*() const { return d->line(i); }
+        Iterator& operator++() { ++i; return *this; }
+        bool operator==(const Iterator& o) const { return i == o.i; }
+        bool operator!=(const Iterator& o) const { return i != o.i; }
+    };
+
+private:
+    struct Text {
+        // lines, each terminated by \n
+        std::string bytes;
+        // offsets of lines' \n
+        std::vector<u_int32_t> ends;
+    };
+
+    static const std::string EMPTY_TEXT;
+
+    std::shared_ptr<Text> text;
+
+public:
+    explicit Description() : text{} {}
+    /**
+     * @brief Description of text lines (split like std::getline()).
+     */
+    explicit Description(const std::string& lines) : text{} { assign(lines); }
+    Description(const Description&) = default;
+    Description(Description&&) = default;
+    Description& operator=(const Description&) = default;
+    Description& operator=(Description&&) = default;
+    ~Description() = default;
+
+    size_t size() const { return text ? text->ends.size() : 0; }
+    bool empty() const { return !size(); }
+    /**
+     * @brief Size of text i.e. lines w/ \n.
+     */
+    size_t getBytesize() const { return text ? text->bytes.size() : 0; }
+
+    Line line(size_t i) const {
+        size_t b = i ? text->ends[i-1]+1 : 0;
+        return Line{text->bytes.data()+b, text->ends[i]-b};
+    }
+    Line operator[](size_t i) const { return line(i); }
+    Iterator begin() const { return Iterator{this, 0}; }
+    Iterator end() const { return Iterator{this, size()}; }
+
+    /**
+     * @brief Description text - lines each terminated by \n.
+     */
+    const std::string& getText() const { return text ? text->bytes : EMPTY_TEXT; }
+    /**
+     * @brief Append lines joined w/ separator (separator is appended also after the last line).
+     */
+    void appendTo(std::string& out, const std::string& separator) const;
+
+    void append(const char* line, size_t size);
+    void append(const std::string& line) { append(line.data(), line.size()); }
+    void append(const Description& description);
+    /**
+     * @brief Replace description w/ lines of text (split like std::getline()).
+     */
+    void assign(const std::string& lines);
+    void reserve(size_t bytes, size_t lines);
+    void clear() { text.reset(); }
+
+    bool operator==(const Description& o) const {
+        return text == o.text || (size() == o.size() && getText() == o.getText());
+    }
+    bool operator!=(const Description& o) const { return !(*this == o); }
+
+private:
+    /**
+     * @brief Text to be modified - it's copied if it's shared w/ other descriptions.
+     */
+    Text& mutableText();
+};
+
+}
+#endif // M8R_DESCRIPTION_H
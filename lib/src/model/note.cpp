@@ -46,11 +46,8 @@ Note::Note(const Note& n)
 {
     name = n.name;
     autolinkName();
-    if(n.description.size()) {
-        for(string* s:n.description) {
-            description.push_back(new string(*s));
-        }
-    }
+    // description buffer is shared until one of Ns is edited
+    description = n.description;
 
     depth = n.depth;
     created = n.created;
@@ -72,9 +69,6 @@ Note::Note(const Note& n)
 
 Note::~Note()
 {
-    for(string* d:description) {
-        delete d;
-    }
     for(Link* l:links) {
         delete l;
     }
@@ -126,6 +120,9 @@ u_int16_t Note::getDepth() const
 void Note::setDepth(u_int16_t depth)
 {
     this->depth = depth;
+    if(outline) {
+        outline->invalidateNoteTree();
+    }
 }
 
 void Note::makeModified()
@@ -151,32 +148,22 @@ void Note::setModified(time_t modified)
 
 const string& Note::getModifiedPretty() const
 {
-    return modifiedPretty;
+    return modifiedPretty.get(modified);
 }
 
 void Note::setModifiedPretty()
 {
-    this->modifiedPretty = datetimeToPrettyHtml(modified);
-}
-
-void Note::setModifiedPretty(const string& modifiedPretty)
-{
-    this->modifiedPretty = modifiedPretty;
+    modifiedPretty.clear();
 }
 
 const string& Note::getReadPretty() const
 {
-    return readPretty;
+    return readPretty.get(read);
 }
 
 void Note::setReadPretty()
 {
-    this->readPretty = datetimeToPrettyHtml(read);
-}
-
-void Note::setReadPretty(const string& readPretty)
-{
-    this->readPretty = readPretty;
+    readPretty.clear();
 }
 
 u_int8_t Note::getProgress() const
@@ -284,49 +271,31 @@ void Note::clear()
     description.clear();
 }
 
-const vector<string*>& Note::getDescription() const
+const Description& Note::getDescription() const
 {
     return description;
 }
 
 string Note::getDescriptionAsString(const std::string& separator) const
-{    
-    // IMPROVE cache narrowed description for performance & return it by reference
+{
     string result{};
-    if(description.size()) {
-        for(string *s:description) {
-            result += *s;
-            result += separator;
-        }
-    }
+    description.appendTo(result, separator);
     return result;
 }
 
-void Note::setDescription(const vector<string*>& description)
+void Note::setDescription(const Description& description)
 {
     this->description = description;
 }
 
-void Note::moveDescription(std::vector<std::string*>& target)
-{
-    if(description.size()) {
-        // IMPROVE find a more efficient method - perhaps an algorithm function
-        for(auto& s:description) {
-            target.push_back(s);
-        }
-        description.clear();
-    }
-}
-
 void Note::clearDescription()
 {
     this->description.clear();
 }
 
-void Note::addDescription(const vector<string*>& d)
+void Note::addDescription(const Description& d)
 {
-    // IMPROVE why not description.push_back(d);
-    description.insert(description.end(),d.begin(),d.end());
+    description.append(d);
 }
 
 Outline* Note::getOutline() const
@@ -348,11 +317,9 @@ string& Note::getOutlineKey() const
     }
 }
 
-void Note::addDescriptionLine(string *line)
+void Note::addDescriptionLine(const string& line)
 {
-    if(line) {
-        description.push_back(line);
-    }
+    description.append(line);
 }
 
 void Note::setType(const NoteType* type)
@@ -412,7 +379,7 @@ void Note::completeProperties(const time_t outlineModificationTime)
     }
 
     if(description.empty()) {
-        description.push_back(new string{""});
+        description.append("");
     }
 
     checkAndFixProperties();
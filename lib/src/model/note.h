@@ -24,11 +24,13 @@
 #include <string>
 
 #include "../definitions.h"
+#include "description.h"
 #include "outline.h"
 #include "note_type.h"
 #include "tag.h"
 #include "link.h"
 #include "../exceptions.h"
+#include "../gear/datetime_utils.h"
 
 namespace m8r {
 
@@ -64,11 +66,12 @@ private:
     std::vector<const Tag*> tags;
     std::vector<Link*> links;
     const NoteType* type;
-    std::vector<std::string*> description;
+    Description description;
 
-    std::string modifiedPretty;
+    // pretty timestamps are calculated lazily on presentation
+    PrettyDatetime modifiedPretty;
     u_int32_t revision;
-    std::string readPretty;
+    PrettyDatetime readPretty;
     u_int32_t reads;
 
     u_int8_t progress;
@@ -110,7 +113,6 @@ public:
     void makeModified();
     const std::string& getModifiedPretty() const;
     void setModifiedPretty();
-    void setModifiedPretty(const std::string& modifiedPretty);
     std::string& getOutlineKey() const;
     u_int8_t getProgress() const;
     void setProgress(u_int8_t progress);
@@ -119,7 +121,6 @@ public:
     void makeRead();
     const std::string& getReadPretty() const;
     void setReadPretty();
-    void setReadPretty(const std::string& readPretty);
     u_int32_t getReads() const;
     void setReads(u_int32_t reads);
     u_int32_t getRevision() const;
@@ -148,13 +149,12 @@ public:
     void addName(const std::string& s);
     const NoteType* getType() const;
     void setType(const NoteType* type);
-    const std::vector<std::string*>& getDescription() const;
+    const Description& getDescription() const;
     std::string getDescriptionAsString(const std::string& separator="\n") const;
-    void setDescription(const std::vector<std::string*>& description);
-    void moveDescription(std::vector<std::string*>& target);
+    void setDescription(const Description& description);
     void clearDescription();
-    void addDescription(const std::vector<std::string*>& d);
-    void addDescriptionLine(std::string *line);
+    void addDescription(const Description& d);
+    void addDescriptionLine(const std::string& line);
     Outline* getOutline() const;
     void setOutline(Outline* outline);
 
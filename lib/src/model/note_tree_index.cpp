@@ -0,0 +1,165 @@
+/*
+ note_tree_index.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "note_tree_index.h"
+
+#include "note.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr u_int32_t NoteTreeIndex::NO_PARENT;
+
+NoteTreeIndex::NoteTreeIndex()
+    : valid{},
+      offsets{},
+      parents{},
+      spans{},
+      childrenCounts{},
+      rootsCount{},
+      stack{}
+{
+}
+
+NoteTreeIndex::~NoteTreeIndex()
+{
+}
+
+void NoteTreeIndex::build(const vector<Note*>& notes)
+{
+    offsets.clear();
+    offsets.reserve(notes.size());
+    parents.resize(notes.size());
+    spans.resize(notes.size());
+    childrenCounts.resize(notes.size());
+
+    layout(notes, 0, notes.size(), NO_PARENT, true);
+    rootsCount = countRoots(0, notes.size());
+    valid = true;
+}
+
+void NoteTreeIndex::move(const vector<Note*>& notes, size_t start, size_t count)
+{
+    if(valid) {
+        // moved sibling subtrees have the same parent which is not affected
+        layout(notes, start, start+count+1, parents[start], true);
+    }
+}
+
+void NoteTreeIndex::change(const vector<Note*>& notes, size_t start, size_t count)
+{
+    if(valid) {
+        // depth 0 N cannot have parent > it bounds changes of the layout
+        size_t from = start;
+        while(from) {
+            if(!notes[--from]->getDepth()) {
+                break;
+            }
+        }
+        size_t to = start+count+1;
+        while(to < notes.size() && notes[to]->getDepth()) {
+            to++;
+        }
+
+        rootsCount -= countRoots(from, to);
+        layout(notes, from, to, NO_PARENT, false);
+        rootsCount += countRoots(from, to);
+    }
+}
+
+void NoteTreeIndex::layout(
+        const vector<Note*>& notes,
+        size_t from,
+        size_t to,
+        u_int32_t parent,
+        bool updateOffsets)
+{
+    // stack of the open subtrees i.e. path from the (region) root to the last N
+    stack.clear();
+    for(size_t i=from; i<to; i++) {
+        u_int16_t depth = notes[i]->getDepth();
+        while(!stack.empty() && notes[stack.back()]->getDepth() >= depth) {
+            spans[stack.back()] = i-stack.back()-1;
+            stack.pop_back();
+        }
+        if(stack.empty()) {
+            parents[i] = parent;
+        } else {
+            parents[i] = stack.back();
+            childrenCounts[stack.back()]++;
+        }
+        childrenCounts[i] = 0;
+        if(updateOffsets) {
+            offsets[notes[i]] = static_cast<u_int32_t>(i);
+        }
+        stack.push_back(static_cast<u_int32_t>(i));
+    }
+    while(!stack.empty()) {
+        spans[stack.back()] = to-stack.back()-1;
+        stack.pop_back();
+    }
+}
+
+size_t NoteTreeIndex::countRoots(size_t from, size_t to) const
+{
+    size_t roots{};
+    for(size_t i=from; i<to; i+=spans[i]+1) {
+        if(parents[i] == NO_PARENT) {
+            roots++;
+        }
+    }
+    return roots;
+}
+
+bool NoteTreeIndex::check(const vector<Note*>& notes, string* error) const
+{
+    NoteTreeIndex expected{};
+    expected.build(notes);
+
+    string e{};
+    if(!valid) {
+        e = "index is not valid";
+    } else if(offsets.size() != notes.size()) {
+        e = "offsets count " + std::to_string(offsets.size()) + " != " + std::to_string(notes.size());
+    } else if(rootsCount != expected.rootsCount) {
+        e = "roots count " + std::to_string(rootsCount) + " != " + std::to_string(expected.rootsCount);
+    } else {
+        for(size_t i=0; i<notes.size(); i++) {
+            if(getOffset(notes[i]) != static_cast<int>(i)) {
+                e = "offset of N " + std::to_string(i);
+            } else if(parents[i] != expected.parents[i]) {
+                e = "parent of N " + std::to_string(i);
+            } else if(spans[i] != expected.spans[i]) {
+                e = "descendants of N " + std::to_string(i);
+            } else if(childrenCounts[i] != expected.childrenCounts[i]) {
+                e = "children of N " + std::to_string(i);
+            }
+            if(!e.empty()) {
+                break;
+            }
+        }
+    }
+
+    if(error) {
+        *error = e;
+    }
+    return e.empty();
+}
+
+} // m8r namespace
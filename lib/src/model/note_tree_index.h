@@ -0,0 +1,108 @@
+/*
+ note_tree_index.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_NOTE_TREE_INDEX_H
+#define M8R_NOTE_TREE_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../definitions.h"
+
+namespace m8r {
+
+class Note;
+
+/**
+ * @brief Tree index of O's Ns.
+ *
+ * Ns are stored by O as a vector in the pre-order, tree structure is given
+ * by Ns depths only: N's parent is the nearest N above which has lower depth
+ * (regardless how big the depth gap is). Index keeps N offsets and, for every
+ * offset, parent offset, number of descendants (subtree span) and number of
+ * direct children. Therefore structural queries are O(1) or O(subtree).
+ *
+ * Index is built lazily (O(n)) after arbitrary Ns modification and it is
+ * updated incrementally on move (O(moved Ns)) and depth change (O(top level
+ * N subtree)) - the same boundaries which are reported by Outline::Patch.
+ */
+class NoteTreeIndex
+{
+public:
+    static constexpr u_int32_t NO_PARENT = 0xFFFFFFFF;
+
+private:
+    bool valid;
+
+    std::unordered_map<const Note*,u_int32_t> offsets;
+
+    std::vector<u_int32_t> parents;
+    std::vector<u_int32_t> spans;
+    std::vector<u_int32_t> childrenCounts;
+    size_t rootsCount;
+
+    // layout stack (kept to avoid allocation on update)
+    std::vector<u_int32_t> stack;
+
+public:
+    explicit NoteTreeIndex();
+    NoteTreeIndex(const NoteTreeIndex&) = delete;
+    NoteTreeIndex(const NoteTreeIndex&&) = delete;
+    NoteTreeIndex& operator=(const NoteTreeIndex&) = delete;
+    NoteTreeIndex& operator=(const NoteTreeIndex&&) = delete;
+    ~NoteTreeIndex();
+
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+
+    void build(const std::vector<Note*>& notes);
+
+    /**
+     * @brief Update index after sibling subtrees in [start, start+count] were shuffled.
+     */
+    void move(const std::vector<Note*>& notes, size_t start, size_t count);
+    /**
+     * @brief Update index after depth of Ns in [start, start+count] was changed.
+     */
+    void change(const std::vector<Note*>& notes, size_t start, size_t count);
+
+    /**
+     * @brief Get N offset or -1 if N is not indexed.
+     */
+    int getOffset(const Note* note) const {
+        auto i = offsets.find(note);
+        return i==offsets.end()?-1:static_cast<int>(i->second);
+    }
+    u_int32_t getParent(size_t offset) const { return parents[offset]; }
+    size_t getDescendantsCount(size_t offset) const { return spans[offset]; }
+    size_t getChildrenCount(size_t offset) const { return childrenCounts[offset]; }
+    size_t getRootsCount() const { return rootsCount; }
+
+    /**
+     * @brief Check index invariant: index must be equal to the index built from scratch.
+     */
+    bool check(const std::vector<Note*>& notes, std::string* error=nullptr) const;
+
+private:
+    void layout(const std::vector<Note*>& notes, size_t from, size_t to, u_int32_t parent, bool updateOffsets);
+    size_t countRoots(size_t from, size_t to) const;
+};
+
+}
+#endif // M8R_NOTE_TREE_INDEX_H
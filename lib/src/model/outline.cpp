@@ -76,18 +76,17 @@ Outline::Outline(const OutlineType* type)
       urgency{},
       progress{},
       notes{},
+      noteTree{},
       outlineDescriptorAsNote{new Note(&NOTE_4_OUTLINE_TYPE, this)},
       bytesize{},
       dirty{false},
+      observer{nullptr},
       readOnly{false},
       timeScope{}
 {
 }
 
 Outline::~Outline() {
-    for(string* d:description) {
-        delete d;
-    }
     for(string* d:preamble) {
         delete d;
     }
@@ -98,9 +97,7 @@ Outline::~Outline() {
         delete note;
     }
 
-    // description is shared between this outline and Note
     if(outlineDescriptorAsNote) {
-        outlineDescriptorAsNote->clear();
         delete outlineDescriptorAsNote;
     }
 }
@@ -134,9 +131,11 @@ Outline::Outline(const Outline& o)
       urgency{},
       progress{},
       notes{},
+      noteTree{},
       outlineDescriptorAsNote{},
       bytesize{},
       dirty{},
+      observer{nullptr},
       readOnly{},
       timeScope{}
 {
@@ -145,11 +144,8 @@ Outline::Outline(const Outline& o)
     // IMPROVE i18n
     name = "Copy of " + o.name;
     autolinkName();
-    if(o.description.size()) {
-        for(string* s:o.description) {
-            description.push_back(new string(*s));
-        }
-    }
+    // description buffer is shared until one of Os is edited
+    description = o.description;
     if(o.preamble.size()) {
         for(string* s:o.preamble) {
             preamble.push_back(new string(*s));
@@ -302,7 +298,7 @@ void Outline::notifyChange(Note* note)
     revision++;
 
     note->setModified(modified);
-    note->setModifiedPretty(datetimeToPrettyHtml(modified));
+    note->setModifiedPretty();
     note->incRevision();
 }
 
@@ -365,17 +361,12 @@ void Outline::makeModified()
 
 const string& Outline::getModifiedPretty() const
 {
-    return modifiedPretty;
+    return modifiedPretty.get(modified);
 }
 
 void Outline::setModifiedPretty()
 {
-    this->modifiedPretty = datetimeToPrettyHtml(modified);
-}
-
-void Outline::setModifiedPretty(const string& modifiedPretty)
-{
-    this->modifiedPretty = modifiedPretty;
+    modifiedPretty.clear();
 }
 
 const vector<Note*>& Outline::getNotes() const
@@ -391,6 +382,7 @@ size_t Outline::getNotesCount() const
 void Outline::setNotes(const vector<Note*>& notes)
 {
     this->notes = notes;
+    noteTree.invalidate();
 }
 
 int8_t Outline::getProgress() const
@@ -523,6 +515,7 @@ Note* Outline::cloneNote(const Note* clonedNote, const bool deep)
                     resetClonedNote(newNote);
                     newNote->setOutline(this);
                     notes.push_back(newNote);
+                    noteTree.invalidate();
                 }
             }
         }
@@ -542,6 +535,7 @@ void Outline::addNote(Note* note)
 {
     note->setOutline(this);
     notes.push_back(note);
+    noteTree.invalidate();
 }
 
 void Outline::addNote(Note* note, int offset)
@@ -552,6 +546,7 @@ void Outline::addNote(Note* note, int offset)
     } else {
         notes.insert(notes.begin()+offset, note);
     }
+    noteTree.invalidate();
 }
 
 void Outline::addNotes(std::vector<Note*>& notesToAdd, int offset)
@@ -590,11 +585,7 @@ int Outline::getNoteOffset(const Note* note) const
         if(notes.size()==1) {
             return 0;
         } else {
-            // IMPROVE this is SLOW O(n) - consider keeping order of N within it as a field
-            auto it = std::find(notes.begin(), notes.end(), note);
-            if(it != notes.end()) {
-                return std::distance(notes.begin(), it);
-            }
+            return getNoteTree().getOffset(note);
         }
     }
     return -1;
@@ -602,36 +593,22 @@ int Outline::getNoteOffset(const Note* note) const
 
 void Outline::getDirectNoteChildren(vector<Note*>& directChildren)
 {
-    if(notes.size()) {
-        // child depth is initialized to a big nuber
-        //  +
-        // any non-monotonous non-growing depth is detected as direct child
-        u_int16_t minDepth = static_cast<u_int16_t>(1 << 15);
-        for(Note* n:notes) {
-            if(minDepth >= n->getDepth()) {
-                directChildren.push_back(n);
-                minDepth = n->getDepth();
-            }
-        }
+    // Ns w/o parent i.e. top level subtrees
+    const NoteTreeIndex& tree = getNoteTree();
+    for(size_t i=0; i<notes.size(); i+=tree.getDescendantsCount(i)+1) {
+        directChildren.push_back(notes[i]);
     }
 }
 
 void Outline::getDirectNoteChildren(const Note* note, std::vector<Note*>& directChildren)
 {
     if(note) {
-        if(notes.size()) {
-            vector<Note*> allNoteChildren{};
-            getAllNoteChildren(note, &allNoteChildren);
-
-            // child depth is initialized to a big nuber
-            //  +
-            // any non-monotonous non-growing depth is detected as direct child
-            u_int16_t minDepth = static_cast<u_int16_t>(1 << 15);
-            for(Note* n:allNoteChildren) {
-                if(minDepth >= n->getDepth()) {
-                    directChildren.push_back(n);
-                    minDepth = n->getDepth();
-                }
+        const NoteTreeIndex& tree = getNoteTree();
+        int offset = tree.getOffset(note);
+        if(offset != NO_OFFSET) {
+            size_t last = offset + tree.getDescendantsCount(offset);
+            for(size_t i=offset+1; i<=last; i+=tree.getDescendantsCount(i)+1) {
+                directChildren.push_back(notes[i]);
             }
         }
     } else {
@@ -639,45 +616,40 @@ void Outline::getDirectNoteChildren(const Note* note, std::vector<Note*>& direct
     }
 }
 
-// IMPROVE: if gap between Ns level is >1, this method doesn't work (user has freedom to make arbitrary depth)
+size_t Outline::getDirectNoteChildrenCount()
+{
+    return getNoteTree().getRootsCount();
+}
+
+size_t Outline::getDirectNoteChildrenCount(const Note* note)
+{
+    if(note) {
+        const NoteTreeIndex& tree = getNoteTree();
+        int offset = tree.getOffset(note);
+        return offset==NO_OFFSET?0:tree.getChildrenCount(offset);
+    } else {
+        return getDirectNoteChildrenCount();
+    }
+}
+
 void Outline::getAllNoteChildren(const Note* note, vector<Note*>* children, Outline::Patch* patch)
 {
     if(note) {
-        if(note == notes[notes.size()-1]) {
+        const NoteTreeIndex& tree = getNoteTree();
+        int offset = tree.getOffset(note);
+        if(offset != NO_OFFSET) {
+            size_t descendants = tree.getDescendantsCount(offset);
+            if(children) {
+                children->insert(children->end(), notes.begin()+offset+1, notes.begin()+offset+1+descendants);
+            }
             if(patch) {
-                patch->start=notes.size()-1;
-                patch->count=0;
+                patch->start=offset;
+                patch->count=descendants;
             }
-            return;
         } else {
-            // IMPROVE this is SLOW o(n) - consider keeping order of N within it as a field
-            auto offset = std::find(notes.begin(), notes.end(), note);
-            if(offset != notes.end()) {
-                auto index = std::distance(notes.begin(), offset);
-                for(size_t i=index+1; i<notes.size(); i++) {
-                    if(notes[i]->getDepth() > note->getDepth()) {
-                        if(children) {
-                            children->push_back(notes[i]);
-                        }
-                    } else {
-                        if(patch) {
-                            patch->start=index;
-                            patch->count=i-index;
-                        }
-                        return;
-                    }
-                }
-                if(patch) {
-                    patch->start=index;
-                    patch->count=notes.size()-1-index;
-                }
-                return;
-            } else {
-                // note not in vector
-                if(patch) {
-                    patch->start=patch->count=0;
-                }
-                return;
+            // note not in vector
+            if(patch) {
+                patch->start=patch->count=0;
             }
         }
     }
@@ -705,49 +677,38 @@ void Outline::getNotePathToRoot(const size_t offset, std::vector<int>& parents)
 void Outline::removeNote(Note* note, bool deallocate)
 {
     if(note && notes.size()) {
-        auto d = note->getDepth();
-        for(size_t i=0; i<notes.size(); i++) {
-            if(notes[i] == note) {
-                auto begin = i++;
-                while(i<notes.size() && notes[i]->getDepth()>d) {
-                    if(deallocate) {
-                        delete notes[i];
-                    }
-                    i++;
-                }
-                // because erase deletes [begin,end)
-                notes.erase(notes.begin()+begin, notes.begin()+i);
-
-                if(deallocate) {
-                    delete note;
+        const NoteTreeIndex& tree = getNoteTree();
+        int offset = tree.getOffset(note);
+        if(offset != NO_OFFSET) {
+            // because erase deletes [begin,end)
+            auto begin = notes.begin()+offset;
+            auto end = begin+tree.getDescendantsCount(offset)+1;
+            if(deallocate) {
+                for(auto i=begin; i!=end; ++i) {
+                    delete *i;
                 }
-
-                return;
             }
+            notes.erase(begin, end);
+            noteTree.invalidate();
         }
-
-        // IMPROVE this iterates ALL Ns, but I know that I need to delete just 1st one
-        notes.erase(std::remove(notes.begin(), notes.end(), note), notes.end());
     }
 }
 
 int Outline::getOffsetOfAboveNoteSibling(Note* note, int& offset)
 {
     offset = getNoteOffset(note);
-    if(offset != Outline::NO_OFFSET) {
-        if(offset) {
-            for(int o=offset-1; o>=0; o--) {
-                if(notes[o]->getDepth() == note->getDepth()) {
-                    if(offset == o) {
-                        return NO_SIBLING;
-                    } else {
-                        return o;
-                    }
-                }
-                if(notes[o]->getDepth() < note->getDepth()) {
-                    return NO_SIBLING;
-                }
+    if(offset != Outline::NO_OFFSET && offset) {
+        // sibling is the nearest N above which has the same parent
+        const NoteTreeIndex& tree = getNoteTree();
+        u_int32_t parent = tree.getParent(offset);
+        for(int o=offset-1; o>=0 && static_cast<u_int32_t>(o)!=parent; o--) {
+            while(tree.getParent(o) != parent) {
+                o = tree.getParent(o);
+            }
+            if(notes[o]->getDepth() == note->getDepth()) {
+                return o;
             }
+            // deeper N w/ the same parent (depth gap) is skipped
         }
     }
     return NO_SIBLING;
@@ -757,19 +718,10 @@ int Outline::getOffsetOfBelowNoteSibling(Note* note, int& offset)
 {
     offset = getNoteOffset(note);
     if(offset != Outline::NO_OFFSET) {
-        if(static_cast<unsigned int>(offset) < notes.size()-1) {
-            for(unsigned int o=offset+1; o<notes.size(); o++) {
-                if(notes[o]->getDepth() == note->getDepth()) {
-                    if(static_cast<unsigned int>(offset) == o) {
-                        return NO_SIBLING;
-                    } else {
-                        return o;
-                    }
-                }
-                if(notes[o]->getDepth() < note->getDepth()) {
-                    return NO_SIBLING;
-                }
-            }
+        // sibling is the first N below note's subtree
+        size_t o = offset + getNoteTree().getDescendantsCount(offset) + 1;
+        if(o < notes.size() && notes[o]->getDepth() == note->getDepth()) {
+            return o;
         }
     }
     return NO_SIBLING;
@@ -779,17 +731,22 @@ void Outline::promoteNote(Note* note, Outline::Patch* patch)
 {
     if(note) {
         if(note->getDepth()) {
-            vector<Note*> children{};
-            getAllNoteChildren(note, &children, patch);
+            Outline::Patch p{};
+            getAllNoteChildren(note, nullptr, &p);
             note->promote();
             note->makeModified();
-            for(Note* n:children) {
-                n->promote();
-                // IMPROVE consider whether children should be marked as modified or no n->makeModified();
+            if(notes.size() && notes[p.start] == note) {
+                for(size_t i=p.start+1; i<=p.start+p.count; i++) {
+                    notes[i]->promote();
+                    // IMPROVE consider whether children should be marked as modified or no n->makeModified();
+                }
+                noteTree.change(notes, p.start, p.count);
             }
             makeModified();
             if(patch) {
                 patch->diff = Outline::Patch::Diff::CHANGE;
+                patch->start = p.start;
+                patch->count = p.count;
             }
             return;
         }
@@ -803,17 +760,22 @@ void Outline::demoteNote(Note* note, Outline::Patch* patch)
 {
     if(note) {
         if(note->getDepth() < MAX_NOTE_DEPTH) {
-            vector<Note*> children{};
-            getAllNoteChildren(note, &children, patch);
+            Outline::Patch p{};
+            getAllNoteChildren(note, nullptr, &p);
             note->demote();
             note->makeModified();
-            for(Note* n:children) {
-                n->demote();
-                // IMPROVE consider whether children should be marked as modified or no n->makeModified();
+            if(notes.size() && notes[p.start] == note) {
+                for(size_t i=p.start+1; i<=p.start+p.count; i++) {
+                    notes[i]->demote();
+                    // IMPROVE consider whether children should be marked as modified or no n->makeModified();
+                }
+                noteTree.change(notes, p.start, p.count);
             }
             makeModified();
             if(patch) {
                 patch->diff = Outline::Patch::Diff::CHANGE;
+                patch->start = p.start;
+                patch->count = p.count;
             }
             return;
         }
@@ -823,7 +785,36 @@ void Outline::demoteNote(Note* note, Outline::Patch* patch)
     }
 }
 
-// IMPROVE move to up and first are almost the same - introduce method that has sibling offset as parameter
+void Outline::moveNoteBefore(int noteOffset, int siblingOffset, Outline::Patch* patch)
+{
+    // upper tier to patch [sibling's offset, note's last child]
+    size_t count = noteOffset + getNoteTree().getDescendantsCount(noteOffset) - siblingOffset;
+    // modify outline: N subtree is rotated above sibling(s)
+    std::rotate(notes.begin()+siblingOffset, notes.begin()+noteOffset, notes.begin()+siblingOffset+count+1);
+    noteTree.move(notes, siblingOffset, count);
+    if(patch) {
+        patch->diff = Outline::Patch::Diff::MOVE;
+        patch->start = siblingOffset;
+        patch->count = count;
+    }
+}
+
+void Outline::moveNoteAfter(int noteOffset, int siblingOffset, Outline::Patch* patch)
+{
+    // upper tier to patch [note's original offset, sibling's last child]
+    const NoteTreeIndex& tree = getNoteTree();
+    size_t count = siblingOffset + tree.getDescendantsCount(siblingOffset) - noteOffset;
+    // modify outline: sibling(s) subtrees are rotated above N
+    size_t belowNote = noteOffset + tree.getDescendantsCount(noteOffset) + 1;
+    std::rotate(notes.begin()+noteOffset, notes.begin()+belowNote, notes.begin()+noteOffset+count+1);
+    noteTree.move(notes, noteOffset, count);
+    if(patch) {
+        patch->diff = Outline::Patch::Diff::MOVE;
+        patch->start = noteOffset;
+        patch->count = count;
+    }
+}
+
 void Outline::moveNoteToFirst(Note* note, Outline::Patch* patch)
 {
     if(note) {
@@ -835,42 +826,18 @@ void Outline::moveNoteToFirst(Note* note, Outline::Patch* patch)
         while((so = getOffsetOfAboveNoteSibling(n, no)) != NO_SIBLING) {
             if(noteOffset == NO_OFFSET) noteOffset = no;
             siblingOffset = so;
-            n = note->getOutline()->getNotes()[siblingOffset];
+            n = notes[siblingOffset];
         }
 
         if(siblingOffset != NO_SIBLING) {
-            vector<Note*> children{};
-            getAllNoteChildren(note, &children);
-            if(patch) {
-                // upper tier to patch [sibling's offset, note's last child]
-                patch->diff = Outline::Patch::Diff::MOVE;
-                patch->start = siblingOffset;
-                patch->count = noteOffset+children.size() - siblingOffset;
-            }
-            // modify outline: cut & insert
-            if(children.size()) {
-                notes.erase(notes.begin()+noteOffset, notes.begin()+noteOffset+children.size()+1);
-                for(int c=children.size()-1; c>=0; c--) {
-                    // bottom up insert
-                    notes.insert(notes.begin()+siblingOffset, children[c]);
-                }
-            } else {
-                notes.erase(notes.begin()+noteOffset);
-            }
-            notes.insert(notes.begin()+siblingOffset, note);
+            moveNoteBefore(noteOffset, siblingOffset, patch);
             note->makeModified();
             return;
-        } else {
-            if(patch) {
-                patch->diff = Outline::Patch::Diff::NO;
-                return;
-            }
-        }
-    } else {
-        if(patch) {
-            patch->diff = Outline::Patch::Diff::NO;
         }
     }
+    if(patch) {
+        patch->diff = Outline::Patch::Diff::NO;
+    }
 }
 
 void Outline::moveNoteUp(Note* note, Outline::Patch* patch)
@@ -879,38 +846,14 @@ void Outline::moveNoteUp(Note* note, Outline::Patch* patch)
         int noteOffset;
         int siblingOffset = getOffsetOfAboveNoteSibling(note, noteOffset);
         if(siblingOffset != NO_SIBLING) {
-            vector<Note*> children{};
-            getAllNoteChildren(note, &children);
-            if(patch) {
-                // upper tier to patch [sibling's offset, note's last child]
-                patch->diff = Outline::Patch::Diff::MOVE;
-                patch->start = siblingOffset;
-                patch->count = noteOffset+children.size() - siblingOffset;
-            }
-            // modify outline: cut & insert
-            if(children.size()) {
-                notes.erase(notes.begin()+noteOffset, notes.begin()+noteOffset+children.size()+1);
-                for(int c=children.size()-1; c>=0; c--) {
-                    // bottom up insert
-                    notes.insert(notes.begin()+siblingOffset, children[c]);
-                }
-            } else {
-                notes.erase(notes.begin()+noteOffset);
-            }
-            notes.insert(notes.begin()+siblingOffset, note);
+            moveNoteBefore(noteOffset, siblingOffset, patch);
             makeModified();
             return;
-        } else {
-            if(patch) {
-                patch->diff = Outline::Patch::Diff::NO;
-                return;
-            }
-        }
-    } else {
-        if(patch) {
-            patch->diff = Outline::Patch::Diff::NO;
         }
     }
+    if(patch) {
+        patch->diff = Outline::Patch::Diff::NO;
+    }
 }
 
 void Outline::moveNoteDown(Note* note, Outline::Patch* patch)
@@ -919,40 +862,14 @@ void Outline::moveNoteDown(Note* note, Outline::Patch* patch)
         int noteOffset;
         int siblingOffset = getOffsetOfBelowNoteSibling(note, noteOffset);
         if(siblingOffset != NO_SIBLING) {
-            Note* sibling = notes[siblingOffset];
-            vector<Note*> siblingChildren{};
-            getAllNoteChildren(sibling, &siblingChildren);
-            if(patch) {
-                // upper tier to patch [note's original offset,sibling's last child]
-                patch->diff = Outline::Patch::Diff::MOVE;
-                patch->start = noteOffset;
-                patch->count = siblingOffset+siblingChildren.size() - noteOffset;
-            }
-            // modify outline: cut & insert (COPY moved Note below sibling, DELETE original Note)
-            vector<Note*> children{};
-            getAllNoteChildren(note, &children);
-            int belowSiblingIndex = siblingOffset+siblingChildren.size()+1;
-            notes.insert(notes.begin()+belowSiblingIndex, note);
-            if(children.size()) {
-                for(int c=children.size()-1; c>=0; c--) {
-                    // bottom up insert
-                    notes.insert(notes.begin()+belowSiblingIndex+1, children[c]);
-                }
-            }
-            notes.erase(notes.begin()+noteOffset, notes.begin()+noteOffset+children.size()+1);
+            moveNoteAfter(noteOffset, siblingOffset, patch);
             makeModified();
             return;
-        } else {
-            if(patch) {
-                patch->diff = Outline::Patch::Diff::NO;
-                return;
-            }
-        }
-    } else {
-        if(patch) {
-            patch->diff = Outline::Patch::Diff::NO;
         }
     }
+    if(patch) {
+        patch->diff = Outline::Patch::Diff::NO;
+    }
 }
 
 void Outline::moveNoteToLast(Note* note, Outline::Patch* patch)
@@ -960,50 +877,24 @@ void Outline::moveNoteToLast(Note* note, Outline::Patch* patch)
     if(note) {
         int no, noteOffset = NO_OFFSET;
 
-        // loop to find the first sibling
+        // loop to find the last sibling
         int so, siblingOffset = NO_OFFSET;
         Note* n = note;
         while((so = getOffsetOfBelowNoteSibling(n, no)) != NO_SIBLING) {
             if(noteOffset == NO_OFFSET) noteOffset = no;
             siblingOffset = so;
-            n = note->getOutline()->getNotes()[siblingOffset];
+            n = notes[siblingOffset];
         }
 
         if(siblingOffset != NO_SIBLING) {
-            Note* sibling = notes[siblingOffset];
-            vector<Note*> siblingChildren{};
-            getAllNoteChildren(sibling, &siblingChildren);
-            if(patch) {
-                // upper tier to patch [note's original offset,sibling's last child]
-                patch->diff = Outline::Patch::Diff::MOVE;
-                patch->start = noteOffset;
-                patch->count = siblingOffset+siblingChildren.size() - noteOffset;
-            }
-            // modify outline: cut & insert (COPY moved Note below sibling, DELETE original Note)
-            vector<Note*> children{};
-            getAllNoteChildren(note, &children);
-            int belowSiblingIndex = siblingOffset+siblingChildren.size()+1;
-            notes.insert(notes.begin()+belowSiblingIndex, note);
-            if(children.size()) {
-                for(int c=children.size()-1; c>=0; c--) {
-                    // bottom up insert
-                    notes.insert(notes.begin()+belowSiblingIndex+1, children[c]);
-                }
-            }
-            notes.erase(notes.begin()+noteOffset, notes.begin()+noteOffset+children.size()+1);
+            moveNoteAfter(noteOffset, siblingOffset, patch);
             makeModified();
             return;
-        } else {
-            if(patch) {
-                patch->diff = Outline::Patch::Diff::NO;
-                return;
-            }
-        }
-    } else {
-        if(patch) {
-            patch->diff = Outline::Patch::Diff::NO;
         }
     }
+    if(patch) {
+        patch->diff = Outline::Patch::Diff::NO;
+    }
 }
 
 const vector<string*>& Outline::getPreamble() const
@@ -1037,32 +928,24 @@ void Outline::setPreamble(const vector<string*>& preamble)
     this->preamble = preamble;
 }
 
-const vector<string*>& Outline::getDescription() const
+const Description& Outline::getDescription() const
 {
     return description;
 }
 
 string Outline::getDescriptionAsString(const std::string& separator) const
 {
-    // IMPROVE cache narrowed description for performance
     string result{};
-    if(description.size()) {
-        for(string *s:description) {
-            result += *s;
-            result += separator;
-        }
-    }
+    description.appendTo(result, separator);
     return result;
 }
 
-void Outline::addDescriptionLine(string *line)
+void Outline::addDescriptionLine(const string& line)
 {
-    if(line) {
-        description.push_back(line);
-    }
+    description.append(line);
 }
 
-void Outline::setDescription(const vector<string*>& description)
+void Outline::setDescription(const Description& description)
 {
     this->description = description;
 }
@@ -1120,7 +1003,9 @@ void Outline::organizeToEisenhowerMatrix(
     vector<Note*>& lowerLeftNs,
     vector<Note*>& lowerRightNs
 ) {
-    organizer->makeModified();
+    if(organizer) {
+        organizer->makeModified();
+    }
 
     if(os.size()) {
         if(!organizer || organizer->getKey()==EisenhowerMatrix::KEY_EISENHOWER_MATRIX) {
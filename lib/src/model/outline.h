@@ -23,7 +23,9 @@
 #include <vector>
 
 #include "../mind/ontology/thing_class_rel_triple.h"
+#include "description.h"
 #include "note.h"
+#include "note_tree_index.h"
 #include "outline_type.h"
 #include "eisenhower_matrix.h"
 #include "kanban.h"
@@ -35,6 +37,18 @@
 namespace m8r {
 
 class Note;
+class Outline;
+
+/**
+ * @brief Observer of O changes which are not remembered (e.g. read counters incremented by views).
+ */
+class OutlineObserver
+{
+public:
+    virtual ~OutlineObserver() {}
+
+    virtual void outlineDirty(Outline* outline) = 0;
+};
 
 enum class OutlineMemoryLocation {
     NORMAL,
@@ -125,9 +139,10 @@ private:
     std::vector<const Tag*> tags;
     std::vector<Link*> links;
     const OutlineType* type;
-    std::vector<std::string*> description;
+    Description description;
 
-    std::string modifiedPretty;
+    // pretty timestamp is calculated lazily on presentation
+    PrettyDatetime modifiedPretty;
     u_int32_t revision;
     u_int32_t reads;
 
@@ -135,8 +150,9 @@ private:
     int8_t urgency;
     int8_t progress;
 
-    // IMPROVE introduce own data structure: tree of ordered notes w/ offset i.e. heap
     std::vector<Note*> notes;
+    // tree structure of Ns: built lazily, patched on move/promote/demote
+    mutable NoteTreeIndex noteTree;
 
     Note* outlineDescriptorAsNote;
 
@@ -153,7 +169,8 @@ private:
      * @brief Indicates that O has been changed (e.g. read timestamp), but it was not saved (yet).
      */
     bool dirty;
-
+    // notified when O is made dirty, nullptr if none
+    OutlineObserver* observer;
 
     /**
      * @brief Outline is READ ONLY i.e. it cannot be modified.
@@ -206,10 +223,10 @@ public:
     std::string getPreambleAsString() const;
     void addPreambleLine(std::string *line);
     void setPreamble(const std::vector<std::string*>& preamble);
-    const std::vector<std::string*>& getDescription() const;
+    const Description& getDescription() const;
     std::string getDescriptionAsString(const std::string& separator="\n") const;
-    void addDescriptionLine(std::string *);
-    void setDescription(const std::vector<std::string*>& description);
+    void addDescriptionLine(const std::string& line);
+    void setDescription(const Description& description);
     void clearDescription();
     int8_t getImportance() const;
     void setImportance(int8_t importance);
@@ -235,7 +252,6 @@ public:
     void makeModified();
     const std::string& getModifiedPretty() const;
     void setModifiedPretty();
-    void setModifiedPretty(const std::string& modifiedPretty);
     int8_t getProgress() const;
     void setProgress(int8_t progress);
     u_int32_t getRevision() const;
@@ -294,8 +310,7 @@ public:
      * are returned regardless how big depth GAP is between O and N.
      */
     void getDirectNoteChildren(std::vector<Note*>& children);
-    // IMPROVE cache w/ dirty flag
-    size_t getDirectNoteChildrenCount() { std::vector<Note*> c{}; getDirectNoteChildren(c); return c.size(); }
+    size_t getDirectNoteChildrenCount();
     /**
      * @brief Get direct Ns children.
      *
@@ -303,9 +318,22 @@ public:
      * the gap in depth is.
      */
     void getDirectNoteChildren(const Note* note, std::vector<Note*>& children);
-    size_t getDirectNoteChildrenCount(const Note* note) { std::vector<Note*> c{}; getDirectNoteChildren(note, c); return c.size(); }
+    size_t getDirectNoteChildrenCount(const Note* note);
 
     void getAllNoteChildren(const Note* note, std::vector<Note*>* children=nullptr, Outline::Patch* patch=nullptr);
+    /**
+     * @brief Get Ns tree index (built if needed).
+     */
+    const NoteTreeIndex& getNoteTree() const {
+        if(!noteTree.isValid()) {
+            noteTree.build(notes);
+        }
+        return noteTree;
+    }
+    /**
+     * @brief Notify N depth modification which was not made by O.
+     */
+    void invalidateNoteTree() { noteTree.invalidate(); }
     /**
      * @brief Get skeleton-style (Note per level) path to root.
      */
@@ -332,7 +360,11 @@ public:
     }
 
     bool isDirty() const { return dirty; }
-    void makeDirty() { dirty = true; }
+    void makeDirty() {
+        dirty = true;
+        if(observer) observer->outlineDirty(this);
+    }
+    void setObserver(OutlineObserver* observer) { this->observer = observer; }
     void clearDirty() { dirty = false; }
 
     bool isReadOnly() const { return readOnly; }
@@ -374,6 +406,14 @@ private:
      */
     int getOffsetOfAboveNoteSibling(Note* note, int& offset);
     int getOffsetOfBelowNoteSibling(Note* note, int& offset);
+    /**
+     * @brief Move N subtree above its sibling, offsets are valid and sibling is above N.
+     */
+    void moveNoteBefore(int noteOffset, int siblingOffset, Outline::Patch* patch);
+    /**
+     * @brief Move N subtree below its sibling's subtree, sibling is below N.
+     */
+    void moveNoteAfter(int noteOffset, int siblingOffset, Outline::Patch* patch);
 
     void resetClonedNote(Note* n);
     void resetClonedOutline(Outline* o);
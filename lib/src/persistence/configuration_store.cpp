@@ -0,0 +1,71 @@
+/*
+ configuration_store.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "configuration_store.h"
+
+#include "../debug.h"
+#include "../gear/file_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr unsigned ConfigurationStore::DEBOUNCE_MILLIS;
+
+ConfigurationStore::ConfigurationStore()
+    : mutex{},
+      stored{},
+      writer{DEBOUNCE_MILLIS},
+      skipped{}
+{
+}
+
+ConfigurationStore::~ConfigurationStore()
+{
+    flush();
+}
+
+bool ConfigurationStore::store(const string& path, const string& content)
+{
+    // queued under lock so that the order of writes is the order of stores
+    lock_guard<std::mutex> lock{mutex};
+    auto s = stored.find(path);
+    if(s != stored.end() && s->second == content && isFile(path.c_str())) {
+        skipped++;
+        return false;
+    }
+
+    MF_DEBUG("Configuration store DIRTY: " << path << endl);
+    stored[path] = content;
+    writer.write(path, new string{content});
+    return true;
+}
+
+void ConfigurationStore::invalidate(const string& path)
+{
+    lock_guard<std::mutex> lock{mutex};
+    stored.erase(path);
+}
+
+unsigned ConfigurationStore::getSkipped()
+{
+    lock_guard<std::mutex> lock{mutex};
+    return skipped;
+}
+
+} // m8r namespace
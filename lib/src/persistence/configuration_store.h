@@ -0,0 +1,98 @@
+/*
+ configuration_store.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_CONFIGURATION_STORE_H
+#define M8R_CONFIGURATION_STORE_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "write_behind_queue.h"
+
+namespace m8r {
+
+/**
+ * @brief Configuration store: dirty tracked, debounced and atomic configuration files persistence.
+ *
+ * Configuration is serialized by the caller (consistent snapshot w/o configuration
+ * locking) and a configuration file is dirty only if its serialization differs from
+ * the last stored one (or file doesn't exist) - unchanged files are not written at all.
+ * Dirty files are written in background after debounce, therefore bursts of changes
+ * (mind state transitions, organizer and preferences edits) are coalesced to a single
+ * atomic (temp file and rename) write of the latest configuration.
+ *
+ * Configuration is a singleton, therefore there is one store per process - all
+ * configuration representations must save files through it to keep writes ordered.
+ * flush() must be called on exit (it's called on destruction as a fallback).
+ */
+class ConfigurationStore
+{
+public:
+    static constexpr unsigned DEBOUNCE_MILLIS = 500;
+
+    static ConfigurationStore& getInstance() {
+        static ConfigurationStore SINGLETON{};
+        return SINGLETON;
+    }
+
+private:
+    std::mutex mutex;
+    // path > the last stored content
+    std::unordered_map<std::string,std::string> stored;
+    WriteBehindQueue writer;
+    unsigned skipped;
+
+    explicit ConfigurationStore();
+
+public:
+    ConfigurationStore(const ConfigurationStore&) = delete;
+    ConfigurationStore(const ConfigurationStore&&) = delete;
+    ConfigurationStore& operator=(const ConfigurationStore&) = delete;
+    ConfigurationStore& operator=(const ConfigurationStore&&) = delete;
+    ~ConfigurationStore();
+
+    /**
+     * @brief Store configuration file - it's written in background if it's dirty.
+     *
+     * @return true if file is dirty and will be written.
+     */
+    bool store(const std::string& path, const std::string& content);
+
+    /**
+     * @brief Forget the last stored content of the file (it was loaded or written by others).
+     */
+    void invalidate(const std::string& path);
+
+    /**
+     * @brief Write all dirty files now and wait until they are written.
+     */
+    void flush() { writer.flush(); }
+
+    /**
+     * @brief Number of files written so far.
+     */
+    unsigned getWrites() { return writer.getWrites(); }
+    /**
+     * @brief Number of stores which were not written as the file was not dirty.
+     */
+    unsigned getSkipped();
+};
+
+}
+#endif // M8R_CONFIGURATION_STORE_H
@@ -46,7 +46,9 @@ string FilesystemPersistence::getUniqueDirOrFileName(
 }
 
 FilesystemPersistence::FilesystemPersistence(MarkdownOutlineRepresentation& mdRepresentation, HtmlOutlineRepresentation& htmlRepresentation)
-    : mdRepresentation(mdRepresentation), htmlRepresentation(htmlRepresentation)
+    : mdRepresentation(mdRepresentation),
+      htmlRepresentation(htmlRepresentation),
+      writeBehind{}
 {
 }
 
@@ -101,18 +103,21 @@ void FilesystemPersistence::save(Outline* outline)
     string* text = mdRepresentation.to(outline);
     if(text!=nullptr) {
         MF_DEBUG("Saving O: " << outline->getKey() << endl);
-        ofstream out(outline->getKey());
-        MF_DEBUG("  O opened: " << boolalpha << out.is_open() << endl);
-        out << *text;
-        MF_DEBUG("  O written: " << &out << endl);
-        out.close();
-        MF_DEBUG("O saved: " << &out << endl);
-        delete text;
-
-        outline->clearDirty();
+        // queue takes ownership of the text snapshot
+        writeBehind.write(outline->getKey(), text);
     }
 }
 
+void FilesystemPersistence::flush()
+{
+    writeBehind.flush();
+}
+
+void FilesystemPersistence::takeWriteResults(unordered_map<string,bool>& results)
+{
+    writeBehind.takeResults(results);
+}
+
 void FilesystemPersistence::saveAsHtml(Outline* outline, const string& fileName)
 {
     string* text = new string{};
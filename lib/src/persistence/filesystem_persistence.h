@@ -22,6 +22,7 @@
 #include <string>
 
 #include "persistence.h"
+#include "write_behind_queue.h"
 #include "../config/configuration.h"
 #include "../model/stencil.h"
 #include "../representations/markdown/markdown_outline_representation.h"
@@ -35,6 +36,9 @@ private:
     MarkdownOutlineRepresentation& mdRepresentation;
     HtmlOutlineRepresentation& htmlRepresentation;
 
+    // Os are serialized by caller, but written in background
+    WriteBehindQueue writeBehind;
+
 public:
 
     static std::string getUniqueDirOrFileName(
@@ -70,7 +74,14 @@ public:
      * @return `false` if read-only, else `true`.
      */
     bool isWriteable(const std::string& outlineKey);
+    /**
+     * @brief Save O - O is serialized immediately, but written in background.
+     *
+     * O stays dirty until its write is confirmed by takeWriteResults().
+     */
     virtual void save(Outline* outline);
+    virtual void flush();
+    virtual void takeWriteResults(std::unordered_map<std::string,bool>& results);
     virtual void saveAsHtml(Outline* o, const std::string& fileName);
 };
 
@@ -19,6 +19,9 @@
 #ifndef M8R_PERSISTENCE_H_
 #define M8R_PERSISTENCE_H_
 
+#include <string>
+#include <unordered_map>
+
 #include "../model/stencil.h"
 #include "../model/outline.h"
 
@@ -37,7 +40,15 @@ public:
             const std::string& extension) = 0;
     virtual void load(Stencil* stencil) = 0;
     virtual bool isWriteable(const std::string& outlineKey) = 0;
-    virtual void save(Outline* outline) = 0;    
+    virtual void save(Outline* outline) = 0;
+    /**
+     * @brief Wait until all saved Os are written.
+     */
+    virtual void flush() = 0;
+    /**
+     * @brief Take results of O writes finished since the last call: O key > written.
+     */
+    virtual void takeWriteResults(std::unordered_map<std::string,bool>& results) = 0;
     virtual void saveAsHtml(Outline* outline, const std::string& fileName) = 0;
 };
 
@@ -0,0 +1,512 @@
+/*
+ repository_snapshot.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "repository_snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sys/stat.h>
+
+#include "../gear/datetime_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr const char SNAPSHOT_MAGIC[] = "M8RSNAPS";
+constexpr const size_t SNAPSHOT_MAGIC_SIZE = sizeof(SNAPSHOT_MAGIC)-1;
+
+constexpr const u_int8_t FLAG_POST_DECLARED_SECTION = 1;
+constexpr const u_int8_t FLAG_TRAILING_HASHES_SECTION = 1<<1;
+
+/*
+ * Serialization
+ */
+
+class SnapshotWriter
+{
+private:
+    string& out;
+
+public:
+    explicit SnapshotWriter(string& out) : out(out) {}
+
+    void u8(u_int8_t v) { out += static_cast<char>(v); }
+    void u16(u_int16_t v) { integer(v, 2); }
+    void u32(u_int32_t v) { integer(v, 4); }
+    void i64(long long v) { integer(static_cast<unsigned long long>(v), 8); }
+    void str(const string& s) {
+        u32(static_cast<u_int32_t>(s.size()));
+        out += s;
+    }
+    void lines(const vector<string*>& ls) {
+        u32(static_cast<u_int32_t>(ls.size()));
+        for(const string* l:ls) {
+            str(*l);
+        }
+    }
+    void lines(const Description& ls) {
+        u32(static_cast<u_int32_t>(ls.size()));
+        for(const Description::Line& l:ls) {
+            u32(static_cast<u_int32_t>(l.size()));
+            out.append(l.data(), l.size());
+        }
+    }
+
+private:
+    void integer(unsigned long long v, int bytes) {
+        for(int i=0; i<bytes; i++) {
+            out += static_cast<char>((v >> (8*i)) & 0xFF);
+        }
+    }
+};
+
+class SnapshotReader
+{
+private:
+    const char* data;
+    size_t size;
+    size_t pos;
+    bool valid;
+
+public:
+    explicit SnapshotReader(const char* data, size_t size)
+        : data(data), size(size), pos(0), valid(true) {}
+
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; }
+    size_t getPosition() const { return pos; }
+
+    u_int8_t u8() { return static_cast<u_int8_t>(integer(1)); }
+    u_int16_t u16() { return static_cast<u_int16_t>(integer(2)); }
+    u_int32_t u32() { return static_cast<u_int32_t>(integer(4)); }
+    long long i64() { return static_cast<long long>(integer(8)); }
+    string str() {
+        u_int32_t length = u32();
+        if(!ensure(length)) {
+            return string{};
+        }
+        string s{data+pos, length};
+        pos += length;
+        return s;
+    }
+    bool bytes(const char* expected, size_t length) {
+        if(ensure(length) && !memcmp(data+pos, expected, length)) {
+            pos += length;
+            return true;
+        }
+        valid = false;
+        return false;
+    }
+
+private:
+    bool ensure(size_t length) {
+        if(!valid || length > size-pos) {
+            valid = false;
+            return false;
+        }
+        return true;
+    }
+    unsigned long long integer(int bytes) {
+        if(!ensure(static_cast<size_t>(bytes))) {
+            return 0;
+        }
+        unsigned long long v = 0;
+        for(int i=0; i<bytes; i++) {
+            v |= static_cast<unsigned long long>(static_cast<unsigned char>(data[pos+i])) << (8*i);
+        }
+        pos += static_cast<size_t>(bytes);
+        return v;
+    }
+};
+
+static u_int32_t symbol(const string& name, unordered_map<string,u_int32_t>& ids, vector<const string*>& symbols)
+{
+    auto i = ids.find(name);
+    if(i != ids.end()) {
+        return i->second;
+    }
+    u_int32_t id = static_cast<u_int32_t>(symbols.size());
+    auto inserted = ids.insert(make_pair(name, id));
+    symbols.push_back(&inserted.first->first);
+    return id;
+}
+
+static void writeTagsAndLinks(
+        SnapshotWriter& w,
+        const vector<const Tag*>* tags,
+        const vector<Link*>& links,
+        unordered_map<string,u_int32_t>& ids,
+        vector<const string*>& symbols)
+{
+    w.u32(tags?static_cast<u_int32_t>(tags->size()):0);
+    if(tags) {
+        for(const Tag* t:*tags) {
+            w.u32(symbol(t->getName(), ids, symbols));
+        }
+    }
+    w.u32(static_cast<u_int32_t>(links.size()));
+    for(Link* l:links) {
+        w.str(l->getName());
+        w.str(l->getUrl());
+    }
+}
+
+static void writeOutline(
+        SnapshotWriter& w,
+        Outline* o,
+        unordered_map<string,u_int32_t>& ids,
+        vector<const string*>& symbols)
+{
+    w.u8(static_cast<u_int8_t>(o->getFormat()));
+    w.u8((o->isPostDeclaredSection()?FLAG_POST_DECLARED_SECTION:0)
+         | (o->isTrailingHashesSection()?FLAG_TRAILING_HASHES_SECTION:0));
+    w.str(o->getName());
+    w.u32(symbol(o->getType()->getName(), ids, symbols));
+    w.i64(o->getCreated());
+    w.i64(o->getModified());
+    w.i64(o->getRead());
+    w.u32(o->getRevision());
+    w.u32(o->getReads());
+    w.u8(static_cast<u_int8_t>(o->getImportance()));
+    w.u8(static_cast<u_int8_t>(o->getUrgency()));
+    w.u8(static_cast<u_int8_t>(o->getProgress()));
+    const TimeScope& ts = o->getTimeScope();
+    w.u8(ts.years);
+    w.u8(ts.months);
+    w.u8(ts.days);
+    w.u8(ts.hours);
+    w.u8(ts.minutes);
+    w.u32(static_cast<u_int32_t>(ts.relativeSecs));
+    w.u32(o->getBytesize());
+    w.lines(o->getPreamble());
+    w.lines(o->getDescription());
+    writeTagsAndLinks(w, o->getTags(), o->getLinks(), ids, symbols);
+
+    w.u32(static_cast<u_int32_t>(o->getNotes().size()));
+    for(Note* n:o->getNotes()) {
+        w.u8((n->isPostDeclaredSection()?FLAG_POST_DECLARED_SECTION:0)
+             | (n->isTrailingHashesSection()?FLAG_TRAILING_HASHES_SECTION:0));
+        w.str(n->getName());
+        w.u32(symbol(n->getType()->getName(), ids, symbols));
+        w.u16(n->getDepth());
+        w.i64(n->getCreated());
+        w.i64(n->getModified());
+        w.i64(n->getRead());
+        w.i64(n->getDeadline());
+        w.u32(n->getRevision());
+        w.u32(n->getReads());
+        w.u8(n->getProgress());
+        w.lines(n->getDescription());
+        writeTagsAndLinks(w, n->getTags(), n->getLinks(), ids, symbols);
+    }
+}
+
+/*
+ * Snapshot
+ */
+
+RepositorySnapshot::RepositorySnapshot(Ontology& ontology)
+    : ontology(ontology),
+      content{},
+      symbols{},
+      entries{}
+{
+}
+
+RepositorySnapshot::~RepositorySnapshot()
+{
+}
+
+void RepositorySnapshot::clear()
+{
+    content.clear();
+    symbols.clear();
+    entries.clear();
+}
+
+bool RepositorySnapshot::fileStamp(const string& fileName, long long& modified, long long& size)
+{
+    struct stat attrs;
+    if(stat(fileName.c_str(), &attrs)) {
+        return false;
+    }
+    modified = static_cast<long long>(attrs.st_mtime);
+    size = static_cast<long long>(attrs.st_size);
+    return true;
+}
+
+bool RepositorySnapshot::load(const string& fileName)
+{
+    clear();
+
+    ifstream in(fileName, ios::in | ios::binary);
+    if(!in) {
+        return false;
+    }
+    content.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+
+    SnapshotReader r{content.data(), content.size()};
+    if(!r.bytes(SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) || r.u32() != VERSION) {
+        MF_DEBUG("Snapshot " << fileName << " is NOT valid > IGNORED" << endl);
+        clear();
+        return false;
+    }
+
+    u_int32_t count = r.u32();
+    for(u_int32_t i=0; i<count && r.isValid(); i++) {
+        symbols.push_back(r.str());
+    }
+    count = r.u32();
+    for(u_int32_t i=0; i<count && r.isValid(); i++) {
+        string key = r.str();
+        Entry e{};
+        e.modified = r.i64();
+        e.size = r.i64();
+        e.offset = static_cast<size_t>(r.i64());
+        e.length = static_cast<size_t>(r.i64());
+        entries[key] = e;
+    }
+
+    size_t recordsOffset = r.getPosition();
+    for(auto& e:entries) {
+        e.second.offset += recordsOffset;
+        if(e.second.offset > content.size() || e.second.length > content.size()-e.second.offset) {
+            r.invalidate();
+        }
+    }
+    if(!r.isValid()) {
+        MF_DEBUG("Snapshot " << fileName << " is CORRUPTED > IGNORED" << endl);
+        clear();
+        return false;
+    }
+
+    MF_DEBUG("Snapshot " << fileName << " w/ " << entries.size() << " Os loaded" << endl);
+    return true;
+}
+
+Outline* RepositorySnapshot::outline(const string& fileName) const
+{
+    auto i = entries.find(fileName);
+    if(i == entries.end()) {
+        return nullptr;
+    }
+    long long modified, size;
+    // modification time 0 ~ entry was written as invalid
+    if(!i->second.modified
+       || !fileStamp(fileName, modified, size)
+       || modified != i->second.modified
+       || size != i->second.size)
+    {
+        return nullptr;
+    }
+
+    SnapshotReader r{content.data()+i->second.offset, i->second.length};
+    auto outlineType = [&]() {
+        u_int32_t s = r.u32();
+        const OutlineType* t = s<symbols.size()?ontology.getOutlineTypes().get(symbols[s]):nullptr;
+        return t?t:ontology.getDefaultOutlineType();
+    };
+    auto noteType = [&]() {
+        u_int32_t s = r.u32();
+        const NoteType* t = s<symbols.size()?ontology.getNoteTypes().get(symbols[s]):nullptr;
+        return t?t:ontology.getDefaultNoteType();
+    };
+    auto lines = [&](vector<string*>& ls) {
+        u_int32_t count = r.u32();
+        for(u_int32_t l=0; l<count && r.isValid(); l++) {
+            ls.push_back(new string{r.str()});
+        }
+    };
+    auto description = [&](Description& d) {
+        u_int32_t count = r.u32();
+        for(u_int32_t l=0; l<count && r.isValid(); l++) {
+            d.append(r.str());
+        }
+    };
+    auto tags = [&](vector<const Tag*>& ts) {
+        u_int32_t count = r.u32();
+        for(u_int32_t t=0; t<count && r.isValid(); t++) {
+            u_int32_t s = r.u32();
+            if(s < symbols.size()) {
+                ts.push_back(ontology.findOrCreateTag(symbols[s]));
+            }
+        }
+    };
+    auto links = [&](vector<Link*>& ls) {
+        u_int32_t count = r.u32();
+        for(u_int32_t l=0; l<count && r.isValid(); l++) {
+            string name = r.str();
+            ls.push_back(new Link{name, r.str()});
+        }
+    };
+
+    Outline* o = new Outline{ontology.getDefaultOutlineType()};
+    o->setFormat(static_cast<MarkdownDocument::Format>(r.u8()));
+    u_int8_t flags = r.u8();
+    if(flags & FLAG_POST_DECLARED_SECTION) o->setPostDeclaredSection();
+    if(flags & FLAG_TRAILING_HASHES_SECTION) o->setTrailingHashesSection();
+    o->setName(r.str());
+    o->setType(outlineType());
+    o->setCreated(r.i64());
+    o->setModified(r.i64());
+    o->setRead(r.i64());
+    o->setRevision(r.u32());
+    o->setReads(r.u32());
+    o->setImportance(static_cast<int8_t>(r.u8()));
+    o->setUrgency(static_cast<int8_t>(r.u8()));
+    o->setProgress(static_cast<int8_t>(r.u8()));
+    TimeScope ts{};
+    ts.years = r.u8();
+    ts.months = r.u8();
+    ts.days = r.u8();
+    ts.hours = r.u8();
+    ts.minutes = r.u8();
+    ts.relativeSecs = static_cast<int>(r.u32());
+    if(ts.relativeSecs) {
+        o->setTimeScope(ts);
+    }
+    o->setBytesize(r.u32());
+    vector<string*> ls{};
+    lines(ls);
+    for(string* l:ls) {
+        o->addPreambleLine(l);
+    }
+    Description d{};
+    description(d);
+    o->setDescription(d);
+    vector<const Tag*> tgs{};
+    tags(tgs);
+    for(const Tag* t:tgs) {
+        o->addTag(t);
+    }
+    vector<Link*> lns{};
+    links(lns);
+    for(Link* l:lns) {
+        o->addLink(l);
+    }
+
+    u_int32_t count = r.u32();
+    for(u_int32_t i=0; i<count && r.isValid(); i++) {
+        u_int8_t noteFlags = r.u8();
+        string name = r.str();
+        Note* n = new Note{noteType(), o};
+        if(noteFlags & FLAG_POST_DECLARED_SECTION) n->setPostDeclaredSection();
+        if(noteFlags & FLAG_TRAILING_HASHES_SECTION) n->setTrailingHashesSection();
+        n->setName(name);
+        n->setDepth(r.u16());
+        n->setCreated(r.i64());
+        n->setModified(r.i64());
+        n->setRead(r.i64());
+        n->setDeadline(r.i64());
+        n->setRevision(r.u32());
+        n->setReads(r.u32());
+        n->setProgress(r.u8());
+        d.clear();
+        description(d);
+        n->setDescription(d);
+        tgs.clear();
+        tags(tgs);
+        for(const Tag* t:tgs) {
+            n->addTag(t);
+        }
+        lns.clear();
+        links(lns);
+        for(Link* l:lns) {
+            n->addLink(l);
+        }
+        o->addNote(n);
+    }
+
+    if(!r.isValid() || r.getPosition() != i->second.length) {
+        MF_DEBUG("Snapshot O " << fileName << " is CORRUPTED > it will be parsed" << endl);
+        delete o;
+        return nullptr;
+    }
+
+    o->setKey(fileName);
+    o->setModifiedPretty();
+    return o;
+}
+
+bool RepositorySnapshot::save(const string& fileName, const vector<Outline*>& outlines)
+{
+    unordered_map<string,u_int32_t> ids{};
+    vector<const string*> symbols{};
+
+    string index{}, records{};
+    SnapshotWriter i{index}, w{records};
+    // files modified in the current second might be modified again w/o modification time change
+    long long racy = static_cast<long long>(time(nullptr)) - 1;
+    u_int32_t count = 0;
+    for(Outline* o:outlines) {
+        long long modified, size;
+        if(!fileStamp(o->getKey(), modified, size)) {
+            continue;
+        }
+        size_t offset = records.size();
+        writeOutline(w, o, ids, symbols);
+
+        i.str(o->getKey());
+        i.i64(modified>=racy?0:modified);
+        i.i64(size);
+        i.i64(static_cast<long long>(offset));
+        i.i64(static_cast<long long>(records.size()-offset));
+        count++;
+    }
+
+    string header{SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE};
+    SnapshotWriter h{header};
+    h.u32(VERSION);
+    h.u32(static_cast<u_int32_t>(symbols.size()));
+    for(const string* s:symbols) {
+        h.str(*s);
+    }
+    h.u32(count);
+
+    string tmpFileName{fileName};
+    tmpFileName += ".tmp";
+    {
+        ofstream out(tmpFileName, ios::out | ios::binary | ios::trunc);
+        if(!out) {
+            return false;
+        }
+        out.write(header.data(), static_cast<streamsize>(header.size()));
+        out.write(index.data(), static_cast<streamsize>(index.size()));
+        out.write(records.data(), static_cast<streamsize>(records.size()));
+        if(!out) {
+            out.close();
+            remove(tmpFileName.c_str());
+            return false;
+        }
+    }
+#ifdef _WIN32
+    remove(fileName.c_str());
+#endif
+    if(rename(tmpFileName.c_str(), fileName.c_str())) {
+        remove(tmpFileName.c_str());
+        return false;
+    }
+
+    MF_DEBUG("Snapshot " << fileName << " w/ " << count << " Os written" << endl);
+    return true;
+}
+
+} // m8r namespace
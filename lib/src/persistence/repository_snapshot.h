@@ -0,0 +1,111 @@
+/*
+ repository_snapshot.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_REPOSITORY_SNAPSHOT_H
+#define M8R_REPOSITORY_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "../model/outline.h"
+#include "../mind/ontology/ontology.h"
+
+namespace m8r {
+
+/**
+ * @brief Binary snapshot of parsed repository Os.
+ *
+ * Snapshot allows to skip lexing and parsing of Markdown files which
+ * didn't change since the snapshot was written. Snapshot entry is valid
+ * if file modification time and size are the same as when the snapshot
+ * was written. Files modified in the second of the snapshot write cannot
+ * be distinguished from later modifications by the modification time,
+ * therefore they are stored as invalid and parsed on the next load.
+ *
+ * Snapshot layout (integers are little endian):
+ *
+ *   magic, version
+ *   symbols ... tags and types names referenced by O records
+ *   entries ... file path, modification time, size, O record offset and length
+ *   O records
+ *
+ * Snapshot content is loaded once and O records are deserialized on demand
+ * (thread safe) so that snapshot Os and parsed Os can be mixed in any order.
+ * Any inconsistency makes the snapshot (or the O record) invalid i.e. files
+ * are parsed as if there was no snapshot.
+ */
+class RepositorySnapshot
+{
+public:
+    static constexpr u_int32_t VERSION = 1;
+
+private:
+    struct Entry {
+        long long modified;
+        long long size;
+        size_t offset;
+        size_t length;
+    };
+
+    Ontology& ontology;
+
+    std::string content;
+    std::vector<std::string> symbols;
+    std::unordered_map<std::string,Entry> entries;
+
+public:
+    explicit RepositorySnapshot(Ontology& ontology);
+    RepositorySnapshot(const RepositorySnapshot&) = delete;
+    RepositorySnapshot(const RepositorySnapshot&&) = delete;
+    RepositorySnapshot& operator=(const RepositorySnapshot&) = delete;
+    RepositorySnapshot& operator=(const RepositorySnapshot&&) = delete;
+    ~RepositorySnapshot();
+
+    /**
+     * @brief Load snapshot index.
+     *
+     * @return FALSE if snapshot doesn't exist, it has different version or it's corrupted.
+     */
+    bool load(const std::string& fileName);
+
+    void clear();
+
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Get O of given Markdown file from snapshot.
+     *
+     * @return O if file didn't change since the snapshot was written, nullptr otherwise
+     *         (file must be parsed).
+     */
+    Outline* outline(const std::string& fileName) const;
+
+    /**
+     * @brief Write snapshot of Os (keys are file paths).
+     *
+     * Snapshot is written to temporary file which is renamed once it's complete.
+     */
+    static bool save(const std::string& fileName, const std::vector<Outline*>& outlines);
+
+private:
+    static bool fileStamp(const std::string& fileName, long long& modified, long long& size);
+};
+
+}
+#endif // M8R_REPOSITORY_SNAPSHOT_H
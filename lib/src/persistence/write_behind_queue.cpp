@@ -0,0 +1,184 @@
+/*
+ write_behind_queue.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "write_behind_queue.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "../debug.h"
+#include "../gear/file_utils.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr int WriteBehindQueue::MAX_DEBOUNCE;
+
+WriteBehindQueue::WriteBehindQueue(unsigned debounceMillis)
+    : debounce{debounceMillis},
+      mutex{},
+      wakeUp{},
+      idle{},
+      writer{},
+      stopping{false},
+      writing{false},
+      flushing{},
+      pendingSince{},
+      lastWrite{},
+      queue{},
+      contents{},
+      results{},
+      writes{},
+      coalesced{},
+      failures{}
+{
+}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+    flush();
+
+    {
+        lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    if(writer.joinable()) {
+        writer.join();
+    }
+}
+
+void WriteBehindQueue::write(const string& path, string* content)
+{
+    {
+        lock_guard<std::mutex> lock{mutex};
+        lastWrite = chrono::steady_clock::now();
+        // result of a previous write is obsolete
+        results.erase(path);
+        if(contents.empty()) {
+            pendingSince = lastWrite;
+        }
+        auto c = contents.find(path);
+        if(c != contents.end()) {
+            MF_DEBUG("Write-behind COALESCED: " << path << endl);
+            delete c->second;
+            c->second = content;
+            coalesced++;
+        } else {
+            contents[path] = content;
+            queue.push_back(path);
+        }
+
+        if(!writer.joinable()) {
+            writer = std::thread{&WriteBehindQueue::work, this};
+        }
+    }
+    wakeUp.notify_one();
+}
+
+void WriteBehindQueue::flush()
+{
+    unique_lock<std::mutex> lock{mutex};
+    flushing++;
+    // writer waiting for the end of debounce must write now
+    wakeUp.notify_all();
+    idle.wait(lock, [this]{ return queue.empty() && !writing; });
+    flushing--;
+}
+
+unsigned WriteBehindQueue::getWrites()
+{
+    lock_guard<std::mutex> lock{mutex};
+    return writes;
+}
+
+unsigned WriteBehindQueue::getCoalesced()
+{
+    lock_guard<std::mutex> lock{mutex};
+    return coalesced;
+}
+
+unsigned WriteBehindQueue::getFailures()
+{
+    lock_guard<std::mutex> lock{mutex};
+    return failures;
+}
+
+void WriteBehindQueue::takeResults(unordered_map<string,bool>& results)
+{
+    lock_guard<std::mutex> lock{mutex};
+    results.insert(this->results.begin(), this->results.end());
+    this->results.clear();
+}
+
+void WriteBehindQueue::work()
+{
+    unique_lock<std::mutex> lock{mutex};
+    while(true) {
+        wakeUp.wait(lock, [this]{ return stopping || !queue.empty(); });
+        if(queue.empty()) {
+            // stopping
+            return;
+        }
+
+        if(debounce.count()) {
+            // wait for a quiet period so that bursts of writes are coalesced
+            while(!stopping && !flushing) {
+                chrono::steady_clock::time_point deadline = std::min(
+                    lastWrite + debounce,
+                    pendingSince + MAX_DEBOUNCE*debounce);
+                if(chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+                wakeUp.wait_until(lock, deadline);
+            }
+        }
+
+        string path{queue.front()};
+        queue.pop_front();
+        auto c = contents.find(path);
+        string* content = c->second;
+        contents.erase(c);
+        writing = true;
+
+        // new saves of the file are queued while it's being written
+        lock.unlock();
+        bool written = stringToFileAtomically(path, *content);
+        delete content;
+        lock.lock();
+
+        writing = false;
+        if(written) {
+            writes++;
+            MF_DEBUG("Write-behind WRITTEN: " << path << endl);
+        } else {
+            failures++;
+            cerr << "Error: unable to write '" << path << "'" << endl;
+        }
+        // newer save queued meanwhile > its write decides
+        if(contents.find(path) == contents.end()) {
+            results[path] = written;
+        }
+        if(queue.empty()) {
+            idle.notify_all();
+        }
+    }
+}
+
+} // m8r namespace
@@ -0,0 +1,132 @@
+/*
+ write_behind_queue.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_WRITE_BEHIND_QUEUE_H
+#define M8R_WRITE_BEHIND_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace m8r {
+
+/**
+ * @brief Write-behind queue which writes files in a background thread.
+ *
+ * Caller hands over a content snapshot and returns immediately. Saves of
+ * the same file which are still queued are coalesced - only the latest
+ * content is written. Files are written atomically (temp file, fsync and
+ * rename), therefore crash never leaves a truncated file.
+ *
+ * Writer thread is started on the first write. flush() is a barrier which
+ * waits until all queued files are written - it must be called before
+ * the files are read, moved or deleted by others and it's called on destruction.
+ *
+ * Result of the latest write of every file is kept until taken by
+ * takeResults() - the owner of the content uses it to find out whether
+ * the file was really written (results of writes which were superseded
+ * by a newer save are dropped).
+ *
+ * Optional debounce delays writes until there are no new writes for the
+ * debounce period (but at most MAX_DEBOUNCE periods since the first queued
+ * write), therefore bursts of saves are coalesced to a single write. flush()
+ * doesn't wait for the debounce.
+ */
+class WriteBehindQueue
+{
+public:
+    /**
+     * @brief Maximum write delay in debounce periods (writes are not postponed forever).
+     */
+    static constexpr int MAX_DEBOUNCE = 4;
+
+private:
+    const std::chrono::milliseconds debounce;
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable idle;
+    std::thread writer;
+    bool stopping;
+    bool writing;
+    unsigned flushing;
+
+    // debounce: when the queue became non-empty and the last write
+    std::chrono::steady_clock::time_point pendingSince;
+    std::chrono::steady_clock::time_point lastWrite;
+
+    // FIFO of files to write, path > the latest content to be written
+    std::deque<std::string> queue;
+    std::unordered_map<std::string,std::string*> contents;
+
+    // path > whether the latest write succeeded
+    std::unordered_map<std::string,bool> results;
+
+    unsigned writes;
+    unsigned coalesced;
+    unsigned failures;
+
+public:
+    /**
+     * @param debounceMillis    debounce period, no debounce if 0
+     */
+    explicit WriteBehindQueue(unsigned debounceMillis=0);
+    WriteBehindQueue(const WriteBehindQueue&) = delete;
+    WriteBehindQueue(const WriteBehindQueue&&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&&) = delete;
+    ~WriteBehindQueue();
+
+    /**
+     * @brief Queue file write - queue takes ownership of the content.
+     */
+    void write(const std::string& path, std::string* content);
+
+    /**
+     * @brief Wait until all queued files are written.
+     */
+    void flush();
+
+    /**
+     * @brief Number of files written so far.
+     */
+    unsigned getWrites();
+    /**
+     * @brief Number of saves which were replaced by a newer save before written.
+     */
+    unsigned getCoalesced();
+    /**
+     * @brief Number of files which failed to be written.
+     */
+    unsigned getFailures();
+
+    /**
+     * @brief Take results of writes finished since the last call: path > written.
+     */
+    void takeResults(std::unordered_map<std::string,bool>& results);
+
+private:
+    void work();
+};
+
+}
+#endif // M8R_WRITE_BEHIND_QUEUE_H
@@ -18,13 +18,35 @@
  */
 #include "repository_indexer.h"
 
+#ifdef __linux__
+  #include <sys/inotify.h>
+  #include <sys/stat.h>
+#endif
+
 using namespace std;
 using namespace m8r::filesystem;
 
 namespace m8r {
 
+#ifdef __linux__
+constexpr const uint32_t WATCH_EVENTS
+    = IN_CLOSE_WRITE|IN_CREATE|IN_DELETE|IN_MOVED_FROM|IN_MOVED_TO|IN_DELETE_SELF;
+
+static bool fileStamp(const string& path, pair<long long,long long>& stamp)
+{
+    struct stat attrs;
+    if(stat(path.c_str(), &attrs)) {
+        return false;
+    }
+    stamp.first = static_cast<long long>(attrs.st_mtim.tv_sec)*1000000000LL + attrs.st_mtim.tv_nsec;
+    stamp.second = static_cast<long long>(attrs.st_size);
+    return true;
+}
+#endif
+
 RepositoryIndexer::RepositoryIndexer()
-    : repository(nullptr)
+    : repository(nullptr),
+      watchDescriptor(-1)
 {}
 
 RepositoryIndexer::~RepositoryIndexer() {
@@ -33,12 +55,14 @@ RepositoryIndexer::~RepositoryIndexer() {
 
 void RepositoryIndexer::clear()
 {
+    unwatch();
     repository = nullptr;
 
     for(const string* f:allFiles) {
         delete f;
     }
     allFiles.clear();
+    filesByPath.clear();
 
     // markdowns (strings were cleared as a part of allFiles strings)
     markdowns.clear();
@@ -147,14 +171,7 @@ void RepositoryIndexer::updateIndexMemory(const string& directory)
                         ppath->append(FILE_PATH_SEPARATOR);
                         ppath->append(entry->d_name);
 
-                        allFiles.insert(ppath);
-                        if(File::fileHasMarkdownExtension(*ppath)) {
-                            markdowns.insert(ppath);
-                        } else if(File::fileHasPdfExtension(*ppath)) {
-                            pdfs.insert(ppath);
-                        } else if(File::fileHasTextExtension(*ppath)) {
-                            texts.insert(ppath);
-                        }
+                        indexFile(ppath);
                     }
                 } while ((entry = readdir(dir)) != 0);
                 closedir(dir);
@@ -167,6 +184,7 @@ void RepositoryIndexer::updateIndexMemory(const string& directory)
             path->append(FILE_PATH_SEPARATOR);
             path->append(repository->getFile());
             allFiles.insert(path);
+            filesByPath[*path] = path;
             if(File::fileHasMarkdownExtension(*path)) {
                 markdowns.insert(path);
             }
@@ -198,6 +216,229 @@ void RepositoryIndexer::updateIndexStencils(const string& directory, set<const s
     }
 }
 
+void RepositoryIndexer::indexFile(const string* path)
+{
+    allFiles.insert(path);
+    filesByPath[*path] = path;
+    if(File::fileHasMarkdownExtension(*path)) {
+        markdowns.insert(path);
+    } else if(File::fileHasPdfExtension(*path)) {
+        pdfs.insert(path);
+    } else if(File::fileHasTextExtension(*path)) {
+        texts.insert(path);
+    }
+}
+
+bool RepositoryIndexer::unindexFile(const string& path)
+{
+    const string* file = findFile(path);
+    if(file) {
+        bool markdown = markdowns.erase(file) > 0;
+        pdfs.erase(file);
+        texts.erase(file);
+        allFiles.erase(file);
+        filesByPath.erase(path);
+        delete file;
+        return markdown;
+    }
+    return false;
+}
+
+const string* RepositoryIndexer::findFile(const string& path) const
+{
+    auto f = filesByPath.find(path);
+    return f != filesByPath.end() ? f->second : nullptr;
+}
+
+bool RepositoryIndexer::watch()
+{
+#ifdef __linux__
+    if(!repository || repository->getMode() != Repository::RepositoryMode::REPOSITORY) {
+        return false;
+    }
+    if(isWatching()) {
+        return true;
+    }
+
+    watchDescriptor = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+    if(watchDescriptor < 0) {
+        MF_DEBUG("Unable to watch repository: inotify cannot be initialized" << endl);
+        return false;
+    }
+    watchDirectory(memoryDirectory, nullptr);
+    MF_DEBUG("Watching " << watchedDirectories.size() << " directories of " << memoryDirectory << endl);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RepositoryIndexer::unwatch()
+{
+#ifdef __linux__
+    if(isWatching()) {
+        // closing inotify instance removes all its watches
+        ::close(watchDescriptor);
+        watchDescriptor = -1;
+    }
+#endif
+    watchedDirectories.clear();
+    ownWrites.clear();
+}
+
+void RepositoryIndexer::watchDirectory(const string& directory, set<string>* changed)
+{
+#ifdef __linux__
+    int wd = inotify_add_watch(watchDescriptor, directory.c_str(), WATCH_EVENTS);
+    if(wd < 0) {
+        MF_DEBUG("Unable to watch directory " << directory << endl);
+        return;
+    }
+    watchedDirectories[wd] = directory;
+
+    // directory is watched first > files which appear in the meantime are reported twice at most
+    DIR* dir;
+    if((dir = opendir(directory.c_str()))) {
+        const struct dirent *entry;
+        string path{};
+        while((entry = readdir(dir))) {
+            if(entry->d_name[0] == '.') {
+                // ., .. and hidden directories/files like .git
+                continue;
+            }
+            path.assign(directory);
+            path += FILE_PATH_SEPARATOR;
+            path += entry->d_name;
+            if(entry->d_type == DT_DIR) {
+                watchDirectory(path, changed);
+            } else if(changed && !findFile(path)) {
+                indexFile(new string{path});
+                if(File::fileHasMarkdownExtension(path)) {
+                    changed->insert(path);
+                }
+            }
+        }
+        closedir(dir);
+    }
+#else
+    UNUSED_ARG(directory);
+    UNUSED_ARG(changed);
+#endif
+}
+
+void RepositoryIndexer::watchOwnWrite(const string& path)
+{
+#ifdef __linux__
+    pair<long long,long long> stamp{};
+    if(isWatching() && fileStamp(path, stamp)) {
+        ownWrites[path] = stamp;
+    }
+#else
+    UNUSED_ARG(path);
+#endif
+}
+
+bool RepositoryIndexer::updateIndexFromWatch(set<string>& changed, set<string>& removed)
+{
+#ifdef __linux__
+    if(!isWatching()) {
+        return true;
+    }
+
+    bool reliable = true;
+    alignas(struct inotify_event) char buffer[16*1024];
+    ssize_t length;
+    while((length = read(watchDescriptor, buffer, sizeof(buffer))) > 0) {
+        const char* e = buffer;
+        while(e < buffer+length) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(e);
+            e += sizeof(struct inotify_event) + event->len;
+
+            if(event->mask & IN_Q_OVERFLOW) {
+                MF_DEBUG("Repository watch queue OVERFLOW" << endl);
+                reliable = false;
+                continue;
+            }
+            auto d = watchedDirectories.find(event->wd);
+            if(d == watchedDirectories.end()) {
+                continue;
+            }
+            if(event->mask & IN_IGNORED) {
+                // watched directory was deleted
+                watchedDirectories.erase(d);
+                continue;
+            }
+            if(!event->len || event->name[0] == '.') {
+                // event on watched directory itself or hidden file
+                continue;
+            }
+
+            string path{d->second};
+            path += FILE_PATH_SEPARATOR;
+            path += event->name;
+            if(event->mask & IN_ISDIR) {
+                if(event->mask & (IN_CREATE|IN_MOVED_TO)) {
+                    watchDirectory(path, &changed);
+                } else if(event->mask & IN_MOVED_FROM) {
+                    // directory moved away: stop watching it and forget its files
+                    string prefix{path};
+                    prefix += FILE_PATH_SEPARATOR;
+                    for(auto w = watchedDirectories.begin(); w != watchedDirectories.end(); ) {
+                        if(w->second == path || stringStartsWith(w->second, prefix)) {
+                            inotify_rm_watch(watchDescriptor, w->first);
+                            w = watchedDirectories.erase(w);
+                        } else {
+                            ++w;
+                        }
+                    }
+                    vector<string> files{};
+                    for(const string* f:allFiles) {
+                        if(stringStartsWith(*f, prefix)) {
+                            files.push_back(*f);
+                        }
+                    }
+                    for(const string& f:files) {
+                        if(unindexFile(f)) {
+                            changed.erase(f);
+                            removed.insert(f);
+                        }
+                    }
+                }
+                // deleted directory files are reported by IN_DELETE events
+            } else if(event->mask & (IN_CLOSE_WRITE|IN_MOVED_TO)) {
+                auto w = ownWrites.find(path);
+                if(w != ownWrites.end()) {
+                    pair<long long,long long> stamp{};
+                    if(fileStamp(path, stamp) && stamp == w->second) {
+                        continue;
+                    }
+                    ownWrites.erase(w);
+                }
+                if(!findFile(path)) {
+                    indexFile(new string{path});
+                }
+                if(File::fileHasMarkdownExtension(path)) {
+                    removed.erase(path);
+                    changed.insert(path);
+                }
+            } else if(event->mask & (IN_DELETE|IN_MOVED_FROM)) {
+                ownWrites.erase(path);
+                if(unindexFile(path)) {
+                    changed.erase(path);
+                    removed.insert(path);
+                }
+            }
+        }
+    }
+
+    return reliable;
+#else
+    UNUSED_ARG(changed);
+    UNUSED_ARG(removed);
+    return true;
+#endif
+}
+
 const set<const string*> RepositoryIndexer::getMarkdownFiles() const {
     return markdowns;
 }
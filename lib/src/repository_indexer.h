@@ -32,6 +32,9 @@
 
 #include <iostream>
 #include <vector>
+#include <set>
+#include <unordered_map>
+#include <map>
 
 #include "debug.h"
 #include "gear/file_utils.h"
@@ -78,6 +81,8 @@ private:
     std::string noteStencilsDirectory;
 
     std::set<const std::string*> allFiles;
+    // allFiles by path
+    std::unordered_map<std::string,const std::string*> filesByPath;
     std::set<const std::string*> markdowns;
     std::set<const std::string*> outlineStencils;
     std::set<const std::string*> noteStencils;
@@ -91,6 +96,17 @@ private:
     // TXTs
     std::set<const std::string*> texts;
 
+    /*
+     * Watch: memory directory changes made by others (Linux inotify)
+     */
+
+    // inotify instance, -1 if repository is not watched
+    int watchDescriptor;
+    // watch descriptor > watched directory
+    std::map<int,std::string> watchedDirectories;
+    // files written by MindForger > (modification time ns, size) when written
+    std::map<std::string,std::pair<long long,long long>> ownWrites;
+
 public:
     explicit RepositoryIndexer();
     RepositoryIndexer(const RepositoryIndexer&) = delete;
@@ -124,9 +140,52 @@ public:
      */
     void clear();
 
+    /**
+     * @brief Watch memory directory (and its subdirectories) for changes made by others.
+     *
+     * Only directory repositories can be watched, hidden directories like .git are skipped.
+     *
+     * @return FALSE if watch is not supported (non-Linux platform) or it cannot be established.
+     */
+    bool watch();
+    void unwatch();
+    bool isWatching() const { return watchDescriptor >= 0; }
+
+    /**
+     * @brief Don't report the change of a file which was written by MindForger itself.
+     *
+     * File is ignored until it is modified again.
+     */
+    void watchOwnWrite(const std::string& path);
+
+    /**
+     * @brief Update index with watched changes since the last call (non-blocking).
+     *
+     * @param changed   Markdown files which were created or modified.
+     * @param removed   Markdown files which were deleted or moved away.
+     * @return FALSE if changes were lost (watch queue overflow) and the repository
+     *         must be indexed from scratch.
+     */
+    bool updateIndexFromWatch(std::set<std::string>& changed, std::set<std::string>& removed);
+
 private:
     void updateIndexMemory(const std::string& directory);
     void updateIndexStencils(const std::string& directory, std::set<const std::string*>& stencils);
+
+    /**
+     * @brief Add file to the sets of files by its type.
+     */
+    void indexFile(const std::string* path);
+    /**
+     * @brief Remove file from the sets of files.
+     * @return TRUE if file was an indexed Markdown.
+     */
+    bool unindexFile(const std::string& path);
+    const std::string* findFile(const std::string& path) const;
+    /**
+     * @brief Watch directory recursively and index (and report) files which are not known yet.
+     */
+    void watchDirectory(const std::string& directory, std::set<std::string>* changed);
 };
 
 } /* namespace */
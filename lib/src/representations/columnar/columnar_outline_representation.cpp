@@ -0,0 +1,378 @@
+/*
+ columnar_outline_representation.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "columnar_outline_representation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+
+#include "../../mind/ai/nlp/bag_of_words.h"
+#include "../../mind/ai/nlp/lexicon.h"
+#include "../../mind/ai/nlp/markdown_tokenizer.h"
+#include "../../mind/ai/nlp/string_char_provider.h"
+
+using namespace std;
+using namespace m8r::filesystem;
+
+namespace m8r {
+
+const char ColumnarOutlineRepresentation::MAGIC[8] = {'M','F','C','O','L','S','0','1'};
+
+/*
+ * Os chunk processed by a worker: thing columns, tags and BoW w/ chunk local word IDs.
+ */
+struct ColumnarChunk {
+    ColumnarOutlineRepresentation::Dataset rows;
+    std::vector<Thing*> things;
+    // row tags: [tagOffsets[i], tagOffsets[i+1])
+    std::vector<const Tag*> tags;
+    std::vector<size_t> tagOffsets;
+    Lexicon lexicon;
+    BagOfWords bow;
+
+    explicit ColumnarChunk() : rows{}, things{}, tags{}, tagOffsets(1, 0), lexicon{}, bow{} {}
+};
+
+template<typename T> static void chunkRow(
+    T* thing,
+    u_int32_t outline,
+    u_int32_t offset,
+    u_int32_t depth,
+    MarkdownTokenizer& tokenizer,
+    ColumnarChunk& chunk)
+{
+    ColumnarOutlineRepresentation::Dataset& rows = chunk.rows;
+    rows.types.push_back(offset?1:0);
+    rows.outlines.push_back(outline);
+    rows.offsets.push_back(offset);
+    rows.depths.push_back(depth);
+    rows.reads.push_back(thing->getReads());
+    rows.writes.push_back(thing->getRevision());
+    rows.created.push_back(thing->getCreated());
+    rows.modified.push_back(thing->getModified());
+    rows.read.push_back(thing->getRead());
+    rows.keys.add(thing->getKey());
+    rows.titles.add(thing->getName());
+
+    chunk.tags.insert(chunk.tags.end(), thing->getTags()->begin(), thing->getTags()->end());
+    chunk.tagOffsets.push_back(chunk.tags.size());
+
+    string text{thing->getName()};
+    text += '\n';
+    text += thing->getDescription().getText();
+    StringCharProvider chars{text};
+    WordFrequencyList wfl{&chunk.lexicon};
+    tokenizer.tokenize(chars, wfl);
+    chunk.bow.add(thing, wfl);
+    chunk.things.push_back(thing);
+}
+
+template<typename T> static void appendVector(vector<T>& to, const vector<T>& from)
+{
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+static void appendStrings(
+    ColumnarOutlineRepresentation::StringColumn& to,
+    const ColumnarOutlineRepresentation::StringColumn& from)
+{
+    u_int64_t base = to.bytes.size();
+    for(size_t i=1; i<from.offsets.size(); i++) {
+        to.offsets.push_back(base + from.offsets[i]);
+    }
+    to.bytes += from.bytes;
+}
+
+void ColumnarOutlineRepresentation::Dataset::clear()
+{
+    types.clear();
+    outlines.clear();
+    offsets.clear();
+    depths.clear();
+    reads.clear();
+    writes.clear();
+    created.clear();
+    modified.clear();
+    read.clear();
+    keys.clear();
+    titles.clear();
+    tags.clear();
+    tagOffsets.assign(1, 0);
+    tagIds.clear();
+    vocabulary.clear();
+    documentFrequencies.clear();
+    tfidfOffsets.assign(1, 0);
+    tfidfWords.clear();
+    tfidfValues.clear();
+}
+
+ColumnarOutlineRepresentation::ColumnarOutlineRepresentation()
+    : wordBlacklist{}
+{
+}
+
+ColumnarOutlineRepresentation::~ColumnarOutlineRepresentation()
+{
+}
+
+void ColumnarOutlineRepresentation::to(
+    const vector<Outline*>& os,
+    Dataset& dataset,
+    ThreadPool* workers,
+    ProgressCallbackCtx* callbackCtx)
+{
+    dataset.clear();
+
+    // 1st pass: chunks are tokenized in parallel and merged in Os order
+    vector<size_t> chunks{};
+    CsvOutlineRepresentation::chunkOutlines(os, CsvOutlineRepresentation::CHUNK_THINGS, chunks);
+    size_t chunksCount = chunks.size()-1;
+    vector<unique_ptr<ColumnarChunk>> pieces(chunksCount);
+
+    unordered_map<const Tag*,u_int32_t> tagIds{};
+    unordered_map<string,u_int32_t> wordIds{};
+    vector<u_int32_t> rowTags{};
+    vector<u_int32_t> wordIdMap{};
+
+    auto process = [&](size_t c) {
+        ColumnarChunk* chunk = new ColumnarChunk{};
+        MarkdownTokenizer tokenizer{chunk->lexicon, wordBlacklist};
+        for(size_t i=chunks[c]; i<chunks[c+1]; i++) {
+            Outline* o = os[i];
+            chunkRow(o, static_cast<u_int32_t>(i), 0, 0, tokenizer, *chunk);
+            u_int32_t offset = 1;
+            for(Note* n:o->getNotes()) {
+                chunkRow(n, static_cast<u_int32_t>(i), offset++, n->getDepth()+1, tokenizer, *chunk);
+            }
+        }
+        pieces[c].reset(chunk);
+    };
+    auto consume = [&](size_t c) {
+        unique_ptr<ColumnarChunk> chunk{std::move(pieces[c])};
+        const Dataset& rows = chunk->rows;
+        appendVector(dataset.types, rows.types);
+        appendVector(dataset.outlines, rows.outlines);
+        appendVector(dataset.offsets, rows.offsets);
+        appendVector(dataset.depths, rows.depths);
+        appendVector(dataset.reads, rows.reads);
+        appendVector(dataset.writes, rows.writes);
+        appendVector(dataset.created, rows.created);
+        appendVector(dataset.modified, rows.modified);
+        appendVector(dataset.read, rows.read);
+        appendStrings(dataset.keys, rows.keys);
+        appendStrings(dataset.titles, rows.titles);
+
+        // chunk local word IDs to dataset vocabulary IDs
+        wordIdMap.resize(chunk->lexicon.size());
+        for(u_int32_t w=0; w<chunk->lexicon.size(); w++) {
+            const string& word = chunk->lexicon.getWord(w);
+            auto i = wordIds.find(word);
+            if(i == wordIds.end()) {
+                u_int32_t id = static_cast<u_int32_t>(dataset.vocabulary.size());
+                wordIds[word] = id;
+                dataset.vocabulary.add(word);
+                dataset.documentFrequencies.push_back(0);
+                wordIdMap[w] = id;
+            } else {
+                wordIdMap[w] = i->second;
+            }
+        }
+
+        for(size_t r=0; r<chunk->things.size(); r++) {
+            rowTags.clear();
+            for(size_t t=chunk->tagOffsets[r]; t<chunk->tagOffsets[r+1]; t++) {
+                const Tag* tag = chunk->tags[t];
+                auto i = tagIds.find(tag);
+                if(i == tagIds.end()) {
+                    u_int32_t id = static_cast<u_int32_t>(dataset.tags.size());
+                    tagIds[tag] = id;
+                    dataset.tags.add(tag->getName());
+                    rowTags.push_back(id);
+                } else {
+                    rowTags.push_back(i->second);
+                }
+            }
+            std::sort(rowTags.begin(), rowTags.end());
+            rowTags.erase(std::unique(rowTags.begin(), rowTags.end()), rowTags.end());
+            appendVector(dataset.tagIds, rowTags);
+            dataset.tagOffsets.push_back(dataset.tagIds.size());
+
+            // raw frequencies - weighted in the 2nd pass once document frequencies are known
+            const BagOfWords::DocVector* terms = chunk->bow.get(chunk->things[r]);
+            for(const WordFrequencyList::Term& term:*terms) {
+                u_int32_t id = wordIdMap[term.id];
+                dataset.tfidfWords.push_back(id);
+                dataset.tfidfValues.push_back(static_cast<float>(term.frequency));
+                dataset.documentFrequencies[id]++;
+            }
+            dataset.tfidfOffsets.push_back(dataset.tfidfWords.size());
+        }
+
+        if(callbackCtx) {
+            callbackCtx->updateProgress(static_cast<float>(chunks[c+1])/static_cast<float>(os.size()));
+        }
+    };
+    if(workers) {
+        workers->processInOrder(chunksCount, process, consume);
+    } else {
+        for(size_t c=0; c<chunksCount; c++) {
+            process(c);
+            consume(c);
+        }
+    }
+
+    // 2nd pass: TF-IDF weights and rows ordered by word ID (rows are independent)
+    const size_t ROWS_CHUNK = 4096;
+    size_t rowsChunks = (dataset.size()+ROWS_CHUNK-1)/ROWS_CHUNK;
+    float documents = static_cast<float>(dataset.size());
+    auto weigh = [&](size_t c) {
+        vector<pair<u_int32_t,float>> row{};
+        for(size_t r=c*ROWS_CHUNK; r<std::min(dataset.size(), (c+1)*ROWS_CHUNK); r++) {
+            size_t from = dataset.tfidfOffsets[r];
+            size_t to = dataset.tfidfOffsets[r+1];
+            float words = 0;
+            for(size_t i=from; i<to; i++) {
+                words += dataset.tfidfValues[i];
+            }
+            row.clear();
+            for(size_t i=from; i<to; i++) {
+                u_int32_t w = dataset.tfidfWords[i];
+                float idf = std::log((1.f+documents)/(1.f+dataset.documentFrequencies[w])) + 1.f;
+                row.push_back(make_pair(w, dataset.tfidfValues[i]/words*idf));
+            }
+            std::sort(row.begin(), row.end());
+            for(size_t i=from; i<to; i++) {
+                dataset.tfidfWords[i] = row[i-from].first;
+                dataset.tfidfValues[i] = row[i-from].second;
+            }
+        }
+    };
+    if(workers) {
+        workers->processInOrder(rowsChunks, weigh, [](size_t) {});
+    } else {
+        for(size_t c=0; c<rowsChunks; c++) {
+            weigh(c);
+        }
+    }
+}
+
+/*
+ * Binary writer: arrays are padded to 8B so that every array is aligned.
+ */
+class ColumnarWriter
+{
+private:
+    std::ofstream& out;
+    u_int64_t position;
+
+public:
+    explicit ColumnarWriter(std::ofstream& out) : out(out), position{0} {}
+
+    void bytes(const void* data, size_t size) {
+        out.write(static_cast<const char*>(data), size);
+        position += size;
+        static const char PADDING[8] = {};
+        if(position % 8) {
+            size_t padding = 8 - position % 8;
+            out.write(PADDING, padding);
+            position += padding;
+        }
+    }
+    template<typename T> void array(const vector<T>& v) {
+        bytes(v.data(), v.size()*sizeof(T));
+    }
+    void strings(const ColumnarOutlineRepresentation::StringColumn& s) {
+        array(s.offsets);
+        bytes(s.bytes.data(), s.bytes.size());
+    }
+};
+
+bool ColumnarOutlineRepresentation::write(const Dataset& dataset, const string& fileName)
+{
+    std::ofstream out{fileName, std::ofstream::binary};
+    if(!out.is_open()) {
+        cerr << "Error: unable to open file " << fileName << endl;
+        return false;
+    }
+
+    ColumnarWriter writer{out};
+    vector<u_int64_t> counts{
+        dataset.size(),
+        dataset.tags.size(),
+        dataset.vocabulary.size(),
+        dataset.tfidfValues.size()};
+    writer.bytes(MAGIC, sizeof(MAGIC));
+    writer.array(counts);
+    writer.array(dataset.types);
+    writer.array(dataset.outlines);
+    writer.array(dataset.offsets);
+    writer.array(dataset.depths);
+    writer.array(dataset.reads);
+    writer.array(dataset.writes);
+    writer.array(dataset.created);
+    writer.array(dataset.modified);
+    writer.array(dataset.read);
+    writer.strings(dataset.keys);
+    writer.strings(dataset.titles);
+    writer.strings(dataset.tags);
+    writer.array(dataset.tagOffsets);
+    writer.array(dataset.tagIds);
+    writer.strings(dataset.vocabulary);
+    writer.array(dataset.documentFrequencies);
+    writer.array(dataset.tfidfOffsets);
+    writer.array(dataset.tfidfWords);
+    writer.array(dataset.tfidfValues);
+
+    out.flush();
+    bool written = !out.fail();
+    out.close();
+    if(!written) {
+        cerr << "Error: unable to write file " << fileName << endl;
+    }
+    return written;
+}
+
+bool ColumnarOutlineRepresentation::to(
+    const vector<Outline*>& os,
+    const File& sourceFile,
+    ThreadPool* workers,
+    ProgressCallbackCtx* callbackCtx)
+{
+    MF_DEBUG("Exporting Memory to columnar " << sourceFile.getName() << " ..." << endl);
+
+    if(sourceFile.getName().empty()) {
+        cerr << "Error: target file name is empty";
+        return false;
+    }
+
+    Dataset dataset{};
+    try {
+        to(os, dataset, workers, callbackCtx);
+    } catch(...) {
+        cerr << "Error: unable to export Os to file " << sourceFile.getName() << endl;
+        return false;
+    }
+    bool written = write(dataset, sourceFile.getName());
+
+    MF_DEBUG("FINISHED export of MIND to columnar " << sourceFile.getName() << endl);
+    return written;
+}
+
+} // m8r namespace
@@ -0,0 +1,160 @@
+/*
+ columnar_outline_representation.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_COLUMNAR_OUTLINE_REPRESENTATION_H
+#define M8R_COLUMNAR_OUTLINE_REPRESENTATION_H
+
+#include <string>
+#include <vector>
+
+#include "../../model/outline.h"
+#include "../../gear/async_utils.h"
+#include "../../gear/file_utils.h"
+#include "../../gear/thread_pool.h"
+#include "../../mind/ai/nlp/common_words_blacklist.h"
+#include "../csv/csv_outline_representation.h"
+
+namespace m8r {
+
+/**
+ * @brief Compact binary columnar export of Os and Ns for machine learning pipelines.
+ *
+ * Rows are Os and Ns in the same order as CSV export. File is a sequence
+ * of arrays in native (little endian) byte order, every array starts
+ * at 8B aligned position so that it can be memory mapped as it is
+ * (e.g. numpy.frombuffer()):
+ *
+ *   char[8]    magic "MFCOLS01"
+ *   u64        rows, tags, words, TF-IDF non-zero values
+ *   u8[rows]   type: 0 O, 1 N
+ *   u32[rows]  O index, offset, depth, reads, writes (one array each)
+ *   i64[rows]  created, modified, read (one array each)
+ *   strings    keys, titles: u64[rows+1] offsets, UTF-8 bytes
+ *   strings    tags dictionary: u64[tags+1] offsets, UTF-8 bytes
+ *   CSR        row tags: u64[rows+1] offsets, u32[] tag IDs
+ *   strings    vocabulary (stemmed words): u64[words+1] offsets, UTF-8 bytes
+ *   u32[words] document frequency
+ *   CSR        TF-IDF: u64[rows+1] offsets, u32[] word IDs (ascending), f32[] values
+ *
+ * TF-IDF is calculated from bag of words of thing's name and description:
+ * tf = frequency / words in thing, idf = ln((1+rows)/(1+df)) + 1.
+ *
+ * Chunks of Os are tokenized in parallel (chunk local Lexicon and BagOfWords),
+ * dictionaries are merged in Os order, therefore IDs are deterministic.
+ */
+class ColumnarOutlineRepresentation
+{
+public:
+    static const char MAGIC[8];
+
+    /**
+     * @brief Strings column: string i is bytes [offsets[i], offsets[i+1]).
+     */
+    struct StringColumn {
+        std::vector<u_int64_t> offsets;
+        std::string bytes;
+
+        explicit StringColumn() : offsets(1, 0), bytes{} {}
+
+        size_t size() const { return offsets.size()-1; }
+        void add(const std::string& s) {
+            bytes += s;
+            offsets.push_back(bytes.size());
+        }
+        std::string get(size_t i) const {
+            return bytes.substr(offsets[i], offsets[i+1]-offsets[i]);
+        }
+        void clear() {
+            offsets.assign(1, 0);
+            bytes.clear();
+        }
+    };
+
+    struct Dataset {
+        std::vector<u_int8_t> types;
+        std::vector<u_int32_t> outlines;
+        std::vector<u_int32_t> offsets;
+        std::vector<u_int32_t> depths;
+        std::vector<u_int32_t> reads;
+        std::vector<u_int32_t> writes;
+        std::vector<int64_t> created;
+        std::vector<int64_t> modified;
+        std::vector<int64_t> read;
+        StringColumn keys;
+        StringColumn titles;
+
+        StringColumn tags;
+        std::vector<u_int64_t> tagOffsets;
+        std::vector<u_int32_t> tagIds;
+
+        StringColumn vocabulary;
+        std::vector<u_int32_t> documentFrequencies;
+        std::vector<u_int64_t> tfidfOffsets;
+        std::vector<u_int32_t> tfidfWords;
+        std::vector<float> tfidfValues;
+
+        explicit Dataset() { clear(); }
+
+        size_t size() const { return types.size(); }
+        void clear();
+    };
+
+private:
+    CommonWordsBlacklist wordBlacklist;
+
+public:
+    explicit ColumnarOutlineRepresentation();
+    ColumnarOutlineRepresentation(const ColumnarOutlineRepresentation&) = delete;
+    ColumnarOutlineRepresentation(const ColumnarOutlineRepresentation&&) = delete;
+    ColumnarOutlineRepresentation& operator =(const ColumnarOutlineRepresentation&) = delete;
+    ColumnarOutlineRepresentation& operator =(const ColumnarOutlineRepresentation&&) = delete;
+    virtual ~ColumnarOutlineRepresentation();
+
+    /**
+     * @brief Build columnar dataset of given Os.
+     *
+     * @param workers  thread pool to process chunks in parallel
+     *                 (nullptr to process them in the calling thread).
+     *
+     * Exception thrown while a chunk is processed is propagated to the caller.
+     */
+    void to(
+        const std::vector<Outline*>& os,
+        Dataset& dataset,
+        ThreadPool* workers = nullptr,
+        ProgressCallbackCtx* callbackCtx = nullptr);
+
+    /**
+     * @brief Serialize given Os to columnar binary file.
+     *
+     * @return `true` on success.
+     */
+    bool to(
+        const std::vector<Outline*>& os,
+        const filesystem::File& sourceFile,
+        ThreadPool* workers = nullptr,
+        ProgressCallbackCtx* callbackCtx = nullptr);
+
+    /**
+     * @brief Write dataset to binary file.
+     */
+    bool write(const Dataset& dataset, const std::string& fileName);
+};
+
+}
+#endif // M8R_COLUMNAR_OUTLINE_REPRESENTATION_H
@@ -23,6 +23,8 @@ using namespace m8r::filesystem;
 
 namespace m8r {
 
+constexpr size_t CsvOutlineRepresentation::CHUNK_THINGS;
+
 const std::string CsvOutlineRepresentation::DELIMITER_CSV_HEADER = string{","};
 
 CsvOutlineRepresentation::CsvOutlineRepresentation()
@@ -33,6 +35,23 @@ CsvOutlineRepresentation::~CsvOutlineRepresentation()
 {
 }
 
+void CsvOutlineRepresentation::chunkOutlines(const vector<Outline*>& os, size_t chunkThings, vector<size_t>& chunks)
+{
+    chunks.clear();
+    chunks.push_back(0);
+    size_t things = 0;
+    for(size_t i=0; i<os.size(); i++) {
+        things += 1 + os[i]->getNotesCount();
+        if(things >= chunkThings) {
+            chunks.push_back(i+1);
+            things = 0;
+        }
+    }
+    if(chunks.back() != os.size()) {
+        chunks.push_back(os.size());
+    }
+}
+
 /**
  * @brief Serialize O to CSV in "Recent view" style
  *
@@ -44,7 +63,8 @@ bool CsvOutlineRepresentation::to(
     const map<const Tag*,int>& tagsCardinality,
     const File& sourceFile,
     int oheTagEncodingCardinality,
-    ProgressCallbackCtx* callbackCtx
+    ProgressCallbackCtx* callbackCtx,
+    ThreadPool* workers
 ) {
     MF_DEBUG("Exporting Memory to CSV "
         << sourceFile.getName()
@@ -55,45 +75,71 @@ bool CsvOutlineRepresentation::to(
     if(sourceFile.getName().size()) {
         if(os.size()) {
             // prepare top tags: filter out entries w/ low cardinality
-            vector<const Tag*> oheTags{};
+            unordered_map<const Tag*,size_t> oheColumns{};
+            vector<string> escapedOheTags{};
             if(oheTagEncodingCardinality > -1) {
                 for(auto t:tagsCardinality) {
                     if(t.second >= oheTagEncodingCardinality) {
-                        oheTags.push_back(t.first);
+                        oheColumns[t.first] = escapedOheTags.size();
+                        escapedOheTags.push_back(normalizeToNcName(t.first->getName(), '_'));
                     }
                 }
             }
-            vector<string> escapedOheTags{};
-            for(auto t:oheTags) {
-                escapedOheTags.push_back(normalizeToNcName(t->getName(), '_'));
+            string oheZeros{};
+            for(size_t i=0; i<escapedOheTags.size(); i++) {
+                oheZeros += ",0";
             }
 
-            std::ofstream out{};
-            try {
-                out.open(sourceFile.getName());
-
-                float exported{0.0};
-                toHeader(out, escapedOheTags);
-                for(Outline* o:os) {
-                    MF_DEBUG("  Exporting O: " << o->getName() << " / " << o->getKey() << endl);
-                    to(o, oheTags, out);
+            std::ofstream out{sourceFile.getName(), std::ofstream::binary};
+            if(!out.is_open()) {
+                cerr << "Error: unable to open file " << sourceFile.getName() << endl;
+                return false;
+            }
 
-                    if(callbackCtx) {
-                        callbackCtx->updateProgress(++exported/(float)os.size());
+            string header{};
+            toHeader(header, escapedOheTags);
+            out.write(header.data(), header.size());
+
+            // chunks are serialized to buffers in parallel and written in order
+            vector<size_t> chunks{};
+            chunkOutlines(os, CHUNK_THINGS, chunks);
+            size_t chunksCount = chunks.size()-1;
+            vector<string> buffers(chunksCount);
+            auto process = [&](size_t c) {
+                for(size_t i=chunks[c]; i<chunks[c+1]; i++) {
+                    MF_DEBUG("  Exporting O: " << os[i]->getName() << " / " << os[i]->getKey() << endl);
+                    to(os[i], oheColumns, oheZeros, buffers[c]);
+                }
+            };
+            auto consume = [&](size_t c) {
+                out.write(buffers[c].data(), buffers[c].size());
+                string{}.swap(buffers[c]);
+                if(callbackCtx) {
+                    callbackCtx->updateProgress(static_cast<float>(chunks[c+1])/static_cast<float>(os.size()));
+                }
+            };
+            try {
+                if(workers) {
+                    workers->processInOrder(chunksCount, process, consume);
+                } else {
+                    for(size_t c=0; c<chunksCount; c++) {
+                        process(c);
+                        consume(c);
                     }
                 }
-            } catch(const std::ofstream::failure& e) {
-                cerr << "Error: unable to open/write file "
-                     << sourceFile.getName()
-                     << " " << e.what();
-                try {
-                    out.close();
-                } catch(const std::ofstream::failure& e) {}
-
+            } catch(...) {
+                // file would be truncated
+                cerr << "Error: unable to export Os to file " << sourceFile.getName() << endl;
                 return false;
             }
+
             out.flush();
+            bool written = !out.fail();
             out.close();
+            if(!written) {
+                cerr << "Error: unable to write file " << sourceFile.getName() << endl;
+                return false;
+            }
 
             MF_DEBUG("FINISHED export of MIND to CSV " << sourceFile.getName() << endl);
             return true;
@@ -105,7 +151,7 @@ bool CsvOutlineRepresentation::to(
     return false;
 }
 
-void CsvOutlineRepresentation::toHeader(std::ofstream& out, vector<string>& extraColumns)
+void CsvOutlineRepresentation::toHeader(string& out, vector<string>& extraColumns)
 {
 
     // O/N CSV line
@@ -138,89 +184,102 @@ void CsvOutlineRepresentation::toHeader(std::ofstream& out, vector<string>& extr
     header.pop_back();
     header += "\n";
 
-    out << header;
+    out += header;
 }
 
 void CsvOutlineRepresentation::to(
-    Outline* o, vector<const Tag*> oheTags, ofstream& out
+    Outline* o,
+    const unordered_map<const Tag*,size_t>& oheColumns,
+    const string& oheZeros,
+    string& out
 ) {
     MF_DEBUG("\n  " << o->getName());
 
-    string s{};
-
-    // O
-    out << o->getKey() << ",";
-    out << "o,";
-    s.clear(); quoteValue(o->getName(), s);
-    out << s << ",";
     // O's offset and depth == 0
-    out << "0,";
-    out << "0,";
-    out << o->getReads() << ",";
-    out << o->getRevision() << ",";
-    out << o->getCreated() << ",";
-    out << o->getModified() << ",";
-    out << o->getRead() << ",";
-    s.clear(); quoteValue(o->getDescriptionAsString(" "), s);
-    out << s;
-
-    for(auto t:oheTags) {
-        if(o->hasTag(t)) {
-            out << ",1";
-        } else {
-            out << ",0";
-        }
-    }
-
-    out << "\n";
+    toRow(o, 0, 0, oheColumns, oheZeros, out);
 
     // Ns
     const vector<Note*>& ns = o->getNotes();
-    int offset = 1;
+    size_t offset = 1;
     for(Note* n:ns) {
         MF_DEBUG("    " << n->getName());
-        out << n->getKey() << ",";
-        out << "n,";
-        s.clear(); quoteValue(n->getName(), s);
-        out << s << ",";
-        // N's offset: <1,inf>
-        out << offset++ << ",";
-        // N's depth: <1,inf>
-        out << (n->getDepth()+1) << ",";
-        out << n->getReads() << ",";
-        out << n->getRevision() << ",";
-        out << n->getCreated() << ",";
-        out << n->getModified() << ",";
-        out << n->getRead() << ",";
-        MF_DEBUG(" B ");
-        s.clear(); quoteValue(n->getDescriptionAsString(" "), s);
-        MF_DEBUG(" F ");
-        out << s;
-
-        for(auto t:oheTags) {
-            if(n->hasTag(t)) {
-                out << ",1";
-            } else {
-                out << ",0";
+        // N's offset and depth: <1,inf>
+        toRow(n, offset++, n->getDepth()+1, oheColumns, oheZeros, out);
+    }
+}
+
+template<typename T> void CsvOutlineRepresentation::toRow(
+    T* thing,
+    size_t offset,
+    size_t depth,
+    const unordered_map<const Tag*,size_t>& oheColumns,
+    const string& oheZeros,
+    string& out
+) {
+    out += thing->getKey();
+    out += offset?",n,":",o,";
+    quoteValue(thing->getName(), out);
+    out += ',';
+    appendNumber(offset, out);
+    out += ',';
+    appendNumber(depth, out);
+    out += ',';
+    appendNumber(thing->getReads(), out);
+    out += ',';
+    appendNumber(thing->getRevision(), out);
+    out += ',';
+    appendNumber(thing->getCreated(), out);
+    out += ',';
+    appendNumber(thing->getModified(), out);
+    out += ',';
+    appendNumber(thing->getRead(), out);
+    out += ',';
+    quoteDescription(thing->getDescription(), out);
+
+    // OHE: zeros w/ ones at columns of thing's tags - ",0" is column at index 2*column+1
+    if(oheZeros.size()) {
+        size_t ohe = out.size();
+        out += oheZeros;
+        for(const Tag* t:*thing->getTags()) {
+            auto c = oheColumns.find(t);
+            if(c != oheColumns.end()) {
+                out[ohe + 2*c->second + 1] = '1';
             }
         }
-
-        out << "\n";
-        MF_DEBUG(" ... DONE" << endl);
-        out.flush();
     }
+
+    out += '\n';
 }
 
 void CsvOutlineRepresentation::quoteValue(const std::string& is, std::string& os)
 {
     if(is.size()) {
-        os.append(" ");
-        os.append(is);
-
-        replaceAll("\"", "\"\"", os);
+        os += '\"';
+        for(char c:is) {
+            if(c == '\"') {
+                os += '\"';
+            }
+            os += c;
+        }
+        os += '\"';
+    }
+}
 
-        os[0] = '\"';
-        os.append("\"");
+void CsvOutlineRepresentation::quoteDescription(const Description& description, string& os)
+{
+    // description lines joined w/ (trailing) space
+    if(description.size()) {
+        os += '\"';
+        for(const Description::Line& line:description) {
+            for(char c:line) {
+                if(c == '\"') {
+                    os += '\"';
+                }
+                os += c;
+            }
+            os += ' ';
+        }
+        os += '\"';
     }
 }
 
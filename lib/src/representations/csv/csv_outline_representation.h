@@ -20,12 +20,14 @@
 #define M8R_CSV_OUTLINE_REPRESENTATION_H
 
 #include <iostream>
+#include <unordered_map>
 #include <vector>
 
 #include "../../model/outline.h"
 #include "../../gear/async_utils.h"
 #include "../../gear/file_utils.h"
 #include "../../gear/string_utils.h"
+#include "../../gear/thread_pool.h"
 
 namespace m8r {
 
@@ -35,10 +37,21 @@ namespace m8r {
  * CSV format is therefore designed to make loading of CSVs as datasets to ML frameworks.
  * No library is used to make things simple - also parsing is not needed, just serialization.
  *
+ * Os are serialized in chunks to memory buffers by workers (if available) and
+ * the buffers are written to the file in Os order, therefore export is bound
+ * by disk bandwidth rather than by formatting. OHE columns of tags are resolved
+ * w/ a map, i.e. O(thing's tags) instead of O(OHE tags) per row.
+ *
  * @see https://tools.ietf.org/html/rfc4180
  */
 class CsvOutlineRepresentation
 {
+public:
+    /**
+     * @brief Approximate number of things (Os and Ns) serialized as one chunk.
+     */
+    static constexpr size_t CHUNK_THINGS = 512;
+
 private:
     static const std::string DELIMITER_CSV_HEADER;
 
@@ -60,6 +73,8 @@ public:
      *                                      or higher to given number (0 or bigger),
      *                                      -1 no OHE.
      * @param callbackCtx                   callback instance to report progress.
+     * @param workers                       thread pool to serialize chunks in parallel
+     *                                      (nullptr to serialize in the calling thread).
      * @return                              `true` on success.
      */
     bool to(
@@ -67,15 +82,58 @@ public:
         const std::map<const Tag*,int>& tagsCardinality,
         const filesystem::File& sourceFile,
         int oheTagEncodingCardinality,
-        ProgressCallbackCtx* callbackCtx = nullptr
+        ProgressCallbackCtx* callbackCtx = nullptr,
+        ThreadPool* workers = nullptr
     );
 
-    void toHeader(std::ofstream& out, std::vector<std::string>& extraColumns);
-    void to(Outline* o, std::vector<const Tag*> oheTags, std::ofstream& out);
+    void toHeader(std::string& out, std::vector<std::string>& extraColumns);
+    /**
+     * @brief Append O and its Ns as CSV rows.
+     *
+     * @param oheColumns  OHE tag to its column index.
+     * @param oheZeros    OHE columns of a thing w/o OHE tags i.e. ",0,0,...,0".
+     */
+    void to(
+        Outline* o,
+        const std::unordered_map<const Tag*,size_t>& oheColumns,
+        const std::string& oheZeros,
+        std::string& out);
+
+    /**
+     * @brief Split Os to chunks of ~given number of things (Os and Ns).
+     *
+     * @param chunks  chunk i is [chunks[i], chunks[i+1]) of Os.
+     */
+    static void chunkOutlines(const std::vector<Outline*>& os, size_t chunkThings, std::vector<size_t>& chunks);
 
 private:
+    template<typename T> void toRow(
+        T* thing,
+        size_t offset,
+        size_t depth,
+        const std::unordered_map<const Tag*,size_t>& oheColumns,
+        const std::string& oheZeros,
+        std::string& out);
     void quoteValue(const std::string& is, std::string& os);
+    void quoteDescription(const Description& description, std::string& os);
 
+    /**
+     * @brief Append decimal number w/o allocation.
+     */
+    static void appendNumber(long long n, std::string& out) {
+        char digits[24];
+        char* e = digits+sizeof(digits);
+        char* b = e;
+        unsigned long long u = n<0?0ULL-static_cast<unsigned long long>(n):static_cast<unsigned long long>(n);
+        do {
+            *--b = static_cast<char>('0' + u%10);
+            u /= 10;
+        } while(u);
+        if(n<0) {
+            *--b = '-';
+        }
+        out.append(b, e-b);
+    }
 };
 
 }
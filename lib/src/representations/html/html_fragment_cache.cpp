@@ -0,0 +1,102 @@
+/*
+ html_fragment_cache.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "html_fragment_cache.h"
+
+#include <iterator>
+
+namespace m8r {
+
+using namespace std;
+
+constexpr size_t HtmlFragmentCache::DEFAULT_CAPACITY;
+
+HtmlFragmentCache::HtmlFragmentCache(size_t capacity)
+    : fragments{},
+      index{},
+      capacity{capacity},
+      bytes{},
+      hits{},
+      misses{}
+{
+}
+
+HtmlFragmentCache::~HtmlFragmentCache()
+{
+}
+
+const string* HtmlFragmentCache::find(const Key& key, const Signature& signature)
+{
+    auto i = index.find(key);
+    if(i != index.end()) {
+        if(i->second->signature == signature) {
+            fragments.splice(fragments.begin(), fragments, i->second);
+            hits++;
+            return &i->second->html;
+        }
+        // stale
+        evict(i->second);
+    }
+
+    misses++;
+    return nullptr;
+}
+
+void HtmlFragmentCache::put(const Key& key, const Signature& signature, const string& html)
+{
+    auto i = index.find(key);
+    if(i != index.end()) {
+        evict(i->second);
+    }
+
+    if(sizeof(Entry) + html.size() <= capacity) {
+        fragments.push_front(Entry{key, signature, html});
+        index[key] = fragments.begin();
+        bytes += entryBytes(fragments.front());
+        shrink();
+    }
+}
+
+void HtmlFragmentCache::setCapacity(size_t capacity)
+{
+    this->capacity = capacity;
+    shrink();
+}
+
+void HtmlFragmentCache::clear()
+{
+    fragments.clear();
+    index.clear();
+    bytes = 0;
+}
+
+void HtmlFragmentCache::evict(list<Entry>::iterator e)
+{
+    bytes -= entryBytes(*e);
+    index.erase(e->key);
+    fragments.erase(e);
+}
+
+void HtmlFragmentCache::shrink()
+{
+    while(bytes > capacity && !fragments.empty()) {
+        evict(std::prev(fragments.end()));
+    }
+}
+
+} // m8r namespace
@@ -0,0 +1,132 @@
+/*
+ html_fragment_cache.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef M8R_HTML_FRAGMENT_CACHE_H
+#define M8R_HTML_FRAGMENT_CACHE_H
+
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "../../definitions.h"
+
+namespace m8r {
+
+/**
+ * @brief Cache of rendered HTML fragments (e.g. Ns) w/ bounded memory.
+ *
+ * Fragment is identified by key (thing + rendering flags) - there is
+ * at most one fragment per key. Signature (revision, content hash,
+ * autolinking fingerprint, ...) describes the source the fragment was
+ * rendered from: fragment w/ different signature is stale and it's dropped
+ * on lookup. Fragments are evicted in least recently used order once
+ * the capacity (bytes) is exceeded.
+ *
+ * Cache is NOT thread safe.
+ */
+class HtmlFragmentCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 16*1024*1024;
+
+    struct Key {
+        const void* thing;
+        u_int32_t flags;
+
+        bool operator==(const Key& k) const { return thing == k.thing && flags == k.flags; }
+    };
+
+    struct Signature {
+        u_int32_t revision;
+        u_int32_t options;
+        u_int64_t contentHash;
+        u_int64_t autolinkingFingerprint;
+
+        bool operator==(const Signature& s) const {
+            return revision == s.revision
+                && options == s.options
+                && contentHash == s.contentHash
+                && autolinkingFingerprint == s.autolinkingFingerprint;
+        }
+    };
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& k) const {
+            return std::hash<const void*>()(k.thing) ^ (static_cast<size_t>(k.flags) << 1);
+        }
+    };
+
+    struct Entry {
+        Key key;
+        Signature signature;
+        std::string html;
+    };
+
+    // the most recently used fragment first
+    std::list<Entry> fragments;
+    std::unordered_map<Key,std::list<Entry>::iterator,KeyHash> index;
+
+    size_t capacity;
+    size_t bytes;
+
+    unsigned hits;
+    unsigned misses;
+
+public:
+    explicit HtmlFragmentCache(size_t capacity=DEFAULT_CAPACITY);
+    HtmlFragmentCache(const HtmlFragmentCache&) = delete;
+    HtmlFragmentCache(const HtmlFragmentCache&&) = delete;
+    HtmlFragmentCache& operator=(const HtmlFragmentCache&) = delete;
+    HtmlFragmentCache& operator=(const HtmlFragmentCache&&) = delete;
+    ~HtmlFragmentCache();
+
+    /**
+     * @brief Find fragment rendered from the source w/ given signature.
+     *
+     * @return fragment (valid until cache is modified) or nullptr.
+     */
+    const std::string* find(const Key& key, const Signature& signature);
+
+    /**
+     * @brief Cache fragment - fragment bigger than capacity is not cached.
+     */
+    void put(const Key& key, const Signature& signature, const std::string& html);
+
+    /**
+     * @brief Set capacity in bytes and evict fragments which don't fit.
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const { return capacity; }
+
+    size_t size() const { return fragments.size(); }
+    size_t getBytes() const { return bytes; }
+    unsigned getHits() const { return hits; }
+    unsigned getMisses() const { return misses; }
+
+    void clear();
+
+private:
+    static size_t entryBytes(const Entry& e) { return sizeof(Entry) + e.html.size(); }
+    void evict(std::list<Entry>::iterator e);
+    void shrink();
+};
+
+}
+#endif // M8R_HTML_FRAGMENT_CACHE_H
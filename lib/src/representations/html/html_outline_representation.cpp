@@ -22,13 +22,18 @@ namespace m8r {
 
 using namespace std;
 
+constexpr u_int32_t HtmlOutlineRepresentation::FRAGMENT_AUTOLINKING;
+constexpr u_int32_t HtmlOutlineRepresentation::FRAGMENT_DESCRIPTION_ONLY;
+
 HtmlOutlineRepresentation::HtmlOutlineRepresentation(
         Ontology& ontology,
         RepresentationInterceptor* descriptionInterceptor)
     : config(Configuration::getInstance()),
       exportColors{},
       lf{exportColors},
-      markdownRepresentation(ontology, descriptionInterceptor)
+      markdownRepresentation(ontology, descriptionInterceptor),
+      descriptionInterceptor{descriptionInterceptor},
+      fragmentCache{}
 {
 #if defined MF_MD_2_HTML_CMARK
     markdownTranscoder = new CmarkGfmMarkdownTranscoder{};
@@ -126,9 +131,9 @@ void HtmlOutlineRepresentation::outlineMetadataToHtml(const Outline* outline, st
         html += "<span style='color: ";
         html += outline->getType()->getColor().asHtml();
         html += "; font-style: italic;' title='Last read on ";
-        html += datetimeToString(outline->getRead());
+        datetimeToString(outline->getRead(), html);
         html += ", last write on ";
-        html += datetimeToString(outline->getModified());
+        datetimeToString(outline->getModified(), html);
         html += "'> with ";
         html += std::to_string(outline->getReads());
         html += " reads and ";
@@ -284,15 +289,7 @@ string* HtmlOutlineRepresentation::to(const string* markdown, string* html, stri
         html->clear();
         header(*html, basePath, standalone, yScrollTo);
 
-        if(markdown->size() > 0) {
-#ifdef MF_NO_MD_2_HTML
-            html->append("<pre>");
-            html->append(*markdown);
-            html->append("</pre>");
-#else
-            markdownTranscoder->to(RepresentationType::HTML, markdown, html);
-#endif
-        }
+        toFragment(*markdown, *html);
 
         footer(*html);
     }
@@ -304,6 +301,114 @@ string* HtmlOutlineRepresentation::to(const string* markdown, string* html, stri
     return html;
 }
 
+void HtmlOutlineRepresentation::toFragment(const string& markdown, string& html)
+{
+    if(markdown.size() > 0) {
+#ifdef MF_NO_MD_2_HTML
+        html.append("<pre>");
+        html.append(markdown);
+        html.append("</pre>");
+#else
+        markdownTranscoder->to(RepresentationType::HTML, &markdown, &html);
+#endif
+    }
+}
+
+void HtmlOutlineRepresentation::toFragment(
+    const Note* note,
+    string& html,
+    bool autolinking,
+    bool descriptionOnly)
+{
+    // MD w/o autolinks is cheap to serialize and hash (unlike autolinking and MD to HTML)
+    string markdown{};
+    markdown.reserve(MarkdownOutlineRepresentation::AVG_NOTE_SIZE);
+    if(descriptionOnly) {
+        markdownRepresentation.toDescription(note, &markdown, false);
+    } else {
+        markdownRepresentation.to(note, &markdown, false, false);
+    }
+
+    autolinking = autolinking && descriptionInterceptor;
+    HtmlFragmentCache::Key key{
+        note,
+        (autolinking?FRAGMENT_AUTOLINKING:0) | (descriptionOnly?FRAGMENT_DESCRIPTION_ONLY:0)};
+    HtmlFragmentCache::Signature signature{
+        note->getRevision(),
+        config.getMd2HtmlOptions(),
+        stringHash(markdown),
+        0};
+    bool cacheable = !autolinking || descriptionInterceptor->getFingerprint(signature.autolinkingFingerprint);
+
+    if(cacheable) {
+        const string* fragment = fragmentCache.find(key, signature);
+        if(fragment) {
+            html += *fragment;
+            return;
+        }
+    }
+
+    if(autolinking) {
+        markdown.clear();
+        if(descriptionOnly) {
+            markdownRepresentation.toDescription(note, &markdown, true);
+        } else {
+            markdownRepresentation.to(note, &markdown, false, true);
+        }
+    }
+    if(cacheable) {
+        string fragment{};
+        toFragment(markdown, fragment);
+        fragmentCache.put(key, signature, fragment);
+        html += fragment;
+    } else {
+        toFragment(markdown, html);
+    }
+}
+
+bool HtmlOutlineRepresentation::isDocumentScoped(Outline* outline)
+{
+    auto scoped = [](const Note* note) {
+        for(const Description::Line& line:note->getDescription()) {
+            const char* c = line.begin();
+            const char* e = line.end();
+            // footnote reference or definition: [^label]
+            for(const char* f = c; f+1 < e; f++) {
+                if(f[0]=='[' && f[1]=='^') {
+                    return true;
+                }
+            }
+            // reference link definition: up to 3 spaces indented [label]: url
+            int indent = 0;
+            while(c < e && *c==' ' && indent < 3) {
+                c++;
+                indent++;
+            }
+            if(c < e && *c=='[') {
+                for(const char* r = c+1; r+1 < e; r++) {
+                    if(r[0]==']') {
+                        if(r[1]==':') {
+                            return true;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        return false;
+    };
+
+    if(scoped(outline->getOutlineDescriptorAsNote())) {
+        return true;
+    }
+    for(const Note* note:outline->getNotes()) {
+        if(scoped(note)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 string* HtmlOutlineRepresentation::toNoMeta(Outline* outline, string* html, bool standalone, int yScrollTo)
 {
     // IMPROVE markdown can be processed by Mind to be enriched with various links and relationships
@@ -422,44 +527,37 @@ string* HtmlOutlineRepresentation::to(
         htmlHeader += "<br/>";
 
         // HTML completion
-        string outlineMd{};
         string path, file;
         pathToDirectoryAndFile(outline->getKey(), path, file);
+        html->clear();
+        header(*html, &path, false, yScrollTo);
 
-        // O header
-        if(autolinking) {
+        if(whole && isDocumentScoped(outline)) {
+            // references/footnotes resolved across Ns > O rendered as one MD document
+            string outlineMd{};
             markdownRepresentation.toDescription(
-                outline->getOutlineDescriptorAsNote(),
-                &outlineMd,
-                autolinking
-            );
+                outline->getOutlineDescriptorAsNote(), &outlineMd, autolinking);
+            string noteMd{};
+            for(Note* note:outline->getNotes()) {
+                outlineMd.append("\n");
+                // TODO MD representation to render also tags as HTML injected code (under section)
+                markdownRepresentation.to(note, &noteMd, false, autolinking);
+                outlineMd.append(noteMd);
+            }
+            toFragment(outlineMd, *html);
         } else {
-            outlineMd.append(
-                outline->getOutlineDescriptorAsNote()->getDescriptionAsString()
-            );
-        }
-        // Ns
-        if(whole) {
-            const vector<Note*>& notes=outline->getNotes();
-            if(notes.size()) {
-                string noteMd{};
-                for(Note* note:notes) {
-                    outlineMd.append("\n");
+            // O header
+            toFragment(outline->getOutlineDescriptorAsNote(), *html, autolinking, true);
+            // Ns: stitched from cached fragments - only modified Ns are rendered
+            if(whole) {
+                for(Note* note:outline->getNotes()) {
                     // TODO MD representation to render also tags as HTML injected code (under section)
-                    markdownRepresentation.to(
-                        note,
-                        &noteMd,
-                        outline->getFormat()==MarkdownDocument::Format::MINDFORGER,
-                        autolinking
-                    );
-                    outlineMd.append(noteMd);
-                    noteMd.clear();
+                    toFragment(note, *html, autolinking, false);
                 }
             }
         }
 
-        // MD 2 HTML
-        to(&outlineMd, html, &path, false, yScrollTo);
+        footer(*html);
         // inject custom HTML header
         html->replace(
                     html->find("<body>"), // <body> element index
@@ -483,14 +581,24 @@ string* HtmlOutlineRepresentation::to(
     bool autolinking,
     int yScrollTo)
 {
-    string* markdown = new string{};
-    markdown->reserve(MarkdownOutlineRepresentation::AVG_NOTE_SIZE);
-    markdownRepresentation.to(note, markdown, true, autolinking);
-
     string path, file;
     pathToDirectoryAndFile(note->getOutlineKey(), path, file);
-    to(markdown, html, &path, false, yScrollTo);
-    delete markdown;
+
+    if(!config.isUiHtmlTheme()) {
+        string markdown{};
+        markdown.reserve(MarkdownOutlineRepresentation::AVG_NOTE_SIZE);
+        markdownRepresentation.to(note, &markdown, true, autolinking);
+        return to(&markdown, html, &path, false, yScrollTo);
+    }
+
+    html->clear();
+    header(*html, &path, false, yScrollTo);
+    toFragment(note, *html, autolinking, false);
+    footer(*html);
+
+#ifdef MF_DEBUG_HTML
+    MF_DEBUG("=== BEGIN HTML ===" << endl << *html << endl << "=== END HTML ===" << endl);
+#endif
     return html;
 }
 
@@ -27,6 +27,7 @@
 #include "../unicode.h"
 #include "../markdown/markdown_outline_representation.h"
 #include "../markdown/markdown_transcoder.h"
+#include "html_fragment_cache.h"
 #if defined  MF_MD_2_HTML_CMARK
   #include "../markdown/cmark_gfm_markdown_transcoder.h"
 #endif
@@ -75,13 +76,19 @@ private:
     // Performance hints:
     //  - += is ~2x faster than append() (depends on cpp lib implementation)
     //  - pre-allocation of the string using reserver() is critical to avoid slow re-allocations
-    //  - IMPROVE consider caching of re-used HTML snippets
+    //  - Ns HTML is cached (as fragments) and O HTML is stitched from N fragments
+
+    // fragment flags
+    static constexpr u_int32_t FRAGMENT_AUTOLINKING = 1;
+    static constexpr u_int32_t FRAGMENT_DESCRIPTION_ONLY = 1<<1;
 
     Configuration& config;
     HtmlExportColorsRepresentation exportColors;
     HtmlColorsRepresentation& lf;    
     MarkdownOutlineRepresentation markdownRepresentation;
     MarkdownTranscoder* markdownTranscoder;
+    RepresentationInterceptor* descriptionInterceptor;
+    HtmlFragmentCache fragmentCache;
 
 public:
     /**
@@ -152,12 +159,32 @@ public:
     void outlineMetadataToHtml(const Outline* outline, std::string& html);
 
     MarkdownOutlineRepresentation& getMarkdownRepresentation() { return markdownRepresentation; }
+    HtmlFragmentCache& getFragmentCache() { return fragmentCache; }
 
 private:
     void header(std::string& html, std::string* basePath, bool standalone, int yScrollTo);
     void footer(std::string& html);
 
     std::string* toNoMeta(Outline* outline, std::string* html, bool standalone, int yScrollTo);
+
+    /**
+     * @brief Append Markdown converted to HTML w/o header and footer.
+     */
+    void toFragment(const std::string& markdown, std::string& html);
+    /**
+     * @brief Append (cached) N HTML w/o header and footer.
+     *
+     * N section metadata are NOT rendered (they change on every read).
+     *
+     * @param descriptionOnly render description only (no section).
+     */
+    void toFragment(const Note* note, std::string& html, bool autolinking, bool descriptionOnly);
+    /**
+     * @brief Does O use Markdown which spans Ns i.e. reference link definitions or footnotes?
+     *
+     * Such O cannot be stitched from N fragments - it must be rendered as one document.
+     */
+    static bool isDocumentScoped(Outline* outline);
 };
 
 } // m8r namespace
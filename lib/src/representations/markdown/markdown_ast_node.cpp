@@ -55,12 +55,12 @@ MarkdownAstNode::~MarkdownAstNode()
  */
 
 MarkdownAstNodeSection::MarkdownAstNodeSection()
-    : MarkdownAstNode{MarkdownAstNodeType::SECTION}
+    : MarkdownAstNode{MarkdownAstNodeType::SECTION},
+      body{}
 {
     depth = 0;
     flags = 0;
     text = nullptr;
-    body = new vector<string*>{};
 }
 
 MarkdownAstNodeSection::MarkdownAstNodeSection(string *text)
@@ -79,26 +79,8 @@ void MarkdownAstNodeSection::setDepth(u_int16_t depth)
     this->depth = depth;
 }
 
-void MarkdownAstNodeSection::setBody(vector<string*>* body)
-{
-    if(this->body!=nullptr) {
-        delete this->body;
-        this->body=nullptr;
-    }
-    this->body = body;
-}
-
 MarkdownAstNodeSection::~MarkdownAstNodeSection()
 {
-    if(body!=nullptr) {
-        for(string*& b:*body) {
-            if(b!=nullptr) {
-                delete b;
-            }
-        }
-        delete body;
-        body = nullptr;
-    }
 }
 
 MarkdownAstSectionMetadata& MarkdownAstNodeSection::getMetadata()
@@ -20,8 +20,10 @@
 #define M8R_MARKDOWN_AST_M8RUI_NAVIGATOR_NODE_H_
 
 #include <string>
+#include <utility>
 
 #include "../../model/link.h"
+#include "../../model/description.h"
 #include "../../config/time_scope.h"
 #include "markdown_note_metadata.h"
 
@@ -179,7 +181,7 @@ protected:
      */
     u_int16_t depth;
     MarkdownAstSectionMetadata metadata;
-    std::vector<std::string*>* body;
+    Description body;
 
     // various flags (bit)
     int flags;
@@ -193,9 +195,9 @@ public:
     MarkdownAstNodeSection &operator=(const MarkdownAstNodeSection &&) = delete;
     virtual ~MarkdownAstNodeSection();
 
-    std::vector<std::string*>* getBody() const { return body; }
-    std::vector<std::string*>* moveBody() { std::vector<std::string*>* result=body; body=nullptr; return result; }
-    void setBody(std::vector<std::string*>* body);
+    const Description& getBody() const { return body; }
+    Description moveBody() { return std::move(body); }
+    void setBody(Description&& body) { this->body = std::move(body); }
 
     u_int16_t getDepth() const;
     void setDepth(u_int16_t depth);
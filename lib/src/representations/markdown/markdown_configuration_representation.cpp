@@ -34,6 +34,9 @@ constexpr const auto CONFIG_SETTING_MIND_TIME_SCOPE_LABEL = "* Time scope: ";
 constexpr const auto CONFIG_SETTING_MIND_TAGS_SCOPE_LABEL = "* Tags scope: ";
 constexpr const auto CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL = "* Async refresh interval (ms): ";
 constexpr const auto CONFIG_SETTING_MIND_AUTOLINKING = "* Autolinking: ";
+constexpr const auto CONFIG_SETTING_MIND_LEARN_THREADS = "* Repository load threads: ";
+constexpr const auto CONFIG_SETTING_MIND_REPOSITORY_WATCH = "* Watch repository: ";
+constexpr const auto CONFIG_SETTING_MIND_REPOSITORY_SNAPSHOT = "* Repository snapshot: ";
 
 // application
 constexpr const auto CONFIG_SETTING_STARTUP_VIEW_LABEL = "* Startup view: ";
@@ -104,14 +107,7 @@ void MarkdownConfigurationRepresentation::configuration(vector<MarkdownAstNodeSe
         if(ast->size() > off+1) {
             off++;
             for(size_t i = off; i < ast->size(); i++) {
-                vector<string*>* sectionBody;
-                sectionBody = ast->at(i)->moveBody();
-                configurationSection(ast->at(i)->getText(), sectionBody, c);
-
-                for(string* l:*sectionBody) {
-                    delete l;
-                }
-                delete sectionBody;
+                configurationSection(ast->at(i)->getText(), ast->at(i)->getBody(), c);
             }
         }
 
@@ -130,40 +126,41 @@ void MarkdownConfigurationRepresentation::configuration(vector<MarkdownAstNodeSe
  */
 void MarkdownConfigurationRepresentation::configurationSection(
     string* title,
-    vector<string*>* body,
+    const Description& body,
     Configuration& c
 ) {
-    if(title && body && title->size() && body->size()) {
+    if(title && title->size() && body.size()) {
         if(!title->compare(CONFIG_SECTION_APP)) {
             MF_DEBUG("PARSING configuration section: Application" << endl);
-            for(string* line: *body) {
-                if(line && line->size() && line->at(0)=='*') {
-                    if(line->find(CONFIG_SETTING_SAVE_READS_METADATA_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+            for(Description::Line l:body) {
+                const string line{l.str()};
+                if(line.size() && line.at(0)=='*') {
+                    if(line.find(CONFIG_SETTING_SAVE_READS_METADATA_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setSaveReadsMetadata(true);
                         } else {
                             c.setSaveReadsMetadata(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_STARTUP_VIEW_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_STARTUP_VIEW_LABEL));
+                    } else if(line.find(CONFIG_SETTING_STARTUP_VIEW_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_STARTUP_VIEW_LABEL));
                         // NOTE: startup view is NOT validated
                         if(t.size()) {
                             c.setStartupView(t);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_THEME_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_UI_THEME_LABEL));
+                    } else if(line.find(CONFIG_SETTING_UI_THEME_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_UI_THEME_LABEL));
                         // NOTE: theme name is NOT validated
                         if(t.size()) {
                             c.setUiThemeName(t);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_HTML_CSS_THEME_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_UI_HTML_CSS_THEME_LABEL));
+                    } else if(line.find(CONFIG_SETTING_UI_HTML_CSS_THEME_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_UI_HTML_CSS_THEME_LABEL));
                         if(t.size()) {
                             // TODO: IMPORTANT - this is potential SECURITY threat - theme name is NOT validated
                             c.setUiHtmlCssPath(t);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_HTML_ZOOM_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_UI_HTML_ZOOM_LABEL));
+                    } else if(line.find(CONFIG_SETTING_UI_HTML_ZOOM_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_UI_HTML_ZOOM_LABEL));
                         std::string::size_type st;
                         int i;
                         try {
@@ -176,26 +173,26 @@ void MarkdownConfigurationRepresentation::configurationSection(
                             i=Configuration::DEFAULT_UI_HTML_ZOOM;
                         }
                         c.setUiHtmlZoom(i);
-                    } else if(line->find(CONFIG_SETTING_UI_SHOW_TOOLBAR_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_SHOW_TOOLBAR_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiShowToolbar(true);
                         } else {
                             c.setUiShowToolbar(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EXPERT_MODE_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EXPERT_MODE_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiExpertMode(true);
                         } else {
                             c.setUiExpertMode(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_LIVE_NOTE_PREVIEW_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_LIVE_NOTE_PREVIEW_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiLiveNotePreview(true);
                         } else {
                             c.setUiLiveNotePreview(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_OS_TABLE_SORT_COL_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_UI_OS_TABLE_SORT_COL_LABEL));
+                    } else if(line.find(CONFIG_SETTING_UI_OS_TABLE_SORT_COL_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_UI_OS_TABLE_SORT_COL_LABEL));
                         std::string::size_type st;
                         int i;
                         try {
@@ -208,117 +205,117 @@ void MarkdownConfigurationRepresentation::configurationSection(
                           i = Configuration::DEFAULT_OS_TABLE_SORT_COLUMN;
                         }
                         c.setUiOsTableSortColumn(i);
-                    } else if(line->find(CONFIG_SETTING_UI_OS_TABLE_SORT_ORDER_LABEL) != std::string::npos) {
-                        if(line->find(UI_OS_TABLE_SORT_ORDER_ASC) != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_OS_TABLE_SORT_ORDER_LABEL) != std::string::npos) {
+                        if(line.find(UI_OS_TABLE_SORT_ORDER_ASC) != std::string::npos) {
                             c.setUiOsTableSortOrder(true);
                         } else {
                             c.setUiOsTableSortOrder(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_NERD_MENU) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_NERD_MENU) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiNerdTargetAudience(true);
                         } else {
                             c.setUiNerdTargetAudience(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_TABS_AS_SPACES_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_TABS_AS_SPACES_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorTabsAsSpaces(true);
                         } else {
                             c.setUiEditorTabsAsSpaces(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_AUTOSAVE_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_AUTOSAVE_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorAutosave(true);
                         } else {
                             c.setUiEditorAutosave(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_CLICK_NOTE_VIEW_TO_EDIT_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_CLICK_NOTE_VIEW_TO_EDIT_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiDoubleClickNoteViewToEdit(true);
                         } else {
                             c.setUiDoubleClickNoteViewToEdit(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_EXTERNAL_EDITOR_CMD_LABEL) != std::string::npos) {
-                        string p = line->substr(strlen(CONFIG_SETTING_EXTERNAL_EDITOR_CMD_LABEL));
+                    } else if(line.find(CONFIG_SETTING_EXTERNAL_EDITOR_CMD_LABEL) != std::string::npos) {
+                        string p = line.substr(strlen(CONFIG_SETTING_EXTERNAL_EDITOR_CMD_LABEL));
                         c.setExternalEditorCmd(p);
-                    } else if(line->find(CONFIG_SETTING_UI_FULL_O_PREVIEW_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_FULL_O_PREVIEW_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiFullOPreview(true);
                         } else {
                             c.setUiFullOPreview(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_KEY_BINDING_LABEL) != std::string::npos) {
-                        if(line->find(UI_EDITOR_KEY_BINDING_EMACS) != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_KEY_BINDING_LABEL) != std::string::npos) {
+                        if(line.find(UI_EDITOR_KEY_BINDING_EMACS) != std::string::npos) {
                             c.setEditorKeyBinding(Configuration::EditorKeyBindingMode::EMACS);
                         } else {
                             c.setEditorKeyBinding(Configuration::EditorKeyBindingMode::WINDOWS);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_FONT_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_UI_EDITOR_FONT_LABEL));
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_FONT_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_UI_EDITOR_FONT_LABEL));
                         if(t.size()) {
                             c.setEditorFont(t);
                         }
-                    } else if(line->find(CONFIG_SETTING_MD_MATH_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_MD_MATH_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEnableMathInMd(true);
                         } else {
                             c.setUiEnableMathInMd(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_MD_DIAGRAM_LABEL) != std::string::npos) {
-                        if(line->find(UI_JS_LIB_ONLINE) != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_MD_DIAGRAM_LABEL) != std::string::npos) {
+                        if(line.find(UI_JS_LIB_ONLINE) != std::string::npos) {
                             c.setUiEnableDiagramsInMd(Configuration::JavaScriptLibSupport::ONLINE);
-                        } else if(line->find(UI_JS_LIB_OFFLINE) != std::string::npos) {
+                        } else if(line.find(UI_JS_LIB_OFFLINE) != std::string::npos) {
                             c.setUiEnableDiagramsInMd(Configuration::JavaScriptLibSupport::OFFLINE);
                         } else {
                             c.setUiEnableDiagramsInMd(Configuration::JavaScriptLibSupport::NO);
                         }
-                    } else if(line->find(CONFIG_SETTING_MD_HIGHLIGHT_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_MD_HIGHLIGHT_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEnableSrcHighlightInMd(true);
                         } else {
                             c.setUiEnableSrcHighlightInMd(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_SYNTAX_HIGHLIGHT_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_SYNTAX_HIGHLIGHT_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorEnableSyntaxHighlighting(true);
                         } else {
                             c.setUiEditorEnableSyntaxHighlighting(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_LIVE_SPELLCHECK_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_LIVE_SPELLCHECK_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorLiveSpellCheck(true);
                         } else {
                             c.setUiEditorLiveSpellCheck(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_SPELLCHECK_LANG_LABEL) != std::string::npos) {
-                        string p = line->substr(strlen(CONFIG_SETTING_UI_EDITOR_SPELLCHECK_LANG_LABEL));
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_SPELLCHECK_LANG_LABEL) != std::string::npos) {
+                        string p = line.substr(strlen(CONFIG_SETTING_UI_EDITOR_SPELLCHECK_LANG_LABEL));
                         c.setUiEditorSpellCheckDefaultLanguage(p);
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_AUTOCOMPLETE_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_AUTOCOMPLETE_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorEnableAutocomplete(true);
                         } else {
                             c.setUiEditorEnableAutocomplete(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_SMART_EDITOR_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_SMART_EDITOR_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorEnableSmartEditor(true);
                         } else {
                             c.setUiEditorEnableSmartEditor(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_SPACE_SECTION_ESCAPING_LABEL) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_SPACE_SECTION_ESCAPING_LABEL) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setUiEditorSpaceSectionEscaping(true);
                         } else {
                             c.setUiEditorSpaceSectionEscaping(false);
                         }
-                    } else if(line->find(CONFIG_SETTING_UI_EDITOR_TAB_WIDTH_LABEL) != std::string::npos) {
-                        if(line->find("8") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_UI_EDITOR_TAB_WIDTH_LABEL) != std::string::npos) {
+                        if(line.find("8") != std::string::npos) {
                             c.setUiEditorTabWidth(8);
                         } else {
                             c.setUiEditorTabWidth(4);
                         }
-                    } else if(line->find(CONFIG_SETTING_NAVIGATOR_MAX_GRAPH_NODES_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_NAVIGATOR_MAX_GRAPH_NODES_LABEL));
+                    } else if(line.find(CONFIG_SETTING_NAVIGATOR_MAX_GRAPH_NODES_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_NAVIGATOR_MAX_GRAPH_NODES_LABEL));
                         std::string::size_type st;
                         int i;
                         try {
@@ -336,18 +333,19 @@ void MarkdownConfigurationRepresentation::configurationSection(
             }
         } else if(!title->compare(CONFIG_SECTION_MIND)) {
             MF_DEBUG("PARSING configuration section: Mind" << endl);
-            for(string* line: *body) {
-                if(line && line->size() && line->at(0)=='*') {
-                    if(line->find(CONFIG_SETTING_MIND_TIME_SCOPE_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_MIND_TIME_SCOPE_LABEL));
+            for(Description::Line l:body) {
+                const string line{l.str()};
+                if(line.size() && line.at(0)=='*') {
+                    if(line.find(CONFIG_SETTING_MIND_TIME_SCOPE_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_MIND_TIME_SCOPE_LABEL));
                         if(t.size()) {
                             TimeScope ts;
                             if(TimeScope::fromString(t, ts)) {
                                 c.setTimeScope(ts);
                             }
                         }
-                    } else if(line->find(CONFIG_SETTING_MIND_TAGS_SCOPE_LABEL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_MIND_TAGS_SCOPE_LABEL));
+                    } else if(line.find(CONFIG_SETTING_MIND_TAGS_SCOPE_LABEL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_MIND_TAGS_SCOPE_LABEL));
                         c.getTagsScope().clear();
                         if(t.size()) {
                             char **r = stringSplit(t.c_str(), ' ');
@@ -358,14 +356,14 @@ void MarkdownConfigurationRepresentation::configurationSection(
                             };
                             delete[] r;
                         }
-                    } else if(line->find(CONFIG_SETTING_MIND_STATE) != std::string::npos) {
-                        if(line->find("think") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_MIND_STATE) != std::string::npos) {
+                        if(line.find("think") != std::string::npos) {
                             c.setDesiredMindState(Configuration::MindState::THINKING);
                         } else {
                             c.setDesiredMindState(Configuration::MindState::SLEEPING);
                         }
-                    } else if(line->find(CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL) != std::string::npos) {
-                        string t = line->substr(strlen(CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL));
+                    } else if(line.find(CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_MIND_DISTRIBUTOR_INTERVAL));
                         std::string::size_type st;
                         int i;
                         try {
@@ -379,8 +377,33 @@ void MarkdownConfigurationRepresentation::configurationSection(
                         }
                         i %= 10000;
                         c.setDistributorSleepInterval(i);
-                    } else if(line->find(CONFIG_SETTING_MIND_AUTOLINKING) != std::string::npos) {
-                        if(line->find("yes") != std::string::npos) {
+                    } else if(line.find(CONFIG_SETTING_MIND_LEARN_THREADS) != std::string::npos) {
+                        string t = line.substr(strlen(CONFIG_SETTING_MIND_LEARN_THREADS));
+                        int i;
+                        try {
+                          i = std::stoi(t);
+                        }
+                        catch(...) {
+                          i = Configuration::DEFAULT_LEARN_THREADS;
+                        }
+                        if(i<0) {
+                            i = Configuration::DEFAULT_LEARN_THREADS;
+                        }
+                        c.setLearnThreads(static_cast<unsigned int>(i));
+                    } else if(line.find(CONFIG_SETTING_MIND_REPOSITORY_WATCH) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
+                            c.setRepositoryWatch(true);
+                        } else {
+                            c.setRepositoryWatch(false);
+                        }
+                    } else if(line.find(CONFIG_SETTING_MIND_REPOSITORY_SNAPSHOT) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
+                            c.setRepositorySnapshot(true);
+                        } else {
+                            c.setRepositorySnapshot(false);
+                        }
+                    } else if(line.find(CONFIG_SETTING_MIND_AUTOLINKING) != std::string::npos) {
+                        if(line.find("yes") != std::string::npos) {
                             c.setAutolinking(true);
                         } else {
                             c.setAutolinking(false);
@@ -390,10 +413,11 @@ void MarkdownConfigurationRepresentation::configurationSection(
             }
         } else if(!title->compare(CONFIG_SECTION_REPOSITORIES)) {
             MF_DEBUG("PARSING configuration section: Repositories" << endl);
-            for(string* line: *body) {
-                if(line && line->size() && line->at(0)=='*') {
-                    if(line->find(CONFIG_SETTING_ACTIVE_REPOSITORY_LABEL) != std::string::npos) {
-                        string p = line->substr(strlen(CONFIG_SETTING_ACTIVE_REPOSITORY_LABEL));
+            for(Description::Line l:body) {
+                const string line{l.str()};
+                if(line.size() && line.at(0)=='*') {
+                    if(line.find(CONFIG_SETTING_ACTIVE_REPOSITORY_LABEL) != std::string::npos) {
+                        string p = line.substr(strlen(CONFIG_SETTING_ACTIVE_REPOSITORY_LABEL));
                         if(p.size()) {
                             Repository* r = RepositoryIndexer::getRepositoryForPath(p);
                             if(r) {
@@ -407,8 +431,8 @@ void MarkdownConfigurationRepresentation::configurationSection(
                         } else {
                             cerr << "Unable to construct configured active repository as path is empty" << endl;
                         }
-                    } else if(line->find(CONFIG_SETTING_REPOSITORY_LABEL) != std::string::npos) {
-                        string p = line->substr(strlen(CONFIG_SETTING_REPOSITORY_LABEL));
+                    } else if(line.find(CONFIG_SETTING_REPOSITORY_LABEL) != std::string::npos) {
+                        string p = line.substr(strlen(CONFIG_SETTING_REPOSITORY_LABEL));
                         if(p.size()) {
                             Repository* r = RepositoryIndexer::getRepositoryForPath(p);
                             if(r) {
@@ -476,6 +500,15 @@ string& MarkdownConfigurationRepresentation::to(Configuration* c, string& md)
          "    * Examples: 500, 1000, 3000, 5000" << endl <<
          CONFIG_SETTING_MIND_AUTOLINKING << (c?(c->isAutolinking()?"yes":"no"):(Configuration::DEFAULT_AUTOLINKING?"yes":"no")) << endl <<
          "    * Examples: yes, no" << endl <<
+         CONFIG_SETTING_MIND_LEARN_THREADS << (c?c->getLearnThreads():Configuration::DEFAULT_LEARN_THREADS) << endl <<
+         "    * Number of threads parsing Markdown files on repository load (0 for all CPU cores, 1 for sequential load)" << endl <<
+         "    * Examples: 0, 1, 4" << endl <<
+         CONFIG_SETTING_MIND_REPOSITORY_WATCH << (c?(c->isRepositoryWatch()?"yes":"no"):(Configuration::DEFAULT_REPOSITORY_WATCH?"yes":"no")) << endl <<
+         "    * Learn only changed files when repository is modified by others e.g. by git pull (Linux only)" << endl <<
+         "    * Examples: yes, no" << endl <<
+         CONFIG_SETTING_MIND_REPOSITORY_SNAPSHOT << (c?(c->isRepositorySnapshot()?"yes":"no"):(Configuration::DEFAULT_REPOSITORY_SNAPSHOT?"yes":"no")) << endl <<
+         "    * Load unchanged Notebooks from snapshot of parsed repository in mind/ directory (MindForger repositories only)" << endl <<
+         "    * Examples: yes, no" << endl <<
          endl <<
 
          "# " << CONFIG_SECTION_APP << endl <<
@@ -585,6 +618,10 @@ bool MarkdownConfigurationRepresentation::load(Configuration& c)
 {
     MF_DEBUG("Loading configuration from " << c.getConfigFilePath() << endl);
     string file{c.getConfigFilePath().c_str()};
+    // debounced write of the file might be pending > read what was saved
+    ConfigurationStore& store = ConfigurationStore::getInstance();
+    store.flush();
+    store.invalidate(file);
     if(isFile(file.c_str())) {
         MarkdownDocument md{&file};
         md.from();
@@ -597,7 +634,7 @@ bool MarkdownConfigurationRepresentation::load(Configuration& c)
     }
 }
 
-void MarkdownConfigurationRepresentation::save(const File* file, Configuration* c)
+void MarkdownConfigurationRepresentation::save(const File* file, Configuration* c, bool later)
 {
 #ifdef DO_MF_DEBUG
     if(c) {
@@ -618,26 +655,26 @@ void MarkdownConfigurationRepresentation::save(const File* file, Configuration*
     string md{};
     to(c,md);
 
+    ConfigurationStore& store = ConfigurationStore::getInstance();
     if(c) {
         MF_DEBUG("Saving configuration to file " << c->getConfigFilePath() << endl);
-        std::ofstream out(c->getConfigFilePath());
-        out << md;
-        out.close();
+        store.store(c->getConfigFilePath(), md);
 
         // repository configuration path is available only if MF in repository mode
         if(c->hasRepositoryConfiguration()) {
             MF_DEBUG("Saving repository configuration to " << c->getRepositoryConfigFilePath() << endl);
             MarkdownRepositoryConfigurationRepresentation repositorCfgMd{};
-            repositorCfgMd.save(*c);
+            repositorCfgMd.saveLater(*c);
         }
     } else if(file) {
         MF_DEBUG("Saving configuration to FILE " << file->getName() << endl);
-        std::ofstream out(file->getName());
-        out << md;
-        out.close();
+        store.store(file->getName(), md);
     } else {
         MF_DEBUG("WARNING: configuration NOT saved - either configuration instance and/ro file name is not available" << endl);
     }
+    if(!later) {
+        store.flush();
+    }
 }
 
 } // m8r namespace
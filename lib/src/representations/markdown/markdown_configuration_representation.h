@@ -29,6 +29,7 @@
 #include "markdown_repository_configuration_representation.h"
 #include "../../config/configuration.h"
 #include "../../persistence/configuration_persistence.h"
+#include "../../persistence/configuration_store.h"
 
 namespace m8r {
 
@@ -85,19 +86,23 @@ public:
      */
     virtual bool load(Configuration& c);
     /**
-     * @brief Save configuration to file.
+     * @brief Save configuration to file - unchanged file is not written.
      */
-    virtual void save(Configuration& c) { save(nullptr, &c); }
+    virtual void save(Configuration& c) { save(nullptr, &c, false); }
+    /**
+     * @brief Save configuration in background - bursts of saves are coalesced to a single write.
+     */
+    void saveLater(Configuration& c) { save(nullptr, &c, true); }
     /**
      * @brief Save initial configuration file.
      */
-    void save(const filesystem::File& file) { save(&file, nullptr); }
+    void save(const filesystem::File& file) { save(&file, nullptr, false); }
 
 private:
     void configuration(std::vector<MarkdownAstNodeSection*>* ast, Configuration& c);
-    void configurationSection(std::string* title, std::vector<std::string*>* body, Configuration& c);
+    void configurationSection(std::string* title, const Description& body, Configuration& c);
     std::string& to(Configuration* c, std::string& md);
-    void save(const filesystem::File* file, Configuration* c);
+    void save(const filesystem::File* file, Configuration* c, bool later);
 };
 
 }
@@ -53,29 +53,26 @@ Outline* MarkdownDocumentRepresentation::to(
     o->addTag(ontology.findOrCreateTag("pdf"));
     o->addTag(ontology.findOrCreateTag("library-document"));
 
-    o->addDescriptionLine(new string{
+    o->addDescriptionLine(
         "Notebook for document: [" + documentPath + "](" + documentPath + ")"
-        }
     );
-    o->addDescriptionLine(new string{""});
-    o->addDescriptionLine(new string{"---"});
-    o->addDescriptionLine(new string{""});
-    o->addDescriptionLine(new string{
+    o->addDescriptionLine("");
+    o->addDescriptionLine("---");
+    o->addDescriptionLine("");
+    o->addDescriptionLine(
         "This notebook represents document from above in MindForger. "
         "Notebook was created automatically on indexation of a library "
         "and may contain document text (if available) to enable full-text "
         "search, associations and content mining. You can add notes with "
         "your remarks, thoughts and ideas to this notebook as usually."
-        }
     );
-    o->addDescriptionLine(new string{""});
-    o->addDescriptionLine(new string{
+    o->addDescriptionLine("");
+    o->addDescriptionLine(
         "Please do not edit the first row of this description with "
         "document path to ensure that the notebook stays interlinked "
         "with the document."
-        }
     );
-    o->addDescriptionLine(new string{""});
+    o->addDescriptionLine("");
 
     // set O modification time identical to the document
     o->setCreated(fileModificationTime(&documentPath));
@@ -0,0 +1,412 @@
+/*
+ markdown_highlight_scanner.cpp     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "markdown_highlight_scanner.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace m8r {
+
+using namespace std;
+
+constexpr int MarkdownHighlightScanner::NORMAL;
+constexpr int MarkdownHighlightScanner::IN_COMMENT;
+constexpr int MarkdownHighlightScanner::IN_CODE;
+
+namespace {
+
+template<typename C>
+inline bool isSpace(C c) {
+    return c==' ' || c=='\t' || c=='\n' || c=='\r' || c=='\f' || c=='\v';
+}
+
+template<typename C>
+inline bool isDigit(C c) {
+    return c>='0' && c<='9';
+}
+
+template<typename C>
+inline bool isWord(C c) {
+    return (c>='a' && c<='z') || (c>='A' && c<='Z') || isDigit(c) || c=='_'
+        || static_cast<typename make_unsigned<C>::type>(c) >= 0x80;
+}
+
+/**
+ * @brief Does text contain ASCII token at given offset?
+ */
+template<typename C>
+inline bool at(const C* text, size_t length, size_t offset, const char* token) {
+    for(; *token; token++, offset++) {
+        if(offset >= length || text[offset] != static_cast<C>(*token)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Non-greedy paired delimiter like *bold* or `code`.
+ *
+ * The first opening delimiter wins: if it's not closed, then no later
+ * delimiter can be closed either.
+ */
+struct Pair {
+    const char* delimiter;
+    size_t delimiterLength;
+    // minimal distance of closing delimiter from the opening one
+    size_t minClose;
+    // opening delimiter must be followed by non-space
+    bool nonSpace;
+    MarkdownHighlightType type;
+
+    bool open;
+    size_t start;
+    size_t resume;
+
+    Pair(const char* delimiter, size_t minClose, bool nonSpace, MarkdownHighlightType type)
+        : delimiter{delimiter},
+          delimiterLength{char_traits<char>::length(delimiter)},
+          minClose{minClose},
+          nonSpace{nonSpace},
+          type{type},
+          open{false},
+          start{},
+          resume{}
+    {}
+
+    template<typename C>
+    void step(const C* text, size_t length, size_t i, vector<MarkdownHighlightSpan>& spans) {
+        if(open) {
+            if(i >= start+minClose && at(text, length, i, delimiter)) {
+                open = false;
+                resume = i+delimiterLength;
+                spans.push_back(MarkdownHighlightSpan{start, resume-start, type});
+            }
+        } else if(i >= resume && at(text, length, i, delimiter)) {
+            if(!nonSpace || (i+delimiterLength < length && !isSpace(text[i+delimiterLength]))) {
+                open = true;
+                start = i;
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+MarkdownHighlightScanner::MarkdownHighlightScanner()
+    : spans{},
+      codeBlock{false}
+{
+}
+
+MarkdownHighlightScanner::~MarkdownHighlightScanner()
+{
+}
+
+template<typename C>
+int MarkdownHighlightScanner::scan(const C* text, size_t length, int previousState)
+{
+    spans.clear();
+
+    // MD code block ~ there is no need to highlight anything else
+    if(previousState != -1 && (previousState & IN_CODE) == IN_CODE) {
+        codeBlock = true;
+        if(length == 3 && at(text, length, 0, "```")) {
+            // finish block
+            spans.push_back(MarkdownHighlightSpan{0, 3, MarkdownHighlightType::CODE});
+            return NORMAL;
+        } else {
+            spans.push_back(MarkdownHighlightSpan{0, length, MarkdownHighlightType::CODE});
+            return NORMAL|IN_CODE;
+        }
+    } else if(at(text, length, 0, "```")) {
+        // enter block
+        codeBlock = true;
+        spans.push_back(MarkdownHighlightSpan{0, length, MarkdownHighlightType::CODE});
+        return NORMAL|IN_CODE;
+    }
+    codeBlock = false;
+
+    // list items
+    if(length) {
+        size_t p = 0;
+        while(at(text, length, p, "    ")) {
+            p += 4;
+        }
+        if(p+1 < length
+           && (text[p]=='*' || text[p]=='+' || text[p]=='-')
+           && text[p+1]==' ')
+        {
+            spans.push_back(MarkdownHighlightSpan{0, p+2, MarkdownHighlightType::UNORDERED_LIST});
+            if(at(text, length, p+2, "[x]")) {
+                spans.push_back(MarkdownHighlightSpan{0, p+5, MarkdownHighlightType::TASK_DONE});
+            } else if(at(text, length, p+2, "[ ]")) {
+                spans.push_back(MarkdownHighlightSpan{0, p+5, MarkdownHighlightType::TASK_WIP});
+            }
+        } else if(p < length && isDigit(text[p])) {
+            size_t e = p+1;
+            if(e < length && isDigit(text[e])) {
+                e++;
+            }
+            if(at(text, length, e, ". ")) {
+                spans.push_back(MarkdownHighlightSpan{0, e+2, MarkdownHighlightType::ORDERED_LIST});
+            }
+        }
+    }
+
+    // inline spans: all state machines are advanced by the single pass
+    Pair bold{"*", 3, true, MarkdownHighlightType::BOLD};
+    Pair bolder{"**", 3, false, MarkdownHighlightType::BOLDER};
+    Pair italic{"_", 2, false, MarkdownHighlightType::ITALIC};
+    Pair italicer{"__", 3, false, MarkdownHighlightType::ITALICER};
+    Pair strikethrough{"~~", 3, false, MarkdownHighlightType::STRIKETHROUGH};
+    Pair code{"`", 2, false, MarkdownHighlightType::CODE};
+    Pair math{"$", 2, false, MarkdownHighlightType::MATH};
+    Pair comment{"-->", 4, false, MarkdownHighlightType::HTML_COMMENT};
+    // [text](url): 0 seek [, 1 seek ](, 2 seek )
+    int link = 0;
+    size_t linkStart = 0, linkMiddle = 0, linkResume = 0;
+    size_t autolinkResume = 0, tagResume = 0, closingTagResume = 0, entityResume = 0, attributeResume = 0;
+    // there is no closing " or ' after the last attribute value lookahead
+    bool noDoubleQuote = false, noSingleQuote = false;
+    // multiline comments
+    long firstCommentEnd = -1, lastCommentEnd = -1, lastCommentBegin = -1;
+
+    for(size_t i=0; i<length; i++) {
+        switch(text[i]) {
+        case '*':
+            bold.step(text, length, i, spans);
+            bolder.step(text, length, i, spans);
+            break;
+        case '_':
+            italic.step(text, length, i, spans);
+            italicer.step(text, length, i, spans);
+            break;
+        case '~':
+            strikethrough.step(text, length, i, spans);
+            break;
+        case '`':
+            code.step(text, length, i, spans);
+            break;
+        case '$':
+            math.step(text, length, i, spans);
+            break;
+        case '[':
+            if(link == 0 && i >= linkResume) {
+                link = 1;
+                linkStart = i;
+            }
+            break;
+        case ']':
+            if(link == 1 && i >= linkStart+2 && i+1 < length && text[i+1] == '(') {
+                link = 2;
+                linkMiddle = i;
+            }
+            break;
+        case ')':
+            if(link == 2 && i >= linkMiddle+3) {
+                link = 0;
+                linkResume = i+1;
+                spans.push_back(MarkdownHighlightSpan{linkStart, linkResume-linkStart, MarkdownHighlightType::LINK});
+            }
+            break;
+        case 'h':
+            if(i >= autolinkResume && at(text, length, i, "http")) {
+                size_t e = i+4;
+                if(e < length && text[e] == 's') {
+                    e++;
+                }
+                if(at(text, length, e, "://") && e+3 < length && !isSpace(text[e+3])) {
+                    e += 3;
+                    while(e < length && !isSpace(text[e])) {
+                        e++;
+                    }
+                    spans.push_back(MarkdownHighlightSpan{i, e-i, MarkdownHighlightType::AUTOLINK});
+                    autolinkResume = e;
+                }
+            }
+            break;
+        case '<':
+            // <tag <!tag <?tag and <tag/>
+            if(i >= tagResume) {
+                size_t s = i+1;
+                if(s < length && (text[s] == '!' || text[s] == '?')) {
+                    s++;
+                }
+                size_t e = s;
+                while(e < length && isWord(text[e])) {
+                    e++;
+                }
+                if(e > s) {
+                    if(at(text, length, e, "/>")) {
+                        e += 2;
+                    }
+                    spans.push_back(MarkdownHighlightSpan{i, e-i, MarkdownHighlightType::HTML_TAG});
+                    tagResume = e;
+                }
+            }
+            // </tag> and </tag?>
+            if(i >= closingTagResume && i+1 < length && text[i+1] == '/') {
+                size_t e = i+2;
+                while(e < length && isWord(text[e])) {
+                    e++;
+                }
+                if(e > i+2) {
+                    if(e < length && text[e] == '?') {
+                        e++;
+                    }
+                    if(e < length && text[e] == '>') {
+                        spans.push_back(MarkdownHighlightSpan{i, e+1-i, MarkdownHighlightType::HTML_TAG});
+                        closingTagResume = e+1;
+                    }
+                }
+            }
+            if(at(text, length, i, "<!--")) {
+                lastCommentBegin = static_cast<long>(i);
+                if(!comment.open && i >= comment.resume) {
+                    comment.open = true;
+                    comment.start = i;
+                }
+            }
+            break;
+        case '?':
+            if(i >= closingTagResume && i+1 < length && text[i+1] == '>') {
+                spans.push_back(MarkdownHighlightSpan{i, 2, MarkdownHighlightType::HTML_TAG});
+                closingTagResume = i+2;
+            }
+            break;
+        case '>':
+            if(i >= closingTagResume) {
+                spans.push_back(MarkdownHighlightSpan{i, 1, MarkdownHighlightType::HTML_TAG});
+                closingTagResume = i+1;
+            }
+            break;
+        case '-':
+            if(at(text, length, i, "-->")) {
+                if(firstCommentEnd < 0) {
+                    firstCommentEnd = static_cast<long>(i);
+                }
+                lastCommentEnd = static_cast<long>(i);
+                if(comment.open) {
+                    comment.step(text, length, i, spans);
+                }
+            }
+            break;
+        case '&':
+            // &#123; &:#123; and &name;
+            if(i >= entityResume) {
+                size_t e = i+1;
+                if(e < length && text[e] == ':') {
+                    e++;
+                }
+                if(e+1 < length && text[e] == '#' && isDigit(text[e+1])) {
+                    e += 2;
+                    while(e < length && isDigit(text[e])) {
+                        e++;
+                    }
+                } else {
+                    e = i+1;
+                    while(e < length && isWord(text[e])) {
+                        e++;
+                    }
+                    if(e == i+1) {
+                        break;
+                    }
+                }
+                if(e < length && text[e] == ';') {
+                    spans.push_back(MarkdownHighlightSpan{i, e+1-i, MarkdownHighlightType::HTML_ENTITY});
+                    entityResume = e+1;
+                }
+            }
+            break;
+        case '=':
+            // name="value" name='value' and ns:name="value"
+            if(i > attributeResume && i+1 < length
+               && ((text[i+1] == '"' && !noDoubleQuote) || (text[i+1] == '\'' && !noSingleQuote)))
+            {
+                const C quote = text[i+1];
+                size_t e = i+2;
+                while(e < length && text[e] != quote) {
+                    e++;
+                }
+                if(e == length) {
+                    if(quote == '"') noDoubleQuote = true; else noSingleQuote = true;
+                    break;
+                }
+                if(e == i+2) {
+                    // empty value
+                    break;
+                }
+
+                size_t s = i;
+                while(s > attributeResume && isWord(text[s-1])) {
+                    s--;
+                }
+                if(s == i) {
+                    break;
+                }
+                if(s >= attributeResume+2 && text[s-1] == ':' && isWord(text[s-2])) {
+                    s--;
+                    while(s > attributeResume && isWord(text[s-1])) {
+                        s--;
+                    }
+                }
+                spans.push_back(MarkdownHighlightSpan{s, i-s, MarkdownHighlightType::HTML_ATTRIBUTE_NAME});
+                spans.push_back(MarkdownHighlightSpan{i+2, e-i-2, MarkdownHighlightType::HTML_ATTRIBUTE_VALUE});
+                attributeResume = e+1;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // latter types rewrite earlier types
+    stable_sort(
+        spans.begin(),
+        spans.end(),
+        [](const MarkdownHighlightSpan& a, const MarkdownHighlightSpan& b) {
+            return static_cast<int>(a.type) < static_cast<int>(b.type);
+        });
+
+    // multiline HTML comments rewrite all other formatting
+    int state = NORMAL;
+    if(previousState != -1 && (previousState & IN_COMMENT) == IN_COMMENT) {
+        if(firstCommentEnd < 0) {
+            spans.push_back(MarkdownHighlightSpan{0, length, MarkdownHighlightType::HTML_COMMENT});
+            return state|IN_COMMENT;
+        } else {
+            spans.push_back(MarkdownHighlightSpan{0, static_cast<size_t>(firstCommentEnd)+3, MarkdownHighlightType::HTML_COMMENT});
+        }
+    }
+    if(lastCommentBegin >= 0 && lastCommentEnd < lastCommentBegin) {
+        spans.push_back(MarkdownHighlightSpan{
+            static_cast<size_t>(lastCommentBegin),
+            length-static_cast<size_t>(lastCommentBegin),
+            MarkdownHighlightType::HTML_COMMENT});
+        state |= IN_COMMENT;
+    }
+
+    return state;
+}
+
+template int MarkdownHighlightScanner::scan<char>(const char* text, size_t length, int previousState);
+template int MarkdownHighlightScanner::scan<char16_t>(const char16_t* text, size_t length, int previousState);
+
+} // m8r namespace
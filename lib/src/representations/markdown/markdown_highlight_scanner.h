@@ -0,0 +1,125 @@
+/*
+ markdown_highlight_scanner.h     MindForger thinking notebook
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_MARKDOWN_HIGHLIGHT_SCANNER_H
+#define M8R_MARKDOWN_HIGHLIGHT_SCANNER_H
+
+#include <string>
+#include <vector>
+
+namespace m8r {
+
+/**
+ * @brief Type of highlighted Markdown span.
+ *
+ * ORDER matters: spans are reported ordered by type so that formatting of
+ * latter types rewrites formatting of earlier types (e.g. HTML inlined in MD
+ * goes first so that its formatting can be rewritten by MD).
+ */
+enum class MarkdownHighlightType {
+    HTML_TAG,
+    HTML_ENTITY,
+    HTML_COMMENT,
+    HTML_ATTRIBUTE_NAME,
+    HTML_ATTRIBUTE_VALUE,
+
+    BOLD,
+    BOLDER,
+    ITALIC,
+    ITALICER,
+    STRIKETHROUGH,
+    LINK,
+    AUTOLINK,
+    CODE,
+    MATH,
+    UNORDERED_LIST,
+    ORDERED_LIST,
+    TASK_DONE,
+    TASK_WIP
+};
+
+struct MarkdownHighlightSpan {
+    size_t offset;
+    size_t length;
+    MarkdownHighlightType type;
+};
+
+/**
+ * @brief Single-pass Markdown inline scanner for editor highlighting.
+ *
+ * Scanner is fed by the editor line by line (block by block) and it finds
+ * spans of all highlighted types at once - every highlighted type has its
+ * own small state machine (open delimiter, lookahead bounded by the span)
+ * and all of them are advanced by a single loop over the line. Multiline
+ * MD code blocks and HTML comments are tracked by the state which is passed
+ * from the previous line to the next one.
+ *
+ * Matching mimics (Perl like) regular expressions which were used to
+ * highlight Markdown before i.e. non-greedy matching of paired delimiters
+ * like *bold*, `code` or [link](url), HTML tags, entities and attributes,
+ * autolinks and list items.
+ *
+ * Scanner works w/ code units: char (UTF-8) or char16_t (UTF-16 as used by
+ * the editor) - offsets and lengths are in code units. Non-ASCII code units
+ * are considered to be word characters.
+ */
+class MarkdownHighlightScanner
+{
+public:
+    // line state (compatible w/ editor block states: -1 is state of the line before the first line)
+    static constexpr int NORMAL = 1<<0;
+    static constexpr int IN_COMMENT = 1<<1;
+    static constexpr int IN_CODE = 1<<2;
+
+private:
+    std::vector<MarkdownHighlightSpan> spans;
+    bool codeBlock;
+
+public:
+    explicit MarkdownHighlightScanner();
+    MarkdownHighlightScanner(const MarkdownHighlightScanner&) = delete;
+    MarkdownHighlightScanner(const MarkdownHighlightScanner&&) = delete;
+    MarkdownHighlightScanner& operator=(const MarkdownHighlightScanner&) = delete;
+    MarkdownHighlightScanner& operator=(const MarkdownHighlightScanner&&) = delete;
+    ~MarkdownHighlightScanner();
+
+    /**
+     * @brief Scan line and find highlighted spans.
+     *
+     * @param previousState state returned for the previous line (-1 for the first line)
+     * @return state of this line to be passed to the scan of the next line.
+     */
+    template<typename C>
+    int scan(const C* text, size_t length, int previousState);
+    int scan(const std::string& text, int previousState) {
+        return scan(text.c_str(), text.size(), previousState);
+    }
+
+    /**
+     * @brief Spans found by the last scan.
+     */
+    const std::vector<MarkdownHighlightSpan>& getSpans() const { return spans; }
+
+    /**
+     * @brief Is the last scanned line part of multiline MD code block (incl. its fences)?
+     */
+    bool isCodeBlock() const { return codeBlock; }
+};
+
+}
+#endif // M8R_MARKDOWN_HIGHLIGHT_SCANNER_H
@@ -22,42 +22,6 @@ using namespace std;
 
 namespace m8r {
 
-/*
- * FileLineProvider
- */
-
-// IMPROVE consider lazy loading of lines using FileLineProvider instead of pre-loading
-class FileLineProvider
-{
-private:
-    ifstream* infile;
-
-public:
-    explicit FileLineProvider(const char* filename);
-    virtual ~FileLineProvider();
-
-    string* getLine();
-};
-
-FileLineProvider::FileLineProvider(const char* filename)
-{
-    infile = new ifstream{filename};
-}
-
-string* FileLineProvider::getLine()
-{
-    // IMPROVE this is slow heap operation
-    string* line = new string();
-    getline(*infile, *line);
-    return line;
-}
-
-FileLineProvider::~FileLineProvider()
-{
-    infile->close();
-    delete infile;
-}
-
 /*
  * MarkdownLexemTable
  */
@@ -169,6 +133,7 @@ MarkdownSymbolTable::~MarkdownSymbolTable()
  */
 
 MarkdownLexerSections::MarkdownLexerSections(const string* filePath)
+    : lineProvider{}
 {
     this->filePath = filePath;
     this->fileSize = 0;
@@ -178,13 +143,6 @@ MarkdownLexerSections::MarkdownLexerSections(const string* filePath)
 
 MarkdownLexerSections::~MarkdownLexerSections()
 {
-    // lines
-    for(string*& line:lines) {
-        if(line!=nullptr) {
-            delete line;
-        }
-    }
-
     // lexems
     for(MarkdownLexem*& lexem:lexems) {
         if(lexem!=nullptr) {
@@ -199,7 +157,7 @@ MarkdownLexerSections::~MarkdownLexerSections()
 void MarkdownLexerSections::tokenize()
 {
     fileSize = 0;
-    if(fileToLines(filePath, lines, fileSize)) {
+    if(lineProvider.open(filePath, fileSize)) {
         // IMPROVE body of this function can be shared by file & text
         lexems.push_back(MarkdownSymbolTable::LEXEM.BEGIN_DOC);
 
@@ -218,7 +176,7 @@ void MarkdownLexerSections::tokenize()
 
 void MarkdownLexerSections::tokenize(const string* text)
 {
-    if(stringToLines(text, lines)) {
+    if(lineProvider.open(text)) {
         // IMPROVE body of this function can be shared by file & text
         lexems.push_back(MarkdownSymbolTable::LEXEM.BEGIN_DOC);
 
@@ -238,24 +196,22 @@ void MarkdownLexerSections::tokenize(const string* text)
 bool MarkdownLexerSections::lexWhitespaces(const unsigned offset, unsigned short int& idx)
 {
     unsigned short int i = idx+1;
-    if(lines[offset]!=nullptr) {
-        while(lines[offset]->size()>i && isspace(lines[offset]->at(i))) {
-            i++;
-        }
-        if(i != idx+1) {
-            lexems.push_back(new MarkdownLexem(MarkdownLexemType::WHITESPACES,offset,idx+1,i-1-idx));
-            idx = i-1;
-            return true;
-        }
+    while(lines[offset].size()>i && isspace(lines[offset].at(i))) {
+        i++;
+    }
+    if(i != idx+1) {
+        lexems.push_back(new MarkdownLexem(MarkdownLexemType::WHITESPACES,offset,idx+1,i-1-idx));
+        idx = i-1;
+        return true;
     }
     return false;
 }
 
 bool MarkdownLexerSections::startsWithCodeBlockSymbol(const unsigned offset) const
 {
-    if(lines[offset]!=nullptr && lines[offset]->size()>=3
+    if(lines[offset].size()>=3
          &&
-       lines[offset]->at(0)=='`' && lines[offset]->at(1)=='`' && lines[offset]->at(2)=='`'
+       lines[offset].at(0)=='`' && lines[offset].at(1)=='`' && lines[offset].at(2)=='`'
     ){
         return true;
     } else {
@@ -265,9 +221,9 @@ bool MarkdownLexerSections::startsWithCodeBlockSymbol(const unsigned offset) con
 
 bool MarkdownLexerSections::startsWithHtmlCommentEndSymbol(const unsigned offset, const unsigned short idx) const
 {
-    if(lines[offset]!=nullptr && lines[offset]->size()>=(size_t)(idx+3)
+    if(lines[offset].size()>=(size_t)(idx+3)
          &&
-       lines[offset]->at(idx)=='-' && lines[offset]->at(idx+1)=='-' && lines[offset]->at(idx+2)=='>'
+       lines[offset].at(idx)=='-' && lines[offset].at(idx+1)=='-' && lines[offset].at(idx+2)=='>'
     ){
         return true;
     } else {
@@ -278,27 +234,25 @@ bool MarkdownLexerSections::startsWithHtmlCommentEndSymbol(const unsigned offset
 bool MarkdownLexerSections::lexSectionSymbol(const unsigned offset, unsigned short int& idx)
 {
     unsigned depth = 0; // depth = [0,n)
-    if(lines[offset]!=nullptr) {
-        while(lines[offset]->size()>depth && lines[offset]->at(depth)=='#') {
-            ++depth;
-        }
-        if(depth
-             &&
-           (lines[offset]->size()>=depth || isspace(lines[offset]->at(depth))))
-        {
-            idx = depth-1;
-            lexems.push_back(new MarkdownLexem(MarkdownLexemType::SECTION,depth-1));
-            return true;
-        }
+    while(lines[offset].size()>depth && lines[offset].at(depth)=='#') {
+        ++depth;
+    }
+    if(depth
+         &&
+       (lines[offset].size()>=depth || isspace(lines[offset].at(depth))))
+    {
+        idx = depth-1;
+        lexems.push_back(new MarkdownLexem(MarkdownLexemType::SECTION,depth-1));
+        return true;
     }
     return false;
 }
 
 bool MarkdownLexerSections::lexHtmlCommentBeginSymbol(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]!=nullptr && lines[offset]->size()>=(size_t)(idx+4)
+    if(lines[offset].size()>=(size_t)(idx+4)
          &&
-       lines[offset]->at(idx)=='<' && lines[offset]->at(idx+1)=='!' && lines[offset]->at(idx+2)=='-' && lines[offset]->at(idx+3)=='-'
+       lines[offset].at(idx)=='<' && lines[offset].at(idx+1)=='!' && lines[offset].at(idx+2)=='-' && lines[offset].at(idx+3)=='-'
     ){
         idx+=4;
         lexems.push_back(symbolTable.LEXEM.HTML_COMMENT_BEGIN);
@@ -310,9 +264,9 @@ bool MarkdownLexerSections::lexHtmlCommentBeginSymbol(const unsigned offset, uns
 
 bool MarkdownLexerSections::lexHtmlCommentEndSymbol(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]!=nullptr && lines[offset]->size()>=(size_t)(idx+3)
+    if(lines[offset].size()>=(size_t)(idx+3)
          &&
-       lines[offset]->at(idx)=='-' && lines[offset]->at(idx+1)=='-' && lines[offset]->at(idx+2)=='>'
+       lines[offset].at(idx)=='-' && lines[offset].at(idx+1)=='-' && lines[offset].at(idx+2)=='>'
     ){
         idx+=3;
         lexems.push_back(symbolTable.LEXEM.HTML_COMMENT_END);
@@ -325,17 +279,17 @@ bool MarkdownLexerSections::lexHtmlCommentEndSymbol(const unsigned offset, unsig
 bool MarkdownLexerSections::lexMetadataSymbol(const unsigned offset, unsigned short int& idx)
 {
     // case insensitive 'metadata'
-    if(lines[offset]!=nullptr && lines[offset]->size()>=(size_t)(idx+9)
+    if(lines[offset].size()>=(size_t)(idx+9)
          &&
-       (lines[offset]->at(idx+1)=='M' || lines[offset]->at(idx+1)=='m') &&
-       (lines[offset]->at(idx+2)=='e' || lines[offset]->at(idx+2)=='E') &&
-       (lines[offset]->at(idx+3)=='t' || lines[offset]->at(idx+3)=='T') &&
-       (lines[offset]->at(idx+4)=='a' || lines[offset]->at(idx+4)=='A') &&
-       (lines[offset]->at(idx+5)=='d' || lines[offset]->at(idx+5)=='D') &&
-       (lines[offset]->at(idx+6)=='a' || lines[offset]->at(idx+6)=='A') &&
-       (lines[offset]->at(idx+7)=='t' || lines[offset]->at(idx+7)=='T') &&
-       (lines[offset]->at(idx+8)=='a' || lines[offset]->at(idx+8)=='A') &&
-       lines[offset]->at(idx+9)==':'
+       (lines[offset].at(idx+1)=='M' || lines[offset].at(idx+1)=='m') &&
+       (lines[offset].at(idx+2)=='e' || lines[offset].at(idx+2)=='E') &&
+       (lines[offset].at(idx+3)=='t' || lines[offset].at(idx+3)=='T') &&
+       (lines[offset].at(idx+4)=='a' || lines[offset].at(idx+4)=='A') &&
+       (lines[offset].at(idx+5)=='d' || lines[offset].at(idx+5)=='D') &&
+       (lines[offset].at(idx+6)=='a' || lines[offset].at(idx+6)=='A') &&
+       (lines[offset].at(idx+7)=='t' || lines[offset].at(idx+7)=='T') &&
+       (lines[offset].at(idx+8)=='a' || lines[offset].at(idx+8)=='A') &&
+       lines[offset].at(idx+9)==':'
     ){
         idx+=9;
         lexems.push_back(symbolTable.LEXEM.META_BEGIN);
@@ -347,21 +301,21 @@ bool MarkdownLexerSections::lexMetadataSymbol(const unsigned offset, unsigned sh
 
 bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]->size() > (size_t)(idx+1)) {
-        switch(lines[offset]->at(idx+1)) {
+    if(lines[offset].size() > (size_t)(idx+1)) {
+        switch(lines[offset].at(idx+1)) {
         case 't':
-            if(lines[offset]->at(idx+2)=='y' &&
-               lines[offset]->at(idx+3)=='p' &&
-               lines[offset]->at(idx+4)=='e' &&
-               (lines[offset]->at(idx+5)==':' || !isspace(idx+5))) {
+            if(lines[offset].at(idx+2)=='y' &&
+               lines[offset].at(idx+3)=='p' &&
+               lines[offset].at(idx+4)=='e' &&
+               (lines[offset].at(idx+5)==':' || !isspace(idx+5))) {
                 idx+=4;
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_type);
                 return true;
             } else {
-                if(lines[offset]->at(idx+2)=='a' &&
-                   lines[offset]->at(idx+3)=='g' &&
-                   lines[offset]->at(idx+4)=='s' &&
-                   (lines[offset]->at(idx+5)==':' || !isspace(idx+5))) {
+                if(lines[offset].at(idx+2)=='a' &&
+                   lines[offset].at(idx+3)=='g' &&
+                   lines[offset].at(idx+4)=='s' &&
+                   (lines[offset].at(idx+5)==':' || !isspace(idx+5))) {
                     idx+=4;
                     lexems.push_back(symbolTable.LEXEM.META_PROPERTY_tags);
                     return true;
@@ -370,13 +324,13 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 }
             }
         case 'c':
-            if(lines[offset]->at(idx+2)=='r' &&
-               lines[offset]->at(idx+3)=='e' &&
-               lines[offset]->at(idx+4)=='a' &&
-               lines[offset]->at(idx+5)=='t' &&
-               lines[offset]->at(idx+6)=='e' &&
-               lines[offset]->at(idx+7)=='d' &&
-               (lines[offset]->at(idx+8)==':' || !isspace(idx+8))) {
+            if(lines[offset].at(idx+2)=='r' &&
+               lines[offset].at(idx+3)=='e' &&
+               lines[offset].at(idx+4)=='a' &&
+               lines[offset].at(idx+5)=='t' &&
+               lines[offset].at(idx+6)=='e' &&
+               lines[offset].at(idx+7)=='d' &&
+               (lines[offset].at(idx+8)==':' || !isspace(idx+8))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_created);
                 idx+=7;
                 return true;
@@ -384,30 +338,30 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 return false;
             }
         case 'r':
-            if(lines[offset]->at(idx+2)=='e') {
-                if(lines[offset]->at(idx+3)=='a' &&
-                   lines[offset]->at(idx+4)=='d')
+            if(lines[offset].at(idx+2)=='e') {
+                if(lines[offset].at(idx+3)=='a' &&
+                   lines[offset].at(idx+4)=='d')
                 {
-                    if(lines[offset]->at(idx+5)=='s' &&
-                       (lines[offset]->at(idx+6)==':' || !isspace(idx+6))) {
+                    if(lines[offset].at(idx+5)=='s' &&
+                       (lines[offset].at(idx+6)==':' || !isspace(idx+6))) {
                         idx+=5;
                         lexems.push_back(symbolTable.LEXEM.META_PROPERTY_reads);
                         return true;
                     } else {
-                        if((lines[offset]->at(idx+5)==':' || !isspace(idx+5))) {
+                        if((lines[offset].at(idx+5)==':' || !isspace(idx+5))) {
                             idx+=4;
                             lexems.push_back(symbolTable.LEXEM.META_PROPERTY_read);
                             return true;
                         }
                     }
                 } else {
-                    if(lines[offset]->at(idx+3)=='v' &&
-                       lines[offset]->at(idx+4)=='i' &&
-                       lines[offset]->at(idx+5)=='s' &&
-                       lines[offset]->at(idx+6)=='i' &&
-                       lines[offset]->at(idx+7)=='o' &&
-                       lines[offset]->at(idx+8)=='n' &&
-                       (lines[offset]->at(idx+9)==':' || !isspace(idx+9)))
+                    if(lines[offset].at(idx+3)=='v' &&
+                       lines[offset].at(idx+4)=='i' &&
+                       lines[offset].at(idx+5)=='s' &&
+                       lines[offset].at(idx+6)=='i' &&
+                       lines[offset].at(idx+7)=='o' &&
+                       lines[offset].at(idx+8)=='n' &&
+                       (lines[offset].at(idx+9)==':' || !isspace(idx+9)))
                     {
                         idx+=8;
                         lexems.push_back(symbolTable.LEXEM.META_PROPERTY_revision);
@@ -417,16 +371,16 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
             }
             return false;
         case 'i':
-            if(lines[offset]->at(idx+2)=='m' &&
-               lines[offset]->at(idx+3)=='p' &&
-               lines[offset]->at(idx+4)=='o' &&
-               lines[offset]->at(idx+5)=='r' &&
-               lines[offset]->at(idx+6)=='t' &&
-               lines[offset]->at(idx+7)=='a' &&
-               lines[offset]->at(idx+8)=='n' &&
-               lines[offset]->at(idx+9)=='c' &&
-               lines[offset]->at(idx+10)=='e' &&
-               (lines[offset]->at(idx+11)==':' || !isspace(idx+11))) {
+            if(lines[offset].at(idx+2)=='m' &&
+               lines[offset].at(idx+3)=='p' &&
+               lines[offset].at(idx+4)=='o' &&
+               lines[offset].at(idx+5)=='r' &&
+               lines[offset].at(idx+6)=='t' &&
+               lines[offset].at(idx+7)=='a' &&
+               lines[offset].at(idx+8)=='n' &&
+               lines[offset].at(idx+9)=='c' &&
+               lines[offset].at(idx+10)=='e' &&
+               (lines[offset].at(idx+11)==':' || !isspace(idx+11))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_importance);
                 idx+=10;
                 return true;
@@ -434,13 +388,13 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 return false;
             }
         case 'u':
-            if(lines[offset]->at(idx+2)=='r' &&
-               lines[offset]->at(idx+3)=='g' &&
-               lines[offset]->at(idx+4)=='e' &&
-               lines[offset]->at(idx+5)=='n' &&
-               lines[offset]->at(idx+6)=='c' &&
-               lines[offset]->at(idx+7)=='y' &&
-               (lines[offset]->at(idx+8)==':' || !isspace(idx+8))) {
+            if(lines[offset].at(idx+2)=='r' &&
+               lines[offset].at(idx+3)=='g' &&
+               lines[offset].at(idx+4)=='e' &&
+               lines[offset].at(idx+5)=='n' &&
+               lines[offset].at(idx+6)=='c' &&
+               lines[offset].at(idx+7)=='y' &&
+               (lines[offset].at(idx+8)==':' || !isspace(idx+8))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_urgency);
                 idx+=7;
                 return true;
@@ -448,14 +402,14 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 return false;
             }
         case 'p':
-            if(lines[offset]->at(idx+2)=='r' &&
-               lines[offset]->at(idx+3)=='o' &&
-               lines[offset]->at(idx+4)=='g' &&
-               lines[offset]->at(idx+5)=='r' &&
-               lines[offset]->at(idx+6)=='e' &&
-               lines[offset]->at(idx+7)=='s' &&
-               lines[offset]->at(idx+8)=='s' &&
-               (lines[offset]->at(idx+9)==':' || !isspace(idx+9))) {
+            if(lines[offset].at(idx+2)=='r' &&
+               lines[offset].at(idx+3)=='o' &&
+               lines[offset].at(idx+4)=='g' &&
+               lines[offset].at(idx+5)=='r' &&
+               lines[offset].at(idx+6)=='e' &&
+               lines[offset].at(idx+7)=='s' &&
+               lines[offset].at(idx+8)=='s' &&
+               (lines[offset].at(idx+9)==':' || !isspace(idx+9))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_progress);
                 idx+=8;
                 return true;
@@ -463,14 +417,14 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 return false;
             }
         case 'm':
-            if(lines[offset]->at(idx+2)=='o' &&
-               lines[offset]->at(idx+3)=='d' &&
-               lines[offset]->at(idx+4)=='i' &&
-               lines[offset]->at(idx+5)=='f' &&
-               lines[offset]->at(idx+6)=='i' &&
-               lines[offset]->at(idx+7)=='e' &&
-               lines[offset]->at(idx+8)=='d' &&
-               (lines[offset]->at(idx+9)==':' || !isspace(idx+9))) {
+            if(lines[offset].at(idx+2)=='o' &&
+               lines[offset].at(idx+3)=='d' &&
+               lines[offset].at(idx+4)=='i' &&
+               lines[offset].at(idx+5)=='f' &&
+               lines[offset].at(idx+6)=='i' &&
+               lines[offset].at(idx+7)=='e' &&
+               lines[offset].at(idx+8)=='d' &&
+               (lines[offset].at(idx+9)==':' || !isspace(idx+9))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_modified);
                 idx+=8;
                 return true;
@@ -479,11 +433,11 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
             }
         case 'l':
             // key for relationships is 'links' because a) there are clashes for 'r' b) links is shorter than relationships
-            if(lines[offset]->at(idx+2)=='i' &&
-               lines[offset]->at(idx+3)=='n' &&
-               lines[offset]->at(idx+4)=='k' &&
-               lines[offset]->at(idx+5)=='s' &&
-               (lines[offset]->at(idx+6)==':' || !isspace(idx+6))) {
+            if(lines[offset].at(idx+2)=='i' &&
+               lines[offset].at(idx+3)=='n' &&
+               lines[offset].at(idx+4)=='k' &&
+               lines[offset].at(idx+5)=='s' &&
+               (lines[offset].at(idx+6)==':' || !isspace(idx+6))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_links);
                 idx+=5;
                 return true;
@@ -491,11 +445,11 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 return false;
             }
         case 's':
-            if(lines[offset]->at(idx+2)=='c' &&
-               lines[offset]->at(idx+3)=='o' &&
-               lines[offset]->at(idx+4)=='p' &&
-               lines[offset]->at(idx+5)=='e' &&
-               (lines[offset]->at(idx+6)==':' || !isspace(idx+6))) {
+            if(lines[offset].at(idx+2)=='c' &&
+               lines[offset].at(idx+3)=='o' &&
+               lines[offset].at(idx+4)=='p' &&
+               lines[offset].at(idx+5)=='e' &&
+               (lines[offset].at(idx+6)==':' || !isspace(idx+6))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_scope);
                 idx+=5;
                 return true;
@@ -503,14 +457,14 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
                 return false;
             }
         case 'd':
-            if(lines[offset]->at(idx+2)=='e' &&
-               lines[offset]->at(idx+3)=='a' &&
-               lines[offset]->at(idx+4)=='d' &&
-               lines[offset]->at(idx+5)=='l' &&
-               lines[offset]->at(idx+6)=='i' &&
-               lines[offset]->at(idx+7)=='n' &&
-               lines[offset]->at(idx+8)=='e' &&
-               (lines[offset]->at(idx+9)==':' || !isspace(idx+9))) {
+            if(lines[offset].at(idx+2)=='e' &&
+               lines[offset].at(idx+3)=='a' &&
+               lines[offset].at(idx+4)=='d' &&
+               lines[offset].at(idx+5)=='l' &&
+               lines[offset].at(idx+6)=='i' &&
+               lines[offset].at(idx+7)=='n' &&
+               lines[offset].at(idx+8)=='e' &&
+               (lines[offset].at(idx+9)==':' || !isspace(idx+9))) {
                 lexems.push_back(symbolTable.LEXEM.META_PROPERTY_deadline);
                 idx+=8;
                 return true;
@@ -529,19 +483,19 @@ bool MarkdownLexerSections::lexMetaPropertyName(const unsigned offset, unsigned
  */
 bool MarkdownLexerSections::lexToEndOfHtmlComment(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]!=nullptr && lines[offset]->size()>(size_t)(idx+1)) {
+    if(lines[offset].size()>(size_t)(idx+1)) {
         unsigned short int i;
         for(i=idx+1;
-            i<lines[offset]->size();
+            i<lines[offset].size();
             i++) {
-            if(lines[offset]->at(i)=='-') {
+            if(lines[offset].at(i)=='-') {
                 if(startsWithHtmlCommentEndSymbol(offset,i)) {
                     if(i > idx+1) {
                         lexems.push_back(new MarkdownLexem(MarkdownLexemType::META_TEXT,offset,idx,i-idx)); // note: ushort-ushort narrowing ({} > ())
                         idx=i;
                     }
                     lexHtmlCommentEndSymbol(offset,i);
-                    if(lines[offset]->size()>=i) {
+                    if(lines[offset].size()>=i) {
                         lexems.push_back(symbolTable.LEXEM.BR);
                     }
                     return true;
@@ -567,7 +521,7 @@ bool MarkdownLexerSections::lexPostDeclaredSectionHeader(const unsigned int offs
         return false;
     } else {
         // previous line is valid section name && current line is header line for that name
-        if(lines[offset-1]!=nullptr && lines[offset-1]->size()>=2 && !isspace(lines[offset-1]->at(0))
+        if(lines[offset-1].size()>=2 && !isspace(lines[offset-1].at(0))
              &&
            isSameCharsLine(offset, delimiter))
         {
@@ -635,11 +589,11 @@ void MarkdownLexerSections::addLineToLexems(const unsigned int offset)
 
 bool MarkdownLexerSections::nextToken(const unsigned int offset) {
     if(offset<lines.size()) {
-        if(lines[offset]->size()==0) {
+        if(lines[offset].size()==0) {
             lexems.push_back(symbolTable.LEXEM.BR);
             return true;
         } else {
-            switch(lines[offset]->at(0)) {
+            switch(lines[offset].at(0)) {
             case '`':
                 if(startsWithCodeBlockSymbol(offset)) {
                     // sections lexer just needs to detect code block to avoid detection of false sections, but no need to tokenize it
@@ -659,7 +613,7 @@ bool MarkdownLexerSections::nextToken(const unsigned int offset) {
                         char cc;
                         unsigned short int ws=0, text=0, x = idx+1;
                         while(lookahead(offset,idx)) {
-                            cc = lines[offset]->at(++idx);
+                            cc = lines[offset].at(++idx);
                             if(isspace(cc)) {
                                 // a) whitespaces
                                 if(ws==0 && text) {
@@ -700,7 +654,7 @@ bool MarkdownLexerSections::nextToken(const unsigned int offset) {
                                         unsigned short int mess = 0;
                                         char ccc;
                                         while(lookahead(offset,idx)) {
-                                            ccc = lines[offset]->at(++idx);
+                                            ccc = lines[offset].at(++idx);
                                             if(ccc=='-' && lexHtmlCommentEndSymbol(offset,idx)) {
                                                 if(mess) {
                                                     // TODO BUG add text BEFORE last lexem
@@ -774,12 +728,12 @@ bool MarkdownLexerSections::nextToken(const unsigned int offset) {
 bool MarkdownLexerSections::isSameCharsLine(const unsigned offset, const char c) const
 {
     // fail fast
-    if(lines[offset]!=nullptr && lines[offset]->size()
+    if(lines[offset].size()
          &&
-       lines[offset]->at(0)==c && lines[offset]->at(lines[offset]->size()-1)==c)
+       lines[offset].at(0)==c && lines[offset].at(lines[offset].size()-1)==c)
     {
-        for(unsigned i=1; i<lines[offset]->size()-1; i++) {
-            if(lines[offset]->at(i)!=c) {
+        for(unsigned i=1; i<lines[offset].size()-1; i++) {
+            if(lines[offset].at(i)!=c) {
                 return false;
             }
         }
@@ -790,7 +744,7 @@ bool MarkdownLexerSections::isSameCharsLine(const unsigned offset, const char c)
 
 bool MarkdownLexerSections::lookahead(const unsigned offset, const unsigned short idx) const
 {
-    if(lines[offset]->size() > (size_t)(idx+1)) {
+    if(lines[offset].size() > (size_t)(idx+1)) {
         return true;
     } else {
         return false;
@@ -799,7 +753,7 @@ bool MarkdownLexerSections::lookahead(const unsigned offset, const unsigned shor
 
 bool MarkdownLexerSections::lexMetaPropertyNameValueDelimiter(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]->size()>(size_t)(idx+1) && lines[offset]->at(idx+1)==':') {
+    if(lines[offset].size()>(size_t)(idx+1) && lines[offset].at(idx+1)==':') {
         idx++;
         lexems.push_back(symbolTable.LEXEM.META_NAMEVALUE_DELIMITER);
         return true;
@@ -810,10 +764,10 @@ bool MarkdownLexerSections::lexMetaPropertyNameValueDelimiter(const unsigned off
 
 bool MarkdownLexerSections::lexMetaPropertyValue(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]!=nullptr && lines[offset]->size()>(size_t)(idx+1)) {
+    if(lines[offset].size()>(size_t)(idx+1)) {
         unsigned short int i;
         for(i=idx+1;
-            i<lines[offset]->size() && lines[offset]->at(i)!=';';
+            i<lines[offset].size() && lines[offset].at(i)!=';';
             i++)
         {}
         if(i>idx+1) {
@@ -827,7 +781,7 @@ bool MarkdownLexerSections::lexMetaPropertyValue(const unsigned offset, unsigned
 
 bool MarkdownLexerSections::lexMetaPropertyDelimiter(const unsigned offset, unsigned short int& idx)
 {
-    if(lines[offset]->size()>(size_t)(idx+1) && lines[offset]->at(idx+1)==';') {
+    if(lines[offset].size()>(size_t)(idx+1) && lines[offset].at(idx+1)==';') {
         lexems.push_back(symbolTable.LEXEM.META_PROPERTY_DELIMITER);
         idx++;
         return true;
@@ -836,24 +790,18 @@ bool MarkdownLexerSections::lexMetaPropertyDelimiter(const unsigned offset, unsi
     }
 }
 
-string* MarkdownLexerSections::getText(const MarkdownLexem* lexem)
+LineSpan MarkdownLexerSections::getSpan(const MarkdownLexem* lexem) const
 {
-    if(lexem!=nullptr && lines.size()) {
-        if(lexem->getOff()<lines.size()) {
-            if(lexem->getLng()==MarkdownLexem::WHOLE_LINE) {
-                string *result = lines[lexem->getOff()];
-                lines[lexem->getOff()] = nullptr;
-                return result;
-            } else {
-                if(lexem->getLng()==0) {
-                    return new string{};
-                } else {
-                    return new string{lines[lexem->getOff()]->substr(lexem->getIdx(),lexem->getLng())};
-                }
-            }
+    if(lexem!=nullptr && lexem->getOff()<lines.size()) {
+        const LineSpan& line = lines[lexem->getOff()];
+        if(lexem->getLng()==MarkdownLexem::WHOLE_LINE) {
+            return line;
+        } else if(lexem->getIdx()<=line.size()) {
+            size_t lng = line.size()-lexem->getIdx();
+            return LineSpan{line.data+lexem->getIdx(), lexem->getLng()<lng?lexem->getLng():lng};
         }
     }
-    return nullptr;
+    return LineSpan{nullptr, 0};
 }
 
 } // m8r namespace
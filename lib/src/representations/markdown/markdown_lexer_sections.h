@@ -26,6 +26,7 @@
 
 #include "../../gear/lang_utils.h"
 #include "../../gear/file_utils.h"
+#include "../../gear/file_line_provider.h"
 #include "markdown_lexem.h"
 
 namespace m8r {
@@ -110,7 +111,9 @@ private:
     bool inCodeBlock;
 
     size_t fileSize;
-    std::vector<std::string*> lines;
+    // lines are spans over read file (or text) - no per line heap allocation
+    FileLineProvider lineProvider;
+    const std::vector<LineSpan>& lines{lineProvider.getLines()};
     // IMPROVE prepare a LexemPool: vector + MarkdownLexem[1000] and allocate from there (performance)
     std::vector<MarkdownLexem*> lexems;
     MarkdownSymbolTable symbolTable;
@@ -127,14 +130,14 @@ public:
     void tokenize(const std::string* text);
 
     /**
-     * Returns text, caller is expected to destroy it.
+     * Returns lexem's text as a span over the line (no allocation) - empty if not available.
      */
-    std::string* getText(const MarkdownLexem*);
+    LineSpan getSpan(const MarkdownLexem*) const;
 
     void setFilePath(const std::string*& filePath) { this->filePath = filePath; }
     size_t getFileSize() const { return fileSize; }
     const std::vector<MarkdownLexem*>& getLexems() const { return lexems; }
-    const std::vector<std::string*>& getLines() const { return lines; }
+    const std::vector<LineSpan>& getLines() const { return lines; }
     const MarkdownSymbolTable& getSymbolTable() const { return symbolTable; }
     MarkdownLexem* operator[](size_t i) { return lexems[i]; }
     const MarkdownLexem* operator[](size_t i) const { return lexems[i]; }
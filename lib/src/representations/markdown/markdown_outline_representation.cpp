@@ -37,13 +37,15 @@ MarkdownOutlineRepresentation::~MarkdownOutlineRepresentation()
 {
 }
 
+/*
+ * Section body lines are copied to the description buffer and deleted.
+ */
 // IMPROVE return the last N doesn't seem to have much sense...
 Note* MarkdownOutlineRepresentation::note(vector<MarkdownAstNodeSection*>* ast, const size_t astindex, Outline* outline)
 {
     // IMPROVE move declarations to for scope
     Note* note = nullptr;
     const NoteType* noteType;
-    vector<string*>* body;
     const string* s;
     for(size_t i = astindex; i < ast->size(); i++) {
         s = ast->at(i)->getMetadata().getType();
@@ -65,13 +67,7 @@ Note* MarkdownOutlineRepresentation::note(vector<MarkdownAstNodeSection*>* ast,
             note->setName(*(ast->at(i)->getText()));
         }
         note->setDepth(ast->at(i)->getDepth());
-        body = ast->at(i)->moveBody();
-        if(body != nullptr) {
-            for(string*& bodyItem : *body) {
-                note->addDescriptionLine(bodyItem);
-            }
-        }
-        delete body;
+        note->setDescription(ast->at(i)->moveBody());
         note->setCreated(ast->at(i)->getMetadata().getCreated());
         note->setModified(ast->at(i)->getMetadata().getModified());
         note->setRevision(ast->at(i)->getMetadata().getRevision());
@@ -113,7 +109,7 @@ Outline* MarkdownOutlineRepresentation::outline(const File& file)
         o->setKey(*md.getFilePath());
         o->setBytesize(md.getFileSize());
         o->completeProperties(md.getModified());
-        o->setModifiedPretty(datetimeToPrettyHtml(o->getModified()));
+        o->setModifiedPretty();
     }
     return o;
 }
@@ -128,13 +124,9 @@ Outline* MarkdownOutlineRepresentation::outline(vector<MarkdownAstNodeSection*>*
 
             // preamble
             if(astNode->isPreambleSection()) {
-                vector<string*>* body = ast->at(off)->moveBody();
-                if(body!=nullptr) {
-                    // IMPROVE use body as is
-                    for(string*& bodyItem:*body) {
-                        outline->addPreambleLine(bodyItem);
-                    }
-                    delete body;
+                // IMPROVE use body as is
+                for(Description::Line bodyItem:ast->at(off)->getBody()) {
+                    outline->addPreambleLine(new string{bodyItem.str()});
                 }
                 if(ast->size()>1) {
                     astNode = ast->at(++off);
@@ -190,14 +182,7 @@ Outline* MarkdownOutlineRepresentation::outline(vector<MarkdownAstNodeSection*>*
                     }
                 }
 
-                vector<string*>* body = ast->at(off)->moveBody();
-                if(body!=nullptr) {
-                    // IMPROVE use body as is
-                    for(string*& bodyItem:*body) {
-                        outline->addDescriptionLine(bodyItem);
-                    }
-                    delete body;
-                }
+                outline->setDescription(ast->at(off)->moveBody());
             }
         }
 
@@ -302,11 +287,11 @@ void MarkdownOutlineRepresentation::toHeader(Outline* outline, string* md)
             md->append(" type: "); md->append(outline->getType()->getName()); md->append(";");
             if(outline->getTags()->size()) { md->append(" tags: "); md->append(to(outline->getTags())); md->append(";"); }
             if(outline->getLinksCount()) { md->append(" links: "); md->append(to(outline->getLinks())); md->append(";"); }
-            md->append(" created: "); md->append(datetimeToString(outline->getCreated())); md->append(";");
+            md->append(" created: "); datetimeToString(outline->getCreated(), *md); md->append(";");
             sprintf(buffer," reads: %d;",outline->getReads()); md->append(buffer);
-            md->append(" read: "); md->append(datetimeToString(outline->getRead())); md->append(";");
+            md->append(" read: "); datetimeToString(outline->getRead(), *md); md->append(";");
             sprintf(buffer," revision: %d;",outline->getRevision()); md->append(buffer);
-            md->append(" modified: "); md->append(datetimeToString(outline->getModified())); md->append(";");
+            md->append(" modified: "); datetimeToString(outline->getModified(), *md); md->append(";");
             sprintf(buffer," importance: %d/5;",outline->getImportance()); md->append(buffer);
             sprintf(buffer," urgency: %d/5;",outline->getUrgency()); md->append(buffer);
             if(outline->getProgress()) {
@@ -331,19 +316,13 @@ void MarkdownOutlineRepresentation::toHeader(Outline* outline, string* md)
             md->append("\n");
         }
 
-        const vector<string*>& description=outline->getDescription();
-        if(description.size()) {
-            for(string *s:description) {
-                md->append(*s);
-                // IMPROVE endl
-                md->append("\n");
-            }
-        }
+        md->append(outline->getDescription().getText());
     }
 }
 
-void MarkdownOutlineRepresentation::description(const std::string* md, std::vector<std::string*>& description)
+void MarkdownOutlineRepresentation::description(const std::string* md, Description& description)
 {
+    description.clear();
     if(md) {
         bool lastLineEmpty = false;
         bool codeblock = false;
@@ -384,11 +363,11 @@ void MarkdownOutlineRepresentation::description(const std::string* md, std::vect
                    || (line[0]==CE && line[1]==CE && line[2]==CE)
                   )
             ) {
-                description.push_back(new string{""});
+                description.append("");
             }
             lastLineEmpty = !line.size();
 
-            description.push_back(new string{line});
+            description.append(line);
         }
         MF_DEBUG(
             "MD representation: unbounded code fence count=" << codeblockBackticksCount
@@ -396,10 +375,8 @@ void MarkdownOutlineRepresentation::description(const std::string* md, std::vect
         );
         if(codeblockBackticksCount > 0 && codeblockBackticksCount%2 == 1) {
             // close opened ``` to avoid unbounded code fence as described ^
-            description.push_back(new string("```"));
+            description.append("```");
         }
-    } else {
-        description.clear();
     }
 }
 
@@ -506,16 +483,16 @@ string* MarkdownOutlineRepresentation::to(const Note* note, string* md, bool inc
         md->append(" type: "); md->append(note->getType()->getName()); md->append(";");
         if(note->getTags()->size()) { md->append(" tags: "); md->append(to(note->getTags())); md->append(";"); }
         if(note->getLinksCount()) { md->append(" links: "); md->append(to(note->getLinks())); md->append(";"); }
-        md->append(" created: "); md->append(datetimeToString(note->getCreated())); md->append(";");
+        md->append(" created: "); datetimeToString(note->getCreated(), *md); md->append(";");
         sprintf(buffer," reads: %d;",note->getReads()); md->append(buffer);
-        md->append(" read: "); md->append(datetimeToString(note->getRead())); md->append(";");
+        md->append(" read: "); datetimeToString(note->getRead(), *md); md->append(";");
         sprintf(buffer," revision: %d;",note->getRevision()); md->append(buffer);
-        md->append(" modified: "); md->append(datetimeToString(note->getModified())); md->append(";");
+        md->append(" modified: "); datetimeToString(note->getModified(), *md); md->append(";");
         if(note->getProgress()) {
             sprintf(buffer," progress: %d%%;",note->getProgress()); md->append(buffer);
         }
         if(note->getDeadline()) {
-            md->append(" deadline: "); md->append(datetimeToString(note->getDeadline())); md->append(";");
+            md->append(" deadline: "); datetimeToString(note->getDeadline(), *md); md->append(";");
         }
         md->append(" -->");
     }
@@ -554,7 +531,7 @@ string* MarkdownOutlineRepresentation::toDescription(const Note* note, string* m
             md->append(amd);
         }
     } else {
-        toString(note->getDescription(), *md);
+        md->append(note->getDescription().getText());
     }
 
     return md;
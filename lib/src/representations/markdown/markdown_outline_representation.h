@@ -83,7 +83,7 @@ public:
     virtual Note* note(const filesystem::File& file);
     virtual Note* note(const std::string* md);
 
-    virtual void description(const std::string* md, std::vector<std::string*>& description);
+    virtual void description(const std::string* md, Description& description);
 
     virtual std::string* to(Outline* outline);
     virtual std::string* to(Outline* outline, std::string* md);
@@ -184,7 +184,7 @@ MarkdownAstNodeSection* MarkdownParserSections::sectionRule(size_t& offset)
             // lexer ensures existence of LINE and BR right after SECTION_*
             depth = lexer[offset+1]->getType()==MarkdownLexemType::SECTION_equals?0:1;
             ++offset; // move to point to SECTION_*
-            result = new MarkdownAstNodeSection(lexer.getText(lexer[++offset])); // move to LINE
+            result = new MarkdownAstNodeSection(new string{lexer.getSpan(lexer[++offset]).toString()}); // move to LINE
             result->setPostDeclaredSection();
             result->setDepth(depth);
             ++offset; // skip BR
@@ -263,16 +263,14 @@ string* MarkdownParserSections::sectionNameRule(size_t& offset)
         next->getType()==MarkdownLexemType::TEXT)
     {
         string* name = new string();
-        string* text = nullptr;
+        LineSpan text;
         while((next=lookahead(offset+1))!=nullptr
                 &&
               (next->getType()==MarkdownLexemType::WHITESPACES || next->getType()==MarkdownLexemType::TEXT))
         {
-            text = lexer.getText(next);
-            if(text!=nullptr) {
-                name->append(*text);
-                delete text;
-                text = nullptr;
+            text = lexer.getSpan(next);
+            if(text.data!=nullptr) {
+                name->append(text.data, text.size());
             } else {
                 if(name->size()) {
                     name->append(" ");
@@ -280,13 +278,11 @@ string* MarkdownParserSections::sectionNameRule(size_t& offset)
             }
             ++offset;
         }
-        text = lexer.getText(next);
-        if(text!=nullptr) {
+        text = lexer.getSpan(next);
+        if(text.data!=nullptr) {
             if(next->getType()==MarkdownLexemType::WHITESPACES) {
-                name->erase(name->size()-1, text->size());
+                name->erase(name->size()-1, text.size());
             }
-            delete text;
-            text = nullptr;
         }
         return name;
     } else {
@@ -408,13 +404,18 @@ time_t MarkdownParserSections::parsePropertyValueTimestamp(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
+        // fast path: fixed format timestamp parsed directly from the line
+        time_t result;
+        LineSpan span = lexer.getSpan(valueLexem);
+        if(span.size() && datetimeParse(span.data, span.size(), result)) {
+            return result;
+        }
+
         struct tm tm;
         // C-style initialization as GCC doesn't like {}
         memset(&tm, 0, sizeof tm);
-        string* s = lexer.getText(valueLexem);
-        datetimeFrom(s->c_str(), &tm);
-        delete s;
-        time_t result = datetimeSeconds(&tm);
+        datetimeFrom(span.toString().c_str(), &tm);
+        result = datetimeSeconds(&tm);
         return result;
     }
     return 0;
@@ -424,11 +425,8 @@ int MarkdownParserSections::parsePropertyValueInteger(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
         // IMPROVE do this in C++
-        int result = atoi(s->c_str());
-        delete s;
-        return result;
+        return atoi(lexer.getSpan(valueLexem).toString().c_str());
     }
     return 0;
 }
@@ -437,14 +435,14 @@ vector<string*>* MarkdownParserSections::parsePropertyValueTags(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
+        LineSpan s = lexer.getSpan(valueLexem);
+        if(s.data!=nullptr) {
+            if(s.size()) {
                 vector<string*>* result = new vector<string*>();
                 string buffer;
                 bool ws{};
-                for(size_t i=0; i<s->size(); i++) {
-                    switch(s->at(i)) {
+                for(size_t i=0; i<s.size(); i++) {
+                    switch(s[i]) {
                     case ' ':
                         ws = true;
                         break;
@@ -459,7 +457,7 @@ vector<string*>* MarkdownParserSections::parsePropertyValueTags(size_t& offset)
                         if(ws && buffer.size()) {
                             buffer += ' ';
                         }
-                        buffer += s->at(i);
+                        buffer += s[i];
                         ws = false;
                         break;
                     }
@@ -468,10 +466,7 @@ vector<string*>* MarkdownParserSections::parsePropertyValueTags(size_t& offset)
                     result->push_back(new string(buffer));
                     buffer.clear();
                 }
-                delete s;
                 return result;
-            } else {
-                delete s;
             }
         }
     }
@@ -482,13 +477,9 @@ string* MarkdownParserSections::parsePropertyValueString(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                return s;
-            } else {
-                delete s;
-            }
+        LineSpan s = lexer.getSpan(valueLexem);
+        if(s.size()) {
+            return new string{s.toString()};
         }
     }
     return nullptr;
@@ -498,15 +489,9 @@ int MarkdownParserSections::parsePropertyValueFraction(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                int r = (int)s->at(0) - '0';
-                delete s;
-                return r;
-            } else {
-                delete s;
-            }
+        LineSpan s = lexer.getSpan(valueLexem);
+        if(s.size()) {
+            return (int)s[0] - '0';
         }
     }
     return 0;
@@ -516,16 +501,9 @@ int MarkdownParserSections::parsePropertyValuePercent(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                s->resize(s->size()-1);
-                int result = atoi(s->c_str());
-                delete s;
-                return result;
-            } else {
-                delete s;
-            }
+        LineSpan s = lexer.getSpan(valueLexem);
+        if(s.size()) {
+            return atoi(s.substr(0, s.size()-1).c_str());
         }
     }
     return 0;
@@ -536,12 +514,9 @@ TimeScope MarkdownParserSections::parsePropertyValueTimeScope(size_t& offset)
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     TimeScope result{};
     if(valueLexem != nullptr) {
-        string* s = lexer.getText(valueLexem);
-        if(s!=nullptr) {
-            if(s->size()) {
-                TimeScope::fromString(*s, result);
-            }
-            delete s;
+        LineSpan s = lexer.getSpan(valueLexem);
+        if(s.size()) {
+            TimeScope::fromString(s.toString(), result);
         }
     }
     return result;
@@ -562,12 +537,12 @@ vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& offset)
 {
     const MarkdownLexem* valueLexem = parsePropertyValue(offset);
     if(valueLexem != nullptr) {
-        string* t = lexer.getText(valueLexem);
-        if(t != nullptr) {
-            if(t->size()) {
+        LineSpan t = lexer.getSpan(valueLexem);
+        if(t.data != nullptr) {
+            if(t.size()) {
                 vector<Link*>* result = new vector<Link*>{};
 
-                istringstream split(*t);
+                istringstream split(t.toString());
                 string s;
                 while(getline(split, s, ',')) {
                     Link* l;
@@ -575,7 +550,6 @@ vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& offset)
                         result->push_back(l);
                     }
                 }
-                delete t;
 
                 if(result->size()) {
                     return result;
@@ -584,7 +558,6 @@ vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& offset)
                     return nullptr;
                 }
             } else {
-                delete t;
                 return nullptr;
             }
         }
@@ -593,25 +566,26 @@ vector<Link*>* MarkdownParserSections::parsePropertyValueLinks(size_t& offset)
     return nullptr;
 }
 
-vector<string*>* MarkdownParserSections::sectionBodyRule(size_t& offset)
+Description MarkdownParserSections::sectionBodyRule(size_t& offset)
 {
-    vector<string*>* result = new vector<string*>();
-    string* s;
+    // lines are appended directly from lexer's spans - no string per line
+    Description result{};
+    LineSpan s;
     const MarkdownLexem* l;
     while((l=lookaheadNotSection(offset+1))!=nullptr) {
         ++offset;
         switch(l->getType()) {
         case MarkdownLexemType::LINE:
-            if((s=lexer.getText(l))!=nullptr) {
-                result->push_back(s);
+            if((s=lexer.getSpan(l)).data!=nullptr) {
+                result.append(s.data, s.size());
             }
             // skip line's BR
             skipBr(offset);
             break;
         case MarkdownLexemType::BR:
             // empty line
-            if((s=lexer.getText(l))!=nullptr) {
-                result->push_back(s);
+            if((s=lexer.getSpan(l)).data!=nullptr) {
+                result.append(s.data, s.size());
             }
             break;
         default:
@@ -89,7 +89,7 @@ private:
     MarkdownAstNodeSection* sectionHeaderRule(size_t& offset);
     std::string* sectionNameRule(size_t& offset);
     bool sectionMetadataRule(MarkdownAstSectionMetadata& meta, size_t& offset);
-    std::vector<std::string*>* sectionBodyRule(size_t& offset);
+    Description sectionBodyRule(size_t& offset);
 
     const MarkdownLexem* parsePropertyValue(size_t& offset);
     time_t parsePropertyValueTimestamp(size_t& offset);
@@ -78,14 +78,7 @@ void MarkdownRepositoryConfigurationRepresentation::repositoryConfiguration(vect
         if(ast->size() > off+1) {
             off++;
             for(size_t i = off; i < ast->size(); i++) {
-                vector<string*>* sectionBody;
-                sectionBody = ast->at(i)->moveBody();
-                repositoryConfigurationSection(ast->at(i)->getText(), sectionBody, c);
-
-                for(string* l:*sectionBody) {
-                    delete l;
-                }
-                delete sectionBody;
+                repositoryConfigurationSection(ast->at(i)->getText(), ast->at(i)->getBody(), c);
             }
         }
 
@@ -104,10 +97,10 @@ void MarkdownRepositoryConfigurationRepresentation::repositoryConfiguration(vect
  */
 void MarkdownRepositoryConfigurationRepresentation::repositoryConfigurationSection(
     string* title,
-    vector<string*>* body,
+    const Description& body,
     Configuration& c
 ) {
-    if(title && body && title->size() && body->size()) {
+    if(title && title->size() && body.size()) {
         if(!title->compare(CONFIG_SECTION_ORGANIZERS)) {
             MF_DEBUG("PARSING configuration section: Organizers" << endl);
             repositoryConfigurationSectionOrganizers(body, c);
@@ -144,49 +137,50 @@ void MarkdownRepositoryConfigurationRepresentation::repositoryConfigurationSecti
  * MD section is split using organizer name row(s).
  */
 void MarkdownRepositoryConfigurationRepresentation::repositoryConfigurationSectionOrganizers(
-    vector<string*>* body, Configuration& c
+    const Description& body, Configuration& c
 ) {
     set<string> keys{};
-    if(body) {
+    if(body.size()) {
         Organizer* o = nullptr;
         string name{};
         string key{};
         string tags{};
-        for(string* line:*body) {
-            if(line) {
-                if(line && line->find(CONFIG_SETTING_ORG_NAME) != std::string::npos) {
+        for(Description::Line l:body) {
+            const string line{l.str()};
+            if(line.size()) {
+                if(line.find(CONFIG_SETTING_ORG_NAME) != std::string::npos) {
                     // add PREVIOUS Organizer (if available) so that it's not rewritten
                     repositoryConfigurationSectionOrganizerAdd(o, keys, c);
 
-                    name = line->substr(strlen(CONFIG_SETTING_ORG_NAME));
+                    name = line.substr(strlen(CONFIG_SETTING_ORG_NAME));
 
                     o = new EisenhowerMatrix(name);
 
                     key.clear();
-                } else if(o && line->find(CONFIG_SETTING_ORG_TYPE) != std::string::npos) {
-                    if(Organizer::TYPE_STR_KANBAN == line->substr(strlen(CONFIG_SETTING_ORG_TYPE))) {
+                } else if(o && line.find(CONFIG_SETTING_ORG_TYPE) != std::string::npos) {
+                    if(Organizer::TYPE_STR_KANBAN == line.substr(strlen(CONFIG_SETTING_ORG_TYPE))) {
                         delete o;
                         o = new Kanban(name);
                     }
                     if(key.length()) {
                         o->setKey(key);
                     }
-                } else if(o && line->find(CONFIG_SETTING_ORG_KEY) != std::string::npos) {
-                    key = line->substr(strlen(CONFIG_SETTING_ORG_KEY));
-                } else if(o && line->find(CONFIG_SETTING_ORG_TAG_UR) != std::string::npos) {
-                    tags = line->substr(strlen(CONFIG_SETTING_ORG_TAG_UR));
+                } else if(o && line.find(CONFIG_SETTING_ORG_KEY) != std::string::npos) {
+                    key = line.substr(strlen(CONFIG_SETTING_ORG_KEY));
+                } else if(o && line.find(CONFIG_SETTING_ORG_TAG_UR) != std::string::npos) {
+                    tags = line.substr(strlen(CONFIG_SETTING_ORG_TAG_UR));
                     o->tagsUrQuadrant = Tags::tagsFromString(tags);
-                } else if(o && line->find(CONFIG_SETTING_ORG_TAG_LR) != std::string::npos) {
-                    tags = line->substr(strlen(CONFIG_SETTING_ORG_TAG_LR));
+                } else if(o && line.find(CONFIG_SETTING_ORG_TAG_LR) != std::string::npos) {
+                    tags = line.substr(strlen(CONFIG_SETTING_ORG_TAG_LR));
                     o->tagsLrQuadrant = Tags::tagsFromString(tags);
-                } else if(o && line->find(CONFIG_SETTING_ORG_TAG_LL) != std::string::npos) {
-                    tags = line->substr(strlen(CONFIG_SETTING_ORG_TAG_LL));
+                } else if(o && line.find(CONFIG_SETTING_ORG_TAG_LL) != std::string::npos) {
+                    tags = line.substr(strlen(CONFIG_SETTING_ORG_TAG_LL));
                     o->tagsLlQuadrant = Tags::tagsFromString(tags);
-                } else if(o && line->find(CONFIG_SETTING_ORG_TAG_UL) != std::string::npos) {
-                    tags = line->substr(strlen(CONFIG_SETTING_ORG_TAG_UL));
+                } else if(o && line.find(CONFIG_SETTING_ORG_TAG_UL) != std::string::npos) {
+                    tags = line.substr(strlen(CONFIG_SETTING_ORG_TAG_UL));
                     o->tagsUlQuadrant = Tags::tagsFromString(tags);
-                } else if(o && line->find(CONFIG_SETTING_ORG_SORT_BY) != std::string::npos) {
-                    string sortBy{line->substr(strlen(CONFIG_SETTING_ORG_SORT_BY))};
+                } else if(o && line.find(CONFIG_SETTING_ORG_SORT_BY) != std::string::npos) {
+                    string sortBy{line.substr(strlen(CONFIG_SETTING_ORG_SORT_BY))};
                     if(sortBy.length() && Organizer::OrganizerType::EISENHOWER_MATRIX == o->getOrganizerType()) {
                         EisenhowerMatrix* em = dynamic_cast<EisenhowerMatrix*>(o);
                         if(EisenhowerMatrix::CONFIG_VALUE_SORT_BY_I == sortBy) {
@@ -197,8 +191,8 @@ void MarkdownRepositoryConfigurationRepresentation::repositoryConfigurationSecti
                             em->sortBy = EisenhowerMatrix::SortBy::IMPORTANCE;
                         }
                     }
-                } else if(o && line->find(CONFIG_SETTING_ORG_FILTER_BY) != std::string::npos) {
-                    string filterBy{line->substr(strlen(CONFIG_SETTING_ORG_FILTER_BY))};
+                } else if(o && line.find(CONFIG_SETTING_ORG_FILTER_BY) != std::string::npos) {
+                    string filterBy{line.substr(strlen(CONFIG_SETTING_ORG_FILTER_BY))};
                     if(Organizer::CONFIG_VALUE_FILTER_BY_O == filterBy) {
                         o->filterBy = Organizer::FilterBy::OUTLINES;
                     } else if(Organizer::CONFIG_VALUE_FILTER_BY_N == filterBy) {
@@ -208,9 +202,9 @@ void MarkdownRepositoryConfigurationRepresentation::repositoryConfigurationSecti
                     } else {
                         o->filterBy = Organizer::FilterBy::OUTLINES_NOTES;
                     }
-                } else if(o && line->find(CONFIG_SETTING_ORG_SCOPE) != std::string::npos) {
+                } else if(o && line.find(CONFIG_SETTING_ORG_SCOPE) != std::string::npos) {
                     // validity of O ID will be checked (and fixed) on organizer load
-                    o->scopeOutlineId = line->substr(strlen(CONFIG_SETTING_ORG_SCOPE));
+                    o->scopeOutlineId = line.substr(strlen(CONFIG_SETTING_ORG_SCOPE));
                 }
             }
         }
@@ -321,6 +315,10 @@ bool MarkdownRepositoryConfigurationRepresentation::load(Configuration& c)
 {
     MF_DEBUG("Loading repository configuration from: '" << c.getRepositoryConfigFilePath() << "'" << endl);
     string file{c.getRepositoryConfigFilePath().c_str()};
+    // debounced write of the file might be pending > read what was saved
+    ConfigurationStore& store = ConfigurationStore::getInstance();
+    store.flush();
+    store.invalidate(file);
     if(isFile(file.c_str())) {
         MarkdownDocument md{&file};
         md.from();
@@ -333,21 +331,21 @@ bool MarkdownRepositoryConfigurationRepresentation::load(Configuration& c)
     }
 }
 
-void MarkdownRepositoryConfigurationRepresentation::save(const File* file, Configuration* c)
+void MarkdownRepositoryConfigurationRepresentation::save(const File* file, Configuration* c, bool later)
 {
     string md{};
     to(c,md);
 
+    ConfigurationStore& store = ConfigurationStore::getInstance();
     if(c) {
         MF_DEBUG("Saving repository configuration to file " << c->getRepositoryConfigFilePath() << endl);
-        std::ofstream out(c->getRepositoryConfigFilePath());
-        out << md;
-        out.close();
+        store.store(c->getRepositoryConfigFilePath(), md);
     } else {
         MF_DEBUG("Saving repository configuration to File " << file->getName() << endl);
-        std::ofstream out(file->getName());
-        out << md;
-        out.close();
+        store.store(file->getName(), md);
+    }
+    if(!later) {
+        store.flush();
     }
 }
 
@@ -29,6 +29,7 @@
 #include "../../model/kanban.h"
 #include "../../mind/ontology/ontology.h"
 #include "../../persistence/configuration_persistence.h"
+#include "../../persistence/configuration_store.h"
 
 namespace m8r {
 
@@ -71,21 +72,25 @@ public:
      */
     virtual bool load(Configuration& c);
     /**
-     * @brief Save repository configuration to file.
+     * @brief Save repository configuration to file - unchanged file is not written.
      */
-    virtual void save(Configuration& c) { save(nullptr, &c); }
+    virtual void save(Configuration& c) { save(nullptr, &c, false); }
+    /**
+     * @brief Save repository configuration in background - bursts of saves are coalesced to a single write.
+     */
+    void saveLater(Configuration& c) { save(nullptr, &c, true); }
     /**
      * @brief Save initial repository configuration file.
      */
-    void save(const filesystem::File& file) { save(&file, nullptr); }
+    void save(const filesystem::File& file) { save(&file, nullptr, false); }
 
 private:
     void repositoryConfiguration(std::vector<MarkdownAstNodeSection*>* ast, Configuration& c);
-    void repositoryConfigurationSection(std::string* title, std::vector<std::string*>* body, Configuration& c);
-    void repositoryConfigurationSectionOrganizers(std::vector<std::string*>* body, Configuration& c);
+    void repositoryConfigurationSection(std::string* title, const Description& body, Configuration& c);
+    void repositoryConfigurationSectionOrganizers(const Description& body, Configuration& c);
     Organizer* repositoryConfigurationSectionOrganizerAdd(Organizer* o, std::set<std::string>& keys, Configuration& c);
     std::string& to(Configuration* c, std::string& md);
-    void save(const filesystem::File* file, Configuration* c);
+    void save(const filesystem::File* file, Configuration* c, bool later);
 };
 
 }
@@ -22,6 +22,9 @@
 #include <string>
 #include <vector>
 
+#include "../definitions.h"
+#include "../model/description.h"
+
 namespace m8r {
 
 class RepresentationInterceptor
@@ -29,7 +32,20 @@ class RepresentationInterceptor
 public:
     virtual ~RepresentationInterceptor() {}
 
-    virtual void process(const std::vector<std::string*>& in, std::string& out) = 0;
+    virtual void process(const Description& in, std::string& out) = 0;
+
+    /**
+     * @brief Fingerprint of the state which determines process() output.
+     *
+     * Output of process() for the same input is the same while fingerprint
+     * is the same, therefore it might be cached.
+     *
+     * @return `false` if output cannot be cached.
+     */
+    virtual bool getFingerprint(u_int64_t& fingerprint) const {
+        fingerprint = 0;
+        return false;
+    }
 };
 
 }
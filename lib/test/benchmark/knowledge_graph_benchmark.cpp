@@ -0,0 +1,81 @@
+/*
+ knowledge_graph_benchmark.cpp     MindForger knowledge graph benchmark
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <chrono>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "../../src/mind/knowledge_graph_layout.h"
+
+using namespace std;
+using namespace m8r;
+
+/*
+ * Navigator layout step of 5k nodes sub-graph: exact O(n^2) magnets
+ * (the way navigator used to calculate forces) vs. Barnes-Hut quadtree.
+ * Navigator refreshes at 25 FPS i.e. step must take less than 40ms.
+ */
+TEST(KnowledgeGraphBenchmark, DISABLED_Layout)
+{
+    const size_t NODES = 5000;
+    const int STEPS = 25;
+
+    mt19937 random{42};
+    uniform_real_distribution<double> coordinate{-2000.0, 2000.0};
+    KnowledgeGraphLayout exact{}, approximated{};
+    exact.setTheta(0);
+    for(size_t i=0; i<NODES; i++) {
+        double x = coordinate(random), y = coordinate(random);
+        exact.addNode(x, y);
+        approximated.addNode(x, y);
+        if(i) {
+            exact.addEdge(0, i);
+            approximated.addEdge(0, i);
+        }
+    }
+
+    auto begin = chrono::high_resolution_clock::now();
+    for(int s=0; s<STEPS; s++) {
+        exact.step();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Exact step     : "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0/STEPS << "ms" << endl;
+
+    begin = chrono::high_resolution_clock::now();
+    for(int s=0; s<STEPS; s++) {
+        approximated.step();
+    }
+    end = chrono::high_resolution_clock::now();
+    auto stepMs = chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0/STEPS;
+    cout << "Barnes-Hut step: " << stepMs << "ms" << endl;
+
+    int steps = STEPS;
+    begin = chrono::high_resolution_clock::now();
+    while(approximated.step()) {
+        steps++;
+    }
+    end = chrono::high_resolution_clock::now();
+    cout << "Converged in " << steps << " steps ("
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms)" << endl;
+
+    EXPECT_LT(stepMs, 40.0);
+}
@@ -0,0 +1,114 @@
+/*
+ markdown_highlight_benchmark.cpp     MindForger markdown highlight benchmark
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <memory>
+#include <regex>
+
+#include <gtest/gtest.h>
+
+#include "../../src/representations/markdown/markdown_highlight_scanner.h"
+#include "../../src/gear/file_utils.h"
+
+using namespace std;
+using namespace m8r;
+
+extern char* getMindforgerGitHomePath();
+
+/*
+ * Editor highlighting of 5MB note: regexps evaluated one by one over every
+ * line (the way editor highlighter used to do it - std::regex is used instead
+ * of QRegExp) vs. single-pass scanner.
+ */
+TEST(MarkdownHighlightBenchmark, DISABLED_HighlightNote)
+{
+    // 1.1M file repeated to get 5MB note
+    unique_ptr<string> fileName
+            = unique_ptr<string>(new string{"/lib/test/resources/benchmark-repository/memory/meta.md"});
+    fileName.get()->insert(0, getMindforgerGitHomePath());
+    unique_ptr<string> content{m8r::fileToString(*fileName.get())};
+    vector<string> lines{};
+    size_t bytes = 0;
+    while(bytes < 5*1024*1024) {
+        size_t pos = 0, eol;
+        while((eol = content->find('\n', pos)) != string::npos) {
+            lines.push_back(content->substr(pos, eol-pos));
+            bytes += eol-pos+1;
+            pos = eol+1;
+        }
+    }
+    cout << "Note: " << bytes << "B / " << lines.size() << " lines (blocks)" << endl;
+
+    const vector<string> patterns{
+        "<[!?]?\\w+(?:/>)?",
+        "(?:</\\w+)?[?]?>",
+        "&(:?#\\d+|\\w+);",
+        "<!--.*?-->",
+        "(\\w+(?::\\w+)?)=(\"[^\"]+?\"|'[^']+?')",
+        "\\*\\S[\\S\\s]+?\\*",
+        "\\*\\*[\\S\\s]+?\\*\\*",
+        "_[\\S\\s]+?_",
+        "__[\\S\\s]+?__",
+        "~~[\\S\\s]+?~~",
+        "\\[(:?[\\S\\s]+?)\\]\\([\\S\\s]+?\\)",
+        "https?://\\S+",
+        "`[\\S\\s]+?`",
+        "\\$[\\S\\s]+?\\$",
+        "^(?:    )*[\\*\\+\\-] ",
+        "^(?:    )*\\d\\d?\\. ",
+        "^(?:    )*[\\*\\+\\-] \\[x\\]",
+        "^(?:    )*[\\*\\+\\-] \\[ \\]"
+    };
+    vector<regex> regexps{};
+    for(const string& p:patterns) {
+        regexps.push_back(regex{p});
+    }
+
+    size_t regexSpans = 0;
+    auto begin = chrono::high_resolution_clock::now();
+    for(const string& l:lines) {
+        for(const regex& r:regexps) {
+            for(sregex_iterator m{l.begin(), l.end(), r}, end{}; m != end; ++m) {
+                regexSpans++;
+            }
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto regexUs = chrono::duration_cast<chrono::microseconds>(end-begin).count();
+    cout << "Regexps: " << regexSpans << " matches in " << regexUs/1000.0 << "ms ~ "
+         << 1000.0*regexUs/lines.size() << "ns/block" << endl;
+
+    MarkdownHighlightScanner scanner{};
+    size_t scannerSpans = 0;
+    int state = -1;
+    begin = chrono::high_resolution_clock::now();
+    for(const string& l:lines) {
+        state = scanner.scan(l, state);
+        scannerSpans += scanner.getSpans().size();
+    }
+    end = chrono::high_resolution_clock::now();
+    auto scannerUs = chrono::duration_cast<chrono::microseconds>(end-begin).count();
+    cout << "Scanner: " << scannerSpans << " spans in " << scannerUs/1000.0 << "ms ~ "
+         << 1000.0*scannerUs/lines.size() << "ns/block" << endl;
+
+    EXPECT_LT(scannerUs, regexUs);
+}
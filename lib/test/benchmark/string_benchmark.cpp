@@ -0,0 +1,92 @@
+/*
+ string_benchmark.cpp     MindForger string search benchmark
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "../../src/gear/string_utils.h"
+#include "../../src/gear/file_utils.h"
+
+using namespace std;
+using namespace m8r;
+
+extern char* getMindforgerGitHomePath();
+
+/*
+ * Case insensitive FTS of descriptions: lowercase copy & find (the way FTS
+ * used to do it) vs. allocation free folded search.
+ */
+TEST(StringBenchmark, DISABLED_FindIgnoreCase)
+{
+    // 1.1M file
+    unique_ptr<string> fileName
+            = unique_ptr<string>(new string{"/lib/test/resources/benchmark-repository/memory/meta.md"});
+    fileName.get()->insert(0, getMindforgerGitHomePath());
+    unique_ptr<string> content{m8r::fileToString(*fileName.get())};
+    vector<string> lines{};
+    size_t pos = 0, eol;
+    while((eol = content->find('\n', pos)) != string::npos) {
+        lines.push_back(content->substr(pos, eol-pos));
+        pos = eol+1;
+    }
+    cout << "Lines: " << lines.size() << endl;
+
+    const vector<string> patterns{"the", "mindforger", "knowledge", "x", "zzzzzz"};
+    const int ROUNDS = 10;
+
+    size_t lowerMatches = 0;
+    auto begin = chrono::high_resolution_clock::now();
+    for(int r=0; r<ROUNDS; r++) {
+        for(const string& p:patterns) {
+            for(const string& l:lines) {
+                string s{};
+                stringToLower(l, s);
+                if(s.find(p) != string::npos) {
+                    lowerMatches++;
+                }
+            }
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Lowercase & find: " << lowerMatches << " matches in "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+
+    size_t foldMatches = 0;
+    begin = chrono::high_resolution_clock::now();
+    for(int r=0; r<ROUNDS; r++) {
+        for(const string& p:patterns) {
+            for(const string& l:lines) {
+                if(stringFindIgnoreCase(l, p) != string::npos) {
+                    foldMatches++;
+                }
+            }
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    cout << "Folded find     : " << foldMatches << " matches in "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+
+    // benchmark repository is ASCII only > both searches must agree
+    ASSERT_EQ(lowerMatches, foldMatches);
+}
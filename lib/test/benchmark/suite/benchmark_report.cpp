@@ -0,0 +1,144 @@
+/*
+ benchmark_report.cpp     MindForger benchmarks
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "benchmark_report.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+using namespace std;
+
+namespace m8r {
+
+BenchmarkReport::BenchmarkReport()
+    : properties{},
+      series{}
+{
+}
+
+BenchmarkReport::~BenchmarkReport()
+{
+}
+
+void BenchmarkReport::setProperty(const string& name, const string& value)
+{
+    string json{};
+    jsonString(value, json);
+    properties.push_back(make_pair(name, json));
+}
+
+void BenchmarkReport::setProperty(const string& name, unsigned long long value)
+{
+    properties.push_back(make_pair(name, std::to_string(value)));
+}
+
+void BenchmarkReport::addSample(const string& name, double milliseconds)
+{
+    // series keep the order in which they were measured
+    for(Series& s:series) {
+        if(s.name == name) {
+            s.samples.push_back(milliseconds);
+            return;
+        }
+    }
+    series.push_back(Series{name, vector<double>{milliseconds}});
+}
+
+double BenchmarkReport::percentile(const vector<double>& sorted, double p)
+{
+    if(sorted.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(p/100.0*sorted.size()));
+    return sorted[rank?rank-1:0];
+}
+
+string BenchmarkReport::jsonNumber(double d)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.4f", d);
+    return string{buffer};
+}
+
+void BenchmarkReport::jsonString(const string& s, string& json)
+{
+    json += '"';
+    for(char c:s) {
+        switch(c) {
+        case '"': json += "\\\""; break;
+        case '\\': json += "\\\\"; break;
+        case '\n': json += "\\n"; break;
+        case '\t': json += "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                json += buffer;
+            } else {
+                json += c;
+            }
+        }
+    }
+    json += '"';
+}
+
+void BenchmarkReport::toJson(string& json) const
+{
+    json += "{\n  \"suite\": \"mindforger-lib-benchmarks\",\n  \"properties\": {";
+    for(size_t i=0; i<properties.size(); i++) {
+        json += i?",\n    ":"\n    ";
+        jsonString(properties[i].first, json);
+        json += ": ";
+        json += properties[i].second;
+    }
+    json += "\n  },\n  \"benchmarks\": [";
+    for(size_t i=0; i<series.size(); i++) {
+        vector<double> sorted{series[i].samples};
+        std::sort(sorted.begin(), sorted.end());
+        double sum = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+
+        json += i?",\n    {":"\n    {";
+        json += "\"name\": ";
+        jsonString(series[i].name, json);
+        json += ", \"unit\": \"ms\", \"samples\": " + std::to_string(sorted.size());
+        json += ", \"min\": " + jsonNumber(sorted.front());
+        json += ", \"mean\": " + jsonNumber(sum/sorted.size());
+        json += ", \"p50\": " + jsonNumber(percentile(sorted, 50));
+        json += ", \"p90\": " + jsonNumber(percentile(sorted, 90));
+        json += ", \"p99\": " + jsonNumber(percentile(sorted, 99));
+        json += ", \"max\": " + jsonNumber(sorted.back());
+        json += "}";
+    }
+    json += "\n  ]\n}\n";
+}
+
+void BenchmarkReport::toText(string& text) const
+{
+    char buffer[256];
+    for(const Series& s:series) {
+        vector<double> sorted{s.samples};
+        std::sort(sorted.begin(), sorted.end());
+        snprintf(buffer, sizeof(buffer), "%-28s %6zu samples  p50 %12.4fms  p90 %12.4fms  p99 %12.4fms\n",
+                 s.name.c_str(), sorted.size(), percentile(sorted, 50), percentile(sorted, 90), percentile(sorted, 99));
+        text += buffer;
+    }
+}
+
+} // m8r namespace
@@ -0,0 +1,104 @@
+/*
+ benchmark_report.h     MindForger benchmarks
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_BENCHMARK_REPORT_H
+#define M8R_BENCHMARK_REPORT_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace m8r {
+
+/**
+ * @brief Benchmark results: named series of samples (ms) w/ percentiles as JSON.
+ *
+ * Report is machine readable so that results of different commits (label)
+ * can be compared by a script:
+ *
+ * {
+ *   "suite": "mindforger-lib-benchmarks",
+ *   "properties": { "label": "...", "notes": 10000, ... },
+ *   "benchmarks": [
+ *     { "name": "learn", "unit": "ms", "samples": 5,
+ *       "min": ..., "mean": ..., "p50": ..., "p90": ..., "p99": ..., "max": ... },
+ *     ...
+ *   ]
+ * }
+ */
+class BenchmarkReport
+{
+public:
+    struct Series {
+        std::string name;
+        std::vector<double> samples;
+    };
+
+private:
+    // property name and JSON value
+    std::vector<std::pair<std::string,std::string>> properties;
+    std::vector<Series> series;
+
+public:
+    explicit BenchmarkReport();
+    BenchmarkReport(const BenchmarkReport&) = delete;
+    BenchmarkReport(const BenchmarkReport&&) = delete;
+    BenchmarkReport& operator=(const BenchmarkReport&) = delete;
+    BenchmarkReport& operator=(const BenchmarkReport&&) = delete;
+    ~BenchmarkReport();
+
+    void setProperty(const std::string& name, const std::string& value);
+    void setProperty(const std::string& name, unsigned long long value);
+
+    void addSample(const std::string& name, double milliseconds);
+
+    /**
+     * @brief Measure function run and add it as sample of given series.
+     *
+     * @return sample in milliseconds.
+     */
+    template<typename F> double measure(const std::string& name, F f) {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration_cast<std::chrono::nanoseconds>(end-begin).count()/1000000.0;
+        addSample(name, ms);
+        return ms;
+    }
+
+    const std::vector<Series>& getSeries() const { return series; }
+
+    /**
+     * @brief Nearest rank percentile of sorted samples.
+     */
+    static double percentile(const std::vector<double>& sorted, double p);
+
+    void toJson(std::string& json) const;
+    /**
+     * @brief One line per series summary for humans.
+     */
+    void toText(std::string& text) const;
+
+private:
+    static void jsonString(const std::string& s, std::string& json);
+    static std::string jsonNumber(double d);
+};
+
+}
+#endif // M8R_BENCHMARK_REPORT_H
@@ -0,0 +1,341 @@
+/*
+ mindforger_lib_benchmarks.cpp     MindForger benchmarks
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Standalone benchmark suite: synthetic repository of given size is generated
+ * and the key operations (learn, FTS, associations, autolinking, HTML, save and export)
+ * are measured. JSON report w/ percentiles is written so that results can be
+ * compared across commits.
+ *
+ *   mindforger-lib-benchmarks --notes 100000 --label `git rev-parse --short HEAD` --output bench.json
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../../src/mind/mind.h"
+#include "../../../src/gear/aho_corasick.h"
+#include "../../../src/gear/file_utils.h"
+
+#include "benchmark_report.h"
+#include "synthetic_repository.h"
+
+using namespace std;
+using namespace m8r;
+
+struct BenchmarkOptions {
+    size_t notes = 10000;
+    size_t notesPerOutline = 50;
+    u_int64_t seed = SyntheticRepository::DEFAULT_SEED;
+    size_t iterations = 5;
+    size_t samples = 200;
+    string repository{"/tmp/mf-benchmark-repository"};
+    string output{};
+    string label{};
+    string scenarios{"learn,fts,associations,autolinking,html,save,export"};
+
+    bool isScenario(const string& name) const {
+        return ("," + scenarios + ",").find("," + name + ",") != string::npos;
+    }
+};
+
+static void usage()
+{
+    cerr << "Usage: mindforger-lib-benchmarks [options]" << endl
+         << "  --notes N              Ns in synthetic repository (default 10000, 1000 to 1000000)" << endl
+         << "  --notes-per-outline N  average Ns per O (default 50)" << endl
+         << "  --seed N               generator seed (the same seed gives the same repository)" << endl
+         << "  --iterations N         iterations of repository-wide benchmarks (default 5)" << endl
+         << "  --samples N            sampled Ns/Os for per-thing benchmarks (default 200)" << endl
+         << "  --scenarios LIST       comma separated: learn,fts,associations,autolinking,html,save,export" << endl
+         << "  --repository DIR       where to generate repository (default /tmp/mf-benchmark-repository)" << endl
+         << "  --label TEXT           label of the run e.g. commit" << endl
+         << "  --output FILE          JSON report file (default stdout)" << endl;
+}
+
+static bool parseOptions(int argc, char* argv[], BenchmarkOptions& options)
+{
+    for(int i=1; i<argc; i++) {
+        string option{argv[i]};
+        if(option == "--help" || option == "-h" || i+1 == argc) {
+            return false;
+        }
+        string value{argv[++i]};
+        if(option == "--notes") {
+            options.notes = std::strtoull(value.c_str(), nullptr, 10);
+        } else if(option == "--notes-per-outline") {
+            options.notesPerOutline = std::strtoull(value.c_str(), nullptr, 10);
+        } else if(option == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 0);
+        } else if(option == "--iterations") {
+            options.iterations = std::strtoull(value.c_str(), nullptr, 10);
+        } else if(option == "--samples") {
+            options.samples = std::strtoull(value.c_str(), nullptr, 10);
+        } else if(option == "--scenarios") {
+            options.scenarios = value;
+        } else if(option == "--repository") {
+            options.repository = value;
+        } else if(option == "--label") {
+            options.label = value;
+        } else if(option == "--output") {
+            options.output = value;
+        } else {
+            cerr << "Error: unknown option " << option << endl;
+            return false;
+        }
+    }
+    return options.notes && options.iterations && options.samples;
+}
+
+/*
+ * Every n-th thing so that samples are spread over the whole repository.
+ */
+template<typename T> static vector<T*> sampleThings(const vector<T*>& things, size_t samples)
+{
+    vector<T*> sampled{};
+    if(things.size()) {
+        size_t stride = std::max<size_t>(1, things.size()/samples);
+        for(size_t i=0; i<things.size() && sampled.size()<samples; i+=stride) {
+            sampled.push_back(things[i]);
+        }
+    }
+    return sampled;
+}
+
+static void benchmarkFts(Mind& mind, const SyntheticRepository& repository, const BenchmarkOptions& options, BenchmarkReport& report)
+{
+    // words of different frequency (Zipf rank) give very different result sizes
+    struct Band { const char* name; size_t fromRank; size_t toRank; FtsSearch mode; };
+    const Band bands[] = {
+        {"fts.exact.frequent", 0, 10, FtsSearch::EXACT},
+        {"fts.exact.medium", 100, 1000, FtsSearch::EXACT},
+        {"fts.exact.rare", 5000, repository.getVocabularySize(), FtsSearch::EXACT},
+        {"fts.ignore_case.medium", 100, 1000, FtsSearch::IGNORE_CASE}
+    };
+    const size_t QUERIES = 10;
+    for(const Band& band:bands) {
+        for(size_t i=0; i<options.iterations; i++) {
+            for(size_t q=0; q<QUERIES; q++) {
+                const string& pattern = repository.getWord(band.fromRank + q*(band.toRank-band.fromRank)/QUERIES);
+                report.measure(band.name, [&]{
+                    unique_ptr<vector<Note*>> result{mind.findNoteFts(pattern, band.mode)};
+                });
+            }
+        }
+    }
+}
+
+static void benchmarkAssociations(Mind& mind, const vector<Note*>& notes, BenchmarkReport& report)
+{
+    report.measure("associations.think", [&]{ mind.think().get(); });
+    for(Note* n:notes) {
+        report.measure("associations.note", [&]{
+            AssociatedNotes associations{ResourceType::NOTE, n};
+            if(mind.getAssociatedNotes(associations).get() && !associations.getAssociations()->size()) {
+                // leaderboard calculated asynchronously > get it from AI
+                mind.getAssociatedNotes(associations).get();
+            }
+        });
+    }
+}
+
+static void benchmarkAutolinking(Mind& mind, const vector<Note*>& notes, const BenchmarkOptions& options, BenchmarkReport& report)
+{
+    // autolinking index: O and N names in Aho-Corasick automaton
+    const string delimiters{" \t,:;.!?<>{}&()-+/*\\_=%~#$^[]'\""};
+    unique_ptr<AhoCorasick> automaton{};
+    for(size_t i=0; i<options.iterations; i++) {
+        automaton.reset(new AhoCorasick{});
+        report.measure("autolinking.index", [&]{
+            for(Outline* o:mind.remind().getOutlines()) {
+                automaton->addWord(o->getName());
+                for(Note* n:o->getNotes()) {
+                    automaton->addWord(n->getName());
+                }
+            }
+            vector<AhoCorasick::Match> matches{};
+            automaton->findAll("", 0, matches);
+        });
+    }
+    for(Note* n:notes) {
+        string description = n->getDescriptionAsString();
+        report.measure("autolinking.note", [&]{
+            vector<AhoCorasick::Match> matches{};
+            automaton->findWholeWords(description.c_str(), description.size(), delimiters, matches);
+        });
+    }
+}
+
+static void benchmarkHtml(Mind& mind, const vector<Note*>& notes, const vector<Outline*>& outlines, BenchmarkReport& report)
+{
+    HtmlOutlineRepresentation* htmlRepresentation = mind.getHtmlRepresentation();
+    string html{};
+    for(Note* n:notes) {
+        htmlRepresentation->getFragmentCache().clear();
+        html.clear();
+        report.measure("html.note.cold", [&]{ htmlRepresentation->to(n, &html, true); });
+        html.clear();
+        report.measure("html.note.cached", [&]{ htmlRepresentation->to(n, &html, true); });
+    }
+    for(Outline* o:outlines) {
+        htmlRepresentation->getFragmentCache().clear();
+        html.clear();
+        report.measure("html.outline.cold", [&]{ htmlRepresentation->to(o, &html, false, true, true, true); });
+        html.clear();
+        report.measure("html.outline.cached", [&]{ htmlRepresentation->to(o, &html, false, true, true, true); });
+    }
+}
+
+static void benchmarkSave(Mind& mind, const vector<Outline*>& outlines, BenchmarkReport& report)
+{
+    // O is serialized, written behind and flushed (fsync) to disk
+    for(Outline* o:outlines) {
+        report.measure("save.outline", [&]{
+            mind.remember(o);
+            mind.remind().flush();
+        });
+    }
+}
+
+static void benchmarkExport(Mind& mind, const BenchmarkOptions& options, BenchmarkReport& report)
+{
+    // whole memory export: in the calling thread and w/ workers
+    map<const Tag*,int> tagsCardinality{};
+    mind.getTagsCardinality(tagsCardinality);
+    string csv{options.repository + "-export.csv"};
+    string columnar{options.repository + "-export.mfcols"};
+    for(size_t i=0; i<options.iterations; i++) {
+        report.measure("export.csv.sequential", [&]{
+            mind.remind().exportToCsv(csv, tagsCardinality, 1);
+        });
+        report.measure("export.csv.parallel", [&]{
+            mind.remind().exportToCsv(csv, tagsCardinality, 1, nullptr, &mind.getWorkers());
+        });
+        report.measure("export.columnar.parallel", [&]{
+            mind.remind().exportToColumnar(columnar, nullptr, &mind.getWorkers());
+        });
+    }
+    remove(csv.c_str());
+    remove(columnar.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options{};
+    if(!parseOptions(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+
+    BenchmarkReport report{};
+    report.setProperty("label", options.label);
+    report.setProperty("seed", static_cast<unsigned long long>(options.seed));
+    report.setProperty("iterations", static_cast<unsigned long long>(options.iterations));
+    report.setProperty("samples", static_cast<unsigned long long>(options.samples));
+    report.setProperty("cpus", static_cast<unsigned long long>(std::thread::hardware_concurrency()));
+#ifdef MF_MD_2_HTML_CMARK
+    report.setProperty("markdown2html", "cmark-gfm");
+#else
+    report.setProperty("markdown2html", "none");
+#endif
+
+    cerr << "Generating " << options.notes << " Ns repository to " << options.repository << "..." << endl;
+    SyntheticRepository repository{options.notes, options.notesPerOutline, options.seed};
+    bool generated{};
+    report.measure("generate", [&]{ generated = repository.generate(options.repository); });
+    if(!generated) {
+        cerr << "Error: unable to generate repository to " << options.repository << endl;
+        return 1;
+    }
+    report.setProperty("outlines", static_cast<unsigned long long>(repository.getOutlinesCount()));
+    report.setProperty("notes", static_cast<unsigned long long>(repository.getNotesCount()));
+    report.setProperty("bytes", static_cast<unsigned long long>(repository.getBytes()));
+
+    MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    Configuration& config = Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(options.repository + "-config.md");
+    config.setActiveRepository(
+        config.addRepository(RepositoryIndexer::getRepositoryForPath(options.repository)),
+        repositoryConfigRepresentation
+    );
+    config.setAutolinking(true);
+    Mind mind{config};
+
+    cerr << "Learning..." << endl;
+    if(options.isScenario("learn")) {
+        for(size_t i=0; i<options.iterations; i++) {
+            mind.amnesia();
+            report.measure("learn", [&]{ mind.learn(); });
+        }
+    } else {
+        mind.learn();
+    }
+
+    vector<Note*> allNotes{};
+    mind.remind().getAllNotes(allNotes);
+    vector<Note*> notes = sampleThings(allNotes, options.samples);
+    vector<Outline*> outlines = sampleThings(mind.remind().getOutlines(), options.samples);
+
+    if(options.isScenario("fts")) {
+        cerr << "FTS..." << endl;
+        benchmarkFts(mind, repository, options, report);
+    }
+    if(options.isScenario("associations")) {
+        cerr << "Associations..." << endl;
+        benchmarkAssociations(mind, notes, report);
+    }
+    if(options.isScenario("autolinking")) {
+        cerr << "Autolinking..." << endl;
+        benchmarkAutolinking(mind, notes, options, report);
+    }
+    if(options.isScenario("html")) {
+        cerr << "HTML..." << endl;
+        benchmarkHtml(mind, notes, outlines, report);
+    }
+    if(options.isScenario("save")) {
+        cerr << "Save..." << endl;
+        benchmarkSave(mind, outlines, report);
+    }
+    if(options.isScenario("export")) {
+        cerr << "Export..." << endl;
+        benchmarkExport(mind, options, report);
+    }
+
+    string text{};
+    report.toText(text);
+    cerr << text;
+
+    string json{};
+    report.toJson(json);
+    if(options.output.empty()) {
+        cout << json;
+    } else if(!stringToFileAtomically(options.output, json)) {
+        cerr << "Error: unable to write report to " << options.output << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,320 @@
+/*
+ synthetic_repository.cpp     MindForger benchmarks
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "synthetic_repository.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <algorithm>
+
+#include "../../../src/config/configuration.h"
+#include "../../../src/gear/file_utils.h"
+#include "../../../src/install/installer.h"
+
+using namespace std;
+
+namespace m8r {
+
+constexpr u_int64_t SyntheticRepository::DEFAULT_SEED;
+
+// syllables of pseudo words
+static const char* SYLLABLES[] = {
+    "ka", "to", "ri", "mo", "ne", "la", "su", "pi", "da", "ve",
+    "lo", "mi", "ta", "ro", "ni", "se", "pa", "go", "bi", "fu",
+    "ra", "ke", "no", "li", "tu", "ma", "de", "si", "po", "zu",
+    "cha", "en", "or", "an", "is", "ul", "ex", "am", "ir", "on"
+};
+static const size_t SYLLABLES_COUNT = sizeof(SYLLABLES)/sizeof(SYLLABLES[0]);
+
+static const size_t VOCABULARY_SIZE = 20000;
+static const size_t TAGS_COUNT = 300;
+// Zipf exponent of words in natural language texts
+static const double WORDS_ZIPF_EXPONENT = 1.07;
+static const double TAGS_ZIPF_EXPONENT = 1.2;
+static const int MAX_DEPTH = 5;
+// timestamps: 2020/01/01 + up to ~3 years
+static const time_t EPOCH = 1577836800;
+
+u_int64_t SyntheticRepository::Random::next()
+{
+    u_int64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+size_t SyntheticRepository::Random::geometric(double mean)
+{
+    // P(success) = 1/(mean+1)
+    size_t n = 0;
+    while(chance(mean/(mean+1.0)) && n < 1000) {
+        n++;
+    }
+    return n;
+}
+
+SyntheticRepository::SyntheticRepository(size_t notesCount, size_t notesPerOutline, u_int64_t seed)
+    : notesCount{notesCount},
+      notesPerOutline{notesPerOutline?notesPerOutline:1},
+      seed{seed},
+      vocabulary{},
+      wordsCdf{},
+      tags{},
+      tagsCdf{},
+      outlineNames{},
+      outlineFiles{},
+      bytes{},
+      generatedNotes{}
+{
+    vocabulary.reserve(VOCABULARY_SIZE);
+    for(size_t i=0; i<VOCABULARY_SIZE; i++) {
+        vocabulary.push_back(pseudoWord(i));
+    }
+    zipfCdf(vocabulary.size(), WORDS_ZIPF_EXPONENT, wordsCdf);
+
+    // tags are (less frequent) words w/ prefix to keep them distinct
+    for(size_t i=0; i<TAGS_COUNT; i++) {
+        tags.push_back("t" + pseudoWord(i*7+100));
+    }
+    zipfCdf(tags.size(), TAGS_ZIPF_EXPONENT, tagsCdf);
+
+    // O names are known in advance so that Ns can link any O
+    Random random{seed ^ 0x4F55544C494E4553ULL};
+    size_t outlinesCount = (notesCount + this->notesPerOutline - 1) / this->notesPerOutline;
+    char buffer[32];
+    for(size_t i=0; i<outlinesCount; i++) {
+        string name{};
+        title(random, name);
+        outlineNames.push_back(name);
+        snprintf(buffer, sizeof(buffer), "o%07zu.md", i);
+        outlineFiles.push_back(buffer);
+    }
+}
+
+SyntheticRepository::~SyntheticRepository()
+{
+}
+
+void SyntheticRepository::zipfCdf(size_t size, double exponent, vector<double>& cdf)
+{
+    cdf.resize(size);
+    double sum = 0;
+    for(size_t r=0; r<size; r++) {
+        sum += 1.0/std::pow(static_cast<double>(r+1), exponent);
+        cdf[r] = sum;
+    }
+    for(double& c:cdf) {
+        c /= sum;
+    }
+}
+
+size_t SyntheticRepository::sample(Random& random, const vector<double>& cdf)
+{
+    size_t r = std::lower_bound(cdf.begin(), cdf.end(), random.unit()) - cdf.begin();
+    return r<cdf.size()?r:cdf.size()-1;
+}
+
+string SyntheticRepository::pseudoWord(size_t index)
+{
+    // bijective numeration > every index gives different word of 1+ syllables
+    string w{};
+    size_t n = index+1;
+    while(n) {
+        n--;
+        w.insert(0, SYLLABLES[n % SYLLABLES_COUNT]);
+        n /= SYLLABLES_COUNT;
+    }
+    // single syllable words are too short for FTS and names
+    if(w.size() < 4) {
+        w += "n";
+    }
+    return w;
+}
+
+void SyntheticRepository::title(Random& random, string& s)
+{
+    size_t words = 1 + std::min<size_t>(random.geometric(1.5), 7);
+    for(size_t i=0; i<words; i++) {
+        if(i) s += ' ';
+        string w = vocabulary[sample(random, wordsCdf)];
+        if(!i) {
+            w[0] = static_cast<char>(std::toupper(w[0]));
+        }
+        s += w;
+    }
+}
+
+void SyntheticRepository::sentence(Random& random, string& s)
+{
+    size_t words = 5 + random.below(16);
+    for(size_t i=0; i<words; i++) {
+        if(i) {
+            s += ' ';
+        }
+        const string& w = vocabulary[sample(random, wordsCdf)];
+        if(i) {
+            s += w;
+        } else {
+            s += static_cast<char>(std::toupper(w[0]));
+            s.append(w, 1, string::npos);
+        }
+        if(i+1<words && random.chance(0.06)) {
+            s += ',';
+        }
+    }
+    if(random.chance(0.15) && outlineNames.size()) {
+        size_t o = random.below(outlineNames.size());
+        s += " see [" + outlineNames[o] + "](" + outlineFiles[o] + ")";
+    } else if(random.chance(0.05)) {
+        s += " at <https://www." + vocabulary[random.below(1000)] + ".com/" + vocabulary[random.below(vocabulary.size())] + ">";
+    }
+    s += ". ";
+}
+
+void SyntheticRepository::description(Random& random, string& s)
+{
+    size_t paragraphs = 1 + random.geometric(1.5);
+    for(size_t p=0; p<paragraphs; p++) {
+        double kind = random.unit();
+        if(kind < 0.75) {
+            size_t sentences = 1 + random.below(5);
+            for(size_t i=0; i<sentences; i++) {
+                sentence(random, s);
+            }
+            s += '\n';
+        } else if(kind < 0.9) {
+            size_t items = 2 + random.below(5);
+            for(size_t i=0; i<items; i++) {
+                s += "* ";
+                title(random, s);
+                s += '\n';
+            }
+        } else {
+            s += "```\n";
+            size_t lines = 3 + random.below(8);
+            for(size_t i=0; i<lines; i++) {
+                s += vocabulary[sample(random, wordsCdf)] + " = " + vocabulary[sample(random, wordsCdf)]
+                  + "(" + vocabulary[sample(random, wordsCdf)] + ");\n";
+            }
+            s += "```\n";
+        }
+        s += '\n';
+    }
+}
+
+void SyntheticRepository::metadata(Random& random, const char* type, string& s)
+{
+    char buffer[32];
+    time_t created = EPOCH + static_cast<time_t>(random.below(3*365*24*3600));
+    time_t modified = created + static_cast<time_t>(random.below(365*24*3600));
+    time_t read = modified + static_cast<time_t>(random.below(30*24*3600));
+    unsigned revision = 1 + static_cast<unsigned>(random.geometric(3));
+    unsigned reads = revision + static_cast<unsigned>(random.geometric(10));
+
+    s += " <!-- Metadata: type: ";
+    s += type;
+    s += ';';
+    if(random.chance(0.5)) {
+        size_t count = 1 + random.below(3);
+        s += " tags: ";
+        for(size_t i=0; i<count; i++) {
+            if(i) s += ',';
+            s += tags[sample(random, tagsCdf)];
+        }
+        s += ';';
+    }
+    // UTC to get the same bytes regardless time zone
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::gmtime(&created));
+    s += " created: "; s += buffer; s += ';';
+    s += " reads: " + std::to_string(reads) + ';';
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::gmtime(&read));
+    s += " read: "; s += buffer; s += ';';
+    s += " revision: " + std::to_string(revision) + ';';
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", std::gmtime(&modified));
+    s += " modified: "; s += buffer; s += ';';
+    s += " -->\n";
+}
+
+void SyntheticRepository::outline(Random& random, size_t index, size_t notes, string& s)
+{
+    s += "# " + outlineNames[index];
+    metadata(random, "Outline", s);
+    description(random, s);
+
+    // depth: random walk w/ occasional gaps and returns to top level
+    int depth = 0;
+    for(size_t n=0; n<notes; n++) {
+        if(n) {
+            double step = random.unit();
+            if(step < 0.3) {
+                depth += random.chance(0.1)?2:1;
+            } else if(step < 0.75) {
+                // sibling
+            } else {
+                depth -= 1 + static_cast<int>(random.below(depth+1));
+            }
+            depth = std::max(0, std::min(MAX_DEPTH, depth));
+        }
+
+        s += '\n';
+        s.append(depth+1, '#');
+        s += ' ';
+        title(random, s);
+        metadata(random, "Note", s);
+        description(random, s);
+    }
+}
+
+bool SyntheticRepository::generate(const string& directory)
+{
+    removeDirectoryRecursively(directory.c_str());
+    Installer installer{};
+    if(!installer.createEmptyMindForgerRepository(directory)) {
+        return false;
+    }
+    string memory{directory};
+    memory += FILE_PATH_SEPARATOR;
+    memory += DIRNAME_MEMORY;
+    memory += FILE_PATH_SEPARATOR;
+
+    // Ns are spread among Os so that Os sizes vary around the average
+    Random random{seed};
+    bytes = generatedNotes = 0;
+    string md{};
+    for(size_t o=0; o<outlineNames.size(); o++) {
+        size_t remaining = notesCount - generatedNotes;
+        size_t outlinesLeft = outlineNames.size() - o;
+        size_t notes = remaining / outlinesLeft;
+        if(outlinesLeft > 1 && notes > 1) {
+            notes = notes/2 + random.below(notes+1);
+        }
+        notes = std::min(notes, remaining);
+
+        md.clear();
+        outline(random, o, notes, md);
+        stringToFile(memory + outlineFiles[o], md);
+        bytes += md.size();
+        generatedNotes += notes;
+    }
+
+    return true;
+}
+
+} // m8r namespace
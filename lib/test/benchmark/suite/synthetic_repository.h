@@ -0,0 +1,119 @@
+/*
+ synthetic_repository.h     MindForger benchmarks
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef M8R_SYNTHETIC_REPOSITORY_H
+#define M8R_SYNTHETIC_REPOSITORY_H
+
+#include <string>
+#include <vector>
+
+#include "../../../src/definitions.h"
+
+namespace m8r {
+
+/**
+ * @brief Deterministic generator of synthetic MindForger repositories.
+ *
+ * Generated repository has realistic shape rather than realistic content:
+ *
+ * - words of descriptions, titles and queries follow Zipf distribution
+ *   over pseudo-word vocabulary (frequent words are in every N, rare
+ *   words are in a few Ns)
+ * - Ns per O vary around the average, N depth is a random walk w/ gaps
+ * - ~half of Ns is tagged, tags follow Zipf distribution
+ * - descriptions have geometric number of paragraphs w/ links to other Os,
+ *   web links, lists and code blocks
+ *
+ * The same seed gives the same repository (bytes) on every platform - only
+ * raw 64b output of own generator is used (std distributions are
+ * implementation specific).
+ */
+class SyntheticRepository
+{
+public:
+    static constexpr u_int64_t DEFAULT_SEED = 0x6D696E64666F7267ULL;
+
+private:
+    // splitmix64 - portable and good enough for data generation
+    class Random {
+        u_int64_t state;
+    public:
+        explicit Random(u_int64_t seed) : state{seed} {}
+        u_int64_t next();
+        // uniform in [0, n)
+        size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+        // uniform in [0, 1)
+        double unit() { return (next() >> 11) * (1.0/9007199254740992.0); }
+        bool chance(double p) { return unit() < p; }
+        // number of failures before success w/ given mean
+        size_t geometric(double mean);
+    };
+
+    size_t notesCount;
+    size_t notesPerOutline;
+    u_int64_t seed;
+
+    std::vector<std::string> vocabulary;
+    // Zipf CDF over vocabulary/tags ranks
+    std::vector<double> wordsCdf;
+    std::vector<std::string> tags;
+    std::vector<double> tagsCdf;
+
+    std::vector<std::string> outlineNames;
+    std::vector<std::string> outlineFiles;
+    size_t bytes;
+    size_t generatedNotes;
+
+public:
+    explicit SyntheticRepository(size_t notesCount, size_t notesPerOutline=50, u_int64_t seed=DEFAULT_SEED);
+    SyntheticRepository(const SyntheticRepository&) = delete;
+    SyntheticRepository(const SyntheticRepository&&) = delete;
+    SyntheticRepository& operator=(const SyntheticRepository&) = delete;
+    SyntheticRepository& operator=(const SyntheticRepository&&) = delete;
+    ~SyntheticRepository();
+
+    /**
+     * @brief Generate MindForger repository to (cleaned) directory.
+     */
+    bool generate(const std::string& directory);
+
+    u_int64_t getSeed() const { return seed; }
+    size_t getOutlinesCount() const { return outlineNames.size(); }
+    size_t getNotesCount() const { return generatedNotes; }
+    size_t getBytes() const { return bytes; }
+
+    /**
+     * @brief Get vocabulary word by frequency rank (0 is the most frequent word).
+     */
+    const std::string& getWord(size_t rank) const { return vocabulary[rank % vocabulary.size()]; }
+    size_t getVocabularySize() const { return vocabulary.size(); }
+
+private:
+    static void zipfCdf(size_t size, double exponent, std::vector<double>& cdf);
+    static size_t sample(Random& random, const std::vector<double>& cdf);
+    static std::string pseudoWord(size_t index);
+
+    void title(Random& random, std::string& s);
+    void sentence(Random& random, std::string& s);
+    void description(Random& random, std::string& s);
+    void metadata(Random& random, const char* type, std::string& s);
+    void outline(Random& random, size_t index, size_t notes, std::string& s);
+};
+
+}
+#endif // M8R_SYNTHETIC_REPOSITORY_H
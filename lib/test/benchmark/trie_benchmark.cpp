@@ -21,10 +21,14 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <set>
+#include <chrono>
+#include <memory>
 
 #include <gtest/gtest.h>
 
 #include "../../src/gear/trie.h"
+#include "../../src/gear/aho_corasick.h"
 #include "../../src/gear/file_utils.h"
 
 using namespace std;
@@ -118,3 +122,80 @@ TEST(TrieBenchmark, DISABLED_TrieVsMap)
     MF_DEBUG(words.size() << " words SEARCHED in " << chrono::duration_cast<chrono::microseconds>(endTrieSearch-beginTrieSearch).count()/1000.0 << "ms" << endl);
     cout << "TRIE done" << endl;
 }
+
+/*
+ * Autolinking of 1.1M text w/ 10k names: longest prefix word trie search at
+ * every word start (the way autolinking used to do it) vs. single pass of
+ * Aho-Corasick automaton.
+ */
+TEST(TrieBenchmark, DISABLED_TrieVsAhoCorasick)
+{
+    unique_ptr<string> fileName
+            = unique_ptr<string>(new string{"/lib/test/resources/benchmark-repository/memory/meta.md"});
+    fileName.get()->insert(0, getMindforgerGitHomePath());
+    unique_ptr<string> text{m8r::fileToString(*fileName.get())};
+
+    // names: distinct words and word pairs
+    set<string> names{};
+    size_t pos = 0, space, previous = 0;
+    while(names.size() < 10000 && (space = text->find(' ', pos)) != string::npos) {
+        if(space-pos > 3) {
+            names.insert(text->substr(pos, space-pos));
+            names.insert(text->substr(previous, space-previous));
+        }
+        previous = pos;
+        pos = space+1;
+    }
+    size_t maxNameSize = 0;
+    for(const string& n:names) {
+        maxNameSize = std::max(maxNameSize, n.size());
+    }
+    cout << "Names: " << names.size() << " / text: " << text->size() << "B" << endl;
+
+    const string delimiters{" \t,:;.!?<>{}&()-+/*\\_=%~#$^[]'\""};
+
+    Trie trie{};
+    AhoCorasick automaton{};
+    auto begin = chrono::high_resolution_clock::now();
+    for(const string& n:names) {
+        trie.addWord(n);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Trie built in " << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+    begin = chrono::high_resolution_clock::now();
+    for(const string& n:names) {
+        automaton.addWord(n);
+    }
+    vector<AhoCorasick::Match> matches{};
+    automaton.findAll("", 0, matches);
+    end = chrono::high_resolution_clock::now();
+    cout << "Automaton w/ " << automaton.getStatesCount() << " states built in "
+         << chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.0 << "ms" << endl;
+
+    size_t trieMatches = 0;
+    string prefix{};
+    begin = chrono::high_resolution_clock::now();
+    for(size_t i=0; i<text->size(); i++) {
+        if(i==0 || delimiters.find(text->at(i-1)) != string::npos) {
+            prefix.clear();
+            if(trie.findLongestPrefixWord(text->substr(i, maxNameSize), prefix)) {
+                size_t e = i+prefix.size();
+                if(e == text->size() || delimiters.find(text->at(e)) != string::npos) {
+                    trieMatches++;
+                    i = e-1;
+                }
+            }
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    auto trieUs = chrono::duration_cast<chrono::microseconds>(end-begin).count();
+    cout << "Trie: " << trieMatches << " matches in " << trieUs/1000.0 << "ms" << endl;
+
+    begin = chrono::high_resolution_clock::now();
+    automaton.findWholeWords(text->c_str(), text->size(), delimiters, matches);
+    end = chrono::high_resolution_clock::now();
+    auto automatonUs = chrono::duration_cast<chrono::microseconds>(end-begin).count();
+    cout << "Automaton: " << matches.size() << " matches in " << automatonUs/1000.0 << "ms" << endl;
+
+    EXPECT_LE(trieMatches, matches.size());
+}
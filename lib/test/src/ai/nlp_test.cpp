@@ -22,6 +22,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <algorithm>
 
 #include "../../../src/config/configuration.h"
 #include "../../../src/mind/mind.h"
@@ -33,6 +34,7 @@
 #include "../../../src/mind/ai/nlp/lexicon.h"
 #include "../../../src/mind/ai/nlp/word_frequency_list.h"
 #include "../../../src/mind/ai/nlp/bag_of_words.h"
+#include "../../../src/install/installer.h"
 
 #include <gtest/gtest.h>
 
@@ -70,19 +72,19 @@ TEST(AiNlpTestCase, Lexicon)
 
     lexicon.add("a5");
     ASSERT_EQ(1, lexicon.size());
-    ASSERT_EQ(1, lexicon.get("a5")->frequency);
+    ASSERT_EQ(1, lexicon.getFrequency(lexicon.getId("a5")));
 
     lexicon.add("a5");
     ASSERT_EQ(1, lexicon.size());
-    ASSERT_EQ(2, lexicon.get("a5")->frequency);
+    ASSERT_EQ(2, lexicon.getFrequency(lexicon.getId("a5")));
 
     string s{"a5"};
     lexicon.add(s);
     ASSERT_EQ(1, lexicon.size());
-    ASSERT_EQ(3, lexicon.get(s)->frequency);
+    ASSERT_EQ(3, lexicon.getFrequency(lexicon.getId(s)));
     lexicon.add(&s);
     ASSERT_EQ(1, lexicon.size());
-    ASSERT_EQ(4, lexicon.get(&s)->frequency);
+    ASSERT_EQ(4, lexicon.getFrequency(lexicon.getId(&s)));
 
     // adding more words for better weight calculation 5/3/2
     lexicon.add("a5");
@@ -96,14 +98,68 @@ TEST(AiNlpTestCase, Lexicon)
     lexicon.recalculateWeights();
     lexicon.print();
 
-    ASSERT_FLOAT_EQ(0.01, lexicon.get("a5")->weight);
-    ASSERT_FLOAT_EQ(0.4, lexicon.get("a3")->weight);
-    ASSERT_FLOAT_EQ(0.6, lexicon.get("a2")->weight);
+    ASSERT_FLOAT_EQ(0.01, lexicon.getWeight(lexicon.getId("a5")));
+    ASSERT_FLOAT_EQ(0.4, lexicon.getWeight(lexicon.getId("a3")));
+    ASSERT_FLOAT_EQ(0.6, lexicon.getWeight(lexicon.getId("a2")));
+
+    // released occurrences lower frequency (and the maximum on recalculation)
+    lexicon.release(lexicon.getId("a5"), 3);
+    ASSERT_EQ(2, lexicon.getFrequency(lexicon.getId("a5")));
+    lexicon.recalculateWeights();
+    ASSERT_FLOAT_EQ(0.01, lexicon.getWeight(lexicon.getId("a3")));
+    ASSERT_FLOAT_EQ(1.f-2.f/3.f, lexicon.getWeight(lexicon.getId("a2")));
+    ASSERT_EQ(-1, lexicon.getId("a4"));
 
     // TODO weights: increase scale
 
 }
 
+TEST(AiNlpTestCase, WordFrequencyList)
+{
+    m8r::Lexicon lexicon{};
+
+    // words are interned to dense IDs
+    u_int32_t a = lexicon.intern("alpha");
+    u_int32_t b = lexicon.intern("beta");
+    u_int32_t g = lexicon.intern("gamma");
+    ASSERT_EQ(0, a);
+    ASSERT_EQ(1, b);
+    ASSERT_EQ(2, g);
+    ASSERT_EQ(a, lexicon.intern("alpha"));
+    ASSERT_EQ(a, lexicon.intern("alpha"));
+    ASSERT_EQ(b, lexicon.intern("beta"));
+    ASSERT_EQ("beta", lexicon.getWord(b));
+    lexicon.recalculateWeights();
+
+    m8r::WordFrequencyList wfl{&lexicon};
+    ASSERT_EQ(1, wfl.add(a));
+    ASSERT_EQ(1, wfl.add(g));
+    ASSERT_EQ(2, wfl.add(a));
+    ASSERT_EQ(2, wfl.size());
+    ASSERT_TRUE(wfl.contains(a));
+    ASSERT_FALSE(wfl.contains(b));
+    ASSERT_TRUE(wfl.contains(g));
+
+    // ordered by ID and, once sorted, by weight
+    wfl.sort();
+    ASSERT_EQ(a, wfl.iterable()[0].id);
+    ASSERT_EQ(2, wfl.iterable()[0].frequency);
+    ASSERT_EQ(g, wfl.iterableByWeight()[0].id);
+    ASSERT_EQ(a, wfl.iterableByWeight()[1].id);
+    ASSERT_FLOAT_EQ(lexicon.getWeight(a)+lexicon.getWeight(g), wfl.getWeight());
+
+    // unsorted occurrences are merged at once
+    vector<u_int32_t> ids{g, b, a, b};
+    wfl.add(ids);
+    ASSERT_EQ(3, wfl.size());
+    ASSERT_EQ(a, wfl.iterable()[0].id);
+    ASSERT_EQ(3, wfl.iterable()[0].frequency);
+    ASSERT_EQ(b, wfl.iterable()[1].id);
+    ASSERT_EQ(2, wfl.iterable()[1].frequency);
+    ASSERT_EQ(g, wfl.iterable()[2].id);
+    ASSERT_EQ(2, wfl.iterable()[2].frequency);
+}
+
 // DISABLED test because 3rd party stemmer has memory leaks()
 TEST(AiNlpTestCase, DISABLED_BowOutline)
 {
@@ -142,14 +198,14 @@ TEST(AiNlpTestCase, DISABLED_BowOutline)
     wordBlaclist.addWord("text");
     m8r::MarkdownTokenizer tokenizer{lexicon, wordBlaclist};
     m8r::StringCharProvider chars{markdown};
-    m8r::WordFrequencyList* wfl = new m8r::WordFrequencyList{&lexicon};
+    m8r::WordFrequencyList wfl{&lexicon};
     cout << "Tokenizing MD string to word frequency list..." << endl;
-    tokenizer.tokenize(chars, *wfl);
-    wfl->sort();
+    tokenizer.tokenize(chars, wfl);
+    wfl.sort();
 
     // assert wfl
-    wfl->print();
-    ASSERT_EQ(19, wfl->size());
+    wfl.print();
+    ASSERT_EQ(19, wfl.size());
     // assert lexicon
     lexicon.print();
     ASSERT_EQ(19, lexicon.size());
@@ -161,8 +217,13 @@ TEST(AiNlpTestCase, DISABLED_BowOutline)
     m8r::BagOfWords bow{};
     bow.add(&o, wfl);
 
-    bow.print();
+    bow.print(lexicon);
     ASSERT_EQ(1, bow.size());
+    // doc vector is a copy of terms ordered by word ID
+    ASSERT_NE(nullptr, bow.get(&o));
+    ASSERT_EQ(wfl.size(), bow.get(&o)->size());
+    EXPECT_EQ(wfl.iterable()[0].id, bow.get(&o)->at(0).id);
+    EXPECT_EQ(nullptr, bow.get(nullptr));
 }
 
 /*
@@ -297,6 +358,116 @@ TEST(AiNlpTestCase, DISABLED_AaUniverseBow)
     ASSERT_EQ("Alternative Universe", (*leaderboard)[1].first->getOutline()->getName());
 }
 
+static m8r::Note* findNoteByName(m8r::Memory& memory, const string& name)
+{
+    for(m8r::Outline* o:memory.getOutlines()) {
+        for(m8r::Note* n:o->getNotes()) {
+            if(n->getName() == name) {
+                return n;
+            }
+        }
+    }
+    return nullptr;
+}
+
+static vector<string> getAssociatedNoteNames(m8r::Mind& mind, m8r::Note* n)
+{
+    m8r::AssociatedNotes associations{m8r::ResourceType::NOTE, n};
+    if(!mind.getAssociatedNotes(associations).get()) {
+        return vector<string>{};
+    }
+    if(!associations.getAssociations()->size()) {
+        // leaderboard calculated asynchronously > get it from AI
+        mind.getAssociatedNotes(associations).get();
+    }
+    vector<string> names{};
+    for(auto& a:*associations.getAssociations()) {
+        names.push_back(a.first->getName());
+    }
+    return names;
+}
+
+static bool contains(const vector<string>& names, const string& name)
+{
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+TEST(AiNlpTestCase, AaIncrementalBow)
+{
+    string repositoryDir{"/tmp/mf-unit-repository-aa-incremental"};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+    m8r::stringToFile(
+        repositoryDir+"/memory/space.md",
+        "# Space\n\n"
+        "## Apollo\nApollo program Saturn rocket landed astronauts on the Moon.\n\n"
+        "## Kitchen\nSoup recipe with onion and garlic.\n\n");
+    m8r::stringToFile(
+        repositoryDir+"/memory/earth.md",
+        "# Earth\n\n"
+        "## Launch\nSaturn rocket launch from Florida.\n\n"
+        "## Garden\nRoses and tulips bloom in spring.\n\n");
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-antc-aib.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation);
+    config.setAaAlgorithm(m8r::Configuration::AssociationAssessmentAlgorithm::BOW);
+
+    m8r::Mind mind(config);
+    ASSERT_TRUE(mind.learn());
+    ASSERT_TRUE(mind.think().get());
+    ASSERT_EQ(m8r::Configuration::MindState::THINKING, config.getMindState());
+
+    m8r::Note* apollo = findNoteByName(mind.remind(), "Apollo");
+    m8r::Note* launch = findNoteByName(mind.remind(), "Launch");
+    m8r::Note* garden = findNoteByName(mind.remind(), "Garden");
+    ASSERT_NE(nullptr, apollo);
+    ASSERT_NE(nullptr, launch);
+    ASSERT_NE(nullptr, garden);
+
+    // only Ns sharing a word, tag or O are assessed
+    vector<string> names = getAssociatedNoteNames(mind, apollo);
+    EXPECT_TRUE(contains(names, "Launch"));
+    EXPECT_TRUE(contains(names, "Kitchen"));
+    EXPECT_FALSE(contains(names, "Garden"));
+
+    // modified N is re-learned and calculated leaderboards are updated
+    garden->clearDescription();
+    garden->addDescriptionLine("Apollo astronauts landed on the Moon with Saturn rocket.");
+    garden->makeModified();
+    mind.remember(garden->getOutline());
+    names = getAssociatedNoteNames(mind, apollo);
+    EXPECT_TRUE(contains(names, "Garden"));
+
+    // new N is learned
+    m8r::Note* lander = new m8r::Note{garden->getType(), garden->getOutline()};
+    lander->setName("Lander");
+    lander->addDescriptionLine("Lunar module landed on the Moon.");
+    garden->getOutline()->addNote(lander);
+    mind.remember(garden->getOutline());
+    names = getAssociatedNoteNames(mind, apollo);
+    EXPECT_TRUE(contains(names, "Lander"));
+    EXPECT_TRUE(contains(getAssociatedNoteNames(mind, lander), "Apollo"));
+
+    // forgotten N is removed from leaderboards
+    mind.noteForget(launch);
+    names = getAssociatedNoteNames(mind, apollo);
+    EXPECT_FALSE(contains(names, "Launch"));
+    EXPECT_TRUE(contains(names, "Garden"));
+
+    // forgotten O is removed from leaderboards
+    mind.forget(garden->getOutline());
+    names = getAssociatedNoteNames(mind, apollo);
+    EXPECT_FALSE(contains(names, "Garden"));
+    EXPECT_FALSE(contains(names, "Lander"));
+    EXPECT_TRUE(contains(names, "Kitchen"));
+}
+
 /*
  * AA: FTS
  */
@@ -189,6 +189,15 @@ TEST(ConfigurationTestCase, SaveAndLoad)
     EXPECT_EQ(expectedRepositoryConfigurationPath, c.getRepositoryConfigFilePath());
     EXPECT_EQ(2, c.getRepositoryConfiguration().getOrganizers().size());
 
+    // debounced save is not lost by load
+    c.setUiThemeName("LATERCOLORS");
+    configRepresentation.saveLater(c);
+    c.setUiThemeName("CRAZYCOLORS");
+    ASSERT_TRUE(configRepresentation.load(c));
+    EXPECT_EQ("LATERCOLORS", c.getUiThemeName());
+    c.setUiThemeName("CRAZYCOLORS");
+    configRepresentation.save(c);
+
     /*
      * LOAD
      */
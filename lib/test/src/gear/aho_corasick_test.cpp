@@ -0,0 +1,139 @@
+/*
+ aho_corasick_test.cpp     MindForger Aho-Corasick automaton test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gear/aho_corasick.h"
+
+using namespace std;
+
+/*
+ * Matches as text: "word@offset word@offset ..."
+ */
+string matchesToString(const string& text, const vector<m8r::AhoCorasick::Match>& matches)
+{
+    string s{};
+    for(const m8r::AhoCorasick::Match& m:matches) {
+        if(s.size()) s += " ";
+        s += text.substr(m.offset, m.size) + "@" + std::to_string(m.offset);
+    }
+    return s;
+}
+
+TEST(AhoCorasickTestCase, FindAll)
+{
+    m8r::AhoCorasick automaton{};
+    EXPECT_TRUE(automaton.empty());
+    vector<string> words{"he", "she", "his", "hers", "", "he"};
+    for(const string& w:words) {
+        automaton.addWord(w);
+    }
+    EXPECT_EQ(4, automaton.size());
+    EXPECT_TRUE(automaton.findWord("hers"));
+    EXPECT_FALSE(automaton.findWord("her"));
+    // searches are const > automaton is compiled explicitly after modifications
+    EXPECT_FALSE(automaton.isCompiled());
+    automaton.compile();
+    EXPECT_TRUE(automaton.isCompiled());
+
+    // classic example: overlapping words are found via failure and dictionary links
+    string text{"ushers"};
+    vector<m8r::AhoCorasick::Match> matches{};
+    automaton.findAll(text.c_str(), text.size(), matches);
+    EXPECT_EQ("she@1 he@2 hers@2", matchesToString(text, matches));
+
+    text.assign("ahishers");
+    matches.clear();
+    automaton.findAll(text.c_str(), text.size(), matches);
+    EXPECT_EQ("his@1 she@3 he@4 hers@4", matchesToString(text, matches));
+
+    string r{};
+    EXPECT_TRUE(automaton.findLongestPrefixWord("hersey", r));
+    EXPECT_EQ("hers", r);
+    r.clear();
+    EXPECT_FALSE(automaton.findLongestPrefixWord("ushers", r));
+
+    // incremental modifications: "he" was added twice
+    automaton.removeWord("he");
+    EXPECT_TRUE(automaton.findWord("he"));
+    automaton.removeWord("he");
+    EXPECT_FALSE(automaton.findWord("he"));
+    EXPECT_FALSE(automaton.removeWord("he"));
+    automaton.addWord("us");
+    automaton.compile();
+    text.assign("ushers");
+    matches.clear();
+    automaton.findAll(text.c_str(), text.size(), matches);
+    EXPECT_EQ("us@0 she@1 hers@2", matchesToString(text, matches));
+
+    // fingerprint depends on words set only
+    u_int64_t fingerprint = automaton.getFingerprint();
+    automaton.addWord("us");
+    EXPECT_EQ(fingerprint, automaton.getFingerprint());
+    automaton.addWord("usher");
+    EXPECT_NE(fingerprint, automaton.getFingerprint());
+    automaton.removeWord("usher");
+    EXPECT_EQ(fingerprint, automaton.getFingerprint());
+
+    automaton.clear();
+    EXPECT_TRUE(automaton.empty());
+    EXPECT_EQ(0, automaton.getFingerprint());
+    for(const string& w:{"hers", "us", "his", "she"}) {
+        automaton.addWord(w);
+    }
+    EXPECT_EQ(fingerprint, automaton.getFingerprint());
+    automaton.clear();
+    EXPECT_TRUE(automaton.isCompiled());
+    matches.clear();
+    automaton.findAll(text.c_str(), text.size(), matches);
+    EXPECT_EQ(0, matches.size());
+}
+
+TEST(AhoCorasickTestCase, FindWholeWords)
+{
+    m8r::AhoCorasick automaton{};
+    for(const string& w:{"Mind", "MindForger", "Forger", "mind map", "map", "Dvořák"}) {
+        automaton.addWord(w);
+    }
+    automaton.compile();
+    const string delimiters{" \t,.()"};
+
+    // leftmost longest non-overlapping matches of whole words
+    string text{"MindForger is (Mind) and mind map, not MindForgers or Forger."};
+    vector<m8r::AhoCorasick::Match> matches{};
+    automaton.findWholeWords(text.c_str(), text.size(), delimiters, matches);
+    EXPECT_EQ("MindForger@0 Mind@15 mind map@25 Forger@54", matchesToString(text, matches));
+
+    text.assign("map mind map Dvořák");
+    matches.clear();
+    automaton.findWholeWords(text.c_str(), text.size(), delimiters, matches);
+    EXPECT_EQ("map@0 mind map@4 Dvořák@13", matchesToString(text, matches));
+
+    // rename
+    automaton.removeWord("Mind");
+    automaton.addWord("Brain");
+    automaton.compile();
+    text.assign("Mind is Brain");
+    matches.clear();
+    automaton.findWholeWords(text.c_str(), text.size(), delimiters, matches);
+    EXPECT_EQ("Brain@8", matchesToString(text, matches));
+}
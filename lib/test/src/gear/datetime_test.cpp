@@ -175,3 +175,76 @@ TEST(DateTimeGearTestCase, MdDateTimeParsing)
     cout << endl;
     EXPECT_EQ(116, datetime.tm_year);
 }
+
+TEST(DateTimeGearTestCase, FixedFormatCodec)
+{
+    string in[] = {
+            // DTS (summer months)
+            "2016-05-02 21:30:28",
+            "2018-09-21 23:30:00",
+            "2019-03-31 02:30:00",
+            // normal time (winter months)
+            "2017-01-01 00:00:00",
+            "2016-12-31 23:59:59",
+            "2016-02-29 12:00:00",
+            "1976-11-12 18:31:01",
+            "2038-01-19 03:14:08"
+            };
+
+    struct tm datetime;
+    time_t expected, parsed;
+    char to[20];
+    for(const string& s:in) {
+        // fixed format codec is equivalent to strptime() and mktime() based conversions
+        memset(&datetime, 0, sizeof datetime);
+        datetimeFrom(s.c_str(), &datetime);
+        expected = datetimeSeconds(&datetime);
+        ASSERT_TRUE(datetimeParse(s.c_str(), s.size(), parsed)) << s;
+        EXPECT_EQ(expected, parsed) << s;
+        EXPECT_EQ(s, datetimeFormat(parsed, to));
+        EXPECT_EQ(s, datetimeToString(parsed));
+    }
+
+    // surrounding whitespaces are skipped
+    string s{" \t2016-05-02 21:30:28 \r"};
+    EXPECT_TRUE(datetimeParse(s.c_str(), s.size(), parsed));
+    EXPECT_EQ("2016-05-02 21:30:28", datetimeToString(parsed));
+    s.assign("x 2016-05-02 21:30:28 y");
+    EXPECT_TRUE(datetimeParse(s.c_str()+2, 19, parsed));
+    EXPECT_EQ("2016-05-02 21:30:28", datetimeToString(parsed));
+
+    // other formats are left to strptime()
+    for(const char* bad:{"", "2016-5-2 21:30:28", "2016-05-02T21:30:28", "2016-13-02 21:30:28", "2016-05-02 21:30"}) {
+        EXPECT_FALSE(datetimeParse(bad, strlen(bad), parsed)) << bad;
+    }
+
+    // roundtrip over a few years (local standard time has no gaps nor overlaps)
+    for(time_t t=1451606400; t<1546300800; t+=60*60*7+13) {
+        datetimeFormat(t, to);
+        ASSERT_TRUE(datetimeParse(to, strlen(to), parsed)) << to;
+        ASSERT_EQ(t, parsed) << to;
+    }
+
+    // years out of range are clamped
+    EXPECT_STREQ("9999-12-31 23:59:59", datetimeFormat(static_cast<time_t>(1000000)*365*24*60*60, to));
+    EXPECT_STREQ("0000-01-01 00:00:00", datetimeFormat(-static_cast<time_t>(1000000)*365*24*60*60, to));
+
+    s.clear();
+    datetimeToString(parsed, s);
+    EXPECT_EQ(datetimeToString(parsed), s);
+}
+
+TEST(DateTimeGearTestCase, LazyPrettyTimestamp)
+{
+    PrettyDatetime pretty{};
+    time_t now = datetimeNow();
+    time_t longTimeAgo = now - 60*60*24*365*3;
+
+    const string& html = pretty.get(now);
+    EXPECT_EQ(datetimeToPrettyHtml(now), html);
+    // calculated once and cached
+    EXPECT_EQ(&html, &pretty.get(now));
+    EXPECT_EQ(datetimeToPrettyHtml(longTimeAgo), pretty.get(longTimeAgo));
+    pretty.clear();
+    EXPECT_EQ(datetimeToPrettyHtml(longTimeAgo), pretty.get(longTimeAgo));
+}
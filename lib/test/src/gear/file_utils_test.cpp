@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include "../../../src/gear/file_utils.h"
+#include "../../../src/gear/file_line_provider.h"
 #include "../../../src/install/installer.h"
 
 using namespace std;
@@ -157,3 +158,131 @@ TEST(FileGearTestCase, DeepCopyToExisting)
     p.assign(dstRepositoryDir); p.append("/stencils/notebooks/s-o1.md");
     ASSERT_TRUE(m8r::isDirectoryOrFileExists(p.c_str()));
 }
+
+TEST(FileGearTestCase, FileLineProvider)
+{
+    vector<string> contents{
+        "",
+        "\n",
+        "single line w/o newline",
+        "# Section\n\nLine 1\r\nLine 2\n",
+        "trailing\n\n\nempty lines\n\n"
+    };
+    string path{"/tmp/mf-unit-file-line-provider.md"};
+
+    for(const string& content:contents) {
+        // GIVEN
+        m8r::stringToFile(path, content);
+
+        // WHEN
+        vector<string*> expected{};
+        size_t expectedSize = 0;
+        bool expectedResult = m8r::fileToLines(&path, expected, expectedSize);
+        m8r::FileLineProvider provider{};
+        size_t size = 0;
+        bool result = provider.open(&path, size);
+
+        // THEN lines are the same as w/ getline() based loading
+        EXPECT_EQ(expectedResult, result);
+        EXPECT_EQ(expectedSize, size);
+        ASSERT_EQ(expected.size(), provider.getLines().size());
+        for(size_t i=0; i<expected.size(); i++) {
+            EXPECT_EQ(*expected[i], provider.getLines()[i].toString());
+            delete expected[i];
+        }
+
+        // WHEN text
+        m8r::FileLineProvider textProvider{};
+        EXPECT_EQ(!content.empty(), textProvider.open(&content));
+        EXPECT_EQ(provider.getLines().size(), textProvider.getLines().size());
+    }
+
+    m8r::LineSpan span{"abc", 3};
+    EXPECT_EQ("bc", span.substr(1, 100));
+    EXPECT_EQ('c', span.at(2));
+    EXPECT_THROW(span.at(3), std::out_of_range);
+
+    // read file is NOT affected by truncation (e.g. git pull) while lines are used
+    m8r::stringToFile(path, "# Section\n\nBody.\n");
+    {
+        m8r::FileLineProvider readProvider{};
+        size_t readSize = 0;
+        ASSERT_TRUE(readProvider.open(&path, readSize));
+        m8r::stringToFile(path, "");
+        ASSERT_EQ(3, readProvider.getLines().size());
+        EXPECT_EQ("Body.", readProvider.getLines()[2].toString());
+    }
+
+    // big file is NOT affected by truncation either
+    string big{};
+    while(big.size() < 4*1024*1024) {
+        big += "Line of a big Markdown file.\n";
+    }
+    m8r::stringToFile(path, big);
+    {
+        m8r::FileLineProvider bigProvider{};
+        size_t bigSize = 0;
+        ASSERT_TRUE(bigProvider.open(&path, bigSize));
+        EXPECT_EQ(big.size(), bigSize);
+        m8r::stringToFile(path, "");
+        EXPECT_EQ("Line of a big Markdown file.", bigProvider.getLines().back().toString());
+    }
+
+    string missing{"/tmp/mf-unit-file-line-provider-missing.md"};
+    m8r::FileLineProvider provider{};
+    size_t size = 0;
+    EXPECT_FALSE(provider.open(&missing, size));
+    EXPECT_TRUE(provider.getLines().empty());
+}
+
+TEST(FileGearTestCase, StringToFileAtomically)
+{
+    string directory{"/tmp/mf-unit-atomic-write"};
+    m8r::removeDirectoryRecursively(directory.c_str());
+    m8r::createDirectory(directory);
+    string path{directory+"/o.md"};
+
+    // new file
+    EXPECT_TRUE(m8r::stringToFileAtomically(path, "# First\n"));
+    string* content = m8r::fileToString(path);
+    EXPECT_EQ("# First\n", *content);
+    delete content;
+
+    // replaced file keeps its permissions
+    chmod(path.c_str(), 0640);
+    EXPECT_TRUE(m8r::stringToFileAtomically(path, "# Second\n"));
+    content = m8r::fileToString(path);
+    EXPECT_EQ("# Second\n", *content);
+    delete content;
+    struct stat s{};
+    ASSERT_EQ(0, stat(path.c_str(), &s));
+    EXPECT_EQ(0640, s.st_mode & 07777);
+
+    // link is followed, not replaced
+    string link{directory+"/link.md"};
+    unlink(link.c_str());
+    ASSERT_EQ(0, symlink(path.c_str(), link.c_str()));
+    EXPECT_TRUE(m8r::stringToFileAtomically(link, "# Third\n"));
+    ASSERT_EQ(0, lstat(link.c_str(), &s));
+    EXPECT_TRUE(S_ISLNK(s.st_mode));
+    content = m8r::fileToString(path);
+    EXPECT_EQ("# Third\n", *content);
+    delete content;
+
+    // failed write keeps the original file
+    EXPECT_FALSE(m8r::stringToFileAtomically(directory+"/missing/o.md", "# Fourth\n"));
+
+    // no temp files are left
+    vector<string> files{};
+    DIR* dir = opendir(directory.c_str());
+    ASSERT_NE(nullptr, dir);
+    const struct dirent* entry;
+    while((entry = readdir(dir))) {
+        if(string{"."} != entry->d_name && string{".."} != entry->d_name) {
+            files.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    EXPECT_EQ((vector<string>{"link.md", "o.md"}), files);
+}
@@ -120,3 +120,58 @@ TEST(StringGearTestCase, StringTweaks)
 
     ASSERT_STREQ("a2345", s.c_str());
 }
+
+TEST(StringGearTestCase, FindIgnoreCase)
+{
+    // edge cases
+    ASSERT_EQ(0, stringFindIgnoreCase("", ""));
+    ASSERT_EQ(3, stringFindIgnoreCase("abc", "", 3));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("abc", "", 4));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("", "a"));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("ab", "abc"));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("abc", "a", 7));
+
+    ASSERT_EQ(0, stringFindIgnoreCase("MindForger", "mind"));
+    ASSERT_EQ(4, stringFindIgnoreCase("MindForger", "forger"));
+    ASSERT_EQ(4, stringFindIgnoreCase("MindFORGER", "forger"));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("MindForger", "forgery"));
+    ASSERT_EQ(5, stringFindIgnoreCase("aXbXcxb", "x", 4));
+    // non-letters are NOT folded: '@'+32 == '`' and '['+32 == '{'
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("@[", "`{"));
+    // UTF-8 bytes are compared verbatim
+    ASSERT_EQ(3, stringFindIgnoreCase("Dvořák Dvořák", "řák"));
+    ASSERT_EQ(12, stringFindIgnoreCase("Dvořák Dvořák", "řák", 4));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase("DVOŘÁK", "řák"));
+
+    // long text so that vectorized kernels are used incl. tail and last block matches
+    string text(200, 'a');
+    text += "NeeDle";
+    ASSERT_EQ(200, stringFindIgnoreCase(text, "needle"));
+    ASSERT_EQ(string::npos, stringFindIgnoreCase(text, "needles"));
+    for(size_t i=0; i<text.size(); i+=7) {
+        string t{text};
+        t.replace(i, 1, "Z");
+        ASSERT_EQ(i, stringFindIgnoreCase(t, "z"));
+    }
+
+    // compare with lowercase & find on random texts
+    srand(42);
+    const string alphabet{"aAbB cC"};
+    for(int r=0; r<2000; r++) {
+        string s{}, p{};
+        size_t sLength = rand()%150;
+        for(size_t i=0; i<sLength; i++) {
+            s += alphabet[rand()%alphabet.size()];
+        }
+        size_t pLength = 1+rand()%4;
+        for(size_t i=0; i<pLength; i++) {
+            p += alphabet[rand()%alphabet.size()];
+        }
+        string lp{};
+        stringToLower(p, lp);
+        string l{};
+        stringToLower(s, l);
+        size_t from = sLength ? rand()%sLength : 0;
+        ASSERT_EQ(l.find(lp, from), stringFindIgnoreCase(s, lp, from)) << "'" << s << "' ~ '" << lp << "' @ " << from;
+    }
+}
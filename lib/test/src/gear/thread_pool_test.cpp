@@ -0,0 +1,181 @@
+/*
+ thread_pool_test.cpp     MindForger application test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gear/lang_utils.h"
+#include "gear/thread_pool.h"
+
+using namespace std;
+
+TEST(ThreadPoolTestCase, ExecuteAll)
+{
+    atomic<int> executed{0};
+    {
+        m8r::ThreadPool pool{4};
+        ASSERT_EQ(4, pool.size());
+
+        vector<shared_future<void>> results{};
+        for(int i=0; i<1000; i++) {
+            shared_ptr<promise<void>> p = make_shared<promise<void>>();
+            results.push_back(p->get_future().share());
+            pool.submit([&executed,p](bool cancelled) {
+                if(!cancelled) {
+                    executed++;
+                }
+                p->set_value();
+            });
+        }
+        for(auto& r:results) {
+            r.get();
+        }
+        EXPECT_EQ(1000, executed);
+    }
+}
+
+TEST(ThreadPoolTestCase, PriorityAndCancel)
+{
+    m8r::ThreadPool pool{1};
+
+    // block the only worker so that tasks get queued
+    promise<void> started{};
+    promise<void> unblock{};
+    shared_future<void> unblocked = unblock.get_future().share();
+    pool.submit([&started,unblocked](bool cancelled) {
+        UNUSED_ARG(cancelled);
+        started.set_value();
+        unblocked.wait();
+    });
+    started.get_future().wait();
+
+    mutex orderMutex{};
+    vector<int> order{};
+    promise<void> done{};
+    auto task = [&order,&orderMutex,&done](int id) {
+        return [&order,&orderMutex,&done,id](bool cancelled) {
+            lock_guard<mutex> criticalSection{orderMutex};
+            order.push_back(cancelled ? -id : id);
+            if(order.size() == 4) {
+                done.set_value();
+            }
+        };
+    };
+    pool.submit(task(1), m8r::TaskPriority::LOW);
+    pool.submit(task(2), m8r::TaskPriority::NORMAL);
+    m8r::TaskHandle cancelled = pool.submit(task(3), m8r::TaskPriority::HIGH);
+    pool.submit(task(4), m8r::TaskPriority::HIGH);
+    cancelled.cancel();
+    EXPECT_TRUE(cancelled.isCancelled());
+    EXPECT_EQ(4, pool.getPendingCount());
+
+    unblock.set_value();
+    done.get_future().wait();
+
+    // HIGH before NORMAL before LOW, cancelled task is told so
+    ASSERT_EQ(4, order.size());
+    EXPECT_EQ(-3, order[0]);
+    EXPECT_EQ(4, order[1]);
+    EXPECT_EQ(2, order[2]);
+    EXPECT_EQ(1, order[3]);
+}
+
+TEST(ThreadPoolTestCase, Shutdown)
+{
+    m8r::ThreadPool pool{2};
+    pool.shutdown();
+
+    // task submitted to stopped pool is cancelled (not lost)
+    bool wasCancelled = false;
+    pool.submit([&wasCancelled](bool cancelled) { wasCancelled = cancelled; });
+    EXPECT_TRUE(wasCancelled);
+}
+
+TEST(ThreadPoolTestCase, ProcessInOrder)
+{
+    m8r::ThreadPool pool{4};
+
+    // chunks are processed in parallel, but consumed in order w/ bounded window
+    const size_t CHUNKS = 500;
+    const size_t WINDOW = 8;
+    vector<size_t> results(CHUNKS, 0);
+    atomic<size_t> consumed{0};
+    atomic<bool> windowExceeded{false};
+    vector<size_t> order{};
+    pool.processInOrder(
+        CHUNKS,
+        [&](size_t chunk) {
+            if(chunk >= consumed+WINDOW) {
+                windowExceeded = true;
+            }
+            results[chunk] = chunk*chunk;
+        },
+        [&](size_t chunk) {
+            EXPECT_EQ(chunk*chunk, results[chunk]);
+            order.push_back(chunk);
+            consumed = chunk+1;
+        },
+        WINDOW);
+    ASSERT_EQ(CHUNKS, order.size());
+    for(size_t i=0; i<CHUNKS; i++) {
+        EXPECT_EQ(i, order[i]);
+    }
+    EXPECT_FALSE(windowExceeded);
+
+    // no chunks, the only chunk
+    order.clear();
+    pool.processInOrder(0, [](size_t) {}, [&](size_t chunk) { order.push_back(chunk); });
+    EXPECT_EQ(0, order.size());
+    pool.processInOrder(1, [](size_t) {}, [&](size_t chunk) { order.push_back(chunk); });
+    EXPECT_EQ(1, order.size());
+
+    // failed chunk is not consumed, its exception is rethrown in the calling thread
+    order.clear();
+    atomic<size_t> running{0};
+    EXPECT_THROW(
+        pool.processInOrder(
+            100,
+            [&](size_t chunk) {
+                running++;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                running--;
+                if(chunk == 42) {
+                    throw std::runtime_error("chunk failed");
+                }
+            },
+            [&](size_t chunk) { order.push_back(chunk); }),
+        std::runtime_error);
+    EXPECT_EQ(42, order.size());
+    // no chunk is processed after the caller was unwound
+    EXPECT_EQ(0, running);
+
+    // shut down pool: calling thread processes everything
+    pool.shutdown();
+    order.clear();
+    pool.processInOrder(10, [](size_t) {}, [&](size_t chunk) { order.push_back(chunk); });
+    EXPECT_EQ(10, order.size());
+}
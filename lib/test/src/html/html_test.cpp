@@ -161,3 +161,130 @@ TEST(HtmlTestCase, TaskList)
     cout << "= BEGIN N HTML =" << endl << html << endl << "= END N HTML =" << endl;
     EXPECT_NE(std::string::npos, html.find("input"));
 }
+
+TEST(HtmlTestCase, FragmentCache)
+{
+    m8r::HtmlFragmentCache cache{0};
+    int a{}, b{}, c{};
+    m8r::HtmlFragmentCache::Signature s{1, 0, 11, 0};
+
+    // fragment bigger than capacity is not cached
+    cache.put({&a, 0}, s, "<p>A</p>");
+    EXPECT_EQ(0, cache.size());
+
+    // hit, stale signature and flags
+    string fragment(100, 'x');
+    cache.setCapacity(4096);
+    cache.put({&a, 0}, s, fragment);
+    ASSERT_NE(nullptr, cache.find({&a, 0}, s));
+    EXPECT_EQ(fragment, *cache.find({&a, 0}, s));
+    EXPECT_EQ(nullptr, cache.find({&a, 1}, s));
+    m8r::HtmlFragmentCache::Signature modified{2, 0, 12, 0};
+    EXPECT_EQ(nullptr, cache.find({&a, 0}, modified));
+    // stale fragment was dropped
+    EXPECT_EQ(nullptr, cache.find({&a, 0}, s));
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(0, cache.getBytes());
+    EXPECT_EQ(2, cache.getHits());
+
+    // LRU eviction by bytes
+    cache.put({&a, 0}, s, fragment);
+    size_t entryBytes = cache.getBytes();
+    cache.setCapacity(2*entryBytes);
+    cache.put({&b, 0}, s, fragment);
+    EXPECT_NE(nullptr, cache.find({&a, 0}, s));
+    cache.put({&c, 0}, s, fragment);
+    EXPECT_EQ(2, cache.size());
+    EXPECT_EQ(2*entryBytes, cache.getBytes());
+    EXPECT_NE(nullptr, cache.find({&a, 0}, s));
+    EXPECT_EQ(nullptr, cache.find({&b, 0}, s));
+    EXPECT_NE(nullptr, cache.find({&c, 0}, s));
+
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+    EXPECT_EQ(0, cache.getBytes());
+}
+
+TEST(HtmlTestCase, NoteFragments)
+{
+    string repositoryPath{"/lib/test/resources/basic-repository"};
+    repositoryPath.insert(0, getMindforgerGitHomePath());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-htc-nf.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind(config);
+    m8r::HtmlColorsMock dummyColors{};
+    m8r::HtmlOutlineRepresentation htmlRepresentation{mind.remind().getOntology(), dummyColors, nullptr};
+    mind.learn();
+
+    m8r::Outline* o{};
+    for(m8r::Outline* outline:mind.remind().getOutlines()) {
+        if(outline->getNotesCount() > 1) {
+            o = outline;
+        }
+    }
+    ASSERT_NE(nullptr, o);
+    m8r::Note* n1 = o->getNotes()[0];
+    m8r::Note* n2 = o->getNotes()[1];
+    m8r::HtmlFragmentCache& cache = htmlRepresentation.getFragmentCache();
+
+    // switching between Ns: rendered once, then served from cache
+    string html1{}, html2{}, html{};
+    htmlRepresentation.to(n1, &html1);
+    htmlRepresentation.to(n2, &html2);
+    EXPECT_EQ(0, cache.getHits());
+    EXPECT_EQ(2, cache.size());
+    htmlRepresentation.to(n1, &html);
+    EXPECT_EQ(html1, html);
+    htmlRepresentation.to(n2, &html, false, 50);
+    EXPECT_NE(html2, html);
+    EXPECT_NE(std::string::npos, html.find(n2->getName()));
+    EXPECT_EQ(2, cache.getHits());
+
+    // reads don't invalidate fragment, modification does
+    n1->incReads();
+    htmlRepresentation.to(n1, &html);
+    EXPECT_EQ(html1, html);
+    EXPECT_EQ(3, cache.getHits());
+    n1->setName("Renamed N");
+    n1->makeModified();
+    htmlRepresentation.to(n1, &html);
+    EXPECT_EQ(3, cache.getHits());
+    EXPECT_NE(std::string::npos, html.find("Renamed N"));
+
+    // whole O is stitched from N fragments
+    unsigned misses = cache.getMisses();
+    htmlRepresentation.to(o, &html, false, false, true, true);
+    EXPECT_EQ(misses+1+o->getNotesCount()-2, cache.getMisses());
+    EXPECT_NE(std::string::npos, html.find("Renamed N"));
+    EXPECT_NE(std::string::npos, html.find(n2->getName()));
+    EXPECT_NE(std::string::npos, html.find("<table"));
+    string whole{html};
+    htmlRepresentation.to(o, &html, false, false, true, true);
+    EXPECT_EQ(whole, html);
+    EXPECT_EQ(misses+1+o->getNotesCount()-2, cache.getMisses());
+
+    // footnotes (and reference link definitions) span Ns > whole O is rendered as one document
+    n1->addDescriptionLine("Footnoted[^1] and [referenced][ref] N.");
+    n2->addDescriptionLine("[^1]: Footnote.");
+    n2->addDescriptionLine("   [ref]: http://mindforger.com");
+    n1->makeModified();
+    n2->makeModified();
+    misses = cache.getMisses();
+    unsigned hits = cache.getHits();
+    htmlRepresentation.to(o, &html, false, false, true, true);
+    EXPECT_EQ(misses, cache.getMisses());
+    EXPECT_EQ(hits, cache.getHits());
+    EXPECT_NE(std::string::npos, html.find("Renamed N"));
+    EXPECT_NE(std::string::npos, html.find("Footnote."));
+    EXPECT_NE(std::string::npos, html.find("<table"));
+#ifdef MF_NO_MD_2_HTML
+    EXPECT_EQ(html.find("<pre>"), html.rfind("<pre>"));
+#endif
+}
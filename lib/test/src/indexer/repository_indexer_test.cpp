@@ -178,6 +178,7 @@ TEST(RepositoryIndexerTestCase, MindForgerRepository)
     delete outlineAsString;
 
     mind.remind().remember(outline);
+    mind.remind().flush();
 
     outlineAsString = m8r::fileToString(outline->getKey());
     EXPECT_NE(std::string::npos, outlineAsString->find("Metadata"));
@@ -276,7 +277,14 @@ TEST(RepositoryIndexerTestCase, MarkdownRepository)
     delete outlineAsString;
 
     outline->setName("Dirty");
+    outline->makeDirty();
     mind.remind().remember(outline);
+    // O is clean only once it's written
+    EXPECT_TRUE(outline->isDirty());
+    mind.remind().flush();
+    EXPECT_FALSE(outline->isDirty());
+    vector<string> failures{};
+    EXPECT_FALSE(mind.remind().takeWriteFailures(failures));
 
     outlineAsString = m8r::fileToString(outline->getKey());
     EXPECT_EQ(std::string::npos, outlineAsString->find("Metadata"));
@@ -358,7 +366,14 @@ TEST(RepositoryIndexerTestCase, MindForgerFile)
     delete outlineAsString;
 
     outline->setName("Dirty");
+    outline->makeDirty();
     mind.remind().remember(outline);
+    // O is clean only once it's written
+    EXPECT_TRUE(outline->isDirty());
+    mind.remind().flush();
+    EXPECT_FALSE(outline->isDirty());
+    vector<string> failures{};
+    EXPECT_FALSE(mind.remind().takeWriteFailures(failures));
 
     outlineAsString = m8r::fileToString(outline->getKey());
     EXPECT_NE(std::string::npos, outlineAsString->find("Metadata"));
@@ -441,13 +456,21 @@ TEST(RepositoryIndexerTestCase, MarkdownFile)
 
     // assert that load -> save -> load w/o metadata yields identical result
     mind.remind().remember(outline);
+    mind.remind().flush();
     outlineAsString = m8r::fileToString(outline->getKey());
     EXPECT_EQ(*outlineAsString, content);
     delete outlineAsString;
 
     // assert write to O writes NO metadata
     outline->setName("Dirty");
+    outline->makeDirty();
     mind.remind().remember(outline);
+    // O is clean only once it's written
+    EXPECT_TRUE(outline->isDirty());
+    mind.remind().flush();
+    EXPECT_FALSE(outline->isDirty());
+    vector<string> failures{};
+    EXPECT_FALSE(mind.remind().takeWriteFailures(failures));
     outlineAsString = m8r::fileToString(outline->getKey());
     EXPECT_EQ(std::string::npos, outlineAsString->find("Metadata"));
     delete outlineAsString;
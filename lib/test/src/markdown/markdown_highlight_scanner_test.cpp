@@ -0,0 +1,156 @@
+/*
+ markdown_highlight_scanner_test.cpp     MindForger markdown highlight scanner test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/representations/markdown/markdown_highlight_scanner.h"
+
+using namespace std;
+using namespace m8r;
+
+/*
+ * Spans as text: "TYPE:offset:length TYPE:offset:length ..."
+ */
+string highlightSpansToString(const vector<MarkdownHighlightSpan>& spans)
+{
+    static const char* names[] = {
+        "TAG", "ENTITY", "COMMENT", "ATTR", "VALUE",
+        "BOLD", "BOLDER", "ITALIC", "ITALICER", "STRIKE", "LINK", "AUTOLINK", "CODE", "MATH",
+        "UL", "OL", "DONE", "WIP"
+    };
+
+    stringstream s{};
+    for(const MarkdownHighlightSpan& span:spans) {
+        if(s.tellp()) s << " ";
+        s << names[static_cast<int>(span.type)] << ":" << span.offset << ":" << span.length;
+    }
+    return s.str();
+}
+
+string highlight(MarkdownHighlightScanner& scanner, const string& line, int previousState=-1)
+{
+    scanner.scan(line, previousState);
+    return highlightSpansToString(scanner.getSpans());
+}
+
+TEST(MarkdownHighlightScannerTestCase, Inline)
+{
+    MarkdownHighlightScanner scanner{};
+
+    EXPECT_EQ("", highlight(scanner, ""));
+    EXPECT_EQ("", highlight(scanner, "Plain text w/o any markup."));
+
+    // bold is rewritten by bolder (latter types win)
+    EXPECT_EQ("BOLD:2:6", highlight(scanner, "a *bold* b"));
+    EXPECT_EQ("BOLD:0:7 BOLDER:0:8", highlight(scanner, "**bold**"));
+    EXPECT_EQ("", highlight(scanner, "a * b *"));
+    EXPECT_EQ("BOLD:0:4", highlight(scanner, "*ab*cd*"));
+    EXPECT_EQ("ITALIC:0:3 ITALIC:4:3", highlight(scanner, "_a_ _b_"));
+    EXPECT_EQ("ITALIC:0:5 ITALICER:0:6", highlight(scanner, "__ab__"));
+    EXPECT_EQ("STRIKE:2:7", highlight(scanner, "x ~~del~~ ~~"));
+    EXPECT_EQ("CODE:4:7 MATH:14:5", highlight(scanner, "run `ls -l` & $x+1$"));
+    EXPECT_EQ("", highlight(scanner, "`` $$"));
+
+    // links
+    EXPECT_EQ("LINK:4:20", highlight(scanner, "See [MindForger](x.html) now"));
+    EXPECT_EQ("LINK:0:15 AUTOLINK:4:11", highlight(scanner, "[a](http://b.c)"));
+    EXPECT_EQ("LINK:0:12", highlight(scanner, "[a] b [c](d)"));
+    EXPECT_EQ("", highlight(scanner, "[](x) [a]()"));
+    EXPECT_EQ(
+        "AUTOLINK:6:26 AUTOLINK:36:10",
+        highlight(scanner, "Go to https://www.mindforger.com or http://a.b and http:// x"));
+
+    // lists
+    EXPECT_EQ("UL:0:2", highlight(scanner, "* item"));
+    EXPECT_EQ("UL:0:6", highlight(scanner, "    - item"));
+    EXPECT_EQ("UL:0:2 DONE:0:5", highlight(scanner, "+ [x] done"));
+    EXPECT_EQ("UL:0:6 WIP:0:9", highlight(scanner, "    * [ ] wip"));
+    EXPECT_EQ("OL:0:3 OL:0:4", highlight(scanner, "1. one") + " " + highlight(scanner, "12. twelve"));
+    EXPECT_EQ("", highlight(scanner, "123. no"));
+    EXPECT_EQ("", highlight(scanner, " * no"));
+
+    // HTML
+    EXPECT_EQ(
+        "TAG:0:2 TAG:2:1 TAG:8:4 TAG:12:5 TAG:16:1",
+        highlight(scanner, "<b> bold</b><br/>"));
+    EXPECT_EQ("TAG:0:5 TAG:5:2 TAG:10:6", highlight(scanner, "<?xml?> x </div>"));
+    EXPECT_EQ("ENTITY:2:6 ENTITY:9:6 ENTITY:16:5", highlight(scanner, "a &nbsp; &#160; &:#1; & b &;"));
+    EXPECT_EQ(
+        "TAG:0:2 TAG:33:1 ATTR:3:5 ATTR:19:7 VALUE:10:7 VALUE:28:4",
+        highlight(scanner, "<a class=\"x y z s\" xl:href='link'>"));
+    EXPECT_EQ("ATTR:0:1 ATTR:10:1 VALUE:3:4 VALUE:13:1", highlight(scanner, "a=\"x b=\"\" c='y'"));
+    EXPECT_EQ("ATTR:5:1 VALUE:8:1", highlight(scanner, "a=\"\" b=\"c\""));
+    EXPECT_EQ("TAG:15:1 COMMENT:0:16", highlight(scanner, "<!-- comment -->"));
+}
+
+TEST(MarkdownHighlightScannerTestCase, Multiline)
+{
+    MarkdownHighlightScanner scanner{};
+
+    // MD code block
+    int state = scanner.scan("```bash", -1);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL|MarkdownHighlightScanner::IN_CODE, state);
+    EXPECT_TRUE(scanner.isCodeBlock());
+    EXPECT_EQ("CODE:0:7", highlightSpansToString(scanner.getSpans()));
+    state = scanner.scan("ls *.md | grep _x_", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL|MarkdownHighlightScanner::IN_CODE, state);
+    EXPECT_EQ("CODE:0:18", highlightSpansToString(scanner.getSpans()));
+    state = scanner.scan("```", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL, state);
+    EXPECT_TRUE(scanner.isCodeBlock());
+    EXPECT_EQ("CODE:0:3", highlightSpansToString(scanner.getSpans()));
+    state = scanner.scan("*bo*", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL, state);
+    EXPECT_FALSE(scanner.isCodeBlock());
+    EXPECT_EQ("BOLD:0:4", highlightSpansToString(scanner.getSpans()));
+
+    // HTML comment rewrites any other formatting
+    state = scanner.scan("text <!-- *comment*", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL|MarkdownHighlightScanner::IN_COMMENT, state);
+    EXPECT_EQ("BOLD:10:9 COMMENT:5:14", highlightSpansToString(scanner.getSpans()));
+    state = scanner.scan("still comment", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL|MarkdownHighlightScanner::IN_COMMENT, state);
+    EXPECT_EQ("COMMENT:0:13", highlightSpansToString(scanner.getSpans()));
+    state = scanner.scan("end --> *bo*", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL, state);
+    EXPECT_EQ("TAG:6:1 BOLD:8:4 COMMENT:0:7", highlightSpansToString(scanner.getSpans()));
+    state = scanner.scan("<!-- a --> <!-- b", state);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL|MarkdownHighlightScanner::IN_COMMENT, state);
+    EXPECT_EQ("TAG:9:1 COMMENT:0:10 COMMENT:11:6", highlightSpansToString(scanner.getSpans()));
+}
+
+TEST(MarkdownHighlightScannerTestCase, Utf16)
+{
+    MarkdownHighlightScanner scanner{};
+
+    // offsets are in code units: "Dvořák" has 6 UTF-16 code units
+    const u16string line{u"Dvořák *řř* [ř](ř)"};
+    int state = scanner.scan(line.c_str(), line.size(), -1);
+    EXPECT_EQ(MarkdownHighlightScanner::NORMAL, state);
+    EXPECT_EQ("BOLD:7:4 LINK:12:6", highlightSpansToString(scanner.getSpans()));
+
+    const string utf8{"Dvořák *řř*"};
+    scanner.scan(utf8, -1);
+    EXPECT_EQ("BOLD:9:6", highlightSpansToString(scanner.getSpans()));
+}
@@ -421,8 +421,8 @@ TEST(MarkdownParserTestCase, MarkdownRepresentation)
         }
         cout << endl << "    " << (note->getType()?note->getType()->getName():"NULL") << " (type)";
         cout << endl << "      Description[" << note->getDescription().size() << "]:";
-        for(string* description:note->getDescription()) {
-            cout << endl << "        '" << *description << "' (description)";
+        for(const m8r::Description::Line& description:note->getDescription()) {
+            cout << endl << "        '" << description.str() << "' (description)";
         }
         cout << endl << "  " << note->getCreated() << " (created)";
         cout << endl << "  " << note->getModified() << " (modified)";
@@ -0,0 +1,146 @@
+/*
+ aggregates_test.cpp     MindForger aggregates test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/config/configuration.h"
+#include "../../../src/gear/file_utils.h"
+#include "../../../src/mind/mind.h"
+#include "../../../src/install/installer.h"
+
+extern char* getMindforgerGitHomePath();
+
+using namespace std;
+
+TEST(AggregatesTestCase, BasicRepository)
+{
+    string repositoryPath{"/lib/test/resources/basic-repository"};
+    repositoryPath.insert(0, getMindforgerGitHomePath());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-atc-br.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind{config};
+    mind.learn();
+
+    string error{};
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+    EXPECT_EQ(mind.remind().getOutlinesCount(), mind.remind().getAggregates().getOutlinesCount());
+    EXPECT_LT(0, mind.remind().getNotesCount());
+    EXPECT_LT(0, mind.remind().getOutlineMarkdownsSize());
+}
+
+TEST(AggregatesTestCase, Mutations)
+{
+    string repositoryDir{m8r::platformSpecificPath("/tmp/mf-unit-repository-aggregates")};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(m8r::platformSpecificPath("/tmp/cfg-atc-m.md"));
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind{config};
+    mind.learn();
+    const m8r::Aggregates& aggregates = mind.remind().getAggregates();
+    string error{};
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+
+    // new Os and Ns
+    string name{"Alpha"};
+    string alphaKey = mind.outlineNew(&name);
+    name.assign("Beta");
+    string betaKey = mind.outlineNew(&name);
+    name.assign("A1");
+    m8r::Note* a1 = mind.noteNew(alphaKey, 0, &name);
+    name.assign("A2");
+    m8r::Note* a2 = mind.noteNew(alphaKey, 1, &name);
+    name.assign("B1");
+    m8r::Note* b1 = mind.noteNew(betaKey, 0, &name);
+    mind.remember(alphaKey);
+    mind.remember(betaKey);
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+    m8r::Outline* alpha = mind.remind().getOutline(alphaKey);
+    m8r::Outline* beta = mind.remind().getOutline(betaKey);
+    unsigned notes = alpha->getNotesCount() + beta->getNotesCount();
+    EXPECT_EQ(notes, mind.remind().getNotesCount());
+
+    // reads incremented by a view are aggregated on statistics
+    b1->incReads();
+    b1->incReads();
+    b1->makeDirty();
+    a2->incReads();
+    a2->makeDirty();
+    m8r::MindStatistics* stats = mind.getStatistics();
+    EXPECT_EQ(b1, stats->mostReadNote);
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+
+    // only Os made dirty since they were aggregated are re-aggregated
+    EXPECT_EQ(0, mind.remind().getDirtyOutlines().size());
+    u_int32_t a2Reads = a2->getReads();
+    a2->setReads(b1->getReads()+1);
+    stats = mind.getStatistics();
+    EXPECT_EQ(b1, stats->mostReadNote);
+    a2->makeDirty();
+    EXPECT_EQ(1, mind.remind().getDirtyOutlines().size());
+    stats = mind.getStatistics();
+    EXPECT_EQ(a2, stats->mostReadNote);
+    EXPECT_EQ(0, mind.remind().getDirtyOutlines().size());
+    a2->setReads(a2Reads);
+    a2->makeDirty();
+    stats = mind.getStatistics();
+    EXPECT_EQ(b1, stats->mostReadNote);
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+
+    // remembered O is re-aggregated
+    a1->setReads(10);
+    a1->makeModified();
+    mind.remember(alphaKey);
+    EXPECT_EQ(a1, aggregates.getMostReadNote());
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+
+    // forgotten N and O
+    mind.noteForget(a1);
+    EXPECT_EQ(b1, aggregates.getMostReadNote());
+    EXPECT_EQ(notes-1, mind.remind().getNotesCount());
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+    notes = alpha->getNotesCount();
+    mind.outlineForget(betaKey);
+    EXPECT_EQ(a2, aggregates.getMostReadNote());
+    EXPECT_EQ(notes, mind.remind().getNotesCount());
+    EXPECT_TRUE(mind.remind().checkAggregates(&error)) << error;
+
+    // amnesia
+    mind.amnesia();
+    EXPECT_EQ(0, mind.remind().getNotesCount());
+    EXPECT_EQ(nullptr, aggregates.getMostReadNote());
+}
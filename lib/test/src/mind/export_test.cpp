@@ -0,0 +1,132 @@
+/*
+ export_test.cpp     MindForger export test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/config/configuration.h"
+#include "../../../src/gear/file_utils.h"
+#include "../../../src/mind/mind.h"
+#include "../../../src/representations/columnar/columnar_outline_representation.h"
+
+extern char* getMindforgerGitHomePath();
+
+using namespace std;
+
+TEST(ExportTestCase, CsvAndColumnar)
+{
+    string repositoryPath{"/lib/test/resources/basic-repository"};
+    repositoryPath.insert(0, getMindforgerGitHomePath());
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-etc-cac.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryPath)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind{config};
+    mind.learn();
+    const vector<m8r::Outline*>& outlines = mind.remind().getOutlines();
+    size_t rows = outlines.size() + mind.remind().getNotesCount();
+    ASSERT_LT(0, outlines.size());
+
+    // chunks of Os
+    vector<size_t> chunks{};
+    m8r::CsvOutlineRepresentation::chunkOutlines(outlines, 1, chunks);
+    EXPECT_EQ(outlines.size()+1, chunks.size());
+    m8r::CsvOutlineRepresentation::chunkOutlines(outlines, rows, chunks);
+    EXPECT_EQ((vector<size_t>{0, outlines.size()}), chunks);
+
+    // CSV: parallel export is identical to sequential export
+    map<const m8r::Tag*,int> tagsCardinality{};
+    mind.getTagsCardinality(tagsCardinality);
+    string sequentialCsv{"/tmp/mf-unit-export-sequential.csv"};
+    string parallelCsv{"/tmp/mf-unit-export-parallel.csv"};
+    EXPECT_TRUE(mind.remind().exportToCsv(sequentialCsv, tagsCardinality, 0));
+    m8r::ThreadPool workers{4};
+    EXPECT_TRUE(mind.remind().exportToCsv(parallelCsv, tagsCardinality, 0, nullptr, &workers));
+    unique_ptr<string> sequential{m8r::fileToString(sequentialCsv)};
+    unique_ptr<string> parallel{m8r::fileToString(parallelCsv)};
+    EXPECT_EQ(*sequential, *parallel);
+    EXPECT_EQ(rows+1, static_cast<size_t>(std::count(sequential->begin(), sequential->end(), '\n')));
+    EXPECT_EQ(0, sequential->find("id,type,title,offset,depth,reads,writes,created,modified,read,description,"));
+
+    // OHE: ones at columns of thing's tags
+    m8r::Outline* o = outlines[0];
+    string oRow{o->getKey() + ",o,"};
+    size_t b = sequential->find(oRow);
+    ASSERT_NE(string::npos, b);
+    string row = sequential->substr(b, sequential->find('\n', b)-b);
+    size_t ones = 0;
+    for(size_t i=row.size()-tagsCardinality.size()*2; i<row.size(); i+=2) {
+        if(row[i+1] == '1') ones++;
+    }
+    EXPECT_EQ(o->getTags()->size(), ones);
+
+    // columnar dataset
+    m8r::ColumnarOutlineRepresentation columnar{};
+    m8r::ColumnarOutlineRepresentation::Dataset dataset{};
+    columnar.to(outlines, dataset, &workers);
+    ASSERT_EQ(rows, dataset.size());
+    EXPECT_EQ(0, dataset.types[0]);
+    EXPECT_EQ(o->getKey(), dataset.keys.get(0));
+    EXPECT_EQ(o->getName(), dataset.titles.get(0));
+    EXPECT_EQ(o->getReads(), dataset.reads[0]);
+    EXPECT_EQ(o->getModified(), dataset.modified[0]);
+    EXPECT_EQ(rows+1, dataset.tagOffsets.size());
+    EXPECT_EQ(rows+1, dataset.tfidfOffsets.size());
+    EXPECT_EQ(dataset.vocabulary.size(), dataset.documentFrequencies.size());
+    EXPECT_LT(0, dataset.vocabulary.size());
+    set<string> oTags{};
+    for(const m8r::Tag* t:*o->getTags()) oTags.insert(t->getName());
+    set<string> datasetTags{};
+    for(size_t i=dataset.tagOffsets[0]; i<dataset.tagOffsets[1]; i++) {
+        datasetTags.insert(dataset.tags.get(dataset.tagIds[i]));
+    }
+    EXPECT_EQ(oTags, datasetTags);
+    for(size_t r=0; r<rows; r++) {
+        for(size_t i=dataset.tfidfOffsets[r]; i<dataset.tfidfOffsets[r+1]; i++) {
+            EXPECT_LT(0.f, dataset.tfidfValues[i]);
+            EXPECT_LT(0, dataset.documentFrequencies[dataset.tfidfWords[i]]);
+            if(i > dataset.tfidfOffsets[r]) {
+                EXPECT_LT(dataset.tfidfWords[i-1], dataset.tfidfWords[i]);
+            }
+        }
+    }
+
+    // sequential and parallel dataset are the same, file is written
+    m8r::ColumnarOutlineRepresentation::Dataset sequentialDataset{};
+    columnar.to(outlines, sequentialDataset);
+    EXPECT_EQ(dataset.tfidfWords, sequentialDataset.tfidfWords);
+    EXPECT_EQ(dataset.tfidfValues, sequentialDataset.tfidfValues);
+    EXPECT_EQ(dataset.vocabulary.bytes, sequentialDataset.vocabulary.bytes);
+    string columnarFile{"/tmp/mf-unit-export.mfcols"};
+    EXPECT_TRUE(mind.remind().exportToColumnar(columnarFile, nullptr, &workers));
+    unique_ptr<string> binary{m8r::fileToString(columnarFile)};
+    EXPECT_EQ(0, binary->find("MFCOLS01"));
+    EXPECT_EQ(0, binary->size() % 8);
+}
@@ -26,7 +26,9 @@
 #include <gtest/gtest.h>
 
 #include "../../../src/config/configuration.h"
+#include "../../../src/gear/file_utils.h"
 #include "../../../src/mind/mind.h"
+#include "../../../src/install/installer.h"
 
 extern char* getMindforgerGitHomePath();
 
@@ -94,3 +96,82 @@ TEST(FtsTestCase, FTS) {
     EXPECT_EQ(2, result->size());
     delete result;
 }
+
+TEST(FtsTestCase, FtsIndex) {
+    string repositoryDir{m8r::platformSpecificPath("/tmp/mf-unit-repository-fts-index")};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+    string oFile{repositoryDir + FILE_PATH_SEPARATOR + m8r::platformSpecificPath("memory/o.md")};
+    string oContent{
+        "# Index Outline"
+        "\nOutline mentions Zebrafish."
+        "\n"
+        "\n# Fish"
+        "\nZebrafish is a fish."
+        "\n"
+        "\n# Bird"
+        "\nLooking at birds."
+        "\n"};
+    m8r::stringToFile(oFile,oContent);
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath( m8r::platformSpecificPath("/tmp/cfg-ftc-fi.md"));
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind{config};
+    mind.learn();
+    m8r::Outline* o = mind.remind().getOutlines().at(0);
+
+    EXPECT_EQ(3, mind.remind().getFtsIndex().getDocumentsCount());
+
+    // index (pattern length >= 3) and scan (shorter pattern) must give the same results
+    unique_ptr<vector<m8r::Note*>> result{mind.findNoteFts("Zebrafish", m8r::FtsSearch::EXACT)};
+    EXPECT_EQ(2, result->size());
+    EXPECT_EQ(o->getName(), result->at(0)->getName());
+    EXPECT_EQ("Fish", result->at(1)->getName());
+    result.reset(mind.findNoteFts("zebrafish", m8r::FtsSearch::EXACT));
+    EXPECT_EQ(0, result->size());
+    result.reset(mind.findNoteFts("ZEBRAfish", m8r::FtsSearch::IGNORE_CASE));
+    EXPECT_EQ(2, result->size());
+    result.reset(mind.findNoteFts("Ze", m8r::FtsSearch::EXACT));
+    EXPECT_EQ(2, result->size());
+    result.reset(mind.findNoteFts("Lo+king at", m8r::FtsSearch::REGEXP));
+    EXPECT_EQ(1, result->size());
+    result.reset(mind.findNoteFts("fish|bird", m8r::FtsSearch::REGEXP));
+    EXPECT_EQ(3, result->size());
+
+    // regexp literals
+    vector<string> literals{};
+    m8r::FtsIndex::regexpLiterals("lo*king\\.md[0-9]+(ab)?xyz", literals);
+    ASSERT_EQ(3, literals.size());
+    EXPECT_EQ("l", literals[0]);
+    EXPECT_EQ("king.md", literals[1]);
+    EXPECT_EQ("xyz", literals[2]);
+
+    // remember: index is updated
+    string name{"Salmon"};
+    m8r::Note* n = mind.noteNew(o->getKey(), 0, &name);
+    n->addDescriptionLine("Salmon is not a zebrafish.");
+    mind.remember(o->getKey());
+    result.reset(mind.findNoteFts("salmon", m8r::FtsSearch::IGNORE_CASE));
+    EXPECT_EQ(1, result->size());
+    result.reset(mind.findNoteFts("zebrafish", m8r::FtsSearch::IGNORE_CASE));
+    ASSERT_EQ(3, result->size());
+    EXPECT_EQ("Salmon", result->at(1)->getName());
+
+    // N forget: deleted N is not found
+    mind.noteForget(n);
+    result.reset(mind.findNoteFts("salmon", m8r::FtsSearch::IGNORE_CASE));
+    EXPECT_EQ(0, result->size());
+
+    // O forget: nothing is found
+    mind.outlineForget(o->getKey());
+    result.reset(mind.findNoteFts("zebrafish", m8r::FtsSearch::IGNORE_CASE));
+    EXPECT_EQ(0, result->size());
+    EXPECT_EQ(0, mind.remind().getFtsIndex().getDocumentsCount());
+}
@@ -0,0 +1,156 @@
+/*
+ knowledge_graph_layout_test.cpp     MindForger knowledge graph layout test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/mind/knowledge_graph_layout.h"
+
+using namespace std;
+
+TEST(KnowledgeGraphLayoutTestCase, Forces)
+{
+    m8r::KnowledgeGraphLayout layout{};
+    layout.setEdgeLength(300);
+    layout.addNode(0, 0);
+    layout.addNode(100, 0);
+    layout.addEdge(0, 1);
+
+    layout.calculateForces();
+
+    // magnets: 100 * 300 / (2 * 100^2) = 1.5, rubber band: 100 / ((1+1) * 10) = 5
+    EXPECT_DOUBLE_EQ(3.5, layout.getVelocityX(0));
+    EXPECT_DOUBLE_EQ(0, layout.getVelocityY(0));
+    EXPECT_DOUBLE_EQ(-3.5, layout.getVelocityX(1));
+    EXPECT_DOUBLE_EQ(0, layout.getVelocityY(1));
+
+    // coincident nodes don't repulse each other
+    layout.setPosition(1, 0, 0);
+    layout.calculateForces();
+    EXPECT_DOUBLE_EQ(0, layout.getVelocityX(0));
+    EXPECT_DOUBLE_EQ(0, layout.getVelocityY(1));
+}
+
+TEST(KnowledgeGraphLayoutTestCase, BarnesHut)
+{
+    mt19937 random{42};
+    uniform_real_distribution<double> coordinate{-1000.0, 1000.0};
+
+    const size_t NODES = 1000;
+    m8r::KnowledgeGraphLayout exact{}, approximated{};
+    exact.setTheta(0);
+    for(size_t i=0; i<NODES; i++) {
+        double x = coordinate(random), y = coordinate(random);
+        exact.addNode(x, y);
+        approximated.addNode(x, y);
+        if(i) {
+            size_t parent = random() % i;
+            exact.addEdge(parent, i);
+            approximated.addEdge(parent, i);
+        }
+    }
+    // coincident nodes
+    exact.addNode(10, 10);
+    exact.addNode(10, 10);
+    approximated.addNode(10, 10);
+    approximated.addNode(10, 10);
+
+    exact.calculateForces();
+    approximated.calculateForces();
+
+    double error = 0, total = 0;
+    for(size_t i=0; i<exact.size(); i++) {
+        double dx = exact.getVelocityX(i) - approximated.getVelocityX(i);
+        double dy = exact.getVelocityY(i) - approximated.getVelocityY(i);
+        error += sqrt(dx*dx + dy*dy);
+        total += sqrt(exact.getVelocityX(i)*exact.getVelocityX(i) + exact.getVelocityY(i)*exact.getVelocityY(i));
+    }
+    EXPECT_LT(error/total, 0.01);
+
+    // theta is capped so that node's own cell is never approximated
+    approximated.setTheta(2.0);
+    EXPECT_DOUBLE_EQ(m8r::KnowledgeGraphLayout::THETA_MAX, approximated.getTheta());
+}
+
+TEST(KnowledgeGraphLayoutTestCase, Converge)
+{
+    vector<m8r::KnowledgeGraphNode*> nodes{};
+    for(int i=0; i<101; i++) {
+        nodes.push_back(new m8r::KnowledgeGraphNode{m8r::KnowledgeGraphNodeType::NOTE, "N"+to_string(i)});
+    }
+    m8r::KnowledgeSubGraph subgraph{nodes[0]};
+    for(int i=1; i<=70; i++) {
+        subgraph.addChild(nodes[i]);
+    }
+    for(int i=71; i<101; i++) {
+        subgraph.addParent(nodes[i]);
+    }
+
+    m8r::KnowledgeGraphLayout layout{};
+    layout.setSubGraph(subgraph);
+    ASSERT_EQ(101, layout.size());
+    EXPECT_EQ(nodes[0], layout.getGraphNode(0));
+    EXPECT_EQ(nodes[1], layout.getGraphNode(1));
+    EXPECT_EQ(nodes[71], layout.getGraphNode(71));
+
+    mt19937 random{7};
+    uniform_real_distribution<double> coordinate{0, 500.0};
+    for(size_t i=1; i<layout.size(); i++) {
+        layout.setPosition(i, coordinate(random), coordinate(random));
+    }
+    layout.setBounds(-490, -490, 990, 990);
+    layout.setPinned(0, true);
+
+    int steps = 0;
+    while(layout.step()) {
+        ASSERT_LT(++steps, 2000);
+    }
+    EXPECT_GT(steps, 0);
+    EXPECT_LT(layout.getTemperature(), layout.getEdgeLength());
+
+    // pinned node didn't move, other nodes are within bounds and spread around it
+    EXPECT_DOUBLE_EQ(0, layout.getX(0));
+    EXPECT_DOUBLE_EQ(0, layout.getY(0));
+    double minX = 0, maxX = 0, minY = 0, maxY = 0;
+    for(size_t i=1; i<layout.size(); i++) {
+        EXPECT_GE(layout.getX(i), -490);
+        EXPECT_LE(layout.getX(i), 990);
+        EXPECT_GE(layout.getY(i), -490);
+        EXPECT_LE(layout.getY(i), 990);
+        minX = min(minX, layout.getX(i)); maxX = max(maxX, layout.getX(i));
+        minY = min(minY, layout.getY(i)); maxY = max(maxY, layout.getY(i));
+    }
+    EXPECT_LT(minX, 0);
+    EXPECT_GT(maxX, 0);
+    EXPECT_LT(minY, 0);
+    EXPECT_GT(maxY, 0);
+
+    // converged layout moves again once heated and a node is moved
+    layout.setPosition(1, 900, 900);
+    layout.heat();
+    EXPECT_TRUE(layout.step());
+
+    for(m8r::KnowledgeGraphNode* n:nodes) {
+        delete n;
+    }
+}
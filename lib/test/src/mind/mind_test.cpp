@@ -18,11 +18,14 @@
  */
 
 #include <stddef.h>
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 #include <string>
 #include <vector>
 
+#include <utime.h>
+
 #include <gtest/gtest.h>
 
 #include "../../../src/config/repository.h"
@@ -58,7 +61,7 @@ void dumpOutline(m8r::Outline*& outline)
     cout << endl << "  '" << outline->getName() << "' (name)";
     cout << endl << "  Description[" << outline->getDescription().size() << "]:";
     for (size_t d = 0; d < outline->getDescription().size(); d++) {
-        cout << endl << "    '" << *outline->getDescription()[d] << "' (description)";
+        cout << endl << "    '" << outline->getDescription()[d].str() << "' (description)";
     }
     cout << endl << "  " << outline->getCreated() << " (created)";
     cout << endl << "  " << outline->getModified() << " (modified)";
@@ -106,8 +109,8 @@ void dumpOutline(m8r::Outline*& outline)
                     << " (type)";
             cout << endl << "      Description[" << note->getDescription().size()
                     << "]:";
-            for (string* description : note->getDescription()) {
-                cout << endl << "        '" << *description << "' (description)";
+            for (const m8r::Description::Line& description : note->getDescription()) {
+                cout << endl << "        '" << description.str() << "' (description)";
             }
             cout << endl << "  " << note->getCreated() << " (created)";
             cout << endl << "  " << note->getModified() << " (modified)";
@@ -306,6 +309,349 @@ TEST(MindTestCase, LearnAmnesiaLearn) {
     EXPECT_EQ(17, memory.getOntology().getTags().size());
 }
 
+TEST(MindTestCase, ParallelLearn) {
+    // prepare M8R repository w/ enough Os to keep all workers busy
+    string repositoryDir{"/tmp/mf-unit-repository-parallel-learn"};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+    for(int o=0; o<50; o++) {
+        string md{"# Outline "};
+        md += std::to_string(o);
+        md += " <!-- Metadata: type: Grow; tags: parallel-o";
+        md += std::to_string(o%7);
+        md += "; created: 2022-01-01 10:00:00; reads: 1; read: 2022-01-01 10:00:00;"
+              " revision: 1; modified: 2022-01-01 10:00:00; importance: 1/5; urgency: 2/5; -->\n"
+              "Outline description.\n\n";
+        for(int n=0; n<20; n++) {
+            md += "## Note ";
+            md += std::to_string(n);
+            md += " <!-- Metadata: type: Question; tags: parallel-n";
+            md += std::to_string((o+n)%11);
+            md += "; created: 2022-01-01 10:00:00; reads: 1; read: 2022-01-01 10:00:00;"
+                  " revision: 1; modified: 2022-01-01 10:00:00; -->\n"
+                  "Note description.\n\n";
+        }
+        m8r::stringToFile(repositoryDir+"/memory/outline-"+std::to_string(o)+".md", md);
+    }
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-mtc-pl.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+
+    m8r::Mind mind(config);
+    m8r::Memory& memory = mind.remind();
+    m8r::MarkdownOutlineRepresentation mdr{memory.getOntology(), nullptr};
+
+    // sequential load
+    config.setLearnThreads(1);
+    mind.learn();
+    vector<string> sequentialMds{};
+    vector<const m8r::Tag*> sequentialTags{};
+    for(m8r::Outline* o:memory.getOutlines()) {
+        string md{};
+        mdr.to(o, &md);
+        sequentialMds.push_back(o->getKey()+md);
+        sequentialTags.push_back(o->getNotes()[0]->getTags()->at(0));
+    }
+    size_t tagsCount = memory.getOntology().getTags().size();
+    EXPECT_EQ(50, sequentialMds.size());
+    mind.amnesia();
+
+    // parallel load must yield the same result
+    config.setLearnThreads(4);
+    EXPECT_EQ(4, config.getLearnThreads());
+    mind.learn();
+    EXPECT_EQ(sequentialMds.size(), memory.getOutlines().size());
+    EXPECT_EQ(sequentialMds.size(), memory.getOutlinesCount());
+    EXPECT_EQ(sequentialMds.size()*20, memory.getNotesCount());
+    EXPECT_EQ(tagsCount, memory.getOntology().getTags().size());
+    for(size_t i=0; i<memory.getOutlines().size() && i<sequentialMds.size(); i++) {
+        m8r::Outline* o = memory.getOutlines()[i];
+        string md{};
+        mdr.to(o, &md);
+        EXPECT_EQ(sequentialMds[i], o->getKey()+md);
+        // tags are interned i.e. the same instances are used
+        EXPECT_EQ(sequentialTags[i], o->getNotes()[0]->getTags()->at(0));
+        EXPECT_EQ(o, memory.getOutline(o->getKey()));
+    }
+
+    config.setLearnThreads(m8r::Configuration::DEFAULT_LEARN_THREADS);
+}
+
+#ifdef __linux__
+TEST(MindTestCase, LearnChanges) {
+    string repositoryDir{"/tmp/mf-unit-repository-learn-changes"};
+    string memoryDir{repositoryDir+"/memory"};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+    auto outlineMd = [](const string& name, const string& description) {
+        return "# "+name+" <!-- Metadata: type: Grow; created: 2022-01-01 10:00:00; reads: 1; read: 2022-01-01 10:00:00;"
+               " revision: 1; modified: 2022-01-01 10:00:00; importance: 1/5; urgency: 2/5; -->\n"
+               +description+"\n\n"
+               "## Note of "+name+" <!-- Metadata: type: Question; created: 2022-01-01 10:00:00; reads: 1; read: 2022-01-01 10:00:00;"
+               " revision: 1; modified: 2022-01-01 10:00:00; -->\n"
+               "Note description.\n\n";
+    };
+    m8r::stringToFile(memoryDir+"/outline-a.md", outlineMd("Alpha", "First."));
+    m8r::stringToFile(memoryDir+"/outline-b.md", outlineMd("Bravo", "Second."));
+    m8r::stringToFile(memoryDir+"/outline-c.md", outlineMd("Charlie", "Third."));
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-mtc-lc.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+    config.setRepositoryWatch(true);
+
+    m8r::Mind mind(config);
+    m8r::Memory& memory = mind.remind();
+    mind.learn();
+    ASSERT_TRUE(memory.getRepositoryIndexer().isWatching());
+    ASSERT_EQ(3, memory.getOutlinesCount());
+    EXPECT_EQ(0, mind.learnChanges());
+
+    // MindForger's own writes are NOT changes
+    m8r::Outline* alpha = memory.getOutline(memoryDir+"/outline-a.md");
+    ASSERT_NE(nullptr, alpha);
+    mind.remember(alpha->getKey());
+    EXPECT_EQ(0, mind.learnChanges());
+    EXPECT_EQ(alpha, memory.getOutline(memoryDir+"/outline-a.md"));
+
+    // changes made by others: modify, create (in a new directory) and delete
+    m8r::Outline* bravo = memory.getOutline(memoryDir+"/outline-b.md");
+    ASSERT_NE(nullptr, bravo);
+    m8r::stringToFile(memoryDir+"/outline-b.md", outlineMd("Bravo", "Second with xylophone."));
+    m8r::createDirectory(memoryDir+"/sub");
+    m8r::stringToFile(memoryDir+"/sub/outline-d.md", outlineMd("Delta", "Fourth."));
+    remove((memoryDir+"/outline-c.md").c_str());
+
+    EXPECT_EQ(3, mind.learnChanges());
+    EXPECT_EQ(3, memory.getOutlinesCount());
+    EXPECT_EQ(3, memory.getRepositoryIndexer().getMarkdownFiles().size());
+    EXPECT_EQ(nullptr, memory.getOutline(memoryDir+"/outline-c.md"));
+    EXPECT_EQ(alpha, memory.getOutline(memoryDir+"/outline-a.md"));
+    m8r::Outline* newBravo = memory.getOutline(memoryDir+"/outline-b.md");
+    ASSERT_NE(nullptr, newBravo);
+    EXPECT_NE(bravo, newBravo);
+    // changed O keeps its position
+    EXPECT_EQ(newBravo, memory.getOutlines()[1]);
+    m8r::Outline* delta = memory.getOutline(memoryDir+"/sub/outline-d.md");
+    ASSERT_NE(nullptr, delta);
+    EXPECT_EQ("Delta", delta->getName());
+
+    // FTS index is patched
+    unique_ptr<vector<m8r::Note*>> result{mind.findNoteFts("xylophone", m8r::FtsSearch::EXACT)};
+    ASSERT_EQ(1, result->size());
+    EXPECT_EQ(newBravo, result->at(0)->getOutline());
+    result.reset(mind.findNoteFts("Third", m8r::FtsSearch::EXACT));
+    EXPECT_EQ(0, result->size());
+    result.reset(mind.findNoteFts("Fourth", m8r::FtsSearch::EXACT));
+    EXPECT_EQ(1, result->size());
+
+    EXPECT_EQ(0, mind.learnChanges());
+
+    config.setRepositoryWatch(m8r::Configuration::DEFAULT_REPOSITORY_WATCH);
+}
+#endif
+
+TEST(MindTestCase, LearnFromSnapshot) {
+    string repositoryDir{"/tmp/mf-unit-repository-snapshot"};
+    string memoryDir{repositoryDir+"/memory"};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+    auto outlineMd = [](const string& name) {
+        return "# "+name+" <!-- Metadata: type: Grow; tags: snapshot,important; links: [Home](https://www.mindforger.com);"
+               " created: 2022-01-01 10:00:00; reads: 3; read: 2022-01-02 10:00:00;"
+               " revision: 2; modified: 2022-01-03 10:00:00; importance: 4/5; urgency: 2/5; progress: 30%; -->\n"
+               "Outline description\nw/ two lines.\n\n"
+               "## Note of "+name+" <!-- Metadata: type: Question; tags: snapshot; created: 2022-01-01 10:00:00; reads: 1;"
+               " read: 2022-01-01 10:00:00; revision: 1; modified: 2022-01-01 10:00:00; deadline: 2022-12-24 10:00:00; progress: 50%; -->\n"
+               "Note description.\n\n"
+               "### Child note ###\n"
+               "Child description.\n\n";
+    };
+    // files modified long time ago (snapshot entries of files modified in the current second are invalid)
+    auto writeOld = [](const string& path, const string& content) {
+        m8r::stringToFile(path, content);
+        struct utimbuf times{1600000000, 1600000000};
+        utime(path.c_str(), &times);
+    };
+    writeOld(memoryDir+"/outline-a.md", outlineMd("Alpha"));
+    writeOld(memoryDir+"/outline-b.md", outlineMd("Bravo"));
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-mtc-lfs.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+    ASSERT_TRUE(config.isRepositorySnapshot());
+
+    m8r::Mind mind(config);
+    m8r::Memory& memory = mind.remind();
+    // snapshot is NOT written to the repository, but to the user's cache
+    string snapshotPath{memory.getSnapshotPath()};
+    ASSERT_FALSE(snapshotPath.empty());
+    EXPECT_EQ(string::npos, snapshotPath.find(repositoryDir));
+    EXPECT_NE(string::npos, snapshotPath.find(m8r::getSystemCachePath()));
+    remove(snapshotPath.c_str());
+    m8r::MarkdownOutlineRepresentation mdr{memory.getOntology(), nullptr};
+    auto toMds = [&]() {
+        vector<string> mds{};
+        for(m8r::Outline* o:memory.getOutlines()) {
+            string md{};
+            mdr.to(o, &md);
+            mds.push_back(o->getKey()+md+std::to_string(o->getBytesize())+o->getModifiedPretty());
+        }
+        return mds;
+    };
+
+    // parse & write snapshot
+    mind.learn();
+    ASSERT_TRUE(m8r::isFile(snapshotPath.c_str()));
+    vector<string> parsedMds = toMds();
+    ASSERT_EQ(2, parsedMds.size());
+    mind.amnesia();
+
+    // file w/ the same modification time and size is NOT parsed
+    writeOld(memoryDir+"/outline-a.md", outlineMd("Alphx"));
+    mind.learn();
+    EXPECT_EQ(parsedMds, toMds());
+    m8r::Outline* alpha = memory.getOutline(memoryDir+"/outline-a.md");
+    ASSERT_NE(nullptr, alpha);
+    EXPECT_EQ("Alpha", alpha->getName());
+    EXPECT_EQ(2, alpha->getTags()->size());
+    EXPECT_EQ(1, alpha->getLinks().size());
+    ASSERT_EQ(2, alpha->getNotes().size());
+    EXPECT_EQ(2, alpha->getNotes()[1]->getDepth());
+    EXPECT_EQ(50, alpha->getNotes()[0]->getProgress());
+    EXPECT_EQ(memory.getOntology().findOrCreateTag("snapshot"), alpha->getNotes()[0]->getTags()->at(0));
+    unique_ptr<vector<m8r::Note*>> result{mind.findNoteFts("description", m8r::FtsSearch::EXACT)};
+    EXPECT_EQ(6, result->size());
+    mind.amnesia();
+
+    // modified file is parsed
+    writeOld(memoryDir+"/outline-a.md", outlineMd("Alpha modified"));
+    mind.learn();
+    alpha = memory.getOutline(memoryDir+"/outline-a.md");
+    ASSERT_NE(nullptr, alpha);
+    EXPECT_EQ("Alpha modified", alpha->getName());
+    mind.amnesia();
+
+    // corrupted snapshot is ignored
+    m8r::stringToFile(snapshotPath, "M8RSNAPS corrupted");
+    mind.learn();
+    EXPECT_EQ(2, memory.getOutlinesCount());
+    alpha = memory.getOutline(memoryDir+"/outline-a.md");
+    ASSERT_NE(nullptr, alpha);
+    EXPECT_EQ("Alpha modified", alpha->getName());
+    EXPECT_EQ(parsedMds[1], toMds()[1]);
+}
+
+TEST(MindTestCase, ScopedQueries) {
+    string repositoryDir{"/tmp/mf-unit-repository-scoped-queries"};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath("/tmp/cfg-mtc-sq.md");
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind{config};
+    mind.learn();
+
+    // Os tagged cool/fast, every other N is tagged cool and every third N was read long ago
+    const m8r::Tag* cool = mind.getOntology().findOrCreateTag("cool");
+    const m8r::Tag* fast = mind.getOntology().findOrCreateTag("fast");
+    for(int o=0; o<4; o++) {
+        string name{"Outline " + std::to_string(o)};
+        string key = mind.outlineNew(&name);
+        m8r::Outline* outline = mind.remind().getOutline(key);
+        outline->addTag(o%2?cool:fast);
+        for(int n=0; n<6; n++) {
+            name.assign("Note " + std::to_string(o) + "." + std::to_string(n));
+            m8r::Note* note = mind.noteNew(key, n, &name);
+            note->setTag(n%2?cool:fast);
+        }
+        mind.remember(key);
+        for(size_t n=0; n<outline->getNotes().size(); n+=3) {
+            outline->getNotes()[n]->setRead(1);
+        }
+    }
+
+    // baseline: tagged Ns in Memory::getAllNotes() which is filtered by Mind scope
+    auto scanNotesByTag = [&mind](const m8r::Tag* tag) {
+        vector<m8r::Note*> all{}, result{};
+        mind.getAllNotes(all);
+        for(m8r::Note* n:all) {
+            if(std::find(n->getTags()->begin(), n->getTags()->end(), tag) != n->getTags()->end()) {
+                result.push_back(n);
+            }
+        }
+        return result;
+    };
+
+    vector<m8r::Note*> notes{};
+    mind.findNotesByTags({cool}, notes);
+    EXPECT_EQ(12, notes.size());
+    EXPECT_EQ(scanNotesByTag(cool), notes);
+
+    // tags scope limits Os (Ns are not scoped by tags), time scope limits Os and Ns
+    vector<const m8r::Tag*> scopeTags{fast};
+    mind.getTagsScopeAspect().setTags(scopeTags);
+    notes.clear();
+    mind.findNotesByTags({cool}, notes);
+    EXPECT_EQ(12, notes.size());
+    EXPECT_EQ(scanNotesByTag(cool), notes);
+
+    mind.getTimeScopeAspect().setTimeScope(m8r::TimeScope{1,0,0,0,0});
+    notes.clear();
+    mind.findNotesByTags({cool}, notes);
+    EXPECT_EQ(8, notes.size());
+    EXPECT_EQ(scanNotesByTag(cool), notes);
+
+    // things: Os scoped like getOutlines(), Ns like getAllNotes()
+    vector<m8r::Thing*> things{};
+    string pattern{"note"};
+    mind.getAllThings(things, nullptr, &pattern);
+    vector<m8r::Note*> scopedNotes{};
+    mind.getAllNotes(scopedNotes);
+    EXPECT_EQ(16, things.size());
+    EXPECT_EQ(vector<m8r::Thing*>(scopedNotes.begin(), scopedNotes.end()), things);
+    things.clear();
+    pattern.assign("outline");
+    mind.getAllThings(things, nullptr, &pattern);
+    EXPECT_EQ(2, things.size());
+    EXPECT_EQ(vector<m8r::Thing*>(mind.getOutlines().begin(), mind.getOutlines().end()), things);
+
+    mind.getTimeScopeAspect().resetTimeScope();
+    mind.getTagsScopeAspect().setTags(vector<const m8r::Tag*>{});
+
+    // exact N name
+    unique_ptr<vector<m8r::Note*>> found = mind.findNoteByNameFts("Note 2.3");
+    ASSERT_EQ(1, found->size());
+    EXPECT_EQ("Note 2.3", found->at(0)->getName());
+    EXPECT_EQ(0, mind.findNoteByNameFts("note 2.3")->size());
+}
+
 TEST(MindTestCase, CommonWordsBlacklist) {
     m8r::CommonWordsBlacklist blacklist{};
 
@@ -0,0 +1,157 @@
+/*
+ name_index_test.cpp     MindForger name index test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/mind/name_index.h"
+#include "../../../src/mind/ontology/ontology.h"
+
+using namespace std;
+
+m8r::Outline* createNamedOutline(m8r::Ontology& ontology, const string& name, const vector<string>& noteNames)
+{
+    m8r::Outline* o = new m8r::Outline{ontology.getDefaultOutlineType()};
+    o->setName(name);
+    for(const string& noteName:noteNames) {
+        m8r::Note* n = new m8r::Note{ontology.getDefaultNoteType(), o};
+        n->setName(noteName);
+        o->addNote(n);
+    }
+    return o;
+}
+
+string findNames(const m8r::NameIndex& index, const string& pattern, bool substring=false, size_t limit=0)
+{
+    vector<m8r::Thing*> things{};
+    index.find(pattern, things, substring, limit);
+    string s{};
+    for(m8r::Thing* t:things) {
+        if(s.size()) s += "|";
+        s += t->getName();
+    }
+    return s;
+}
+
+TEST(NameIndexTestCase, Find)
+{
+    m8r::Ontology ontology{};
+    m8r::Outline* a = createNamedOutline(ontology, "Mind", {"Memory", "mindset", "Thinking"});
+    m8r::Outline* b = createNamedOutline(ontology, "Memoirs", {"MIND map", "Forgetting"});
+
+    m8r::NameIndex index{};
+    index.index(a);
+    index.index(b);
+    EXPECT_EQ(7, index.getDocumentsCount());
+
+    // Os first, then Ns - in memory order
+    EXPECT_EQ("Mind|mindset|MIND map", findNames(index, "mind"));
+    EXPECT_EQ("Memoirs|Memory", findNames(index, "MEM"));
+    EXPECT_EQ("Mind|Memoirs|Memory|mindset|Thinking|MIND map|Forgetting", findNames(index, ""));
+    EXPECT_EQ("", findNames(index, "x"));
+    EXPECT_EQ("", findNames(index, "mindsets"));
+
+    // substring
+    EXPECT_EQ("Thinking|Forgetting", findNames(index, "ING", true));
+    EXPECT_EQ("Memoirs|Memory", findNames(index, "emo", true));
+
+    // top K by reads
+    b->getNotes()[0]->incReads();
+    b->getNotes()[0]->incReads();
+    a->getNotes()[1]->incReads();
+    EXPECT_EQ("MIND map|mindset", findNames(index, "mind", false, 2));
+    EXPECT_EQ("MIND map|mindset|Mind", findNames(index, "mind", false, 5));
+
+    // exact O name
+    vector<m8r::Outline*> outlines{};
+    index.findOutlinesByName("Mind", outlines);
+    ASSERT_EQ(1, outlines.size());
+    EXPECT_EQ(a, outlines[0]);
+    outlines.clear();
+    index.findOutlinesByName("mind", outlines);
+    EXPECT_EQ(0, outlines.size());
+
+    // exact N name
+    vector<m8r::Note*> notes{};
+    index.findNotesByName("MIND map", notes);
+    ASSERT_EQ(1, notes.size());
+    EXPECT_EQ(b->getNotes()[0], notes[0]);
+    notes.clear();
+    index.findNotesByName("Mind", notes);
+    EXPECT_EQ(0, notes.size());
+
+    delete a;
+    delete b;
+}
+
+TEST(NameIndexTestCase, Maintenance)
+{
+    m8r::Ontology ontology{};
+    m8r::Outline* a = createNamedOutline(ontology, "Alpha", {"Apple"});
+    m8r::Outline* b = createNamedOutline(ontology, "Beta", {"Avocado"});
+
+    m8r::NameIndex index{};
+    index.index(a);
+    index.index(b);
+
+    // rename and create N > O re-indexed
+    a->getNotes()[0]->setName("Banana");
+    m8r::Note* n = new m8r::Note{ontology.getDefaultNoteType(), a};
+    n->setName("Apricot");
+    a->addNote(n);
+    index.index(a);
+    EXPECT_EQ("Alpha|Apricot|Avocado", findNames(index, "a"));
+    EXPECT_EQ("Beta|Banana", findNames(index, "b"));
+
+    // replaced O keeps position of the old O
+    m8r::Outline* aa = createNamedOutline(ontology, "Aardvark", {});
+    index.replace(a, aa);
+    delete a;
+    EXPECT_EQ("Aardvark|Avocado", findNames(index, "a"));
+
+    // deleted O is not dereferenced
+    index.forget(b);
+    delete b;
+    EXPECT_EQ("Aardvark", findNames(index, ""));
+
+    // many Os to be merged to the sorted array and many re-indexations to be compacted
+    vector<m8r::Outline*> os{};
+    for(int i=0; i<1000; i++) {
+        os.push_back(createNamedOutline(ontology, "O" + std::to_string(i), {"N" + std::to_string(i)}));
+        index.index(os.back());
+    }
+    for(int i=0; i<5000; i++) {
+        index.index(os[i%10]);
+    }
+    EXPECT_EQ(2001, index.getDocumentsCount());
+    EXPECT_EQ("O99|O990|O991|O992|O993|O994|O995|O996|O997|O998|O999", findNames(index, "o99"));
+    EXPECT_EQ("N5", findNames(index, "n5", false, 1));
+    EXPECT_EQ("Aardvark", findNames(index, "aa"));
+
+    index.clear();
+    EXPECT_EQ(0, index.getDocumentsCount());
+    EXPECT_EQ("", findNames(index, ""));
+
+    delete aa;
+    for(m8r::Outline* o:os) {
+        delete o;
+    }
+}
@@ -933,3 +933,65 @@ TEST(NoteTestCase, DirectNoteChildren) {
     EXPECT_EQ("2", directChildren[1]->getName());
     EXPECT_EQ("4", directChildren[2]->getName());
 }
+
+TEST(NoteTestCase, Description) {
+    m8r::Description d{};
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ("", d.getText());
+    EXPECT_EQ(0, d.getBytesize());
+
+    d.append("# Title");
+    d.append("");
+    d.append(string{"Text w/ \"quotes\"."});
+    EXPECT_EQ(3, d.size());
+    EXPECT_EQ("# Title\n\nText w/ \"quotes\".\n", d.getText());
+    EXPECT_EQ(d.getText().size(), d.getBytesize());
+    EXPECT_TRUE(d[0] == "# Title");
+    EXPECT_TRUE(d[0].startsWith("# "));
+    EXPECT_FALSE(d[0].startsWith("# Title!"));
+    EXPECT_TRUE(d[1].empty());
+    EXPECT_EQ("Text w/ \"quotes\".", d[2].str());
+    vector<string> lines{};
+    for(const m8r::Description::Line& l:d) {
+        lines.push_back(l.str());
+    }
+    EXPECT_EQ(3, lines.size());
+    EXPECT_EQ("", lines[1]);
+
+    string s{};
+    d.appendTo(s, " ");
+    EXPECT_EQ("# Title  Text w/ \"quotes\". ", s);
+
+    // copies share text, modification copies it
+    m8r::Description c{d};
+    EXPECT_EQ(d, c);
+    EXPECT_EQ(d.getText().data(), c.getText().data());
+    c.append("Copy");
+    EXPECT_EQ(3, d.size());
+    EXPECT_EQ(4, c.size());
+    EXPECT_NE(d, c);
+    c.append(c);
+    EXPECT_EQ(8, c.size());
+    EXPECT_TRUE(c[7] == "Copy");
+
+    // split like getline()
+    m8r::Description t{"a\n\nb\n"};
+    EXPECT_EQ(3, t.size());
+    EXPECT_EQ("a\n\nb\n", t.getText());
+    t.assign("a\nb");
+    EXPECT_EQ(2, t.size());
+    EXPECT_EQ("a\nb\n", t.getText());
+    t.clear();
+    EXPECT_TRUE(t.empty());
+    EXPECT_EQ(3, d.size());
+
+    // N description
+    m8r::NoteType type{"Note", nullptr, m8r::Color::RED()};
+    m8r::Note n{&type, nullptr};
+    n.setDescription(d);
+    n.addDescriptionLine("Last");
+    EXPECT_EQ("# Title\n\nText w/ \"quotes\".\nLast\n", n.getDescriptionAsString());
+    EXPECT_EQ(3, d.size());
+    n.clearDescription();
+    EXPECT_TRUE(n.getDescription().empty());
+}
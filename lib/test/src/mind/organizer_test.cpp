@@ -17,17 +17,24 @@
  along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
 
 #include "../test_utils.h"
+#include "../../../src/gear/file_utils.h"
+#include "../../../src/install/installer.h"
+#include "../../../src/mind/mind.h"
 #include "../../../src/model/eisenhower_matrix.h"
+#include "../../../src/model/kanban.h"
 #include "../../../src/representations/markdown/markdown_configuration_representation.h"
 
 using namespace std;
 
+extern char* getMindforgerGitHomePath();
+
 TEST(OrganizerTestCase, SerializeAndSplitTags)
 {
     // GIVEN
@@ -263,3 +270,152 @@ TEST(OrganizerTestCase, DefaultOrganizerParseSaveAndLoad)
     ASSERT_FALSE(c.hasRepositoryConfiguration());
     ASSERT_EQ(0, c.getRepositoryConfiguration().getOrganizers().size());
 }
+
+/*
+ * Quadrants as sorted sets (order of Ns w/ the same read timestamp is not defined).
+ */
+vector<m8r::Note*> quadrant(vector<m8r::Note*> ns)
+{
+    std::sort(ns.begin(), ns.end());
+    return ns;
+}
+
+void assertOrganizerView(m8r::Mind& mind, m8r::Organizer* organizer)
+{
+    vector<m8r::Note*> ul{}, ur{}, ll{}, lr{};
+    mind.organize(organizer, ul, ur, ll, lr);
+
+    // reference: scan of all Os and Ns
+    vector<m8r::Note*> ons{}, ns{};
+    mind.getAllNotes(ons, true, true);
+    mind.getAllNotes(ns, true, false);
+    vector<m8r::Note*> sul{}, sur{}, sll{}, slr{};
+    if(organizer && m8r::Organizer::OrganizerType::KANBAN == organizer->getOrganizerType()) {
+        m8r::Outline::organizeToKanbanColumns(
+            static_cast<m8r::Kanban*>(organizer), ons, mind.getOutlines(), ns, sul, sur, sll, slr);
+    } else {
+        m8r::Outline::organizeToEisenhowerMatrix(
+            organizer, ons, mind.getOutlines(), ns, sul, sur, sll, slr);
+    }
+
+    EXPECT_EQ(quadrant(sul), quadrant(ul));
+    EXPECT_EQ(quadrant(sur), quadrant(ur));
+    EXPECT_EQ(quadrant(sll), quadrant(ll));
+    EXPECT_EQ(quadrant(slr), quadrant(lr));
+}
+
+TEST(OrganizerTestCase, IncrementalViews)
+{
+    string repositoryDir{m8r::platformSpecificPath("/tmp/mf-unit-repository-organizer-views")};
+    m8r::removeDirectoryRecursively(repositoryDir.c_str());
+    m8r::Installer installer{};
+    installer.createEmptyMindForgerRepository(repositoryDir);
+
+    m8r::MarkdownRepositoryConfigurationRepresentation repositoryConfigRepresentation{};
+    m8r::Configuration& config = m8r::Configuration::getInstance();
+    config.clear();
+    config.setConfigFilePath(m8r::platformSpecificPath("/tmp/cfg-otc-iv.md"));
+    config.setActiveRepository(
+        config.addRepository(m8r::RepositoryIndexer::getRepositoryForPath(repositoryDir)),
+        repositoryConfigRepresentation
+    );
+    m8r::Mind mind{config};
+    mind.learn();
+
+    // Os and Ns w/ tags
+    const vector<string> tagNames{"todo", "doing", "done", "important", "later"};
+    vector<const m8r::Tag*> tags{};
+    for(const string& t:tagNames) {
+        tags.push_back(mind.getOntology().findOrCreateTag(t));
+    }
+    vector<string> outlineKeys{};
+    for(int o=0; o<4; o++) {
+        string name{"Outline " + std::to_string(o)};
+        string key = mind.outlineNew(&name);
+        outlineKeys.push_back(key);
+        m8r::Outline* outline = mind.remind().getOutline(key);
+        outline->addTag(tags[o%tags.size()]);
+        outline->setUrgency(o+1);
+        outline->setImportance(4-o);
+        for(int n=0; n<10; n++) {
+            name.assign("N" + std::to_string(o) + "." + std::to_string(n));
+            m8r::Note* note = mind.noteNew(key, n, &name);
+            note->setTag(tags[(o+n)%tags.size()]);
+            if(n%3 == 0) {
+                note->addTag(tags[(n/3)%tags.size()]);
+            }
+        }
+        mind.remember(key);
+    }
+
+    m8r::EisenhowerMatrix notesMatrix{"Notes"};
+    notesMatrix.setKey("/organizers/notes");
+    notesMatrix.setUpperLeftTag("todo");
+    notesMatrix.setUpperRightTags({"todo", "important"});
+    notesMatrix.setLowerLeftTag("done");
+    notesMatrix.filterBy = m8r::Organizer::FilterBy::NOTES;
+    m8r::EisenhowerMatrix outlinesMatrix{"Outlines"};
+    outlinesMatrix.setKey("/organizers/outlines");
+    outlinesMatrix.setUpperLeftTag("todo");
+    outlinesMatrix.setLowerRightTag("later");
+    outlinesMatrix.filterBy = m8r::Organizer::FilterBy::OUTLINES;
+    m8r::Kanban kanban{"Kanban"};
+    kanban.setKey("/organizers/kanban");
+    kanban.setUpperLeftTag("todo");
+    kanban.setUpperRightTag("doing");
+    kanban.setLowerLeftTag("done");
+    kanban.filterBy = m8r::Organizer::FilterBy::OUTLINES_NOTES;
+    vector<m8r::Organizer*> organizers{nullptr, &notesMatrix, &outlinesMatrix, &kanban};
+
+    for(m8r::Organizer* organizer:organizers) {
+        assertOrganizerView(mind, organizer);
+    }
+    EXPECT_EQ(organizers.size(), mind.remind().getOrganizerIndex().getViewsCount());
+    vector<m8r::Note*> ul{}, ur{}, ll{}, lr{};
+    mind.organize(&kanban, ul, ur, ll, lr);
+    EXPECT_LT(0, ul.size());
+    EXPECT_LT(0, ur.size());
+    EXPECT_LT(0, ll.size());
+    EXPECT_EQ(0, lr.size());
+
+    // tags, urgency and importance changes are reflected by views
+    m8r::Outline* o0 = mind.remind().getOutline(outlineKeys[0]);
+    o0->getNotes()[1]->setTag(tags[2]);
+    o0->getNotes()[2]->addTag(tags[3]);
+    o0->getNotes()[4]->setTag(tags[0]);
+    o0->setUrgency(5);
+    o0->addTag(tags[4]);
+    mind.remember(o0->getKey());
+    m8r::Outline* o3 = mind.remind().getOutline(outlineKeys[3]);
+    mind.noteForget(o3->getNotes()[0]);
+    mind.outlineForget(outlineKeys[1]);
+    for(m8r::Organizer* organizer:organizers) {
+        assertOrganizerView(mind, organizer);
+    }
+
+    // organizer definition change recompiles the view
+    kanban.setLowerRightTag("important");
+    notesMatrix.setOutlineScope(o0->getKey());
+    for(m8r::Organizer* organizer:organizers) {
+        assertOrganizerView(mind, organizer);
+    }
+
+    // organizer w/ too many tags is organized by the scan
+    m8r::Kanban wideKanban{"Wide Kanban"};
+    wideKanban.setKey("/organizers/wide-kanban");
+    std::set<string> wideTags{};
+    for(unsigned i=0; i<=m8r::OrganizerIndex::MAX_TAGS; i++) {
+        wideTags.insert("t" + std::to_string(i));
+    }
+    wideKanban.setUpperLeftTags(wideTags);
+    wideKanban.setUpperRightTag("todo");
+    assertOrganizerView(mind, &wideKanban);
+
+    // view of the deleted organizer is evicted
+    EXPECT_EQ(organizers.size(), mind.remind().getOrganizerIndex().getViewsCount());
+    mind.forgetOrganizer(&kanban);
+    EXPECT_EQ(organizers.size()-1, mind.remind().getOrganizerIndex().getViewsCount());
+
+    mind.amnesia();
+    EXPECT_EQ(0, mind.remind().getOrganizerIndex().getViewsCount());
+}
@@ -206,6 +206,14 @@ TEST(OutlineTestCase, CloneOutline) {
     EXPECT_EQ("Note Operations Test Outline", o->getName());
     EXPECT_EQ("Copy of Note Operations Test Outline", c->getName());
     EXPECT_EQ(o->getDescription().size(), c->getDescription().size());
+    EXPECT_EQ(o->getDescription(), c->getDescription());
+    // clone shares description text until it's modified
+    size_t lines = o->getDescription().size();
+    c->addDescriptionLine("Clone only line.");
+    EXPECT_EQ(lines, o->getDescription().size());
+    EXPECT_EQ(lines+1, c->getDescription().size());
+    EXPECT_TRUE(c->getDescription()[lines] == "Clone only line.");
+    EXPECT_NE(o->getDescription(), c->getDescription());
     EXPECT_GE(c->getModified(), c->getCreated());
     EXPECT_GE(c->getRead(), c->getModified());
 }
@@ -275,3 +283,95 @@ TEST(OutlineTestCase, DirectOutlineNoteChildren) {
     EXPECT_EQ("4", directChildren[2]->getName());
     EXPECT_EQ("6", directChildren[3]->getName());
 }
+
+/*
+ * Direct children offsets of N (or O if offset is -1) calculated from Ns depths:
+ * parent is the nearest N above w/ lower depth.
+ */
+vector<int> bruteForceDirectChildren(const vector<m8r::Note*>& notes, int offset)
+{
+    vector<int> children{};
+    for(int i=offset+1; i<static_cast<int>(notes.size()); i++) {
+        int parent = -1;
+        for(int p=i-1; p>=0; p--) {
+            if(notes[p]->getDepth() < notes[i]->getDepth()) {
+                parent = p;
+                break;
+            }
+        }
+        if(parent == offset) {
+            children.push_back(i);
+        }
+    }
+    return children;
+}
+
+void expectNoteTree(m8r::Outline& o)
+{
+    const vector<m8r::Note*>& notes = o.getNotes();
+    string error{};
+    EXPECT_TRUE(o.getNoteTree().check(notes, &error)) << error;
+
+    for(int i=-1; i<static_cast<int>(notes.size()); i++) {
+        m8r::Note* n = i<0?nullptr:notes[i];
+        vector<m8r::Note*> children{};
+        o.getDirectNoteChildren(n, children);
+        vector<int> expected = bruteForceDirectChildren(notes, i);
+        ASSERT_EQ(expected.size(), children.size());
+        for(size_t c=0; c<expected.size(); c++) {
+            EXPECT_EQ(notes[expected[c]], children[c]);
+        }
+        EXPECT_EQ(expected.size(), o.getDirectNoteChildrenCount(n));
+        if(n) {
+            EXPECT_EQ(i, o.getNoteOffset(n));
+        }
+    }
+}
+
+TEST(OutlineTestCase, NoteTreeIndex) {
+    m8r::OutlineType oType{m8r::OutlineType::KeyOutline(),nullptr,m8r::Color::RED()};
+    m8r::NoteType nType{"Note",nullptr,m8r::Color::RED()};
+    m8r::Outline o{&oType};
+    // depth gaps and Ns above the first top level N
+    for(u_int16_t depth:{2, 1, 3, 1, 0, 1, 2, 2, 1, 0, 3, 2, 0, 1}) {
+        m8r::Note* n = new m8r::Note{&nType, &o};
+        n->setName(std::to_string(o.getNotesCount()));
+        n->setDepth(depth);
+        o.addNote(n);
+    }
+    expectNoteTree(o);
+
+    vector<m8r::Note*> children{};
+    m8r::Outline::Patch patch{};
+    o.getAllNoteChildren(o.getNotes()[4], &children, &patch);
+    EXPECT_EQ(4, children.size());
+    EXPECT_EQ(4, patch.start);
+    EXPECT_EQ(4, patch.count);
+
+    // structure operations patch the index incrementally
+    for(int step=0; step<300; step++) {
+        m8r::Note* n = o.getNotes()[(step*7+3) % o.getNotesCount()];
+        patch.diff = m8r::Outline::Patch::Diff::NO;
+        switch(step % 6) {
+        case 0: o.promoteNote(n, &patch); break;
+        case 1: o.moveNoteUp(n, &patch); break;
+        case 2: o.demoteNote(n); break;
+        case 3: o.moveNoteDown(n, &patch); break;
+        case 4: o.moveNoteToFirst(n); break;
+        case 5: o.moveNoteToLast(n, &patch); break;
+        }
+        if(patch.diff == m8r::Outline::Patch::Diff::MOVE) {
+            EXPECT_LE(patch.start+patch.count, o.getNotesCount()-1);
+        }
+        SCOPED_TRACE("step " + std::to_string(step));
+        expectNoteTree(o);
+    }
+
+    // modifications which invalidate the index
+    o.getNotes()[5]->setDepth(o.getNotes()[5]->getDepth()+2);
+    expectNoteTree(o);
+    o.cloneNote(o.getNotes()[1]);
+    expectNoteTree(o);
+    o.forgetNote(o.getNotes()[3]);
+    expectNoteTree(o);
+}
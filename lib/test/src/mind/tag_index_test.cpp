@@ -0,0 +1,198 @@
+/*
+ tag_index_test.cpp     MindForger tag index test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/mind/tag_index.h"
+#include "../../../src/mind/ontology/ontology.h"
+
+using namespace std;
+
+m8r::Outline* createTaggedOutline(
+        m8r::Ontology& ontology,
+        const string& name,
+        const vector<string>& outlineTags,
+        const vector<vector<string>>& notesTags)
+{
+    m8r::Outline* o = new m8r::Outline{ontology.getDefaultOutlineType()};
+    o->setName(name);
+    for(const string& t:outlineTags) {
+        o->addTag(ontology.findOrCreateTag(t));
+    }
+    for(size_t i=0; i<notesTags.size(); i++) {
+        m8r::Note* n = new m8r::Note{ontology.getDefaultNoteType(), o};
+        n->setName(name + "." + std::to_string(i));
+        for(const string& t:notesTags[i]) {
+            n->addTag(ontology.findOrCreateTag(t));
+        }
+        o->addNote(n);
+    }
+    return o;
+}
+
+string tagIndexNotesToString(const vector<m8r::Note*>& notes)
+{
+    string s{};
+    for(m8r::Note* n:notes) {
+        if(s.size()) s += " ";
+        s += n->getName();
+    }
+    return s;
+}
+
+TEST(TagIndexTestCase, Queries)
+{
+    m8r::Ontology ontology{};
+    const m8r::Tag* cool = ontology.findOrCreateTag("cool");
+    const m8r::Tag* fast = ontology.findOrCreateTag("fast");
+    const m8r::Tag* none = ontology.findOrCreateTag("none");
+    const m8r::Tag* unknown = ontology.findOrCreateTag("unknown");
+
+    m8r::Outline* a = createTaggedOutline(ontology, "a", {"cool", "fast"}, {{"cool"}, {"fast", "cool", "cool"}, {}});
+    m8r::Outline* b = createTaggedOutline(ontology, "b", {"fast"}, {{"none"}, {"fast"}});
+    m8r::Outline* c = createTaggedOutline(ontology, "c", {"none"}, {{"cool", "fast"}});
+
+    m8r::TagIndex index{};
+    index.index(a);
+    index.index(b);
+    index.index(c);
+    EXPECT_EQ(9, index.getDocumentsCount());
+
+    // Os
+    vector<m8r::Outline*> outlines{};
+    index.findOutlines({cool}, outlines);
+    ASSERT_EQ(1, outlines.size());
+    EXPECT_EQ(a, outlines[0]);
+    outlines.clear();
+    index.findOutlines({fast}, outlines);
+    ASSERT_EQ(2, outlines.size());
+    EXPECT_EQ(a, outlines[0]);
+    EXPECT_EQ(b, outlines[1]);
+    outlines.clear();
+    index.findOutlines({cool, none}, outlines, true);
+    ASSERT_EQ(2, outlines.size());
+    EXPECT_EQ(a, outlines[0]);
+    EXPECT_EQ(c, outlines[1]);
+    outlines.clear();
+    index.findOutlines({}, outlines);
+    EXPECT_EQ(3, outlines.size());
+    outlines.clear();
+    index.findOutlines({cool, unknown}, outlines);
+    EXPECT_EQ(0, outlines.size());
+
+    // Ns are in O order and N order within O
+    vector<m8r::Note*> notes{};
+    index.findNotes({cool, fast}, notes);
+    EXPECT_EQ("a.1 c.0", tagIndexNotesToString(notes));
+    notes.clear();
+    index.findNotes({fast, none}, notes, true);
+    EXPECT_EQ("a.1 b.0 b.1 c.0", tagIndexNotesToString(notes));
+    notes.clear();
+    index.findNotes({}, notes);
+    EXPECT_EQ("a.0 a.1 a.2 b.0 b.1 c.0", tagIndexNotesToString(notes));
+
+    // cardinality: duplicate tags are counted once and "none" is skipped
+    map<const m8r::Tag*,int> cardinality{};
+    index.getCardinality(cardinality);
+    EXPECT_EQ(4, cardinality[cool]);
+    EXPECT_EQ(5, cardinality[fast]);
+    EXPECT_EQ(0, cardinality.count(none));
+    EXPECT_EQ(2, index.getCardinality(none));
+
+    // scoped cardinality
+    cardinality.clear();
+    vector<m8r::Outline*> scope{b, c};
+    index.getCardinality(cardinality, &scope);
+    EXPECT_EQ(1, cardinality[cool]);
+    EXPECT_EQ(3, cardinality[fast]);
+
+    delete a;
+    delete b;
+    delete c;
+}
+
+TEST(TagIndexTestCase, Maintenance)
+{
+    m8r::Ontology ontology{};
+    const m8r::Tag* cool = ontology.findOrCreateTag("cool");
+
+    m8r::Outline* a = createTaggedOutline(ontology, "a", {"cool"}, {{"cool"}});
+    m8r::Outline* b = createTaggedOutline(ontology, "b", {}, {{"cool"}});
+    m8r::Outline* c = createTaggedOutline(ontology, "c", {"cool"}, {});
+
+    m8r::TagIndex index{};
+    index.index(a);
+    index.index(b);
+    index.index(c);
+    EXPECT_EQ(4, index.getCardinality(cool));
+
+    // re-indexed O keeps its position
+    a->getNotes()[0]->setTags(nullptr);
+    m8r::Note* n = new m8r::Note{ontology.getDefaultNoteType(), a};
+    n->setName("a.1");
+    n->addTag(cool);
+    a->addNote(n);
+    index.index(a);
+    EXPECT_EQ(4, index.getCardinality(cool));
+    vector<m8r::Note*> notes{};
+    index.findNotes({cool}, notes);
+    EXPECT_EQ("a.1 b.0", tagIndexNotesToString(notes));
+
+    // replaced O keeps position of the old O
+    m8r::Outline* aa = createTaggedOutline(ontology, "aa", {"cool"}, {{"cool"}});
+    index.replace(a, aa);
+    delete a;
+    vector<m8r::Outline*> outlines{};
+    index.findOutlines({cool}, outlines);
+    ASSERT_EQ(2, outlines.size());
+    EXPECT_EQ(aa, outlines[0]);
+    EXPECT_EQ(c, outlines[1]);
+
+    // forgotten O (already deleted) is not dereferenced
+    index.forget(b);
+    delete b;
+    notes.clear();
+    index.findNotes({cool}, notes);
+    EXPECT_EQ("aa.0", tagIndexNotesToString(notes));
+    EXPECT_EQ(3, index.getCardinality(cool));
+    EXPECT_EQ(3, index.getDocumentsCount());
+
+    // many re-indexations trigger compaction
+    for(int i=0; i<10000; i++) {
+        index.index(c);
+    }
+    EXPECT_EQ(3, index.getDocumentsCount());
+    EXPECT_EQ(3, index.getCardinality(cool));
+    outlines.clear();
+    index.findOutlines({cool}, outlines);
+    ASSERT_EQ(2, outlines.size());
+    EXPECT_EQ(aa, outlines[0]);
+    EXPECT_EQ(c, outlines[1]);
+
+    index.clear();
+    EXPECT_EQ(0, index.getDocumentsCount());
+    EXPECT_EQ(0, index.getCardinality(cool));
+
+    delete aa;
+    delete c;
+}
@@ -0,0 +1,62 @@
+/*
+ configuration_store_test.cpp     MindForger configuration store test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/gear/file_utils.h"
+#include "../../../src/persistence/configuration_store.h"
+
+using namespace std;
+
+TEST(ConfigurationStoreTestCase, DirtyTracking)
+{
+    string path{"/tmp/mf-unit-configuration-store.md"};
+    remove(path.c_str());
+    m8r::ConfigurationStore& store = m8r::ConfigurationStore::getInstance();
+    store.flush();
+    unsigned writes = store.getWrites();
+    unsigned skipped = store.getSkipped();
+
+    // burst of changes is written once on flush
+    EXPECT_TRUE(store.store(path, "# Configuration 1\n"));
+    EXPECT_TRUE(store.store(path, "# Configuration 2\n"));
+    EXPECT_TRUE(store.store(path, "# Configuration 3\n"));
+    store.flush();
+    EXPECT_EQ(writes+1, store.getWrites());
+    string* content = m8r::fileToString(path);
+    EXPECT_EQ("# Configuration 3\n", *content);
+    delete content;
+
+    // unchanged configuration is not written
+    EXPECT_FALSE(store.store(path, "# Configuration 3\n"));
+    store.flush();
+    EXPECT_EQ(writes+1, store.getWrites());
+    EXPECT_EQ(skipped+1, store.getSkipped());
+
+    // deleted or invalidated file is written even if unchanged
+    remove(path.c_str());
+    EXPECT_TRUE(store.store(path, "# Configuration 3\n"));
+    store.invalidate(path);
+    EXPECT_TRUE(store.store(path, "# Configuration 3\n"));
+    store.flush();
+    EXPECT_EQ(writes+2, store.getWrites());
+    EXPECT_TRUE(m8r::isFile(path.c_str()));
+}
@@ -0,0 +1,127 @@
+/*
+ write_behind_queue_test.cpp     MindForger write-behind queue test
+
+ Copyright (C) 2016-2022 Martin Dvorak <martin.dvorak@mindforger.com>
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "../../../src/gear/file_utils.h"
+#include "../../../src/persistence/write_behind_queue.h"
+
+using namespace std;
+
+TEST(WriteBehindQueueTestCase, WriteAndFlush)
+{
+    string directory{"/tmp/mf-unit-write-behind"};
+    m8r::removeDirectoryRecursively(directory.c_str());
+    m8r::createDirectory(directory);
+    string alpha{directory+"/alpha.md"};
+    string beta{directory+"/beta.md"};
+
+    m8r::WriteBehindQueue queue{};
+    // flush w/o writes doesn't block
+    queue.flush();
+
+    // repeated saves of the same file are coalesced, the last one wins
+    const unsigned SAVES = 1000;
+    for(unsigned i=1; i<=SAVES; i++) {
+        queue.write(alpha, new string{"# Alpha " + std::to_string(i) + "\n"});
+    }
+    queue.write(beta, new string{"# Beta\n"});
+    queue.flush();
+
+    EXPECT_EQ(0, queue.getFailures());
+    EXPECT_EQ(SAVES+1, queue.getWrites()+queue.getCoalesced());
+    EXPECT_LE(2, queue.getWrites());
+    string* content = m8r::fileToString(alpha);
+    EXPECT_EQ("# Alpha " + std::to_string(SAVES) + "\n", *content);
+    delete content;
+    content = m8r::fileToString(beta);
+    EXPECT_EQ("# Beta\n", *content);
+    delete content;
+    unordered_map<string,bool> results{};
+    queue.takeResults(results);
+    EXPECT_EQ(2, results.size());
+    EXPECT_TRUE(results[alpha]);
+    EXPECT_TRUE(results[beta]);
+
+    // failure is counted and reported, the queue keeps working
+    string gamma{directory+"/missing/gamma.md"};
+    queue.write(gamma, new string{"# Gamma\n"});
+    queue.write(beta, new string{"# Beta 2\n"});
+    queue.flush();
+    EXPECT_EQ(1, queue.getFailures());
+    content = m8r::fileToString(beta);
+    EXPECT_EQ("# Beta 2\n", *content);
+    delete content;
+    results.clear();
+    queue.takeResults(results);
+    EXPECT_EQ(2, results.size());
+    EXPECT_FALSE(results[gamma]);
+    EXPECT_TRUE(results[beta]);
+
+    // results are taken only once
+    results.clear();
+    queue.takeResults(results);
+    EXPECT_TRUE(results.empty());
+}
+
+TEST(WriteBehindQueueTestCase, FlushOnDestruction)
+{
+    string path{"/tmp/mf-unit-write-behind-destruction.md"};
+    remove(path.c_str());
+    {
+        m8r::WriteBehindQueue queue{};
+        queue.write(path, new string{"# Written\n"});
+    }
+    string* content = m8r::fileToString(path);
+    EXPECT_EQ("# Written\n", *content);
+    delete content;
+}
+
+TEST(WriteBehindQueueTestCase, Debounce)
+{
+    string path{"/tmp/mf-unit-write-behind-debounce.md"};
+    remove(path.c_str());
+
+    m8r::WriteBehindQueue queue{200};
+    // burst of writes is coalesced to a single write after debounce
+    const unsigned SAVES = 50;
+    for(unsigned i=1; i<=SAVES; i++) {
+        queue.write(path, new string{"# Burst " + std::to_string(i) + "\n"});
+    }
+    EXPECT_EQ(0, queue.getWrites());
+    queue.flush();
+    EXPECT_EQ(1, queue.getWrites());
+    EXPECT_EQ(SAVES-1, queue.getCoalesced());
+    string* content = m8r::fileToString(path);
+    EXPECT_EQ("# Burst " + std::to_string(SAVES) + "\n", *content);
+    delete content;
+
+    // debounced write is done w/o flush
+    queue.write(path, new string{"# Later\n"});
+    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+    EXPECT_EQ(2, queue.getWrites());
+    content = m8r::fileToString(path);
+    EXPECT_EQ("# Later\n", *content);
+    delete content;
+}
@@ -109,7 +109,13 @@ SOURCES += \
     ./gear/string_utils_test.cpp \
     ./indexer/repository_indexer_test.cpp \
     ./markdown/markdown_test.cpp \
+    ./markdown/markdown_highlight_scanner_test.cpp \
     ./mind/fts_test.cpp \
+    ./mind/tag_index_test.cpp \
+    ./mind/name_index_test.cpp \
+    ./mind/aggregates_test.cpp \
+    ./mind/export_test.cpp \
+    ./mind/knowledge_graph_layout_test.cpp \
     ./mind/memory_test.cpp \
     ./mind/mind_test.cpp \
     ./mind/note_test.cpp \
@@ -119,13 +125,20 @@ SOURCES += \
     ./test_utils.cpp \
     ./config/configuration_test.cpp \
     ../benchmark/markdown_benchmark.cpp \
+    ../benchmark/markdown_highlight_benchmark.cpp \
     ../benchmark/html_benchmark.cpp \
     ./html/html_test.cpp \
     ./ai/nlp_test.cpp \
     ../benchmark/trie_benchmark.cpp \
     ../benchmark/ai_benchmark.cpp \
+    ../benchmark/string_benchmark.cpp \
+    ../benchmark/knowledge_graph_benchmark.cpp \
     ./gear/file_utils_test.cpp \
+    ./persistence/configuration_store_test.cpp \
+    ./persistence/write_behind_queue_test.cpp \
     ./gear/trie_test.cpp \
+    ./gear/aho_corasick_test.cpp \
+    ./gear/thread_pool_test.cpp \
     ./ai/autolinking_test.cpp \
     ./ai/autolinking_cmark_test.cpp \
     ./mind/filesystem_information_test.cpp
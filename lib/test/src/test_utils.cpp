@@ -250,11 +250,7 @@ void printAst(const vector<MarkdownAstNodeSection*>* ast)
         for(MarkdownAstNodeSection* section:*ast) {
             cout << endl << "  " << ++c << " #";
             cout << section->getDepth();
-            if(section->getBody()) {
-                cout << " d" << section->getBody()->size();
-            } else {
-                cout << " dNULL";
-            }
+            cout << " d" << section->getBody().size();
             cout << " '";
             name = section->getText();
             if(name!=nullptr) {